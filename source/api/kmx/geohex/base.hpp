@@ -100,6 +100,12 @@ namespace kmx::geohex
     direction_t rotate_60ccw(const direction_t digit) noexcept;
     direction_t rotate_60cw(const direction_t digit) noexcept;
 
+    /// @brief Gets the reverse of a direction, e.g. ij_axes for k_axes; center and invalid map to themselves.
+    constexpr direction_t opposite(const direction_t digit) noexcept
+    {
+        return ((digit == direction_t::center) || (+digit >= direction_count)) ? digit : static_cast<direction_t>(direction_count - +digit);
+    }
+
     using k_distance = std::uint32_t;
 
     namespace cell::base
@@ -154,6 +160,10 @@ namespace kmx::geohex
 
     double scaling_factor(const resolution_t resolution) noexcept;
 
+    /// @ref EARTH_RADIUS_KM
+    constexpr double earth_radius_km = 6371.0088;
+    constexpr double meters_per_km = 1000.0;
+
     /// @brief Converts degrees to radians.
     /// @param degrees Angle in degrees.
     /// @return Angle in radians.
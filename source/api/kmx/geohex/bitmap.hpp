@@ -0,0 +1,87 @@
+/// @file geohex/bitmap.hpp
+#pragma once
+#ifndef PCH
+    #include <cstddef>
+    #include <cstdint>
+    #include <kmx/geohex/index.hpp>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::bitmap
+{
+    /// @brief A set of cells of one resolution, for union, intersection and difference of large sets.
+    /// @details The cells are numbered by `cell::to_number`, their base cell then their digits. As in Roaring bitmaps,
+    /// the high bits of the numbers (the base cell and the leading digits) pick a container of 65536 numbers, holding a
+    /// sorted array of its low 16 bits while it has at most 4096 of them, a bitmap of 1024 words beyond: a set takes at
+    /// most 2 bytes per cell, and one bit per number where it is dense. The operations on two bitmaps are word loops,
+    /// which compilers turn into vector instructions.
+    class set
+    {
+    public:
+        /// @brief An empty set.
+        set() = default;
+
+        /// @brief Replaces the content by cells.
+        /// @param cells The cells, of one resolution, in any order; repeats are kept once.
+        /// @return error_t::none on success, error_t::cell_invalid for a cell that is not valid, error_t::res_mismatch for
+        /// cells of different resolutions.
+        error_t assign(const std::span<const index> cells);
+
+        /// @brief Gets the cells, sorted.
+        /// @param[out] cells The cells, replaced.
+        void to_cells(std::vector<index>& cells) const;
+
+        /// @brief Gets the number of cells.
+        std::size_t size() const noexcept { return size_; }
+
+        bool empty() const noexcept { return size_ == 0u; }
+
+        /// @brief Gets the resolution of the cells; that of an empty set is meaningless.
+        resolution_t resolution() const noexcept { return resolution_; }
+
+        /// @brief Checks whether a cell is in the set.
+        bool contains(const index cell) const noexcept;
+
+        /// @brief Gets the union of two sets.
+        /// @param[out] result The union, replaced on success; it may be one of the sets.
+        /// @return error_t::none on success, error_t::res_mismatch for non-empty sets of different resolutions.
+        friend error_t unite(const set& a, const set& b, set& result);
+
+        /// @brief Gets the intersection of two sets.
+        /// @param[out] result The intersection, replaced on success; it may be one of the sets.
+        /// @return error_t::none on success, error_t::res_mismatch for non-empty sets of different resolutions.
+        friend error_t intersect(const set& a, const set& b, set& result);
+
+        /// @brief Gets the cells of a set that are not in another one.
+        /// @param[out] result The difference, replaced on success; it may be one of the sets.
+        /// @return error_t::none on success, error_t::res_mismatch for non-empty sets of different resolutions.
+        friend error_t subtract(const set& a, const set& b, set& result);
+
+    private:
+        /// @brief The numbers sharing their high bits: an array of low bits, or a bitmap when `words` is not empty.
+        struct container
+        {
+            std::uint64_t high {};
+            std::uint32_t size {};
+            std::vector<std::uint16_t> values;
+            std::vector<std::uint64_t> words;
+        };
+
+        /// @brief Combines the containers of two sets with an operation on containers.
+        template <typename Operation>
+        static error_t combine(const set& a, const set& b, set& result, const bool keep_a, const bool keep_b, Operation&& operation);
+
+        friend struct containers;
+
+        resolution_t resolution_ {};
+        std::size_t size_ {};
+        std::vector<container> containers_; ///< Sorted by their high bits, none empty.
+    };
+
+    error_t unite(const set& a, const set& b, set& result);
+
+    error_t intersect(const set& a, const set& b, set& result);
+
+    error_t subtract(const set& a, const set& b, set& result);
+}
@@ -0,0 +1,64 @@
+/// @file geohex/cap.hpp
+#pragma once
+#ifndef PCH
+    #include <cstdint>
+    #include <kmx/geohex/index.hpp>
+    #include <kmx/gis/wgs84/coordinate.hpp>
+    #include <kmx/math/vector.hpp>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::cap
+{
+    // A cap is the set of points within a great circle distance of a center, such as a geofence around a point. Like
+    // for polygons, a cell belongs to the cap when its center does.
+
+    /// @brief A spherical cap.
+    struct item
+    {
+        gis::wgs84::coordinate center; ///< The center, in radians.
+        double radius {};              ///< The great circle distance to the center, in meters.
+    };
+
+    /// @brief The position of the points near a cell against a cap.
+    enum class position_t : std::uint8_t
+    {
+        outside,  ///< No point is in the cap.
+        inside,   ///< Every point is in the cap.
+        boundary, ///< The cap boundary may pass among the points.
+    };
+
+    /// @brief A cap ready to classify cells during walks down the hierarchy: its center as a unit vector and its radius
+    /// as an angle.
+    class region
+    {
+    public:
+        explicit region(const item& cap) noexcept;
+
+        /// @brief Classifies the points within a reach (in radians) of a cell center, such as its descendant centers
+        /// (see `cell::bounds::center_reaches`).
+        /// @return The position, or position_t::outside for an invalid cell.
+        position_t classify(const index cell, const double reach) const noexcept;
+
+    private:
+        math::vector3d center_;
+        double angle_ {};
+    };
+
+    /// @brief Gets the cells of a resolution whose center is within a cap.
+    /// @details The hierarchy is walked down from the base cells: a cell whose descendant centers are all within, or
+    /// all beyond, the radius from the cap center is emitted or dropped whole, only the cells straddling the cap
+    /// boundary are refined down to `resolution`. The cells come out grouped by base cell.
+    /// @param cap The cap.
+    /// @param resolution The resolution of the cells.
+    /// @param[out] cells The cells, replaced on success.
+    /// @return error_t::none on success, error_t::res_domain for an invalid resolution, error_t::latlng_domain for a
+    /// non-finite center, error_t::domain for a negative or non-finite radius.
+    error_t to_cells(const item& cap, const resolution_t resolution, std::vector<index>& cells);
+
+    /// @brief Gets the cells of a resolution whose center is within a cap, compacted.
+    /// @details The cells of `to_cells`, with every complete set of siblings replaced by their parent (see H3
+    /// compactCells): the cells inside the cap are emitted at the coarsest resolution the walk reaches them.
+    /// @param resolution The finest resolution of the cells.
+    error_t to_compact_cells(const item& cap, const resolution_t resolution, std::vector<index>& cells);
+}
@@ -21,6 +21,49 @@ namespace kmx::geohex::cell
     /// @ref cellToChildrenSize
     /// @param index The parent H3 index.
     /// @param child_resolution The resolution of the children.
-    /// @return The number of children.
+    /// @return The number of children, 0 for a resolution coarser than the one of `index`.
     children_count_t children_count(const index index, const resolution_t child_resolution) noexcept;
+
+    /// @ref cellToParent
+    /// @brief Gets the ancestor of a cell at a resolution.
+    /// @param resolution The resolution of the ancestor, not finer than the one of `cell`: the cell itself for its own.
+    index parent(const index cell, const resolution_t resolution) noexcept;
+
+    /// @brief Gets the number of a cell among those of its resolution: its base cell, then its digits, 3 bits each.
+    /// @details The numbers follow the order of the cells, which makes them dense keys for sets of one resolution.
+    std::uint64_t to_number(const index cell) noexcept;
+
+    /// @brief Gets the cell of a resolution with a number given by `to_number`.
+    index from_number(const std::uint64_t number, const resolution_t resolution) noexcept;
+
+    /// @ref cellToChildren
+    /// @brief Calls a function with each child of a cell at the next resolution, in digit order.
+    /// @param cell A cell coarser than resolution 15.
+    template <typename Function>
+    void for_each_child(const index cell, Function&& function)
+    {
+        const auto res = +cell.resolution();
+        index child = cell;
+        child.set_resolution(static_cast<resolution_t>(res + 1u));
+        for (auto digit = +direction_t::center; digit != direction_count; ++digit)
+        {
+            // the k subsequence of a pentagon is deleted
+            if (cell.is_pentagon() && (digit == +direction_t::k_axes))
+                continue;
+
+            child.set_digit(res, digit);
+            function(child);
+        }
+    }
+
+    /// @brief Calls a function with each descendant of a cell at a resolution, in digit order.
+    /// @param resolution The resolution of the descendants, not coarser than the one of `cell`.
+    template <typename Function>
+    void for_each_descendant(const index cell, const resolution_t resolution, Function&& function)
+    {
+        if (cell.resolution() == resolution)
+            function(cell);
+        else
+            for_each_child(cell, [&](const index child) { for_each_descendant(child, resolution, function); });
+    }
 }
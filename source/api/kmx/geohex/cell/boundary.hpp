@@ -29,4 +29,14 @@ namespace kmx::geohex::cell::boundary
     /// @return error_t::none on success, or an error code.
     error_t get_vertices(const icosahedron::face::ijk& center_fijk, const index cell_index,
                          std::span<gis::wgs84::coordinate>& out_vertices) noexcept;
+
+    /// @brief Calculates a run of consecutive boundary vertices, e.g. the two vertices of a directed edge.
+    /// @param center_fijk The FaceIJK of the cell's center.
+    /// @param cell_index The H3 index of the cell.
+    /// @param start The number of the first vertex (wraps around the cell).
+    /// @param length The number of vertices to produce.
+    /// @param[out] out_vertices The vertices, resized to `length` on success.
+    /// @return error_t::none on success, or an error code.
+    error_t get_vertices(const icosahedron::face::ijk& center_fijk, const index cell_index, const std::uint8_t start,
+                         const std::uint8_t length, std::span<gis::wgs84::coordinate>& out_vertices) noexcept;
 }
@@ -0,0 +1,116 @@
+/// @file geohex/cell/bounds.hpp
+#pragma once
+#ifndef PCH
+    #include <array>
+    #include <kmx/geohex/base.hpp>
+    #include <kmx/geohex/cell/base.hpp>
+    #include <kmx/geohex/index.hpp>
+    #include <kmx/gis/wgs84/coordinate.hpp>
+    #include <kmx/math/vector.hpp>
+    #include <span>
+#endif
+
+namespace kmx::geohex::cell::bounds
+{
+    // Conservative bounds of cells, for culling: R-tree building, tile assignment, polygon pruning.
+
+    /// @brief Upper bound of the distance from a cell center to the center of a child, times the square root of 7 to
+    /// the power of the resolution of the child, in radians.
+    inline constexpr double max_child_distance = 0.39;
+
+    /// @brief Error of the cell centers and vertices computed near a pole, in radians: their latitudes come from an
+    /// arcsine that loses half the digits there. Radii get it as a margin.
+    inline constexpr double radius_margin = 2e-8;
+
+    /// @brief A base cell with its center.
+    struct base_center
+    {
+        index cell;
+        gis::wgs84::coordinate center;
+    };
+
+    /// @brief Gets the base cells with their centers, in base cell order, computed once: walks down the cell hierarchy
+    /// start with them.
+    const std::array<base_center, base::count>& base_cells() noexcept;
+
+    /// @brief Gets the reach of the descendant centers of the cells of each resolution for a walk down to a finer one:
+    /// the center of every descendant at `resolution` of a cell is within its reach of the cell center.
+    /// @param resolution A valid resolution.
+    /// @param[out] out The reaches of resolutions 0 to `resolution` (0 at `resolution`), the others left.
+    void center_reaches(const resolution_t resolution, std::span<double, resolution_count> out) noexcept;
+
+    /// @brief Gets the reach of the cells of each resolution for a walk down to a finer one: every point of a
+    /// descendant at `resolution` of a cell is within its reach of the cell center.
+    /// @param resolution A valid resolution.
+    /// @param[out] out The reaches of resolutions 0 to `resolution`, the others left.
+    void reaches(const resolution_t resolution, std::span<double, resolution_count> out) noexcept;
+
+    /// @brief A spherical cap holding a cell.
+    struct cap
+    {
+        math::vector3d center; ///< The cell center, as a unit vector.
+        double radius {};      ///< The angular radius, in radians.
+
+        /// @brief Checks whether a unit vector is in the cap.
+        bool contains(const math::vector3d& point) const noexcept;
+    };
+
+    /// @brief A latitude/longitude box holding a cell, in radians.
+    /// @details A box crossing the antimeridian has its west longitude greater than its east one; a box reaching a pole
+    /// spans all the longitudes, from -pi to pi.
+    struct box
+    {
+        double south {};
+        double north {};
+        double west {};
+        double east {};
+
+        /// @brief Checks whether the box crosses the antimeridian.
+        bool is_transmeridian() const noexcept { return west > east; }
+
+        /// @brief Checks whether a coordinate is in the box.
+        bool contains(const gis::wgs84::coordinate& coord) const noexcept;
+    };
+
+    /// @brief How closely the boxes of a batch fit their cells.
+    enum class fit_t : std::uint8_t
+    {
+        tight,    ///< From the cell boundary, as `get(index, box&)`.
+        bounding, ///< From the bounding cap, without the boundary: somewhat larger, several times cheaper.
+    };
+
+    /// @brief Gets the largest distance from a cell center to its boundary at a resolution, in radians.
+    /// @details Measured over every cell down to resolution 6; the distance shrinks by the square root of 7 per
+    /// resolution, towards a limit reached from below, which bounds the finer resolutions.
+    /// @return The distance, or 0 for an invalid resolution.
+    double max_radius(const resolution_t resolution) noexcept;
+
+    /// @brief Gets the cap around the center of a cell with the largest radius of its resolution.
+    /// @details Near the poles, where the coordinates of the cells lose precision, the radius has a small margin.
+    /// @return error_t::none on success, or the error of `to_wgs`.
+    error_t get(const index cell, cap& out) noexcept;
+
+    /// @ref cellToBBox
+    /// @brief Gets the smallest box holding a cell, its curved edges included.
+    /// @return error_t::none on success, or the error of `boundary::get`.
+    error_t get(const index cell, box& out) noexcept;
+
+    /// @brief Gets the smallest box holding a cap.
+    box to_box(const cap& cap) noexcept;
+
+    /// @brief Gets the smallest box holding the cap of a radius (in radians) around a coordinate.
+    box to_box(const gis::wgs84::coordinate& center, const double radius) noexcept;
+
+    /// @brief Gets the caps of a batch of cells.
+    /// @param[out] caps At least as many items as cells.
+    /// @return error_t::none on success, error_t::memory_bounds when `caps` is too small, or else the first error of
+    /// a cell.
+    error_t get(std::span<const index> cells, std::span<cap> caps) noexcept;
+
+    /// @brief Gets the boxes of a batch of cells.
+    /// @param[out] boxes At least as many items as cells.
+    /// @param fit How closely the boxes fit the cells.
+    /// @return error_t::none on success, error_t::memory_bounds when `boxes` is too small, or else the first error of
+    /// a cell.
+    error_t get(std::span<const index> cells, std::span<box> boxes, const fit_t fit = fit_t::tight) noexcept;
+}
@@ -0,0 +1,86 @@
+/// @file geohex/codec.hpp
+#pragma once
+#ifndef PCH
+    #include <cstddef>
+    #include <cstdint>
+    #include <kmx/geohex/index.hpp>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::codec
+{
+    // A compressed set of cells of one resolution. A cell is numbered by its base cell and digits, without the mode,
+    // resolution and trailing 7 bits every cell of the set shares; the sorted numbers are cut in blocks of 128 whose
+    // gaps to the previous number are bit packed with the width of the largest gap of the block. The gaps of a block sit
+    // in 4 lanes of 64 bit words, gap i in lane i % 4, so the 4 gaps of a step are unpacked with the same shifts, which
+    // compilers turn into vector instructions. A skip table holds the first number of each block with its packed words:
+    //
+    // | content    | layout                                                                                    |
+    // |------------|-------------------------------------------------------------------------------------------|
+    // | header     | magic "GHXC" (32 bit), version, resolution (8 bit each), 16 bits of 0, cell count (64 bit) |
+    // | skip table | per block: first number (64 bit), first packed word (32 bit), gap width (8 bit), 24 bits of 0 |
+    // | blocks     | the packed words, one block after another                                                  |
+    //
+    // All the numbers are little endian. A dense set takes a few bits per cell, a sparse one about 64 minus the bits of
+    // the ratio between the number of cells of the resolution and of the set.
+
+    /// @brief Cells per block.
+    inline constexpr std::size_t block_size = 128u;
+
+    /// @brief Appends the encoding of a set of cells.
+    /// @param cells The cells, sorted without repeats, all of one resolution.
+    /// @return error_t::none on success, error_t::cell_invalid for a cell that is not valid, error_t::res_mismatch for
+    /// cells of different resolutions, error_t::domain for cells not sorted or repeated.
+    error_t encode(const std::span<const index> cells, std::vector<std::byte>& data);
+
+    /// @brief Reads an encoded set of cells in place.
+    class view
+    {
+    public:
+        /// @brief An empty set, to open later.
+        view() = default;
+
+        /// @brief Opens an encoded set, checking its header and skip table.
+        /// @param data The encoding, which must outlive the view.
+        /// @return error_t::none on success, error_t::domain for data that is not an encoded set or truncated.
+        error_t open(const std::span<const std::byte> data) noexcept;
+
+        /// @brief Gets the number of cells.
+        std::size_t size() const noexcept { return count_; }
+
+        /// @brief Gets the resolution of the cells.
+        resolution_t resolution() const noexcept { return resolution_; }
+
+        /// @brief Gets the number of blocks.
+        std::size_t block_count() const noexcept { return (count_ + block_size - 1u) / block_size; }
+
+        /// @brief Decodes a block.
+        /// @param[out] cells The cells of the block, the first `block_size` of the span at most.
+        /// @return The number of cells of the block.
+        std::size_t decode(const std::size_t block, const std::span<index, block_size> cells) const noexcept;
+
+        /// @brief Decodes every cell.
+        /// @param[out] cells The cells, sorted, replaced.
+        void decode(std::vector<index>& cells) const;
+
+        /// @brief Gets a cell by its rank, decoding its block.
+        /// @return The cell, or the invalid index 0 for a rank not below `size()`.
+        index at(const std::size_t rank) const noexcept;
+
+        /// @brief Checks whether a cell is in the set, decoding the block it would be in.
+        bool contains(const index cell) const noexcept;
+
+    private:
+        /// @brief Gets the first number of a block.
+        std::uint64_t first_key(const std::size_t block) const noexcept;
+
+        /// @brief Decodes the numbers of a block.
+        std::size_t decode_keys(const std::size_t block, std::uint64_t* keys) const noexcept;
+
+        std::size_t count_ {};
+        resolution_t resolution_ {};
+        std::span<const std::byte> skips_;
+        std::span<const std::byte> words_;
+    };
+}
@@ -0,0 +1,47 @@
+/// @file geohex/compact.hpp
+#pragma once
+#ifndef PCH
+    #include <kmx/geohex/index.hpp>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::compact
+{
+    // Set algebra on compacted sets of cells of mixed resolutions, without expanding them to a common resolution. Each
+    // cell stands for the range of numbers (see `cell::to_number`) of its descendants at resolution 15: the ranges of
+    // two cells are nested or apart. The cells are taken in the order of their ranges, a cell before its descendants,
+    // and the operations merge the ranges of both sets in one pass.
+    //
+    // The sets are given in any order and may hold a cell with its descendants; the results come in range order,
+    // compacted: no cell with a descendant, no complete set of siblings.
+
+    /// @ref compactCells
+    /// @brief Compacts a set of cells of mixed resolutions.
+    /// @param[out] result The cells in range order, without those inside another one and with complete sets of siblings
+    /// replaced by their parent, recursively; replaced on success.
+    /// @return error_t::none on success, error_t::cell_invalid for a cell that is not valid.
+    error_t normalize(const std::span<const index> cells, std::vector<index>& result);
+
+    /// @brief Gets the union of two compacted sets.
+    /// @param[out] result The union, compacted, replaced on success.
+    /// @return error_t::none on success, error_t::cell_invalid for a cell that is not valid.
+    error_t unite(const std::span<const index> a, const std::span<const index> b, std::vector<index>& result);
+
+    /// @brief Gets the intersection of two compacted sets.
+    /// @param[out] result The intersection, compacted, replaced on success.
+    /// @return error_t::none on success, error_t::cell_invalid for a cell that is not valid.
+    error_t intersect(const std::span<const index> a, const std::span<const index> b, std::vector<index>& result);
+
+    /// @brief Gets the area of a compacted set outside another one.
+    /// @details A cell of `a` partly covered by `b` is split into its children, down to the cells of `b` inside it.
+    /// @param[out] result The difference, compacted, replaced on success.
+    /// @return error_t::none on success, error_t::cell_invalid for a cell that is not valid.
+    error_t subtract(const std::span<const index> a, const std::span<const index> b, std::vector<index>& result);
+
+    /// @brief Checks whether a set covers another one: every cell of `b` is in a cell of `a` or is one, once `a` is
+    /// compacted (its complete sets of siblings cover their parent).
+    /// @param[out] result True when `a` covers `b`.
+    /// @return error_t::none on success, error_t::cell_invalid for a cell that is not valid.
+    error_t covers(const std::span<const index> a, const std::span<const index> b, bool& result);
+}
@@ -14,9 +14,9 @@ namespace kmx::geohex::coordinate
     using vector2 = kmx::math::vector2d;
     using index_as_tuple = std::tuple<int, int, int>;
 
-    /// @brief Represents hexagonal grid coordinates in the IJK cube coordinate system.
-    /// @details In this system, i + j + k = 0 always holds for valid coordinates.
-    /// This property simplifies many grid algorithms like rotation and neighbor finding.
+    /// @brief Represents hexagonal grid coordinates in the IJK system of three axes 120 degrees apart.
+    /// @details The axes are redundant, (1, 1, 1) is the origin; a normalized coordinate has no negative component
+    /// and at least one zero component.
     /// @ref CoordIJK
     class ijk: public ij
     {
@@ -50,6 +50,10 @@ namespace kmx::geohex::coordinate
         /// @ref _ijkRound
         [[nodiscard]] static ijk from_cube_round(double i, double j, double k) noexcept;
 
+        /// @brief Creates the normalized coordinate of the cell containing a 2D Cartesian point of the grid plane.
+        /// @ref _hex2dToCoordIJK
+        [[nodiscard]] static ijk from_hex2d(const vector2& v) noexcept;
+
         /// @brief Calculates the 2D Cartesian coordinates of the hexagon's center.
         /// @ref _ijkToHex2d
         [[nodiscard]] vector2 center() const noexcept;
@@ -74,8 +78,7 @@ namespace kmx::geohex::coordinate
         void operator-=(const ijk& item) noexcept;
         void operator*=(int factor) noexcept { scale(factor); }
 
-        /// @brief Adjusts IJK coordinates to the nearest valid cube coordinate center.
-        /// @details Ensures that i + j + k = 0.
+        /// @brief Brings the coordinate to its normalized form (no negative component, at least one zero component).
         /// @ref _ijkNormalize
         void normalize() noexcept;
 
@@ -86,30 +89,38 @@ namespace kmx::geohex::coordinate
         /// @ref _unitIjkToDigit
         [[nodiscard]] direction_t to_digit() const noexcept;
 
-        /// @brief Moves coordinates to the parent cell in a Class II resolution grid (aperture 7).
+        /// @brief Moves coordinates to the parent cell, from a Class III grid (counter-clockwise aperture 7).
         /// @ref _upAp7
         void up_ap7() noexcept;
 
-        /// @brief Moves coordinates to the parent cell in a Class III resolution grid (aperture 7, rotated).
+        /// @brief Moves coordinates to the parent cell, from a Class II grid (clockwise aperture 7).
         /// @ref _upAp7r
         void up_ap7r() noexcept;
 
-        /// @brief Moves coordinates to the child cell center in a Class II grid.
+        /// @brief Moves coordinates to the center child, in a Class III grid (counter-clockwise aperture 7).
         /// @ref _downAp7
         void down_ap7() noexcept;
 
-        /// @brief Moves coordinates to the child cell center in a Class III grid.
+        /// @brief Moves coordinates to the center child, in a Class II grid (clockwise aperture 7).
         /// @ref _downAp7r
         void down_ap7r() noexcept;
 
-        /// @brief Returns a copy of this coordinate moved to a finer resolution grid.
+        /// @brief Moves coordinates to the counter-clockwise aperture 3 substrate grid.
+        /// @ref _downAp3
+        void down_ap3() noexcept;
+
+        /// @brief Moves coordinates to the clockwise aperture 3 substrate grid.
+        /// @ref _downAp3r
+        void down_ap3r() noexcept;
+
+        /// @brief Returns a copy of this coordinate moved to the center child, in a grid of the given class.
         [[nodiscard]] ijk down_ap7(bool is_class_3) const noexcept;
 
-        /// @brief Returns a copy of this coordinate moved to a coarser resolution grid.
+        /// @brief Returns a copy of this coordinate moved to the parent cell, from a grid of the given class.
         [[nodiscard]] ijk up_ap7_copy(bool is_class_3) const noexcept;
 
         /// @brief Moves this coordinate to a neighboring cell in a given direction.
-        /// @ref _ijkNeighbor
+        /// @ref _neighbor
         void to_neighbor(direction_t digit) noexcept;
 
         /// @brief Returns the neighboring cell's coordinates in a given direction.
@@ -0,0 +1,44 @@
+/// @file geohex/coverer.hpp
+#pragma once
+#ifndef PCH
+    #include <kmx/geohex/cap.hpp>
+    #include <kmx/geohex/index.hpp>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::polygon
+{
+    class prepared;
+}
+
+namespace kmx::geohex::coverer
+{
+    // A cover approximates a region with a bounded number of cells of mixed resolutions (as S2RegionCoverer): every
+    // cell of `max_resolution` that meets the region is in the cover or has an ancestor in it, the cells at the
+    // boundary reach somewhat beyond it. As the children of a cell stick out of it, the area of the cover cells
+    // themselves may miss a few points of the region near its boundary.
+
+    /// @brief Covers a polygon with at most `max_cells` cells between two resolutions.
+    /// @details The cells of `min_resolution` meeting the region are refined greedily: the boundary cells, which hold
+    /// the error of the cover, are replaced by their children meeting the region while the budget allows, the coarsest
+    /// first and among them those adding the fewest cells; a cell whose children are all inside the region is kept
+    /// whole. Whether a cell meets the region is decided from the cap around its center holding its descendants of
+    /// `max_resolution` (see `cell::bounds::reaches`), so a cell near the boundary may be kept without meeting it.
+    /// @param polygon The polygon, with the conventions of `polygon::span_based` for its edges.
+    /// @param min_resolution The coarsest resolution of the cells; its cells meeting the region are kept even beyond
+    /// the budget.
+    /// @param max_resolution The finest resolution of the cells.
+    /// @param max_cells The largest number of cells.
+    /// @param[out] cells The cells, sorted, replaced on success.
+    /// @return error_t::none on success, error_t::res_domain for an invalid resolution or `min_resolution` finer than
+    /// `max_resolution`, error_t::latlng_domain for a non-finite coordinate.
+    error_t to_cells(const polygon::prepared& polygon, const resolution_t min_resolution, const resolution_t max_resolution,
+                     const std::size_t max_cells, std::vector<index>& cells);
+
+    /// @brief Covers a spherical cap with at most `max_cells` cells between two resolutions.
+    /// @return error_t::none on success, error_t::res_domain for an invalid resolution or `min_resolution` finer than
+    /// `max_resolution`, error_t::latlng_domain for a non-finite center, error_t::domain for a negative or non-finite
+    /// radius.
+    error_t to_cells(const cap::item& cap, const resolution_t min_resolution, const resolution_t max_resolution,
+                     const std::size_t max_cells, std::vector<index>& cells);
+}
@@ -0,0 +1,89 @@
+/// @file geohex/directed_edge.hpp
+#pragma once
+#ifndef PCH
+    #include <kmx/geohex/index.hpp>
+    #include <span>
+#endif
+
+namespace kmx::gis::wgs84
+{
+    class coordinate;
+}
+
+namespace kmx::geohex::directed_edge
+{
+    // A directed edge is its origin cell with the mode set to `edge_unidirectional` and the direction of the
+    // destination stored in the mode dependent bits, so every conversion is a few bit operations.
+
+    /// @brief Maximum number of edges leaving a single cell.
+    constexpr std::uint8_t max_count = 6u;
+
+    /// @brief Upper bound of the edges produced by the batch `of` for a set of cells.
+    constexpr std::size_t max_size(const std::size_t cell_count) noexcept
+    {
+        return cell_count * max_count;
+    }
+
+    /// @ref isValidDirectedEdge
+    bool is_valid(const index edge) noexcept;
+
+    /// @brief Gets the direction from the origin to the destination of an edge.
+    direction_t direction(const index edge) noexcept;
+
+    /// @ref cellsToDirectedEdge
+    /// @return error_t::none on success, error_t::res_mismatch or error_t::not_neighbors for unrelated cells.
+    error_t create(const index origin, const index destination, index& out) noexcept;
+
+    /// @ref getDirectedEdgeOrigin
+    index origin(const index edge) noexcept;
+
+    /// @ref getDirectedEdgeDestination
+    error_t destination(const index edge, index& out) noexcept;
+
+    /// @ref directedEdgeToCells
+    /// @param[out] out The origin followed by the destination.
+    error_t to_cells(const index edge, std::span<index, 2u> out) noexcept;
+
+    /// @ref originToDirectedEdges
+    /// @param[out] out At least `max_count` items; resized to the 6 (hexagon) or 5 (pentagon) edges written.
+    error_t of(const index origin, std::span<index>& out) noexcept;
+
+    /// @brief Emits the edges of every cell of a set, grouped by origin in input order.
+    /// @param cells The origin cells.
+    /// @param[out] out At least `max_size(cells.size())` items; resized to the number of edges written.
+    /// @return error_t::none on success; on an invalid cell the edges written so far are kept.
+    error_t of(std::span<const index> cells, std::span<index>& out) noexcept;
+
+    /// @brief Maximum number of boundary vertices of a single edge: a Class III edge crossing an icosahedron edge gets
+    /// an additional vertex at the crossing.
+    constexpr std::uint8_t max_boundary_count = 3u;
+
+    /// @ref directedEdgeToBoundary
+    /// @param[out] out At least `max_boundary_count` items; resized to the vertices of the edge, from start to end (in radians).
+    error_t boundary(const index edge, std::span<gis::wgs84::coordinate>& out) noexcept;
+
+    /// @brief Edge boundaries in structure-of-arrays layout, one row per edge (in radians).
+    struct boundary_columns
+    {
+        std::span<double> start_latitudes;
+        std::span<double> start_longitudes;
+        std::span<double> end_latitudes;
+        std::span<double> end_longitudes;
+    };
+
+    /// @brief Calculates the start and end vertices of a set of edges.
+    /// @details Consecutive edges sharing an origin (as emitted by the batch `of`) decode the origin only once.
+    /// @param edges The directed edges.
+    /// @param[out] out Columns of at least `edges.size()` items; resized to the number of rows written.
+    /// @return error_t::none on success; on an invalid edge the rows written so far are kept.
+    error_t boundaries(std::span<const index> edges, boundary_columns& out) noexcept;
+
+    /// @ref edgeLengthRads
+    error_t length_rads(const index edge, double& out) noexcept;
+
+    /// @ref edgeLengthKm
+    error_t length_km(const index edge, double& out) noexcept;
+
+    /// @ref edgeLengthM
+    error_t length_m(const index edge, double& out) noexcept;
+}
@@ -0,0 +1,87 @@
+/// @file geohex/external.hpp
+#pragma once
+#ifndef PCH
+    #include <cstddef>
+    #include <cstdint>
+    #include <filesystem>
+    #include <kmx/geohex/index.hpp>
+    #include <memory>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::external
+{
+    // An external merge sort of (cell, payload) records, for more records than fit in memory. The records are gathered up
+    // to a memory budget, radix sorted (see `radix::sort`) and spilled as a run: a file of the records as pairs of 64
+    // bit words in host order, `{cell, payload}`, which can also be mapped or read as is. The runs are then merged by a
+    // loser tree, which finds the next record of k runs with log2(k) comparisons; above 128 runs, earlier passes merge
+    // groups of them into larger runs first. Each run is read in blocks, so the merge takes about the memory budget too.
+
+    /// @brief What a sort does with the records of equal cells.
+    enum class duplicates : std::uint8_t
+    {
+        keep,  ///< Keeps them all, in the order they were added.
+        first, ///< Keeps the first one added.
+        sum,   ///< Keeps one with the sum of their payloads.
+        min,   ///< Keeps one with the least of their payloads.
+        max,   ///< Keeps one with the greatest of their payloads.
+    };
+
+    class merger;
+
+    /// @brief Sorts records: add them all, finish, then read them back in cell order.
+    class sorter
+    {
+    public:
+        /// @brief A sorter spilling runs in a directory.
+        /// @param directory The directory of the run files, which are removed once merged or with the sorter.
+        /// @param memory_limit The memory taken by the records, in bytes, about; at least 64 KiB is taken.
+        /// @param mode What to do with the records of equal cells; they are combined in every run already.
+        sorter(std::filesystem::path directory, const std::size_t memory_limit, const duplicates mode = duplicates::keep);
+
+        sorter(const sorter&) = delete;
+        sorter& operator=(const sorter&) = delete;
+
+        ~sorter();
+
+        /// @brief Adds a record, spilling a run once the memory budget is full.
+        /// @return error_t::none on success, error_t::failed after `finish` or when a run cannot be written.
+        error_t add(const index cell, const std::uint64_t payload);
+
+        /// @brief Ends the input and prepares the merge; the records are kept in memory when they fit.
+        /// @return error_t::none on success, error_t::failed when called twice or when a run cannot be written or read.
+        error_t finish();
+
+        /// @brief Reads the next record in cell order, after `finish`.
+        /// @return False at the end, or on a read error (see `error`).
+        bool next(index& cell, std::uint64_t& payload);
+
+        /// @brief Gets the error of the merge: error_t::failed when a run could not be read.
+        error_t error() const noexcept;
+
+        /// @brief Gets the number of records added.
+        std::size_t size() const noexcept { return size_; }
+
+        /// @brief Gets the number of runs spilled, those of earlier merge passes included.
+        std::size_t run_count() const noexcept { return run_count_; }
+
+    private:
+        /// @brief Sorts the records gathered and writes them as a run.
+        error_t spill();
+
+        /// @brief Gets the path of a new run file.
+        std::filesystem::path new_run_path();
+
+        std::filesystem::path directory_;
+        std::size_t memory_limit_;
+        duplicates mode_;
+        std::vector<index> cells_;
+        std::vector<std::uint64_t> payloads_;
+        std::vector<std::filesystem::path> runs_; ///< In the order of their records.
+        std::unique_ptr<merger> merger_;
+        std::uint64_t name_;
+        std::size_t size_ {};
+        std::size_t run_count_ {};
+        bool finished_ {};
+    };
+}
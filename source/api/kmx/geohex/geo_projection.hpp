@@ -14,18 +14,36 @@ namespace kmx::geohex::projection
     /// @ref _geoToV3d (H3 C internal from algos.c)
     void to_v3d(const gis::wgs84::coordinate& geo_coord, math::vector3d& out_v3) noexcept;
 
-    /// @ref _faceIjkToXYZ (H3 C internal, related to _faceIjkToGeoEx from faceijk.c)
-    /// @brief Converts FaceIJK coordinates (cell center or vertex) to a 3D Cartesian vector.
-    error_t face_ijk_to_v3d(const icosahedron::face::ijk& fijk_coords, resolution_t res, math::vector3d& out_v3) noexcept;
+    /// @ref _geoAzDistanceRads
+    /// @brief Computes the point at a given azimuth and great circle distance (in radians) from an origin.
+    void destination(const gis::wgs84::coordinate& origin, double azimuth, double distance, gis::wgs84::coordinate& out_coord) noexcept;
 
-    /// @ref _v3dToFaceV2d
-    /// @brief Projects a 3D point on the sphere to 2D UV coordinates on a specified face's plane.
-    error_t project_v3d_to_face_uv(const math::vector3d& v3d, const icosahedron::face::id_t face_num, math::vector2d& out_uv) noexcept;
+    /// @ref _geoToHex2d
+    /// @brief Projects a coordinate on the closest icosahedron face, in the 2D Cartesian frame of its IJK grid.
+    /// @param coord The coordinate (in radians).
+    /// @param res The resolution of the grid.
+    /// @param[out] out_face The closest face.
+    /// @param[out] out_v2d The position, in cells of `res` from the face center.
+    void to_hex2d(const gis::wgs84::coordinate& coord, const resolution_t res, icosahedron::face::id_t& out_face,
+                  math::vector2d& out_v2d) noexcept;
 
-    /// @ref _hex2dToCoordIJK
-    /// @brief Converts 2D UV coordinates on a face plane (after scaling/rotation) to IJK coordinates.
-    /// @param raw_uv_on_face The UV coordinates directly from projection, before res-specific scaling/rotation.
-    /// @param res The target resolution for the IJK.
-    /// @param out_ijk Output IJK coordinates.
-    error_t convert_face_uv_to_ijk(const math::vector2d& raw_uv_on_face, const resolution_t res, coordinate::ijk& out_ijk) noexcept;
+    /// @brief Projects a coordinate on a given face, in the 2D Cartesian frame of its IJK grid.
+    /// @details The gnomonic projection extends beyond the face edges, so the polygons crossing a face are drawn in
+    /// its grid; it is only defined within 90 degrees of the face center.
+    /// @param coord The coordinate (in radians).
+    /// @param face The face.
+    /// @param res The resolution of the grid.
+    /// @param[out] out_v2d The position, in cells of `res` from the face center.
+    void to_hex2d(const gis::wgs84::coordinate& coord, const icosahedron::face::id_t face, const resolution_t res,
+                  math::vector2d& out_v2d) noexcept;
+
+    /// @ref _hex2dToGeo
+    /// @brief Projects a 2D Cartesian position of the IJK grid of a face back to the sphere.
+    /// @param v2d The position, in cells of `res` from the face center.
+    /// @param face The face.
+    /// @param res The Class II resolution of the grid, up to 16 (see `icosahedron::face::class_2_resolution`).
+    /// @param substrate True for a position of the aperture 3 substrate grid used by cell vertices.
+    /// @param[out] out_coord The coordinate (in radians).
+    void from_hex2d(const math::vector2d& v2d, const icosahedron::face::id_t face, const std::uint8_t res, const bool substrate,
+                    gis::wgs84::coordinate& out_coord) noexcept;
 }
@@ -0,0 +1,87 @@
+/// @file geohex/geocoder.hpp
+#pragma once
+#ifndef PCH
+    #include <cstddef>
+    #include <cstdint>
+    #include <kmx/geohex/index.hpp>
+    #include <kmx/geohex/polygon/batch.hpp>
+    #include <kmx/geohex/polygon/prepared.hpp>
+    #include <kmx/gis/wgs84/coordinate.hpp>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::geocoder
+{
+    /// @brief Finds the polygon of a layer (such as admin regions or zones) holding a point.
+    /// @details Each polygon is covered with cells of mixed resolutions: a cell whose descendants at the resolution of
+    /// the store all lie inside the polygon maps to it directly, the cells of that resolution along its boundary keep
+    /// it as a candidate, checked against the polygon. The cells of all the polygons make one sorted map, so a query is
+    /// a `from_wgs` at the resolution of the store, then a binary search per stored resolution up the parents of the
+    /// cell; only points near a boundary need a point-in-polygon test.
+    class store
+    {
+    public:
+        /// @brief The number of a polygon in the layer it was built from.
+        using id_t = std::uint32_t;
+
+        /// @brief The id found for a point outside every polygon.
+        static constexpr id_t none = ~id_t {};
+
+        /// @brief An empty store, to build or load later.
+        store() = default;
+
+        /// @brief Builds the store of a layer of polygons, replacing its content.
+        /// @details The polygons are covered in parallel for large layers. Where polygons overlap, a point gets one
+        /// of those holding it.
+        /// @param polygons The polygons, with the conventions of `polygon::span_based`; they are copied.
+        /// @param resolution The finest resolution of the cells: a finer one means fewer point-in-polygon tests but
+        /// more cells.
+        /// @return error_t::none on success, error_t::res_domain for an invalid resolution, error_t::domain for offsets
+        /// that are not increasing or do not cover the coordinates and rings, or too many polygons,
+        /// error_t::latlng_domain for a non-finite coordinate.
+        error_t build(const polygon::batch::polygons& polygons, const resolution_t resolution);
+
+        /// @brief Finds the polygon holding a point.
+        /// @param coord The point, in radians.
+        /// @return The id of the polygon, or `none` for a point outside every polygon or not finite.
+        id_t find(const gis::wgs84::coordinate& coord) const noexcept;
+
+        /// @brief Gets the finest resolution of the cells.
+        resolution_t resolution() const noexcept { return resolution_; }
+
+        /// @brief Gets the number of polygons.
+        std::size_t polygon_count() const noexcept { return polygons_.size(); }
+
+        /// @brief Gets the number of cells in the map.
+        std::size_t cell_count() const noexcept { return cells_.size(); }
+
+        /// @brief Appends the store to a buffer, in the byte order of the host.
+        void save(std::vector<std::byte>& data) const;
+
+        /// @brief Loads a store saved by `save`, replacing the content of this one; only the polygons are prepared
+        /// again, their cells are read as they are.
+        /// @param[in,out] data The saved store, advanced past it on success.
+        /// @return error_t::none on success, error_t::domain for data that is not a saved store, truncated or saved in
+        /// another byte order.
+        error_t load(std::span<const std::byte>& data);
+
+    private:
+        /// @brief Prepares the polygons for the point-in-polygon tests and notes the resolutions of the cells.
+        /// @return error_t::none on success, error_t::latlng_domain for a non-finite coordinate.
+        error_t prepare();
+
+        resolution_t resolution_ {};
+        std::vector<gis::wgs84::coordinate> coordinates_;
+        std::vector<std::size_t> ring_offsets_;
+        std::vector<std::size_t> polygon_offsets_;
+        std::vector<polygon::prepared> polygons_;
+
+        // the map: the sorted cells, the first entry of each cell then the entry count, and the entries, a polygon id
+        // whose top bit tells it is a candidate to check
+        std::vector<index> cells_;
+        std::vector<std::size_t> offsets_;
+        std::vector<id_t> entries_;
+        std::uint16_t resolutions_ {}; ///< A bit per resolution with cells.
+    };
+}
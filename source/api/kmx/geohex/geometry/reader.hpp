@@ -0,0 +1,78 @@
+/// @file geohex/geometry/reader.hpp
+#pragma once
+#ifndef PCH
+    #include <cstddef>
+    #include <kmx/geohex/base.hpp>
+    #include <kmx/geohex/polygon/batch.hpp>
+    #include <kmx/geohex/polygon/span_based.hpp>
+    #include <kmx/gis/wgs84/coordinate.hpp>
+    #include <span>
+    #include <string_view>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::geometry
+{
+    /// @brief The geometry types read, with their WKB codes.
+    enum class type_t : std::uint8_t
+    {
+        point = 1u,
+        line_string,
+        polygon,
+        multi_point,
+        multi_line_string,
+        multi_polygon,
+    };
+
+    /// @brief The unit of the coordinates read.
+    enum class unit_t : std::uint8_t
+    {
+        degrees,
+        radians,
+    };
+
+    /// @brief A geometry read into flat arrays, laid out as the polygons of `polygon::batch`.
+    /// @details A geometry is made of parts (points, line strings or polygons), each of rings of coordinates: a point
+    /// is a part with a ring of one coordinate, a line string a part with one ring, a polygon a part with its outer ring
+    /// then its holes. The rings of polygons drop the closing vertex of WKB and WKT, as rings are closed implicitly.
+    /// The arrays keep their capacity from one read to the next, so reading many geometries into the same item only
+    /// allocates until they have grown.
+    struct item
+    {
+        type_t type {type_t::point};
+        gis::wgs84::coordinate::vector coordinates; ///< In radians.
+        std::vector<std::size_t> ring_offsets;      ///< The first coordinate of each ring, then the coordinate count.
+        std::vector<std::size_t> part_offsets;      ///< The first ring of each part, then the ring count.
+
+        /// @brief Gets the number of parts; an empty geometry has none.
+        std::size_t size() const noexcept { return part_offsets.empty() ? 0u : part_offsets.size() - 1u; }
+
+        /// @brief Gets the coordinates of a ring, for `polygon::span_based` or `from_wgs`.
+        polygon::span_based::item ring(const std::size_t ring) const noexcept
+        {
+            return std::span {coordinates}.subspan(ring_offsets[ring], ring_offsets[ring + 1u] - ring_offsets[ring]);
+        }
+
+        /// @brief Gets the parts as polygons, for `polygon::batch::to_cells`.
+        polygon::batch::polygons polygons() const noexcept { return {coordinates, ring_offsets, part_offsets}; }
+    };
+
+    /// @brief Reads a geometry in WKB (OGC well-known binary), either byte order.
+    /// @details ISO and extended (PostGIS) WKB are read, with their Z and M values skipped and their SRID ignored. An
+    /// empty point (NaN coordinates) reads as an empty geometry.
+    /// @param[in,out] data The bytes, advanced past the geometry read, so a stream of geometries reads one by one.
+    /// @param unit The unit of the coordinates in the data, whose X is the longitude and Y the latitude.
+    /// @param[out] out The geometry, replaced.
+    /// @return error_t::none on success, error_t::domain for malformed or truncated data or an unsupported type (then
+    /// `data` is left as is).
+    error_t read_wkb(std::span<const std::byte>& data, const unit_t unit, item& out);
+
+    /// @brief Reads a geometry in WKT (OGC well-known text).
+    /// @details The keywords are case insensitive; Z, M and ZM geometries have their extra values skipped.
+    /// @param[in,out] text The text, advanced past the geometry read.
+    /// @param unit The unit of the coordinates in the text, whose X is the longitude and Y the latitude.
+    /// @param[out] out The geometry, replaced.
+    /// @return error_t::none on success, error_t::domain for malformed text or an unsupported type (then `text` is left
+    /// as is).
+    error_t read_wkt(std::string_view& text, const unit_t unit, item& out);
+}
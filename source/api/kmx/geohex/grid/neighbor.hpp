@@ -0,0 +1,28 @@
+/// @file geohex/grid/neighbor.hpp
+#pragma once
+#ifndef PCH
+    #include <kmx/geohex/index.hpp>
+#endif
+
+namespace kmx::geohex::grid::neighbor
+{
+    /// @brief Finds the neighbor of a cell in a given direction using only the index digits.
+    /// @details Walks the digits from the finest resolution towards the base cell, replacing each digit and
+    ///          carrying the remaining move to the parent level, so no FaceIJK decoding is involved.
+    /// @ref h3NeighborRotations
+    /// @param origin The origin cell.
+    /// @param direction The direction to move, in the origin's frame.
+    /// @param[in,out] rotations The number of 60 degree ccw rotations applied to `direction` on input;
+    ///                          on output the rotations to apply to directions in the neighbor's frame.
+    /// @param[out] out The neighbor cell.
+    /// @return error_t::none on success, error_t::pentagon when moving into a deleted pentagon subsequence.
+    error_t get(const index origin, direction_t direction, int& rotations, index& out) noexcept;
+
+    /// @brief Finds the direction from an origin cell to one of its neighbors.
+    /// @ref directionForNeighbor
+    /// @return The direction, or direction_t::invalid when the cells are not neighbors.
+    direction_t direction_to(const index origin, const index destination) noexcept;
+
+    /// @ref areNeighborCells
+    bool check(const index origin, const index destination) noexcept;
+}
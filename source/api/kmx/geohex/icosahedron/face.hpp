@@ -72,6 +72,10 @@ namespace kmx::geohex::icosahedron::face
 
     gis::wgs84::coordinate center_wgs(const id_t face) noexcept;
 
+    /// @brief Gets the azimuth in radians from the face center to vertex 0, the direction of the Class II i-axis.
+    /// @ref faceAxesAzRadsCII
+    double axis_azimuth(const id_t face) noexcept;
+
     /// @brief Represents a coordinate on a specific icosahedron face.
     /// @ref FaceIJK
     /// @note This is analogous to H3 C's internal `FaceIJK` struct.
@@ -96,8 +100,78 @@ namespace kmx::geohex::icosahedron::face
         constexpr bool operator!=(const oriented_ijk&) const noexcept = default;
     };
 
+    /// @brief Quadrants of a face, each shared with one neighboring face.
+    enum class quadrant_t : std::uint8_t
+    {
+        center, ///< the face itself
+        ij,     ///< across the edge opposite to the k-axis
+        ki,     ///< across the edge opposite to the j-axis
+        jk,     ///< across the edge opposite to the i-axis
+    };
+
+    constexpr std::uint8_t quadrant_count = +quadrant_t::jk + 1u;
+
+    /// @brief Gets the neighboring face in a quadrant, with the rotation and translation (in Class II resolution 0
+    /// cells) from this face frame to the neighbor frame.
+    /// @ref faceNeighbors
+    const oriented_ijk& neighbor(const id_t face, const quadrant_t quadrant) noexcept;
+
+    /// @brief Gets the quadrant of a face shared with another face.
+    /// @ref adjacentFaceDir
+    /// @return The quadrant, or std::nullopt when the faces are not adjacent.
+    std::optional<quadrant_t> adjacent_quadrant(const id_t face, const id_t other) noexcept;
+
+    /// @brief Class II resolutions address the Class II grids up to the one holding the vertices of resolution 15 cells.
+    constexpr std::uint8_t class_2_resolution_count = resolution_count + 1u;
+
+    /// @brief Gets the Class II resolution of the grid used for the geometry of the cells of a resolution.
+    constexpr std::uint8_t class_2_resolution(const resolution_t res) noexcept
+    {
+        return +res + (is_class_3(res) ? 1u : 0u);
+    }
+
+    /// @brief Gets the sum of the IJK components of the vertices of a face, in cells of a Class II resolution.
+    /// @ref maxDimByCIIres
+    std::int32_t max_dimension(const std::uint8_t class_2_res) noexcept;
+
+    /// @brief Gets the length of a Class II resolution 0 unit vector, in cells of a Class II resolution.
+    /// @ref unitScaleByCIIres
+    std::int32_t unit_scale(const std::uint8_t class_2_res) noexcept;
+
+    /// @ref Overage
+    enum class overage_t : std::uint8_t
+    {
+        none,      ///< on the original face
+        face_edge, ///< on a face edge (substrate grids only)
+        new_face,  ///< moved to an adjacent face
+    };
+
+    /// @brief Moves a Class II coordinate which lies beyond the edge of its face to the frame of the adjacent face.
+    /// @ref _adjustOverageClassII
+    /// @param[in,out] fijk The coordinate.
+    /// @param class_2_res The Class II resolution of the grid.
+    /// @param pentagon_leading_4 True for a cell of a pentagon base cell with a leading i-axis digit, whose
+    /// coordinate is rotated out of the deleted subsequence when it crosses the ki edge.
+    /// @param substrate True for a coordinate of the aperture 3 substrate grid of `class_2_res`.
+    /// @return The overage found.
+    overage_t adjust_overage(ijk& fijk, const std::uint8_t class_2_res, const bool pentagon_leading_4, const bool substrate) noexcept;
+
+    /// @brief Moves a pentagon vertex of the substrate grid to the face it lies on, over as many faces as needed.
+    /// @ref _adjustPentVertOverage
+    overage_t adjust_pentagon_vertex_overage(ijk& fijk, const std::uint8_t class_2_res) noexcept;
+
+    /// @brief Gets the vertices of a cell in the aperture 3 substrate grid of its Class II resolution.
+    /// @ref _faceIjkToVerts and _faceIjkPentToVerts
+    /// @param fijk The cell center, on the face of the cell frame.
+    /// @param res The resolution of the cell.
+    /// @param[out] out The vertices counter-clockwise from the i-axis; a pentagon fills the first 5.
+    /// @return The Class II resolution of the substrate grid.
+    std::uint8_t to_vertices(const ijk& fijk, const resolution_t res, std::span<ijk, 6u> out) noexcept;
+
     /// @ref _h3ToFaceIjk (H3 C internal)
     /// @brief Converts an H3 cell index to its corresponding FaceIJK representation.
+    /// @details The coordinate is expressed on the face holding the cell center, which is not the home face of the
+    /// base cell when the cell lies beyond the home face edge (an overage).
     /// @param index The H3 cell index.
     /// @param out Output: The FaceIJK representation.
     /// @return error_t::none on success, or an error code.
@@ -106,8 +180,10 @@ namespace kmx::geohex::icosahedron::face
     /// @brief Converts a FaceIJK representation back into a canonical H3 index.
     /// @details This is the logical inverse of `from_index`.
     /// @ref _faceIjkToH3
+    /// @return error_t::none on success, error_t::failed when the coordinate is too far from the face to address a cell.
     error_t to_index(const ijk& fijk, resolution_t res, index& out_index) noexcept;
 
+    /// @ref _geoToClosestFace
     id_t from_wgs(const gis::wgs84::coordinate& coord) noexcept;
 
     /// @brief Converts FaceIJK coordinates to a geographic WGS84 coordinate.
@@ -118,74 +194,17 @@ namespace kmx::geohex::icosahedron::face
     /// @brief Converts geographic WGS84 coordinates (radians) to FaceIJK representation.
     error_t from_wgs(const gis::wgs84::coordinate& coord, const resolution_t res, ijk& out_fijk) noexcept;
 
-    std::optional<ijk> get(const std::uint8_t pentagon_no, const direction_t direction) noexcept;
-
-    /// @brief Adjusts FaceIJK coordinates for pentagon distortion when crossing icosahedron face boundaries.
-    /// @details This is the core "worker" function that contains the complex logic for handling the
-    ///          coordinate system transformations that occur when moving from a pentagonal base cell
-    ///          onto an adjacent icosahedron face. It is the C++ equivalent of H3's internal
-    ///          `_adjustOverageClassII` and `_adjustOverageClassIII` functions.
-    /// @note    This function does not *detect* overage; it performs the *correction* after a
-    ///          higher-level algorithm has already determined that a traversal has crossed a face
-    ///          boundary from a pentagon.
-    /// @param[in,out] current_face The current icosahedron face. On success, this is updated to the new face ID.
-    /// @param[in,out] current_ccw_rotations_60 The current system's counter-clockwise 60-degree rotations.
-    ///                                         This is updated if the new face has a different orientation.
-    /// @param[in,out] ijk_coords_to_adjust The IJK coordinates to adjust. On success, these are replaced
-    ///                                     with the corresponding coordinates on the new face's system.
-
-    /// @param[in] base_cell_id The ID of the pentagonal base cell from which the move originated.
-    /// @param[in] digit_moved The direction of movement that caused the overage and triggered this adjustment.
-    /// @return error_t::none on success, or an error code if adjustment fails (e.g., invalid input).
-    error_t adjust_overage(id_t& current_face, std::int8_t& current_ccw_rotations_60, coordinate::ijk& ijk_coords_to_adjust,
-                           const cell::base::id_t base_cell_id, const direction_t digit_moved) noexcept;
-
-    /// @brief Convenience wrapper to adjust for pentagon overage using a bundled `oriented_ijk` struct.
-    /// @details This function provides a simpler public-facing API for the most common use case.
-    ///          It determines the base cell from the provided `fijk` and then delegates the
-    ///          complex adjustment logic to the more detailed `adjust_overage` worker function.
-    /// @param[in,out] fijk The FaceIJK with orientation to adjust. Its members (face, rotation, coordinates)
-    ///                     will be modified in-place upon a successful adjustment.
-    /// @param[in] res The resolution of the grid system.
-    /// @param[in] digit The direction of movement that may have caused an overage.
-    /// @return error_t::none on success, or an error propagated from the core adjustment logic.
-    error_t adjust_overage(oriented_ijk& fijk, const resolution_t res, const direction_t digit) noexcept;
-
-    /// @brief Determines the H3 base cell and resolution 0 orientation for a given FaceIJK.
-    /// @details This is a key part of the reverse mapping from coordinates to an H3 index,
-    /// corresponding to the core logic of `_faceIjkToH3` in the H3 C library.
-    /// @param fijk The FaceIJK coordinates to find the base cell for.
-    /// @param res The resolution of the provided `fijk`.
-    /// @param[out] out_base_cell The determined base cell ID (0-121).
-    /// @param[out] out_orientation The canonical orientation of the base cell at resolution 0.
-    /// @return error_t::none on success, or an error code if no base cell could be found.
-    error_t to_base_cell_and_orientation(const ijk& fijk, const resolution_t res, cell::base::id_t& out_base_cell,
-                                         int& out_orientation) noexcept;
-
-    /// @brief Simplified helper to determine the H3 base cell for a given FaceIJK.
-    /// @param fijk The FaceIJK coordinates.
-    /// @param res The resolution of the provided `fijk`.
-    /// @return The base cell ID (0-121), or `base::invalid_index` on failure.
-    cell::base::id_t to_base_cell(const ijk& fijk, const resolution_t res) noexcept;
-
-    /// @brief Converts a FaceIJK representation at one resolution to its IJK coordinates at another.
-    error_t to_ijk_at_resolution(const ijk& fijk_higher_res, const resolution_t res_higher, const resolution_t res_lower,
-                                 coordinate::ijk& out_ijk_lower_res) noexcept;
-
-    /// @brief Finds the FaceIJK of a neighboring cell, handling icosahedron face-crossing ("overage").
-    /// @details This is a core internal function that orchestrates grid traversal. It corresponds to the
-    ///          logic in H3's `_h3Neighbor` function. It first performs a simple IJK translation and
-    ///          then checks if the new coordinates have exceeded the bounds of the current face's
-    ///          coordinate system. If they have, it acts as a "traffic cop", calling the appropriate
-    ///          low-level adjustment function (`adjust_hexagon_overage` or `adjust_overage`) based
-    ///          on whether the origin cell was a hexagon or a pentagon.
-    /// @param[in] start_fijk The FaceIJK of the starting cell.
-    /// @param[in] res The H3 resolution of the grid.
-    /// @param[in] dir The direction to move to find the neighbor.
-    /// @param[out] out_neighbor_fijk The resulting FaceIJK of the neighbor cell.
-    /// @return error_t::none on success, or an error code on failure.
-    error_t find_neighbor_face_ijk(const oriented_ijk& start_fijk, const resolution_t res, const direction_t dir,
-                                   oriented_ijk& out_neighbor_fijk) noexcept;
-
-    std::int8_t find_vertex_on_face(const id_t face, const std::int8_t vertex_to_find) noexcept;
+    /// @brief Gets the base cell at a resolution 0 coordinate, which may lie on a neighboring face.
+    /// @ref _faceIjkToBaseCell
+    /// @return The base cell, or `cell::base::invalid_index` when a component exceeds 2.
+    cell::base::id_t to_base_cell(const ijk& fijk) noexcept;
+
+    /// @brief Gets the rotations from the frame of a face to the frame of the base cell at a resolution 0 coordinate.
+    /// @ref _faceIjkToBaseCellCCWrot60
+    int to_base_cell_rotations(const ijk& fijk) noexcept;
+
+    /// @brief Gets the rotations from the frame of a face to the frame of a base cell it holds.
+    /// @ref _baseCellToCCWrot60
+    /// @return The counter-clockwise 60 degree rotations, or -1 when the base cell is not on the face.
+    int base_cell_rotations(const cell::base::id_t base_cell, const id_t face) noexcept;
 }
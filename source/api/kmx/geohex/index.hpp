@@ -2,14 +2,10 @@
 #pragma once
 #ifndef PCH
     #include <kmx/geohex/base.hpp>
+    #include <kmx/gis/wgs84/view.hpp>
     #include <span>
 #endif
 
-namespace kmx::gis::wgs84
-{
-    class coordinate;
-}
-
 namespace kmx::geohex
 {
     class index
@@ -33,6 +29,11 @@ namespace kmx::geohex
         index_mode_t mode() const noexcept;
         void set_mode(const index_mode_t item) noexcept;
 
+        /// @ref H3_GET_RESERVED_BITS
+        /// @brief Mode dependent bits: the edge direction or the vertex number, zero for cells.
+        std::uint8_t mode_dependent() const noexcept;
+        void set_mode_dependent(const std::uint8_t item) noexcept;
+
         resolution_t resolution() const noexcept;
         void set_resolution(const resolution_t item) noexcept;
 
@@ -67,6 +68,16 @@ namespace kmx::geohex
         /// @ref _h3LeadingNonZeroDigit
         direction_t leading_non_zero_digit() const noexcept;
 
+        /// @ref _h3Rotate60ccw
+        void rotate_60ccw() noexcept;
+
+        /// @ref _h3Rotate60cw
+        void rotate_60cw() noexcept;
+
+        /// @ref _h3RotatePent60ccw
+        /// @brief Rotates a pentagon index, skipping over the deleted k-axes subsequence.
+        void rotate_pentagon_60ccw() noexcept;
+
         using number_span = std::span<char, 16u>;
 
         void get_number(number_span& span) const noexcept;
@@ -109,4 +120,44 @@ namespace kmx::geohex
     /// @param[out] coord The output WGS84 coordinate (in radians).
     /// @return error_t::none on success.
     error_t to_wgs(const index index, gis::wgs84::coordinate& coord) noexcept;
+
+    /// @brief Gets the cell containing a geographic coordinate.
+    /// @ref latLngToCell
+    /// @param coord The WGS84 coordinate (in radians).
+    /// @param res The resolution of the cell.
+    /// @param[out] out The cell.
+    /// @return error_t::none on success, error_t::latlng_domain for a non-finite coordinate.
+    error_t from_wgs(const gis::wgs84::coordinate& coord, const resolution_t res, index& out) noexcept;
+
+    /// @brief Gets the cells containing coordinates read in place through an accessor, such as a
+    /// `gis::wgs84::strided_view` over a buffer of degrees.
+    /// @ref latLngToCell
+    /// @param points The coordinates.
+    /// @param res The resolution of the cells.
+    /// @param[out] out At least `points.size()` items; resized to the number of cells written, one per point.
+    /// @return error_t::none on success, error_t::memory_bounds when `out` is too small, or else the first error of a
+    /// point (the cells before it are written).
+    template <gis::wgs84::coordinate_accessor Points>
+    error_t from_wgs(const Points& points, const resolution_t res, std::span<index>& out) noexcept
+    {
+        const std::size_t count = points.size();
+        if (out.size() < count)
+        {
+            out = out.first(0u);
+            return error_t::memory_bounds;
+        }
+
+        for (std::size_t i {}; i != count; ++i)
+        {
+            const auto err = from_wgs(points[i], res, out[i]);
+            if (err != error_t::none)
+            {
+                out = out.first(i);
+                return err;
+            }
+        }
+
+        out = out.first(count);
+        return error_t::none;
+    }
 }
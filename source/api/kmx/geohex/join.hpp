@@ -0,0 +1,47 @@
+/// @file geohex/join.hpp
+#pragma once
+#ifndef PCH
+    #include <cstdint>
+    #include <kmx/geohex/index.hpp>
+    #include <kmx/gis/wgs84/coordinate.hpp>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::join
+{
+    // A sort-merge join of points against a layer of cells of mixed resolutions, each with the id of its polygon. Each
+    // layer cell stands for the range of numbers (see `cell::to_number`) of its descendants at resolution 15, as in
+    // `compact`: the ranges are nested or apart, and a point lies in a cell when the number of its cell falls in the
+    // range. The points, sorted by cell, meet the layer cells sorted by range in one pass, which keeps the ranges
+    // around the current point on a stack, the coarsest at the bottom: no point looks its parents up.
+    //
+    // Nothing crosses a base cell, so the join runs on a pool of threads taking a base cell each.
+
+    /// @brief The number of a polygon of a layer.
+    using id_t = std::uint32_t;
+
+    /// @brief A point in a cell of the layer.
+    struct match
+    {
+        std::uint64_t point; ///< The position of the point in the input.
+        id_t id;             ///< The id of the layer cell.
+    };
+
+    /// @brief Joins points given by their cells against a layer.
+    /// @param points The cells of the points, of one resolution, in any order; layer cells finer than them match none.
+    /// @param layer The layer cells, in any order; they may overlap, as cells of overlapping polygons do.
+    /// @param ids The id of each layer cell.
+    /// @param[out] result The matches, replaced on success: in the order of the point cells, then coarsest layer cell
+    /// first.
+    /// @return error_t::none on success, error_t::domain for a layer and ids of different sizes, error_t::cell_invalid
+    /// for a cell that is not valid, error_t::res_mismatch for points of different resolutions.
+    error_t cells(const std::span<const index> points, const std::span<const index> layer, const std::span<const id_t> ids,
+                  std::vector<match>& result);
+
+    /// @brief Joins points against a layer, indexing them at the finest resolution of the layer first, in parallel.
+    /// @param points The WGS84 coordinates of the points (in radians).
+    /// @return As `cells`, or error_t::latlng_domain for a coordinate that is not finite.
+    error_t points(const std::span<const gis::wgs84::coordinate> points, const std::span<const index> layer,
+                   const std::span<const id_t> ids, std::vector<match>& result);
+}
@@ -0,0 +1,35 @@
+/// @file geohex/mesh.hpp
+#pragma once
+#ifndef PCH
+    #include <kmx/geohex/index.hpp>
+    #include <kmx/geohex/vertex.hpp>
+    #include <kmx/math/vector.hpp>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::mesh
+{
+    /// @brief Indexed triangle mesh of a set of cells, storing every vertex shared by several cells once.
+    struct indexed
+    {
+        std::vector<index> vertices;           ///< Canonical vertex indexes (see `vertex::of`), sorted.
+        std::vector<math::vector3f> positions; ///< Unit vectors on the sphere, parallel to `vertices`.
+        std::vector<std::uint32_t> triangles;  ///< Three items of `positions` per triangle, in cell boundary order.
+    };
+
+    /// @brief Upper bound of the triangles produced for a number of cells (a hexagon is fanned into 4 triangles).
+    constexpr std::size_t max_triangle_count(const std::size_t cell_count) noexcept
+    {
+        return cell_count * (vertex::max_count - 2u);
+    }
+
+    /// @brief Builds the indexed triangle mesh of a set of cells.
+    /// @details Each vertex position is computed once, from the owner of its canonical index, instead of once per cell
+    /// sharing it. The buffers of `out` are reused across calls.
+    /// @param cells Valid cells of one resolution, without duplicates.
+    /// @param[out] out The mesh, replaced on success.
+    /// @return error_t::none on success, error_t::cell_invalid for an invalid cell, error_t::memory_bounds when the
+    /// vertices do not fit 32-bit triangle indexes.
+    error_t build(std::span<const index> cells, indexed& out);
+}
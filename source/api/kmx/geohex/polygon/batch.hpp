@@ -0,0 +1,52 @@
+/// @file geohex/polygon/batch.hpp
+#pragma once
+#ifndef PCH
+    #include <kmx/geohex/index.hpp>
+    #include <kmx/gis/wgs84/coordinate.hpp>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::polygon::batch
+{
+    // Many polygons in flat arrays, with the polygon conventions of `span_based`: the coordinates of all the rings one
+    // after another, the rings of all the polygons one after another (the outer ring first, then the holes).
+
+    /// @brief A batch of polygons.
+    struct polygons
+    {
+        std::span<const gis::wgs84::coordinate> coordinates; ///< The vertices of every ring, in radians.
+        std::span<const std::size_t> ring_offsets;           ///< The first vertex of each ring, then the vertex count.
+        std::span<const std::size_t> polygon_offsets;        ///< The first ring of each polygon, then the ring count.
+
+        /// @brief Gets the number of polygons.
+        std::size_t size() const noexcept { return polygon_offsets.empty() ? 0u : polygon_offsets.size() - 1u; }
+    };
+
+    /// @brief The cells of a batch of polygons.
+    struct cells
+    {
+        std::vector<index> items;          ///< The cells of every polygon, one polygon after another.
+        std::vector<std::size_t> offsets;  ///< The first cell of each polygon, then the cell count.
+
+        /// @brief Gets the cells of a polygon.
+        std::span<const index> of(const std::size_t polygon) const noexcept
+        {
+            return std::span<const index> {items}.subspan(offsets[polygon], offsets[polygon + 1u] - offsets[polygon]);
+        }
+    };
+
+    /// @ref polygonToCells
+    /// @brief Fills every polygon of a batch with the cells of a resolution.
+    /// @details Meant for many small polygons: the polygons are split in chunks taken in turn by a pool of threads,
+    /// each preparing its polygons in the same `prepared` and filling them in the same buffer, so a polygon costs no
+    /// allocation once the buffers have grown. The cells of each polygon are those of `span_based::to_cells`, in the
+    /// same order.
+    /// @param polygons The polygons.
+    /// @param resolution The resolution of the cells.
+    /// @param[out] cells The cells, replaced on success.
+    /// @return error_t::none on success, error_t::res_domain for an invalid resolution, error_t::domain for offsets
+    /// that are not increasing or do not cover the coordinates and rings, or else the first error of a polygon, in
+    /// polygon order.
+    error_t to_cells(const polygons& polygons, const resolution_t resolution, cells& cells);
+}
@@ -0,0 +1,258 @@
+/// @file geohex/polygon/prepared.hpp
+#pragma once
+#ifndef PCH
+    #include <algorithm>
+    #include <array>
+    #include <cfloat>
+    #include <cmath>
+    #include <kmx/geohex/icosahedron/face.hpp>
+    #include <kmx/geohex/polygon/span_based.hpp>
+    #include <kmx/gis/wgs84/view.hpp>
+    #include <numbers>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::polygon
+{
+    /// @brief A polygon prepared once for many fills and point in polygon tests.
+    /// @details Keeps a copy of the edges with two indexes built at construction: the edges of each ring bucketed by
+    /// latitude band and longitude, so the point in polygon test of H3 only visits the edges near the point, and the
+    /// edges bucketed by icosahedron face, so a fill only projects the edges near each face. Queries do not modify it
+    /// and may run concurrently.
+    class prepared
+    {
+    public:
+        /// @brief An edge of a ring, south to north, with the longitudes of a transmeridian ring made continuous.
+        struct edge
+        {
+            double south_latitude;
+            double south_longitude;
+            double north_latitude;
+            double north_longitude;
+
+            /// @brief Checks whether the edge crosses a latitude/longitude box, by clipping it (Liang-Barsky).
+            bool crosses(const double south, const double north, const double west, const double east) const noexcept;
+        };
+
+        /// @ref BBox
+        struct bounding_box
+        {
+            double north {-DBL_MAX};
+            double south {DBL_MAX};
+            double east {-DBL_MAX};
+            double west {DBL_MAX};
+
+            /// @ref bboxFromGeoLoop
+            template <gis::wgs84::coordinate_accessor Ring>
+            static bounding_box of(const Ring& ring) noexcept
+            {
+                bounding_box result;
+                if (ring.size() == 0u)
+                    return {0.0, 0.0, 0.0, 0.0};
+
+                double min_positive_longitude = DBL_MAX;
+                double max_negative_longitude = -DBL_MAX;
+                bool transmeridian = false;
+                gis::wgs84::coordinate coord = ring[0u];
+                for (std::size_t i {}; i != ring.size(); ++i)
+                {
+                    const gis::wgs84::coordinate next = ring[(i + 1u) % ring.size()];
+                    result.south = std::min(result.south, coord.latitude);
+                    result.west = std::min(result.west, coord.longitude);
+                    result.north = std::max(result.north, coord.latitude);
+                    result.east = std::max(result.east, coord.longitude);
+
+                    // the longitudes closest to the antimeridian bound a transmeridian ring
+                    if ((coord.longitude > 0.0) && (coord.longitude < min_positive_longitude))
+                        min_positive_longitude = coord.longitude;
+                    if ((coord.longitude < 0.0) && (coord.longitude > max_negative_longitude))
+                        max_negative_longitude = coord.longitude;
+
+                    // an edge spanning more than 180 degrees of longitude crosses the antimeridian
+                    if (std::abs(coord.longitude - next.longitude) > std::numbers::pi_v<double>)
+                        transmeridian = true;
+
+                    coord = next;
+                }
+
+                if (transmeridian)
+                {
+                    result.east = max_negative_longitude;
+                    result.west = min_positive_longitude;
+                }
+
+                return result;
+            }
+
+            /// @ref bboxIsTransmeridian
+            bool is_transmeridian() const noexcept { return east < west; }
+
+            /// @ref bboxContains
+            bool contains(const gis::wgs84::coordinate& coord) const noexcept;
+
+            /// @ref NORMALIZE_LNG
+            double normalize(const double longitude) const noexcept
+            {
+                return is_transmeridian() && (longitude < 0.0) ? longitude + 2.0 * std::numbers::pi_v<double> : longitude;
+            }
+        };
+
+        /// @brief Longest piece (in radians of latitude or longitude) an edge is cut into to follow its projection on a
+        /// face.
+        static constexpr double max_piece_length = std::numbers::pi_v<double> / 180.0;
+
+        /// @brief Edge pieces with both ends farther than this from a face center (in radians) cannot reach the cells of
+        /// the face: its vertices are 37.4 degrees away, the cells scanned beyond its edges and a piece add a few more.
+        static constexpr double max_face_distance = std::numbers::pi_v<double> / 4.0;
+
+        /// @param polygon The outer ring.
+        /// @param holes The holes of the polygon.
+        explicit prepared(const span_based::item& polygon, const span_based::span& holes = {}) { assign(polygon, holes); }
+
+        /// @brief Prepares a polygon read in place through an accessor, such as a `gis::wgs84::strided_view` over a
+        /// buffer of degrees.
+        /// @param polygon The outer ring.
+        /// @param holes The holes of the polygon.
+        template <gis::wgs84::coordinate_accessor Ring>
+        explicit prepared(const Ring& polygon, const std::span<const Ring> holes = {})
+        {
+            assign(polygon, holes);
+        }
+
+        /// @brief An empty polygon, to assign later.
+        prepared() = default;
+
+        /// @brief Prepares another polygon in place, reusing the storage of the previous one.
+        /// @param polygon The outer ring.
+        /// @param holes The holes of the polygon.
+        void assign(const span_based::item& polygon, const span_based::span& holes = {}) { assign<span_based::item>(polygon, holes); }
+
+        /// @brief Prepares another polygon read in place through an accessor, reusing the storage of the previous one.
+        template <gis::wgs84::coordinate_accessor Ring>
+        void assign(const Ring& polygon, const std::span<const Ring> holes = {})
+        {
+            const auto ring_is_finite = [](const Ring& ring)
+            {
+                for (std::size_t i {}; i != ring.size(); ++i)
+                {
+                    const gis::wgs84::coordinate coord = ring[i];
+                    if (!std::isfinite(coord.latitude) || !std::isfinite(coord.longitude))
+                        return false;
+                }
+                return true;
+            };
+
+            // the rings already there keep their storage; those of a polygon that is not finite are left empty
+            finite_ = ring_is_finite(polygon) && std::all_of(holes.begin(), holes.end(), ring_is_finite);
+            rings_.resize(finite_ ? holes.size() + 1u : 0u);
+            if (finite_)
+            {
+                rings_.front().assign(polygon);
+                for (std::size_t i {}; i != holes.size(); ++i)
+                    rings_[i + 1u].assign(holes[i]);
+            }
+
+            index_faces();
+        }
+
+        /// @brief Checks whether every coordinate is finite; the indexes of a polygon that is not are left empty.
+        bool is_finite() const noexcept { return finite_; }
+
+        /// @brief Gets the number of rings, the outer ring first.
+        std::size_t ring_count() const noexcept { return rings_.size(); }
+
+        /// @brief Gets the number of vertices of all the rings.
+        std::size_t vertex_count() const noexcept { return vertex_count_; }
+
+        /// @brief Gets the edges of a ring, in ring order.
+        std::span<const edge> edges(const std::size_t ring) const noexcept { return rings_[ring].edges(); }
+
+        /// @brief Gets the bounding box of a ring.
+        const bounding_box& bounds(const std::size_t ring) const noexcept { return rings_[ring].bounds(); }
+
+        /// @brief Gets the edges with a piece within `max_face_distance` of the center of a face.
+        std::span<const edge> edges_near(const icosahedron::face::id_t face) const noexcept;
+
+        /// @ref pointInsidePolygon
+        /// @brief Checks whether a coordinate is inside the outer ring and outside every hole.
+        bool contains(const gis::wgs84::coordinate& coord) const;
+
+        /// @brief Checks whether the boundary may pass within a distance of a coordinate.
+        /// @details Conservative: an edge crossing the latitude/longitude box of the cap counts.
+        /// @param radius The radius of the cap, in radians.
+        bool crosses(const gis::wgs84::coordinate& center, const double radius) const noexcept;
+
+    private:
+        /// @brief A ring with its edges bucketed by latitude band, then by longitude.
+        /// @details The edges with an end in a band are kept whole in the band. The edges across bands go to the nodes
+        /// of a segment tree over the bands, whose cells split them at the quantiles of their longitudes: a point only
+        /// visits the edges of its cell in each node above its band, those east of the cell are counted in advance.
+        class ring_index
+        {
+        public:
+            /// @brief Indexes another ring, reusing the storage of the previous one.
+            template <gis::wgs84::coordinate_accessor Ring>
+            void assign(const Ring& ring)
+            {
+                bounds_ = bounding_box::of(ring);
+                edges_.clear();
+                edges_.reserve(ring.size());
+                for (std::size_t i {}; i != ring.size(); ++i)
+                {
+                    gis::wgs84::coordinate a = ring[i];
+                    gis::wgs84::coordinate b = ring[(i + 1u) % ring.size()];
+                    if (a.latitude > b.latitude)
+                        std::swap(a, b);
+
+                    edges_.push_back({a.latitude, bounds_.normalize(a.longitude), b.latitude, bounds_.normalize(b.longitude)});
+                }
+
+                index_edges();
+            }
+
+            const bounding_box& bounds() const noexcept { return bounds_; }
+
+            std::span<const edge> edges() const noexcept { return edges_; }
+
+            /// @ref pointInsideGeoLoop
+            bool contains(const gis::wgs84::coordinate& coord) const;
+
+            /// @brief Checks whether an edge crosses a box given by its latitudes and the longitudes of its center.
+            bool crosses(const double south, const double north, const double longitude, const double half_width) const noexcept;
+
+        private:
+            /// @brief Buckets the edges by latitude band and longitude.
+            void index_edges();
+
+            std::size_t band_of(const double latitude) const noexcept;
+
+            std::size_t cell_of(const std::size_t node, const double longitude) const noexcept;
+
+            /// @brief The point in ring test of H3 over every edge of a band, in ring order.
+            bool contains_exactly(const gis::wgs84::coordinate& coord) const;
+
+            bounding_box bounds_;
+            std::vector<edge> edges_;
+            double west_ {DBL_MAX};
+            double east_ {-DBL_MAX};
+            double band_scale_ {};
+            std::vector<std::uint32_t> band_offsets_;  ///< The edges with an end in each band.
+            std::vector<std::uint32_t> band_edges_;    ///< Ring order within a band.
+            std::vector<std::uint32_t> node_cells_;    ///< The first cell of each node, in heap order from node 1.
+            std::vector<double> cell_wests_;           ///< The west bound of each cell; the first of a node is unbounded.
+            std::vector<std::uint32_t> cell_offsets_;  ///< The edges of a node reaching each cell.
+            std::vector<std::uint32_t> cell_edges_;    ///< Ring order within a cell.
+            std::vector<std::uint8_t> cell_parities_;  ///< The parity of the edges of a node east of each cell.
+        };
+
+        /// @brief Buckets the edges of the rings by the faces they come near.
+        void index_faces();
+
+        std::vector<ring_index> rings_;
+        std::array<std::uint32_t, icosahedron::face::count + 1u> face_offsets_ {};
+        std::vector<edge> face_edges_;
+        std::size_t vertex_count_ {};
+        bool finite_ {true};
+    };
+}
@@ -1,20 +1,80 @@
+/// @file geohex/polygon/span_based.hpp
 #pragma once
 #ifndef PCH
-    #include <h3plus/cell/item.hpp>
+    #include <kmx/geohex/index.hpp>
+    #include <span>
 #endif
 
-namespace h3plus::polygon::span_based
+namespace kmx::gis::wgs84
 {
-    using item = coordinate::wgs84::span;
-    using vector = std::vector<item>;
-    using span = std::span<item>;
+    class coordinate;
+}
+
+namespace kmx::geohex::polygon
+{
+    class prepared;
+}
+
+namespace kmx::geohex::polygon::span_based
+{
+    // A polygon is an outer ring with optional holes. Like in H3, a ring is closed implicitly, its edges are straight
+    // lines in the latitude/longitude plane, and a cell belongs to the polygon when its center is inside the outer ring
+    // and outside every hole.
+
+    /// @brief A ring of coordinates (in radians); the last vertex connects back to the first.
+    using item = std::span<const gis::wgs84::coordinate>;
+
+    /// @brief The holes of a polygon.
+    using span = std::span<const item>;
+
+    /// @ref maxPolygonToCellsSize
+    /// @brief Upper bound of the cells of a polygon, from the area of its bounding box.
+    /// @return The bound, or 0 for an invalid resolution.
+    std::size_t max_size(const item& polygon, const resolution_t resolution) noexcept;
+
+    /// @ref maxPolygonToCellsSize
+    std::size_t max_size(const item& polygon, const span& holes, const resolution_t resolution) noexcept;
+
+    /// @ref maxPolygonToCellsSize
+    std::size_t max_size(const prepared& polygon, const resolution_t resolution) noexcept;
+
+    /// @ref polygonToCells
+    /// @brief Fills a polygon with the cells of a resolution.
+    /// @details Each face of the icosahedron crossed by the polygon is rasterized row by row in its IJK grid: only the
+    /// cells close to an edge of the polygon are tested individually, the runs of cells between them are emitted whole.
+    /// Large polygons are filled in parallel, by face and by row ranges; the cells come out grouped by face and row.
+    /// @param polygon The outer ring.
+    /// @param resolution The resolution of the cells.
+    /// @param[out] cells At least `max_size` items; resized to the number of cells written.
+    /// @return error_t::none on success, error_t::res_domain for an invalid resolution, error_t::latlng_domain for a
+    /// non-finite coordinate, error_t::memory_bounds when `cells` is too small (it is then emptied).
+    error_t to_cells(const item& polygon, const resolution_t resolution, std::span<index>& cells);
+
+    /// @ref polygonToCells
+    /// @param holes The holes of the polygon.
+    error_t to_cells(const item& polygon, const span& holes, const resolution_t resolution, std::span<index>& cells);
+
+    /// @ref polygonToCells
+    /// @brief Fills a prepared polygon with the cells of a resolution, skipping the preparation the other overloads
+    /// repeat on each call.
+    error_t to_cells(const prepared& polygon, const resolution_t resolution, std::span<index>& cells);
 
-    void to_cells(const item& polygon, const resolution_t resolution, cell::item::vector& cells);
-    void to_cells(const item& polygon, const item& holes, const resolution_t resolution, cell::item::vector& cells);
+    /// @brief Fills a polygon with the cells of a resolution, compacted.
+    /// @details The cells of `to_cells`, with every complete set of siblings replaced by their parent (see H3
+    /// compactCells). The hierarchy is walked down from the base cells: a cell whose descendant centers cannot meet the
+    /// polygon boundary is emitted or dropped whole, only the cells near the boundary are refined down to `resolution`.
+    /// The cells come out grouped by base cell.
+    /// @param polygon The outer ring.
+    /// @param resolution The finest resolution of the cells.
+    /// @param[out] cells Resized to the number of cells written; `max_size` items always suffice.
+    /// @return error_t::none on success, error_t::res_domain for an invalid resolution, error_t::latlng_domain for a
+    /// non-finite coordinate, error_t::memory_bounds when `cells` is too small (it is then emptied).
+    error_t to_compact_cells(const item& polygon, const resolution_t resolution, std::span<index>& cells);
 
-    void to_cells(const item& polygon, const resolution_t resolution, cell::item::span& cells);
-    void to_cells(const item& polygon, const item& holes, const resolution_t resolution, cell::item::span& cells);
+    /// @brief Fills a polygon with the cells of a resolution, compacted.
+    /// @param holes The holes of the polygon.
+    error_t to_compact_cells(const item& polygon, const span& holes, const resolution_t resolution, std::span<index>& cells);
 
-    void cells_to_multi_polygon(const cell::item::vector& hexagons, vector& polygons);
-    void cells_to_multi_polygon(const cell::item::span& hexagons, vector& polygons);
+    /// @brief Fills a prepared polygon with the cells of a resolution, compacted.
+    error_t to_compact_cells(const prepared& polygon, const resolution_t resolution, std::span<index>& cells);
 }
@@ -1,20 +1,92 @@
+/// @file geohex/polygon/vector_based.hpp
 #pragma once
 #ifndef PCH
-    #include <h3plus/cell/item.hpp>
+    #include <kmx/geohex/index.hpp>
+    #include <kmx/gis/wgs84/coordinate.hpp>
+    #include <span>
+    #include <vector>
 #endif
 
-namespace h3plus::polygon::vector_based
+namespace kmx::geohex::polygon
 {
-    using item = coordinate::wgs84::vector;
+    class prepared;
+}
+
+namespace kmx::geohex::polygon::vector_based
+{
+    // Allocating counterparts of `span_based`, with the same polygon conventions.
+
+    /// @brief A ring of coordinates (in radians); the last vertex connects back to the first.
+    using item = gis::wgs84::coordinate::vector;
+
+    /// @brief The holes of a polygon.
     using vector = std::vector<item>;
-    using span = std::span<item>;
 
-    void to_cells(const item& polygon, const resolution_t resolution, cell::item::vector& cells);
-    void to_cells(const item& polygon, const item& holes, const resolution_t resolution, cell::item::vector& cells);
+    /// @ref polygonToCells
+    /// @param[out] cells The cells, replaced on success.
+    error_t to_cells(const item& polygon, const resolution_t resolution, std::vector<index>& cells);
+
+    /// @ref polygonToCells
+    error_t to_cells(const item& polygon, const vector& holes, const resolution_t resolution, std::vector<index>& cells);
+
+    /// @ref polygonToCells
+    error_t to_cells(const prepared& polygon, const resolution_t resolution, std::vector<index>& cells);
+
+    /// @brief Fills a polygon with the cells of a resolution, compacted (see `span_based::to_compact_cells`).
+    /// @param[out] cells The cells, replaced on success.
+    error_t to_compact_cells(const item& polygon, const resolution_t resolution, std::vector<index>& cells);
+
+    /// @brief Fills a polygon with the cells of a resolution, compacted (see `span_based::to_compact_cells`).
+    error_t to_compact_cells(const item& polygon, const vector& holes, const resolution_t resolution, std::vector<index>& cells);
+
+    /// @brief Fills a prepared polygon with the cells of a resolution, compacted (see `span_based::to_compact_cells`).
+    error_t to_compact_cells(const prepared& polygon, const resolution_t resolution, std::vector<index>& cells);
+
+    /// @brief A polygon: its outer ring and its holes.
+    struct shape
+    {
+        item outer;
+        vector holes;
+    };
+
+    /// @brief Polygons that do not overlap.
+    using multi = std::vector<shape>;
+
+    /// @ref cellsToMultiPolygon
+    /// @brief Dissolves a set of cells into the polygons covering them.
+    /// @details Every cell edge is keyed by its pair of canonical vertices (see `vertex::of`); the keys are radix sorted
+    /// so the two sides of an edge inside the set meet and cancel. The cells are split by base cell and leading digits
+    /// into groups dissolved in parallel, then the edges left on the seams between groups are sorted and cancelled once
+    /// more. The remaining edges are chained into rings,
+    /// and the cells joined by cancelled edges tell which rings bound the same polygon: its outer ring follows the cell
+    /// boundaries (counterclockwise), its holes run the other way. Of the rings of a band around a pole, the one farther
+    /// from the pole is the outer one, as in H3. Class III edges crossing an icosahedron edge keep their extra vertex.
+    /// @param cells Valid cells of one resolution, without duplicates.
+    /// @param[out] polygons The polygons, one per set of cells connected by their edges, replaced on success.
+    /// @return error_t::none on success, error_t::cell_invalid for an invalid cell, error_t::res_mismatch for cells of
+    /// several resolutions, error_t::duplicate_input for a repeated cell, error_t::memory_bounds for more than 2^32 cells.
+    error_t cells_to_multi_polygon(std::span<const index> cells, multi& polygons);
+
+    /// @brief A cell with the class of its value, e.g. the bucket of a choropleth.
+    struct class_cell
+    {
+        index cell;
+        std::uint32_t class_id;
+    };
 
-    void to_cells(const item& polygon, const resolution_t resolution, cell::item::span& cells);
-    void to_cells(const item& polygon, const item& holes, const resolution_t resolution, cell::item::span& cells);
+    /// @brief The polygons of the cells of a class.
+    struct class_polygons
+    {
+        std::uint32_t class_id;
+        multi polygons;
+    };
 
-    void cells_to_multi_polygon(const cell::item::vector& hexagons, vector& polygons);
-    void cells_to_multi_polygon(const cell::item::span& hexagons, vector& polygons);
+    /// @brief Dissolves the cells of a field into the polygons of each class, in a single pass.
+    /// @details As `cells_to_multi_polygon`, except that only the edges between cells of the same class cancel. An edge
+    /// between two classes is decoded once and bounds a polygon of each, in opposite directions, so neighboring
+    /// polygons share their vertices exactly.
+    /// @param cells Valid cells of one resolution, without duplicates, each with its class.
+    /// @param[out] polygons The polygons of each class present, by increasing class, replaced on success.
+    /// @return As `cells_to_multi_polygon`.
+    error_t cells_to_multi_polygons(std::span<const class_cell> cells, std::vector<class_polygons>& polygons);
 }
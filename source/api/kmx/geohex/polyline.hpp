@@ -0,0 +1,52 @@
+/// @file geohex/polyline.hpp
+#pragma once
+#ifndef PCH
+    #include <kmx/geohex/index.hpp>
+    #include <kmx/geohex/polygon/batch.hpp>
+    #include <kmx/gis/wgs84/coordinate.hpp>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::polyline
+{
+    // A polyline is a sequence of vertices joined by great circle arcs, such as a GPS trajectory or a flight path.
+
+    /// @brief The vertices of a polyline (in radians).
+    using item = std::span<const gis::wgs84::coordinate>;
+
+    /// @brief Many polylines in flat arrays: the vertices of all the polylines one after another.
+    struct lines
+    {
+        std::span<const gis::wgs84::coordinate> coordinates; ///< The vertices of every polyline, in radians.
+        std::span<const std::size_t> offsets;                ///< The first vertex of each polyline, then the vertex count.
+
+        /// @brief Gets the number of polylines.
+        std::size_t size() const noexcept { return offsets.empty() ? 0u : offsets.size() - 1u; }
+    };
+
+    /// @brief The cells of many polylines, one polyline after another.
+    using cells = polygon::batch::cells;
+
+    /// @brief Gets the cells a polyline passes through, in order along it.
+    /// @details Each arc is bisected wherever its two ends fall in different cells, until every crossing from a cell to
+    /// the next is located within a small fraction of the shortest cell edge of the resolution: as the cells are convex
+    /// and the arcs straight in the gnomonic projection of a face, the arc between two points of a cell stays in it. The
+    /// consecutive cells are thus neighbors, except where the arc passes within that tolerance of a cell vertex and
+    /// clips a third cell; consecutive repeats are removed, a cell entered again later is listed again.
+    /// @param line The vertices; a single vertex gives its cell.
+    /// @param resolution The resolution of the cells.
+    /// @param[out] cells The cells, replaced on success.
+    /// @return error_t::none on success, error_t::res_domain for an invalid resolution, error_t::latlng_domain for a
+    /// non-finite coordinate, error_t::domain for an arc between antipodal vertices, whose great circle is undefined.
+    error_t to_cells(const item& line, const resolution_t resolution, std::vector<index>& cells);
+
+    /// @brief Gets the cells every polyline of a batch passes through, in parallel for large batches.
+    /// @param lines The polylines.
+    /// @param resolution The resolution of the cells.
+    /// @param[out] cells The cells, replaced on success.
+    /// @return error_t::none on success, error_t::res_domain for an invalid resolution, error_t::domain for offsets
+    /// that are not increasing or do not cover the coordinates, or else the first error of a polyline, in polyline
+    /// order.
+    error_t to_cells(const lines& lines, const resolution_t resolution, cells& cells);
+}
@@ -0,0 +1,35 @@
+/// @file geohex/pyramid.hpp
+#pragma once
+#ifndef PCH
+    #include <cstdint>
+    #include <kmx/geohex/index.hpp>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::pyramid
+{
+    /// @brief The totals of the cells of a resolution, in columns.
+    struct level
+    {
+        resolution_t resolution {};
+        std::vector<index> cells;          ///< The cells with values, sorted.
+        std::vector<std::uint64_t> counts; ///< The number of values in each cell.
+        std::vector<double> sums;          ///< The sum of the values in each cell.
+    };
+
+    /// @brief Groups values on cells by cell, then by the ancestors of the cells down to a resolution, in one pass.
+    /// @details Setting the digits below a resolution to 7 keeps cells of one resolution in order, so the ancestors of
+    /// sorted cells come sorted too: each resolution is a run of equal cells, summed as the values stream by, with no
+    /// hashing. The values are sorted by cell first when they are not.
+    /// @param cells The cell of each value, all of one resolution, in any order.
+    /// @param values The values.
+    /// @param coarsest The coarsest resolution to group by, not finer than the one of the cells.
+    /// @param[out] levels The totals of the resolution of the cells first, then of each coarser one down to `coarsest`;
+    /// replaced on success, empty for no cells.
+    /// @return error_t::none on success, error_t::domain for spans of different sizes, error_t::cell_invalid for a cell
+    /// that is not valid, error_t::res_mismatch for cells of different resolutions, error_t::res_domain for a coarsest
+    /// resolution finer than the cells.
+    error_t build(const std::span<const index> cells, const std::span<const double> values, const resolution_t coarsest,
+                  std::vector<level>& levels);
+}
@@ -0,0 +1,24 @@
+/// @file geohex/radix.hpp
+#pragma once
+#ifndef PCH
+    #include <cstdint>
+    #include <kmx/geohex/index.hpp>
+    #include <span>
+#endif
+
+namespace kmx::geohex::radix
+{
+    // Radix sorts of indexes, in the order of `index::operator<`. Only the bits that differ between the indexes are
+    // sorted, 11 at a time from the least significant one: the mode, reserved and resolution bits of a set of one mode
+    // and resolution and the trailing 7 digits below it are the same in every index, as are the base cell and leading
+    // digits of a regional set, so a set of cells of resolution 9 in a country takes 3 passes rather than 8. Large
+    // arrays are sorted by a pool of threads, each counting then moving its share of every pass.
+
+    /// @brief Sorts indexes.
+    void sort(const std::span<index> cells);
+
+    /// @brief Sorts indexes with a value each, such as the row of the index in a table; equal indexes keep the order of
+    /// their values.
+    /// @return error_t::none on success, error_t::domain for spans of different sizes.
+    error_t sort(const std::span<index> cells, const std::span<std::uint64_t> values);
+}
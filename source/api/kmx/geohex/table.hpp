@@ -0,0 +1,99 @@
+/// @file geohex/table.hpp
+#pragma once
+#ifndef PCH
+    #include <cstddef>
+    #include <cstdint>
+    #include <kmx/geohex/index.hpp>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::table
+{
+    // An immutable file of cells, each with a payload of bytes, read in place: a reader maps the file in memory (with
+    // `mmap` or `MapViewOfFile`) and looks cells up with no loading step, processes mapping the same file share its
+    // pages. All the numbers are 64 bit little endian values, the sections start at multiples of 64 bytes:
+    //
+    // | offset           | content                                                                                       |
+    // |------------------|-----------------------------------------------------------------------------------------------|
+    // | 0                | header: magic "GHXT", version (32 bit each), key count, block count, a bit per resolution     |
+    // |                  | with cells, then the offsets of the summary, keys, payload offsets and payloads sections       |
+    // | summary          | the first key of each block with the number of the block, in Eytzinger (breadth first) order, |
+    // |                  | from slot 1: a search visits the slots near the root first, which stay in the cache            |
+    // | keys             | the cells, sorted, in blocks of 64 (eight cache lines), the last one padded with ~0            |
+    // | payload offsets  | the first byte of the payload of each key in the payloads, then their size                     |
+    // | payloads         | the payloads, in key order                                                                     |
+
+    /// @brief Keys per block of the keys section.
+    inline constexpr std::size_t block_size = 64u;
+
+    /// @brief Collects cells with their payloads, then writes them as a table.
+    class writer
+    {
+    public:
+        /// @brief Adds a cell with its payload, copied.
+        void add(const index cell, const std::span<const std::byte> payload);
+
+        /// @brief Gets the number of cells added.
+        std::size_t size() const noexcept { return cells_.size(); }
+
+        /// @brief Appends the table of the cells added, padded to a multiple of 64 bytes first.
+        /// @return error_t::none on success, error_t::cell_invalid for a cell that is not valid, error_t::duplicate_input
+        /// for a cell added twice, error_t::domain on a big endian host.
+        error_t write(std::vector<std::byte>& data) const;
+
+    private:
+        std::vector<index> cells_;
+        std::vector<std::size_t> offsets_ {0u}; ///< The first byte of each payload, then their size.
+        std::vector<std::byte> payloads_;
+    };
+
+    /// @brief Reads a table in place.
+    /// @details Opening it only checks its header and section bounds; the sections are read as they are, so the view
+    /// costs nothing more than the memory of the table, which must outlive it.
+    class view
+    {
+    public:
+        /// @brief An empty table, to open later.
+        view() = default;
+
+        /// @brief Opens a table.
+        /// @param data The table, aligned to 8 bytes at least, such as a memory mapped file.
+        /// @return error_t::none on success, error_t::domain for data that is not a table, truncated or not aligned,
+        /// or on a big endian host.
+        error_t open(const std::span<const std::byte> data) noexcept;
+
+        /// @brief Gets the number of cells.
+        std::size_t size() const noexcept { return key_count_; }
+
+        /// @brief Gets a cell by its rank in the sorted cells.
+        index key(const std::size_t rank) const noexcept { return keys_[rank]; }
+
+        /// @brief Gets the payload of a cell by its rank in the sorted cells.
+        std::span<const std::byte> payload(const std::size_t rank) const noexcept;
+
+        /// @brief Finds the rank of a cell.
+        /// @return The rank, or `size()` for a cell not in the table.
+        std::size_t find(const index cell) const noexcept;
+
+        /// @brief Finds the finest cell of the table among a cell and its ancestors.
+        /// @return The rank of that cell, or `size()` when there is none.
+        std::size_t find_ancestor(const index cell) const noexcept;
+
+    private:
+        /// @brief A slot of the summary.
+        struct slot
+        {
+            std::uint64_t first_key;
+            std::uint64_t block;
+        };
+
+        std::size_t key_count_ {};
+        std::size_t block_count_ {};
+        std::uint64_t resolutions_ {};
+        std::span<const slot> summary_;
+        const std::uint64_t* keys_ {};
+        const std::uint64_t* payload_offsets_ {};
+        std::span<const std::byte> payloads_;
+    };
+}
@@ -0,0 +1,102 @@
+/// @file geohex/tile.hpp
+#pragma once
+#ifndef PCH
+    #include <compare>
+    #include <cstdint>
+    #include <kmx/geohex/cell/bounds.hpp>
+    #include <kmx/geohex/index.hpp>
+    #include <memory>
+    #include <mutex>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::tile
+{
+    // Covers for tile servers: the cells meeting a latitude/longitude box or an XYZ web mercator tile, and the tiles
+    // meeting a set of cells.
+
+    /// @brief A latitude/longitude box, in radians (see `cell::bounds::box`).
+    using box = cell::bounds::box;
+
+    /// @brief The finest zoom level of the tiles.
+    constexpr std::uint8_t max_zoom = 30u;
+
+    /// @brief An XYZ web mercator tile: at zoom level z, x counts the tiles eastwards from the antimeridian and y
+    /// southwards from the northern edge of the map, both below 2 to the power of z.
+    struct id
+    {
+        std::uint8_t zoom {};
+        std::uint32_t x {};
+        std::uint32_t y {};
+
+        auto operator<=>(const id&) const noexcept = default;
+
+        /// @brief Checks whether the zoom level and the coordinates are in range.
+        bool is_valid() const noexcept { return (zoom <= max_zoom) && (x >> zoom == 0u) && (y >> zoom == 0u); }
+    };
+
+    /// @brief Gets the box of a tile; the tiles of the first and last rows stop at the latitude limit of the map
+    /// (about 85.05 degrees).
+    box to_box(const id& tile) noexcept;
+
+    /// @brief Gets the cells of a resolution meeting a box.
+    /// @details The hierarchy is walked down from the base cells, each cell against the box of the cap holding the
+    /// cells of the resolution below it: a cell whose cap box is inside the box is emitted whole, one whose cap box
+    /// misses it is dropped, only the cells along the edges of the box are refined. As the cells of the resolution are
+    /// kept when their bounding cap (see `cell::bounds`) meets the box, a few of them near its edges only come close.
+    /// @param box The box; it crosses the antimeridian when its west longitude is greater than its east one.
+    /// @param resolution The resolution of the cells.
+    /// @param[out] cells The cells, sorted, replaced on success.
+    /// @return error_t::none on success, error_t::res_domain for an invalid resolution, error_t::latlng_domain for a
+    /// non-finite box, latitudes out of order or out of range, or longitudes out of range.
+    error_t to_cells(const box& box, const resolution_t resolution, std::vector<index>& cells);
+
+    /// @brief Gets the cells of a resolution meeting a tile.
+    /// @return error_t::none on success, error_t::res_domain for an invalid resolution, error_t::domain for an invalid
+    /// tile.
+    error_t to_cells(const id& tile, const resolution_t resolution, std::vector<index>& cells);
+
+    /// @brief Gets the tiles of a zoom level meeting a set of cells, from the boxes of the cells.
+    /// @param cells The cells.
+    /// @param zoom The zoom level.
+    /// @param[out] tiles The tiles, sorted and unique, replaced on success.
+    /// @return error_t::none on success, error_t::domain for an invalid zoom level, or else the first error of a cell.
+    error_t to_tiles(std::span<const index> cells, const std::uint8_t zoom, std::vector<id>& tiles);
+
+    /// @brief The recent tile covers of each zoom level, shared between threads.
+    /// @details A tile server asks again and again for the tiles of a view: their covers are kept, a few per zoom
+    /// level, the oldest replaced first.
+    class cache
+    {
+    public:
+        using cells = std::shared_ptr<const std::vector<index>>;
+
+        /// @param capacity The number of covers kept per zoom level.
+        explicit cache(const std::size_t capacity = 64u): capacity_ {capacity} {}
+
+        /// @brief Gets the cells of a resolution meeting a tile, from the cache or else computed and cached.
+        /// @param[out] cells The cells, sorted, replaced on success.
+        /// @return The errors of `to_cells`.
+        error_t get(const id& tile, const resolution_t resolution, cells& cells);
+
+    private:
+        struct entry
+        {
+            id tile;
+            resolution_t resolution;
+            cells items;
+        };
+
+        /// @brief The covers of a zoom level, replaced in turn.
+        struct level
+        {
+            std::vector<entry> entries;
+            std::size_t next {};
+        };
+
+        const std::size_t capacity_;
+        std::mutex mutex_;
+        level levels_[max_zoom + 1u];
+    };
+}
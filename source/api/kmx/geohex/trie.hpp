@@ -0,0 +1,100 @@
+/// @file geohex/trie.hpp
+#pragma once
+#ifndef PCH
+    #include <cstddef>
+    #include <cstdint>
+    #include <kmx/geohex/base.hpp>
+    #include <kmx/geohex/cell/base.hpp>
+    #include <kmx/geohex/index.hpp>
+    #include <limits>
+    #include <span>
+    #include <vector>
+#endif
+
+namespace kmx::geohex::trie
+{
+    /// @brief The count, sum, minimum and maximum of values.
+    struct aggregate
+    {
+        std::uint64_t count {};
+        double sum {};
+        double min {std::numeric_limits<double>::infinity()};
+        double max {-std::numeric_limits<double>::infinity()};
+
+        void add(const double value) noexcept
+        {
+            ++count;
+            sum += value;
+            min = value < min ? value : min;
+            max = value > max ? value : max;
+        }
+
+        void add(const aggregate& other) noexcept
+        {
+            count += other.count;
+            sum += other.sum;
+            min = other.min < min ? other.min : min;
+            max = other.max > max ? other.max : max;
+        }
+    };
+
+    /// @brief Values on cells of any resolutions, in a tree following the base cell then the digits of the cells, with
+    /// the aggregate of each subtree: the aggregate of the values in a cell at any resolution is read at its node.
+    /// @details The nodes sit in one array, with the indexes of their children by digit; bulk loads create them in depth
+    /// first order, so a walk down reads nearby nodes.
+    class tree
+    {
+    public:
+        /// @brief An empty tree.
+        tree() = default;
+
+        /// @brief Replaces the content by values on cells.
+        /// @param cells The cells, of any resolutions, in any order; a cell may have many values.
+        /// @param values The value of each cell.
+        /// @return error_t::none on success, error_t::domain for spans of different sizes, error_t::cell_invalid for a
+        /// cell that is not valid.
+        error_t assign(const std::span<const index> cells, const std::span<const double> values);
+
+        /// @brief Adds a value on a cell.
+        /// @return error_t::none on success, error_t::cell_invalid for a cell that is not valid.
+        error_t insert(const index cell, const double value);
+
+        /// @brief Gets the aggregate of the values on a cell and its descendants.
+        /// @return The aggregate, empty for a cell that is not valid.
+        aggregate total(const index cell) const noexcept;
+
+        /// @brief Gets the aggregate of the values on a cell itself.
+        /// @return The aggregate, empty for a cell that is not valid.
+        aggregate values(const index cell) const noexcept;
+
+        /// @brief Finds the finest cell with values among a cell and its ancestors.
+        /// @param[out] found The cell, when there is one.
+        /// @return True when there is one.
+        bool find_ancestor(const index cell, index& found) const noexcept;
+
+        /// @brief Gets the number of values.
+        std::size_t size() const noexcept { return size_; }
+
+        /// @brief Gets the number of nodes, one per cell with values or with descendants with values.
+        std::size_t node_count() const noexcept { return nodes_.empty() ? 0u : nodes_.size() - 1u; }
+
+    private:
+        /// @brief The index of a missing node.
+        static constexpr std::uint32_t none = 0u;
+
+        struct node
+        {
+            std::uint32_t children[direction_count] {}; ///< The child of each digit.
+            aggregate total;                            ///< The values of the subtree.
+            aggregate own;                              ///< The values of the cell.
+        };
+
+        /// @brief Finds the node of a cell.
+        /// @return The node, or `none` for a cell without values in it.
+        std::uint32_t find(const index cell) const noexcept;
+
+        std::uint32_t roots_[cell::base::count] {};
+        std::vector<node> nodes_;
+        std::size_t size_ {};
+    };
+}
@@ -0,0 +1,72 @@
+/// @file geohex/vertex.hpp
+#pragma once
+#ifndef PCH
+    #include <kmx/geohex/index.hpp>
+    #include <span>
+#endif
+
+namespace kmx::gis::wgs84
+{
+    class coordinate;
+}
+
+namespace kmx::geohex::vertex
+{
+    // A vertex is shared by up to three cells. Its canonical index is the cell with the lowest index among them (the
+    // owner) with the mode set to `vertex` and the number of the vertex on the owner stored in the mode dependent bits,
+    // so every topological vertex has exactly one index.
+
+    using number_t = std::int8_t;
+
+    constexpr number_t invalid_number = -1;
+
+    /// @ref NUM_HEX_VERTS
+    constexpr std::uint8_t hexagon_count = 6u;
+
+    /// @ref NUM_PENT_VERTS
+    constexpr std::uint8_t pentagon_count = 5u;
+
+    /// @brief Maximum number of vertices of a single cell.
+    constexpr std::uint8_t max_count = hexagon_count;
+
+    /// @brief Gets the number of vertices of a cell.
+    inline std::uint8_t count(const index cell) noexcept
+    {
+        return cell.is_pentagon() ? pentagon_count : hexagon_count;
+    }
+
+    /// @brief Gets the number of the first vertex of the edge shared with the neighbor in a given direction.
+    /// @ref vertexNumForDirection
+    /// @return The vertex number, or invalid_number for the center, invalid or deleted pentagon directions.
+    number_t number_for_direction(const index origin, const direction_t direction) noexcept;
+
+    /// @brief Gets the direction of the neighbor sharing the edge which starts at a given vertex.
+    /// @ref directionForVertexNum
+    /// @return The direction, or direction_t::invalid for an out of range vertex number.
+    direction_t direction_for_number(const index origin, const number_t number) noexcept;
+
+    /// @brief Gets the owner cell of a vertex.
+    index owner(const index vertex) noexcept;
+
+    /// @brief Gets the number of a vertex on its owner cell.
+    number_t number(const index vertex) noexcept;
+
+    /// @ref cellToVertex
+    /// @param cell A valid cell.
+    /// @param number The vertex number on the cell, below `count(cell)`.
+    /// @param[out] out The canonical vertex index.
+    /// @return error_t::none on success, error_t::domain for an out of range vertex number.
+    error_t of(const index cell, const number_t number, index& out) noexcept;
+
+    /// @ref cellToVertexes
+    /// @param[out] out At least `max_count` items; resized to the 6 (hexagon) or 5 (pentagon) vertices written.
+    error_t of(const index cell, std::span<index>& out) noexcept;
+
+    /// @ref isValidVertex
+    /// @return True for a canonical vertex index of a valid cell.
+    bool is_valid(const index vertex) noexcept;
+
+    /// @ref vertexToLatLng
+    /// @param[out] out The vertex coordinate (in radians).
+    error_t to_wgs84(const index vertex, gis::wgs84::coordinate& out) noexcept;
+}
@@ -0,0 +1,88 @@
+/// @file kmx/gis/wgs84/view.hpp
+#pragma once
+#ifndef PCH
+    #include <concepts>
+    #include <cstddef>
+    #include <kmx/gis/wgs84/coordinate.hpp>
+    #include <numbers>
+#endif
+
+namespace kmx::gis::wgs84
+{
+    /// @brief Unit tag of coordinates stored in radians.
+    struct radians
+    {
+        static constexpr double scale = 1.0;
+    };
+
+    /// @brief Unit tag of coordinates stored in degrees.
+    struct degrees
+    {
+        static constexpr double scale = std::numbers::pi_v<double> / 180.0;
+    };
+
+    /// @brief A sequence of coordinates read by index, such as `coordinate::vector`, a span of coordinates or a
+    /// `strided_view`; each item converts to a `coordinate` in radians.
+    template <typename T>
+    concept coordinate_accessor = requires(const T& coordinates, const std::size_t i) {
+        { coordinates.size() } -> std::convertible_to<std::size_t>;
+        { coordinates[i] } -> std::convertible_to<coordinate>;
+    };
+
+    /// @brief Coordinates read in place from a buffer of numbers: interleaved pairs, columns or the fields of records.
+    /// @details The latitude and longitude of item `i` are at `i * stride` from their first values, in numbers of type
+    /// `Value` (such as `double` or `float`) and in the unit `Unit`; items convert to radians when read.
+    template <typename Value, typename Unit = radians>
+    class strided_view
+    {
+    public:
+        constexpr strided_view() noexcept = default;
+
+        /// @param latitudes The latitude of the first item.
+        /// @param longitudes The longitude of the first item.
+        /// @param size The number of items.
+        /// @param stride The distance between two items, in numbers.
+        constexpr strided_view(const Value* latitudes, const Value* longitudes, const std::size_t size,
+                               const std::size_t stride = 1u) noexcept:
+            latitudes_ {latitudes},
+            longitudes_ {longitudes},
+            size_ {size},
+            stride_ {stride}
+        {
+        }
+
+        /// @brief Views pairs of latitude then longitude.
+        static constexpr strided_view latitude_longitude(const Value* data, const std::size_t size) noexcept
+        {
+            return {data, data + 1, size, 2u};
+        }
+
+        /// @brief Views pairs of longitude then latitude (X then Y, as in GeoJSON and WKB).
+        static constexpr strided_view longitude_latitude(const Value* data, const std::size_t size) noexcept
+        {
+            return {data + 1, data, size, 2u};
+        }
+
+        constexpr std::size_t size() const noexcept { return size_; }
+
+        constexpr bool empty() const noexcept { return size_ == 0u; }
+
+        constexpr coordinate operator[](const std::size_t i) const noexcept
+        {
+            const auto offset = i * stride_;
+            return {static_cast<double>(latitudes_[offset]) * Unit::scale, static_cast<double>(longitudes_[offset]) * Unit::scale};
+        }
+
+        /// @brief Views `count` items from `offset`, such as a ring of a buffer of many.
+        constexpr strided_view subview(const std::size_t offset, const std::size_t count) const noexcept
+        {
+            return {latitudes_ + offset * stride_, longitudes_ + offset * stride_, count, stride_};
+        }
+
+    private:
+        const Value* latitudes_ {};
+        const Value* longitudes_ {};
+        std::size_t size_ {};
+        std::size_t stride_ {1u};
+    };
+}
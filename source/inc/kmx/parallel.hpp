@@ -0,0 +1,124 @@
+/// @file kmx/parallel.hpp
+#pragma once
+#ifndef PCH
+    #include <algorithm>
+    #include <atomic>
+    #include <cstddef>
+    #include <span>
+    #include <thread>
+    #include <vector>
+#endif
+
+namespace kmx
+{
+    /// @brief Runs tasks on a pool of threads, each taking the next task until none is left.
+    /// @details The calling thread is one of the `thread_count` workers; the call returns once every task is done.
+    template <typename Function>
+    void run_parallel(const std::size_t task_count, const std::size_t thread_count, Function&& function)
+    {
+        std::atomic<std::size_t> next_task {};
+        const auto worker = [&]
+        {
+            for (auto task = next_task++; task < task_count; task = next_task++)
+                function(task);
+        };
+
+        std::vector<std::jthread> threads;
+        threads.reserve(thread_count - 1u);
+        for (std::size_t i = 1u; i < thread_count; ++i)
+            threads.emplace_back(worker);
+
+        worker();
+    }
+
+    /// @brief Items per chunk taken by a thread in `for_each_chunk`.
+    inline constexpr std::size_t chunk_size = 64u;
+
+    /// @brief Fewer items than this are handled on the calling thread in `for_each_chunk`.
+    inline constexpr std::size_t min_parallel_size = 4u * chunk_size;
+
+    /// @brief Calls a function on chunks of items, taken in turn by a pool of threads for many items.
+    /// @param make_state Called once per thread for the state it hands to each of its chunks, such as buffers to reuse.
+    /// @param function Called with the state of the thread, the first item of a chunk, the item after its last and the
+    /// number of the chunk.
+    template <typename MakeState, typename Function>
+    void for_each_chunk(const std::size_t count, MakeState&& make_state, Function&& function)
+    {
+        const auto chunk_count = (count + chunk_size - 1u) / chunk_size;
+        std::atomic<std::size_t> next_chunk {};
+        const auto thread_count =
+            count < min_parallel_size ? 1u : std::min<std::size_t>(chunk_count, std::max(1u, std::thread::hardware_concurrency()));
+        run_parallel(thread_count, thread_count,
+                     [&](std::size_t)
+                     {
+                         auto state = make_state();
+                         for (auto chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++)
+                             function(state, chunk * chunk_size, std::min(count, (chunk + 1u) * chunk_size), chunk);
+                     });
+    }
+
+    /// @brief Calls a function on chunks of items, taken in turn by a pool of threads for many items.
+    /// @param function Called with the first item of a chunk, the item after its last and the number of the chunk.
+    template <typename Function>
+    void for_each_chunk(const std::size_t count, Function&& function)
+    {
+        for_each_chunk(count, [] { return 0; },
+                       [&function](int, const std::size_t first, const std::size_t last, const std::size_t chunk)
+                       { function(first, last, chunk); });
+    }
+
+    /// @brief The outputs of a chunk of inputs, one input after another, with the number of outputs of each input.
+    template <typename Item, typename Error>
+    struct chunk_output
+    {
+        std::vector<Item> items;
+        std::vector<std::size_t> counts;
+        Error error {};
+    };
+
+    /// @brief Maps each input to outputs by chunks (see `for_each_chunk`), then joins the outputs of all the inputs in
+    /// one array, with the offset of the outputs of each input.
+    /// @param function Called with the state of the thread, the first input of a chunk, the input after its last and
+    /// the output of the chunk; it stops at the first input failing, setting the error of the output.
+    /// @param[out] items The outputs, one input after another, replaced on success.
+    /// @param[out] offsets The first output of each input, then the output count, replaced on success.
+    /// @return The first error, in input order, or else a default `Error`.
+    template <typename Item, typename Error, typename MakeState, typename Function>
+    Error map_chunks(const std::size_t count, MakeState&& make_state, Function&& function, std::vector<Item>& items,
+                     std::vector<std::size_t>& offsets)
+    {
+        // 1. The chunks, taken in turn by the threads, each in its own output.
+        std::vector<chunk_output<Item, Error>> chunks((count + chunk_size - 1u) / chunk_size);
+        for_each_chunk(count, make_state,
+                       [&](auto& state, const std::size_t first, const std::size_t last, const std::size_t chunk)
+                       { function(state, first, last, chunks[chunk]); });
+
+        // 2. The chunks one after another, or the first error.
+        std::size_t total {};
+        for (const auto& chunk: chunks)
+        {
+            if (chunk.error != Error {})
+                return chunk.error;
+            total += chunk.items.size();
+        }
+
+        items.clear();
+        items.reserve(total);
+        offsets.assign(1u, 0u);
+        offsets.reserve(count + 1u);
+        for (const auto& chunk: chunks)
+        {
+            items.insert(items.end(), chunk.items.begin(), chunk.items.end());
+            for (const auto size: chunk.counts)
+                offsets.push_back(offsets.back() + size);
+        }
+
+        return Error {};
+    }
+
+    /// @brief Checks that offsets into an array start at 0, never decrease and end at its size.
+    inline bool are_valid_offsets(const std::span<const std::size_t> offsets, const std::size_t size) noexcept
+    {
+        return !offsets.empty() && (offsets.front() == 0u) && (offsets.back() == size) && std::is_sorted(offsets.begin(), offsets.end());
+    }
+}
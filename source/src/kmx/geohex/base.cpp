@@ -28,4 +28,38 @@ namespace kmx::geohex
 
         return data[+resolution];
     }
+
+    direction_t rotate_60ccw(const direction_t digit) noexcept
+    {
+        /// @ref _rotate60ccw
+        static constexpr std::array<direction_t, direction_count + 1u> data {
+            direction_t::center,  // center
+            direction_t::ik_axes, // k
+            direction_t::jk_axes, // j
+            direction_t::k_axes,  // jk
+            direction_t::ij_axes, // i
+            direction_t::i_axes,  // ik
+            direction_t::j_axes,  // ij
+            direction_t::invalid, // invalid
+        };
+
+        return +digit < data.size() ? data[+digit] : direction_t::invalid;
+    }
+
+    direction_t rotate_60cw(const direction_t digit) noexcept
+    {
+        /// @ref _rotate60cw
+        static constexpr std::array<direction_t, direction_count + 1u> data {
+            direction_t::center,  // center
+            direction_t::jk_axes, // k
+            direction_t::ij_axes, // j
+            direction_t::j_axes,  // jk
+            direction_t::ik_axes, // i
+            direction_t::k_axes,  // ik
+            direction_t::i_axes,  // ij
+            direction_t::invalid, // invalid
+        };
+
+        return +digit < data.size() ? data[+digit] : direction_t::invalid;
+    }
 }
@@ -0,0 +1,275 @@
+/// @file geohex/bitmap.cpp
+#include "kmx/geohex/bitmap.hpp"
+#include "kmx/geohex/cell.hpp"
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <numeric>
+
+namespace kmx::geohex::bitmap
+{
+    /// @brief The bits of a number kept in its container.
+    static constexpr unsigned low_bits = 16u;
+
+    /// @brief The largest array of a container; a bitmap takes less memory beyond.
+    static constexpr std::size_t max_array_size = 4096u;
+
+    /// @brief The words of a bitmap container.
+    static constexpr std::size_t word_count = (std::size_t {1u} << low_bits) / 64u;
+
+    /// @brief The operations on the containers of a set.
+    struct containers
+    {
+        using container = set::container;
+
+        static bool is_bitmap(const container& item) noexcept { return !item.words.empty(); }
+
+        static bool contains(const container& item, const std::uint16_t value) noexcept
+        {
+            return is_bitmap(item) ? ((item.words[value / 64u] >> (value % 64u)) & 1u) != 0u
+                                   : std::binary_search(item.values.begin(), item.values.end(), value);
+        }
+
+        /// @brief Gets the bitmap of a container.
+        static std::vector<std::uint64_t> words_of(const container& item)
+        {
+            if (is_bitmap(item))
+                return item.words;
+
+            std::vector<std::uint64_t> words(word_count);
+            for (const auto value: item.values)
+                words[value / 64u] |= std::uint64_t {1u} << (value % 64u);
+            return words;
+        }
+
+        /// @brief Counts the numbers of a bitmap container, turning it into an array when small enough.
+        static void finish_bitmap(container& item)
+        {
+            item.size = 0u;
+            for (const auto word: item.words)
+                item.size += static_cast<std::uint32_t>(std::popcount(word));
+
+            if (item.size > max_array_size)
+                return;
+
+            item.values.clear();
+            item.values.reserve(item.size);
+            for (std::size_t i {}; i != word_count; ++i)
+                for (auto word = item.words[i]; word != 0u; word &= word - 1u)
+                    item.values.push_back(static_cast<std::uint16_t>(64u * i + static_cast<std::size_t>(std::countr_zero(word))));
+            item.words = {};
+        }
+
+        /// @brief Sizes an array container, turning it into a bitmap when too large.
+        static void finish_array(container& item)
+        {
+            item.size = static_cast<std::uint32_t>(item.values.size());
+            if (item.size <= max_array_size)
+                return;
+
+            item.words = words_of(item);
+            item.values = {};
+        }
+
+        static void unite(const container& a, const container& b, container& out)
+        {
+            if (!is_bitmap(a) && !is_bitmap(b))
+            {
+                out.values.reserve(a.values.size() + b.values.size());
+                std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), std::back_inserter(out.values));
+                finish_array(out);
+                return;
+            }
+
+            const auto& bitmap = is_bitmap(a) ? a : b;
+            const auto& other = is_bitmap(a) ? b : a;
+            out.words = bitmap.words;
+            if (is_bitmap(other))
+                for (std::size_t i {}; i != word_count; ++i)
+                    out.words[i] |= other.words[i];
+            else
+                for (const auto value: other.values)
+                    out.words[value / 64u] |= std::uint64_t {1u} << (value % 64u);
+            finish_bitmap(out);
+        }
+
+        static void intersect(const container& a, const container& b, container& out)
+        {
+            if (is_bitmap(a) && is_bitmap(b))
+            {
+                out.words.resize(word_count);
+                for (std::size_t i {}; i != word_count; ++i)
+                    out.words[i] = a.words[i] & b.words[i];
+                finish_bitmap(out);
+                return;
+            }
+
+            // an array filtered by the other container
+            const auto& array = is_bitmap(a) ? b : a;
+            const auto& other = is_bitmap(a) ? a : b;
+            if (is_bitmap(other))
+                std::copy_if(array.values.begin(), array.values.end(), std::back_inserter(out.values),
+                             [&other](const std::uint16_t value) { return contains(other, value); });
+            else
+                std::set_intersection(array.values.begin(), array.values.end(), other.values.begin(), other.values.end(),
+                                      std::back_inserter(out.values));
+            finish_array(out);
+        }
+
+        static void subtract(const container& a, const container& b, container& out)
+        {
+            if (!is_bitmap(a))
+            {
+                if (is_bitmap(b))
+                    std::copy_if(a.values.begin(), a.values.end(), std::back_inserter(out.values),
+                                 [&b](const std::uint16_t value) { return !contains(b, value); });
+                else
+                    std::set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), std::back_inserter(out.values));
+                finish_array(out);
+                return;
+            }
+
+            out.words = a.words;
+            if (is_bitmap(b))
+                for (std::size_t i {}; i != word_count; ++i)
+                    out.words[i] &= ~b.words[i];
+            else
+                for (const auto value: b.values)
+                    out.words[value / 64u] &= ~(std::uint64_t {1u} << (value % 64u));
+            finish_bitmap(out);
+        }
+    };
+
+    error_t set::assign(const std::span<const index> cells)
+    {
+        const auto resolution = cells.empty() ? resolution_t {} : cells.front().resolution();
+        std::vector<std::uint64_t> numbers;
+        numbers.reserve(cells.size());
+        for (const auto cell: cells)
+        {
+            if (!cell.is_valid())
+                return error_t::cell_invalid;
+            if (cell.resolution() != resolution)
+                return error_t::res_mismatch;
+            numbers.push_back(cell::to_number(cell));
+        }
+
+        std::sort(numbers.begin(), numbers.end());
+        numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+
+        // the numbers sharing their high bits, in turn
+        std::vector<container> result;
+        for (auto first = numbers.begin(); first != numbers.end();)
+        {
+            const auto high = *first >> low_bits;
+            const auto last =
+                std::find_if(first, numbers.end(), [high](const std::uint64_t number) { return (number >> low_bits) != high; });
+            auto& item = result.emplace_back();
+            item.high = high;
+            item.values.reserve(static_cast<std::size_t>(last - first));
+            for (auto number = first; number != last; ++number)
+                item.values.push_back(static_cast<std::uint16_t>(*number));
+            containers::finish_array(item);
+            first = last;
+        }
+
+        resolution_ = resolution;
+        size_ = numbers.size();
+        containers_ = std::move(result);
+        return error_t::none;
+    }
+
+    void set::to_cells(std::vector<index>& cells) const
+    {
+        cells.clear();
+        cells.reserve(size_);
+        for (const auto& item: containers_)
+        {
+            const auto base = item.high << low_bits;
+            if (containers::is_bitmap(item))
+            {
+                for (std::size_t i {}; i != word_count; ++i)
+                    for (auto word = item.words[i]; word != 0u; word &= word - 1u)
+                    {
+                        const auto value = 64u * i + static_cast<std::size_t>(std::countr_zero(word));
+                        cells.push_back(cell::from_number(base | value, resolution_));
+                    }
+            }
+            else
+                for (const auto value: item.values)
+                    cells.push_back(cell::from_number(base | value, resolution_));
+        }
+    }
+
+    bool set::contains(const index cell) const noexcept
+    {
+        if (empty() || (cell.resolution() != resolution_))
+            return false;
+
+        // only the cells whose number gives them back belong to the resolution
+        const auto number = cell::to_number(cell);
+        if (cell::from_number(number, resolution_) != cell)
+            return false;
+
+        const auto high = number >> low_bits;
+        const auto found = std::lower_bound(containers_.begin(), containers_.end(), high,
+                                            [](const container& item, const std::uint64_t value) { return item.high < value; });
+        return (found != containers_.end()) && (found->high == high) && containers::contains(*found, static_cast<std::uint16_t>(number));
+    }
+
+    template <typename Operation>
+    error_t set::combine(const set& a, const set& b, set& result, const bool keep_a, const bool keep_b, Operation&& operation)
+    {
+        if (!a.empty() && !b.empty() && (a.resolution_ != b.resolution_))
+            return error_t::res_mismatch;
+
+        // the containers of both sets merged by their high bits
+        set out;
+        out.resolution_ = a.empty() ? b.resolution_ : a.resolution_;
+        auto i = a.containers_.begin();
+        auto j = b.containers_.begin();
+        while ((i != a.containers_.end()) || (j != b.containers_.end()))
+        {
+            if ((j == b.containers_.end()) || ((i != a.containers_.end()) && (i->high < j->high)))
+            {
+                if (keep_a)
+                    out.containers_.push_back(*i);
+                ++i;
+            }
+            else if ((i == a.containers_.end()) || (j->high < i->high))
+            {
+                if (keep_b)
+                    out.containers_.push_back(*j);
+                ++j;
+            }
+            else
+            {
+                container item;
+                item.high = i->high;
+                operation(*i++, *j++, item);
+                if (item.size != 0u)
+                    out.containers_.push_back(std::move(item));
+            }
+        }
+
+        out.size_ = std::accumulate(out.containers_.begin(), out.containers_.end(), std::size_t {},
+                                    [](const std::size_t total, const container& item) { return total + item.size; });
+        result = std::move(out);
+        return error_t::none;
+    }
+
+    error_t unite(const set& a, const set& b, set& result)
+    {
+        return set::combine(a, b, result, true, true, containers::unite);
+    }
+
+    error_t intersect(const set& a, const set& b, set& result)
+    {
+        return set::combine(a, b, result, false, false, containers::intersect);
+    }
+
+    error_t subtract(const set& a, const set& b, set& result)
+    {
+        return set::combine(a, b, result, true, false, containers::subtract);
+    }
+}
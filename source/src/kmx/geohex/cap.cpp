@@ -0,0 +1,117 @@
+/// @file geohex/cap.cpp
+#include "kmx/geohex/cap.hpp"
+#include "kmx/geohex/cell.hpp"
+#include "kmx/geohex/cell/bounds.hpp"
+#include "kmx/geohex/geo_projection.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace kmx::geohex::cap
+{
+    region::region(const item& cap) noexcept:
+        angle_ {std::min(cap.radius / (earth_radius_km * meters_per_km), std::numbers::pi_v<double>)}
+    {
+        projection::to_v3d(cap.center, center_);
+    }
+
+    position_t region::classify(const index cell, const double reach) const noexcept
+    {
+        gis::wgs84::coordinate center;
+        if (to_wgs(cell, center) != error_t::none)
+            return position_t::outside;
+
+        math::vector3d point;
+        projection::to_v3d(center, point);
+        const double distance = std::atan2(center_.cross(point).magnitude(), center_.dot(point));
+        if (distance + reach <= angle_)
+            return position_t::inside;
+        if (distance - reach > angle_)
+            return position_t::outside;
+        return position_t::boundary;
+    }
+
+    /// @brief Walks a cap down the cell hierarchy.
+    class walker
+    {
+    public:
+        walker(const item& cap, const resolution_t resolution, const bool compact) noexcept:
+            region_ {cap},
+            resolution_ {resolution},
+            compact_ {compact}
+        {
+            // at the target resolution the reach is 0: a cell is either in or out of the cap
+            cell::bounds::center_reaches(resolution, reaches_);
+        }
+
+        /// @brief Appends the cells of the cap below a cell.
+        /// @return True when all the descendants are in the cap: for a compacted cover, the cell itself was then
+        /// emitted.
+        bool descend(const index cell, std::vector<index>& out) const
+        {
+            switch (region_.classify(cell, reaches_[+cell.resolution()]))
+            {
+                case position_t::outside:
+                    return false;
+                case position_t::inside:
+                    if (compact_)
+                        out.push_back(cell);
+                    else
+                        cell::for_each_descendant(cell, resolution_, [&out](const index descendant) { out.push_back(descendant); });
+                    return true;
+                default:
+                    break;
+            }
+
+            // at the target resolution a cell is either in or out of the cap
+            const auto first = out.size();
+            bool full = true;
+            cell::for_each_child(cell, [&](const index child) { full = descend(child, out) && full; });
+
+            // a complete set of children is replaced by its parent
+            if (full && compact_)
+            {
+                out.resize(first);
+                out.push_back(cell);
+            }
+
+            return full;
+        }
+
+    private:
+        const region region_;
+        const resolution_t resolution_;
+        const bool compact_;
+        double reaches_[resolution_count] {};
+    };
+
+    static error_t cover(const item& cap, const resolution_t resolution, const bool compact, std::vector<index>& cells)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        if (!std::isfinite(cap.center.latitude) || !std::isfinite(cap.center.longitude))
+            return error_t::latlng_domain;
+
+        if (!std::isfinite(cap.radius) || (cap.radius < 0.0))
+            return error_t::domain;
+
+        const walker walk {cap, resolution, compact};
+        std::vector<index> result;
+        for (const auto& base: cell::bounds::base_cells())
+            walk.descend(base.cell, result);
+
+        cells = std::move(result);
+        return error_t::none;
+    }
+
+    error_t to_cells(const item& cap, const resolution_t resolution, std::vector<index>& cells)
+    {
+        return cover(cap, resolution, false, cells);
+    }
+
+    error_t to_compact_cells(const item& cap, const resolution_t resolution, std::vector<index>& cells)
+    {
+        return cover(cap, resolution, true, cells);
+    }
+}
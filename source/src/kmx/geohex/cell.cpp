@@ -1,4 +1,5 @@
 /// @file geohex/cell.cpp
+#include "kmx/geohex/cell.hpp"
 #include "kmx/geohex/cell/pentagon.hpp"
 #include "kmx/geohex/index.hpp"
 #include <kmx/geohex/icosahedron/face.hpp>
@@ -6,10 +7,43 @@
 
 namespace kmx::geohex::cell
 {
+    /// @brief The bits of a cell value below the base cell: its digits.
+    static constexpr unsigned digit_bits = 45u;
+
+    /// @brief The bits of a cell value below the resolution: its base cell and digits.
+    static constexpr unsigned number_bits = 52u;
+
+    /// @brief The mode bits of a cell.
+    static constexpr index::value_t cell_mode = index::value_t {1u} << 59u;
+
     children_count_t children_count(const index index, const resolution_t child_resolution) noexcept
     {
+        if (+child_resolution < +index.resolution())
+            return 0u;
+
         const auto resolution_diff = +child_resolution - +index.resolution();
         const auto result = unsafe_ipow<children_count_t>(base_children_count, resolution_diff);
-        return pentagon::check(index.base_cell()) ? basic_children_count(result) : result;
+        return index.is_pentagon() ? basic_children_count(result) : result;
+    }
+
+    index parent(index cell, const resolution_t resolution) noexcept
+    {
+        for (auto res = +resolution; res < +cell.resolution(); ++res)
+            cell.set_digit(static_cast<index::digit_index>(res), +direction_t::invalid);
+        cell.set_resolution(resolution);
+        return cell;
+    }
+
+    std::uint64_t to_number(const index cell) noexcept
+    {
+        const index::value_t value = cell;
+        return (value & ((index::value_t {1u} << number_bits) - 1u)) >> (digit_bits - 3u * +cell.resolution());
+    }
+
+    index from_number(const std::uint64_t number, const resolution_t resolution) noexcept
+    {
+        // the digits below the resolution are 7
+        const auto shift = digit_bits - 3u * +resolution;
+        return cell_mode | (index::value_t {+resolution} << number_bits) | (number << shift) | ((index::value_t {1u} << shift) - 1u);
     }
 }
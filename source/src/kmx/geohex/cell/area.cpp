@@ -8,9 +8,6 @@
 
 namespace kmx::geohex::cell::area
 {
-    constexpr double earth_radius_km = 6371.0088;
-    constexpr double meters_per_km = 1000.0;
-
     error_t km2(const index& cell, double& out) noexcept
     {
         out = 0.0;
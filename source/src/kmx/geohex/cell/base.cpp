@@ -148,55 +148,134 @@ namespace kmx::geohex::cell::base
         return direction_t::invalid;
     }
 
-    static constexpr std::array<rotations_60ccw_per_direction_array, 27u> distinct_rotation_data {{
-        {0, 5, 0, 0, 1, 5, 1},  // Index 0
-        {0, 0, 1, 0, 1, 0, 1},  // Index 1
-        {0, 0, 0, 0, 0, 5, 0},  // Index 2
-        {0, 5, 0, 0, 2, 5, 1},  // Index 3
-        {0, -1, 1, 0, 3, 4, 2}, // Index 4 (pentagon)
-        {0, 0, 0, 3, 5, 5, 0},  // Index 5
-        {0, 5, 0, 0, 0, 5, 1},  // Index 6
-        {0, 0, 1, 3, 0, 0, 1},  // Index 7
-        {0, 3, 3, 3, 0, 0, 0},  // Index 8
-        {0, 5, 0, 0, 3, 5, 1},  // Index 9
-        {0, -1, 3, 0, 5, 2, 0}, // Index 10 (pentagon)
-        {0, 5, 0, 0, 4, 5, 1},  // Index 11
-        {0, 3, 3, 3, 3, 0, 3},  // Index 12
-        {0, 3, 3, 3, 0, 3, 0},  // Index 13
-        {0, 0, 0, 3, 0, 0, 3},  // Index 14
-        {0, 3, 0, 0, 0, 3, 3},  // Index 15
-        {0, 0, 3, 0, 3, 0, 3},  // Index 16
-        {0, 3, 0, 0, 3, 3, 0},  // Index 17
-        {0, 0, 3, 0, 0, 3, 3},  // Index 18
-        {0, 3, 3, 3, 0, 0, 3},  // Index 19
-        {0, 3, 3, 3, 3, 3, 0},  // Index 20
-        {0, 0, 0, 3, 0, 5, 0},  // Index 21
-        {0, 0, 1, 3, 1, 0, 1},  // Index 22
-        {0, 0, 0, 0, 0, 0, 1},  // Index 23
-        {0, 5, 0, 0, 5, 5, 0},  // Index 24
-        {0, 0, 1, 0, 3, 5, 1},  // Index 25
-        {0, 0, 1, 0, 0, 5, 1}   // Index 26
-    }};
-
-    static constexpr std::array<std::uint8_t, 122u> rotation_index_map {{
-        0u,  1u,  2u,  3u,  4u,  1u,  5u,  2u,  6u,  7u,  // Maps rows 0-9
-        7u,  8u,  9u,  1u,  10u, 11u, 2u,  12u, 5u,  8u,  // Maps rows 10-19
-        13u, 5u,  1u,  13u, 10u, 14u, 2u,  15u, 1u,  7u,  // Maps rows 20-29
-        8u,  2u,  12u, 7u,  12u, 16u, 14u, 15u, 10u, 17u, // Maps rows 30-39
-        17u, 5u,  5u,  8u,  7u,  18u, 13u, 13u, 10u, 14u, // Maps rows 40-49
-        15u, 16u, 8u,  16u, 18u, 19u, 13u, 10u, 20u, 20u, // Maps rows 50-59
-        12u, 12u, 10u, 14u, 13u, 15u, 17u, 8u,  17u, 18u, // Maps rows 60-69
-        13u, 10u, 19u, 19u, 14u, 15u, 21u, 8u,  22u, 22u, // Maps rows 70-79
-        16u, 16u, 10u, 18u, 13u, 17u, 20u, 21u, 20u, 23u, // Maps rows 80-89
-        8u,  21u, 24u, 18u, 23u, 13u, 10u, 19u, 24u, 22u, // Maps rows 90-99
-        19u, 8u,  22u, 20u, 23u, 25u, 10u, 24u, 11u, 8u,  // Maps rows 100-109
-        21u, 21u, 3u,  23u, 22u, 24u, 4u,  26u, 23u, 24u, // Maps rows 110-119
-        0u,  26u                                          // Maps rows 120-121
+    static constexpr std::array<rotations_60ccw_per_direction_array, count> rotation_data {{
+        {0, 5, 0, 0, 1, 5, 1}, // base cell 0
+        {0, 0, 1, 0, 1, 0, 1}, // base cell 1
+        {0, 0, 0, 0, 0, 5, 0}, // base cell 2
+        {0, 5, 0, 0, 2, 5, 1}, // base cell 3
+        {0, -1, 1, 0, 3, 4, 2}, // base cell 4 (pentagon)
+        {0, 0, 1, 0, 1, 0, 1}, // base cell 5
+        {0, 0, 0, 3, 5, 5, 0}, // base cell 6
+        {0, 0, 0, 0, 0, 5, 0}, // base cell 7
+        {0, 5, 0, 0, 0, 5, 1}, // base cell 8
+        {0, 0, 1, 3, 0, 0, 1}, // base cell 9
+        {0, 0, 1, 3, 0, 0, 1}, // base cell 10
+        {0, 3, 3, 3, 0, 0, 0}, // base cell 11
+        {0, 5, 0, 0, 3, 5, 1}, // base cell 12
+        {0, 0, 1, 0, 1, 0, 1}, // base cell 13
+        {0, -1, 3, 0, 5, 2, 0}, // base cell 14 (pentagon)
+        {0, 5, 0, 0, 4, 5, 1}, // base cell 15
+        {0, 0, 0, 0, 0, 5, 0}, // base cell 16
+        {0, 3, 3, 3, 3, 0, 3}, // base cell 17
+        {0, 0, 0, 3, 5, 5, 0}, // base cell 18
+        {0, 3, 3, 3, 0, 0, 0}, // base cell 19
+        {0, 3, 3, 3, 0, 3, 0}, // base cell 20
+        {0, 0, 0, 3, 5, 5, 0}, // base cell 21
+        {0, 0, 1, 0, 1, 0, 1}, // base cell 22
+        {0, 3, 3, 3, 0, 3, 0}, // base cell 23
+        {0, -1, 3, 0, 5, 2, 0}, // base cell 24 (pentagon)
+        {0, 0, 0, 3, 0, 0, 3}, // base cell 25
+        {0, 0, 0, 0, 0, 5, 0}, // base cell 26
+        {0, 3, 0, 0, 0, 3, 3}, // base cell 27
+        {0, 0, 1, 0, 1, 0, 1}, // base cell 28
+        {0, 0, 1, 3, 0, 0, 1}, // base cell 29
+        {0, 3, 3, 3, 0, 0, 0}, // base cell 30
+        {0, 0, 0, 0, 0, 5, 0}, // base cell 31
+        {0, 3, 3, 3, 3, 0, 3}, // base cell 32
+        {0, 0, 1, 3, 0, 0, 1}, // base cell 33
+        {0, 3, 3, 3, 3, 0, 3}, // base cell 34
+        {0, 0, 3, 0, 3, 0, 3}, // base cell 35
+        {0, 0, 0, 3, 0, 0, 3}, // base cell 36
+        {0, 3, 0, 0, 0, 3, 3}, // base cell 37
+        {0, -1, 3, 0, 5, 2, 0}, // base cell 38 (pentagon)
+        {0, 3, 0, 0, 3, 3, 0}, // base cell 39
+        {0, 3, 0, 0, 3, 3, 0}, // base cell 40
+        {0, 0, 0, 3, 5, 5, 0}, // base cell 41
+        {0, 0, 0, 3, 5, 5, 0}, // base cell 42
+        {0, 3, 3, 3, 0, 0, 0}, // base cell 43
+        {0, 0, 1, 3, 0, 0, 1}, // base cell 44
+        {0, 0, 3, 0, 0, 3, 3}, // base cell 45
+        {0, 0, 0, 3, 0, 3, 0}, // base cell 46
+        {0, 3, 3, 3, 0, 3, 0}, // base cell 47
+        {0, 3, 3, 3, 0, 3, 0}, // base cell 48
+        {0, -1, 3, 0, 5, 2, 0}, // base cell 49 (pentagon)
+        {0, 0, 0, 3, 0, 0, 3}, // base cell 50
+        {0, 3, 0, 0, 0, 3, 3}, // base cell 51
+        {0, 0, 3, 0, 3, 0, 3}, // base cell 52
+        {0, 3, 3, 3, 0, 0, 0}, // base cell 53
+        {0, 0, 3, 0, 3, 0, 3}, // base cell 54
+        {0, 0, 3, 0, 0, 3, 3}, // base cell 55
+        {0, 3, 3, 3, 0, 0, 3}, // base cell 56
+        {0, 0, 0, 3, 0, 3, 0}, // base cell 57
+        {0, -1, 3, 0, 5, 2, 0}, // base cell 58 (pentagon)
+        {0, 3, 3, 3, 3, 3, 0}, // base cell 59
+        {0, 3, 3, 3, 3, 3, 0}, // base cell 60
+        {0, 3, 3, 3, 3, 0, 3}, // base cell 61
+        {0, 3, 3, 3, 3, 0, 3}, // base cell 62
+        {0, -1, 3, 0, 5, 2, 0}, // base cell 63 (pentagon)
+        {0, 0, 0, 3, 0, 0, 3}, // base cell 64
+        {0, 3, 3, 3, 0, 3, 0}, // base cell 65
+        {0, 3, 0, 0, 0, 3, 3}, // base cell 66
+        {0, 3, 0, 0, 3, 3, 0}, // base cell 67
+        {0, 3, 3, 3, 0, 0, 0}, // base cell 68
+        {0, 3, 0, 0, 3, 3, 0}, // base cell 69
+        {0, 0, 3, 0, 0, 3, 3}, // base cell 70
+        {0, 0, 0, 3, 0, 3, 0}, // base cell 71
+        {0, -1, 3, 0, 5, 2, 0}, // base cell 72 (pentagon)
+        {0, 3, 3, 3, 0, 0, 3}, // base cell 73
+        {0, 3, 3, 3, 0, 0, 3}, // base cell 74
+        {0, 0, 0, 3, 0, 0, 3}, // base cell 75
+        {0, 3, 0, 0, 0, 3, 3}, // base cell 76
+        {0, 0, 0, 3, 0, 5, 0}, // base cell 77
+        {0, 3, 3, 3, 0, 0, 0}, // base cell 78
+        {0, 0, 1, 3, 1, 0, 1}, // base cell 79
+        {0, 0, 1, 3, 1, 0, 1}, // base cell 80
+        {0, 0, 3, 0, 3, 0, 3}, // base cell 81
+        {0, 0, 3, 0, 3, 0, 3}, // base cell 82
+        {0, -1, 3, 0, 5, 2, 0}, // base cell 83 (pentagon)
+        {0, 0, 3, 0, 0, 3, 3}, // base cell 84
+        {0, 0, 0, 3, 0, 3, 0}, // base cell 85
+        {0, 3, 0, 0, 3, 3, 0}, // base cell 86
+        {0, 3, 3, 3, 3, 3, 0}, // base cell 87
+        {0, 0, 0, 3, 0, 5, 0}, // base cell 88
+        {0, 3, 3, 3, 3, 3, 0}, // base cell 89
+        {0, 0, 0, 0, 0, 0, 1}, // base cell 90
+        {0, 3, 3, 3, 0, 0, 0}, // base cell 91
+        {0, 5, 0, 3, 0, 5, 0}, // base cell 92
+        {0, 5, 0, 0, 5, 5, 0}, // base cell 93
+        {0, 0, 3, 0, 0, 3, 3}, // base cell 94
+        {0, 0, 0, 0, 0, 0, 1}, // base cell 95
+        {0, 0, 0, 3, 0, 3, 0}, // base cell 96
+        {0, -1, 3, 0, 5, 2, 0}, // base cell 97 (pentagon)
+        {0, 3, 3, 3, 0, 0, 3}, // base cell 98
+        {0, 5, 0, 0, 5, 5, 0}, // base cell 99
+        {0, 0, 1, 3, 1, 0, 1}, // base cell 100
+        {0, 3, 3, 3, 0, 0, 3}, // base cell 101
+        {0, 3, 3, 3, 0, 0, 0}, // base cell 102
+        {0, 0, 1, 3, 1, 0, 1}, // base cell 103
+        {0, 3, 3, 3, 3, 3, 0}, // base cell 104
+        {0, 0, 0, 0, 0, 0, 1}, // base cell 105
+        {0, 0, 1, 0, 3, 5, 1}, // base cell 106
+        {0, -1, 3, 0, 5, 2, 0}, // base cell 107 (pentagon)
+        {0, 5, 0, 0, 5, 5, 0}, // base cell 108
+        {0, 0, 1, 0, 4, 5, 1}, // base cell 109
+        {0, 3, 3, 3, 0, 0, 0}, // base cell 110
+        {0, 0, 0, 3, 0, 5, 0}, // base cell 111
+        {0, 5, 0, 3, 0, 5, 0}, // base cell 112
+        {0, 0, 1, 0, 2, 5, 1}, // base cell 113
+        {0, 0, 0, 0, 0, 0, 1}, // base cell 114
+        {0, 0, 1, 3, 1, 0, 1}, // base cell 115
+        {0, 5, 0, 0, 5, 5, 0}, // base cell 116
+        {0, -1, 1, 0, 3, 4, 2}, // base cell 117 (pentagon)
+        {0, 0, 1, 0, 0, 5, 1}, // base cell 118
+        {0, 0, 0, 0, 0, 0, 1}, // base cell 119
+        {0, 5, 0, 0, 5, 5, 0}, // base cell 120
+        {0, 0, 1, 0, 1, 5, 1},  // base cell 121
     }};
 
     const rotations_60ccw_per_direction_array& rotations_60ccw(const id_t base_cell_id) noexcept
     {
-        return distinct_rotation_data[rotation_index_map[base_cell_id]];
+        return rotation_data[base_cell_id];
     }
 
 }
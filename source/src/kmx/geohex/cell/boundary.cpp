@@ -1,115 +1,194 @@
 /// @file geohex/cell/boundary.cpp
 #include "kmx/geohex/cell/boundary.hpp"
+#include "kmx/geohex/geo_projection.hpp"
 #include "kmx/geohex/icosahedron/face.hpp"
 #include <array>
+#include <cfloat>
 #include <cmath>
 
 namespace kmx::geohex::cell::boundary
 {
-    /// @brief Defines the sequence of neighbor directions to traverse to find cell vertices.
-    /// @details H3 uses a different vertex ordering for Class II (even) and Class III (odd)
-    /// resolutions to maintain grid continuity. This table provides the correct sequence
-    /// of single-step `ijk` direction vectors for both cases.
-    ///
-    /// The vertex directions are ordered to produce a clockwise polygon boundary.
-    /// @ref H3 C library constant `VERTEX_DIRECTIONS`.
-    static constexpr std::array<std::array<pseudo_ijk, direction_count - 1u>, 2u> vertex_directions = {
-        {// Class II (even resolutions) vertex sequence.
-         // Directions: J, IJ, I, IK, K, JK
-         {{{0, 1, -1}, {1, 1, -2}, {1, 0, -1}, {2, -1, -1}, {1, -1, 0}, {1, -2, 1}}},
-         // Class III (odd resolutions) vertex sequence.
-         // Directions: JK, J, IJ, I, IK, K
-         {{{1, -2, 1}, {0, 1, -1}, {1, 1, -2}, {1, 0, -1}, {2, -1, -1}, {1, -1, 0}}}}};
-
-    /// @brief Calculates the geographic boundary vertices for a cell given its center FaceIJK.
-    /// @details This is the core logic for `cellToBoundary` operations. It determines the
-    /// correct vertex sequence based on the cell's resolution class and pentagon status,
-    /// then converts the FaceIJK of each vertex into a geographic coordinate.
-    ///
-    /// The resulting vertices form a clockwise polygon.
-    ///
-    /// @ref _faceIjkToCellBoundary and _faceIjkPentToCellBoundary (H3 C internal)
-    ///
-    /// @param center_fijk The FaceIJK of the cell's center.
-    /// @param cell_index The H3 index of the cell (needed for resolution and pentagon status).
-    /// @param[out] out_vertices A span that will be filled with the boundary vertices.
-    ///                        Its size will be adjusted to the number of vertices written.
-    /// @return error_t::none on success, or an error code if the output span is too small.
-    error_t get_vertices(const icosahedron::face::ijk& center_fijk, const index cell_index,
-                         std::span<gis::wgs84::coordinate>& out_vertices) noexcept
+    /// @ref _v2dIntersect
+    static math::vector2d intersect(const math::vector2d& p0, const math::vector2d& p1, const math::vector2d& p2,
+                                    const math::vector2d& p3) noexcept
     {
-        const resolution_t res = cell_index.resolution();
-        const bool is_pentagon = cell_index.is_pentagon();
-        const auto num_vertices = is_pentagon ? 5u : 6u;
+        const auto s1 = p1 - p0;
+        const auto s2 = p3 - p2;
+        const double t = (s2.x * (p0.y - p2.y) - s2.y * (p0.x - p2.x)) / (-s2.x * s1.y + s1.x * s2.y);
+        return {p0.x + t * s1.x, p0.y + t * s1.y};
+    }
 
-        // Ensure the output span is large enough to hold the result.
-        if (out_vertices.size() < num_vertices)
-            return error_t::memory_bounds;
+    /// @ref _v2dAlmostEquals
+    static bool almost_equals(const math::vector2d& v1, const math::vector2d& v2) noexcept
+    {
+        return (std::abs(static_cast<float>(v1.x - v2.x)) < FLT_EPSILON) && (std::abs(static_cast<float>(v1.y - v2.y)) < FLT_EPSILON);
+    }
 
-        // Select the correct vertex direction sequence based on resolution class.
-        // The index `is_class_3(res)` will evaluate to 0 (false) or 1 (true).
-        const auto& directions = vertex_directions[is_class_3(res)];
+    /// @brief Gets the crossing of a cell edge with the edge of the face shared with another face.
+    /// @param face The face of the frame of `p0` and `p1`.
+    /// @param other The adjacent face.
+    static math::vector2d face_edge_intersection(const math::vector2d& p0, const math::vector2d& p1, const icosahedron::face::id_t face,
+                                                 const icosahedron::face::id_t other, const std::uint8_t class_2_res) noexcept
+    {
+        // the icosahedron face vertices in the substrate grid
+        const double max_dim = icosahedron::face::max_dimension(class_2_res);
+        const math::vector2d v0 {3.0 * max_dim, 0.0};
+        const math::vector2d v1 {-1.5 * max_dim, 3.0 * sqrt3_2 * max_dim};
+        const math::vector2d v2 {-1.5 * max_dim, -3.0 * sqrt3_2 * max_dim};
 
-        // This variable tracks how many vertices we have successfully generated.
-        std::size_t vertices_written {};
+        switch (icosahedron::face::adjacent_quadrant(face, other).value_or(icosahedron::face::quadrant_t::ki))
+        {
+            case icosahedron::face::quadrant_t::ij:
+                return intersect(p0, p1, v0, v1);
+            case icosahedron::face::quadrant_t::jk:
+                return intersect(p0, p1, v1, v2);
+            default:
+                return intersect(p0, p1, v2, v0);
+        }
+    }
+
+    /// @ref _faceIjkToCellBoundary
+    static error_t get_hexagon_vertices(const icosahedron::face::ijk& center_fijk, const resolution_t res, const std::uint8_t start,
+                                        const std::uint8_t length, std::span<gis::wgs84::coordinate>& out) noexcept
+    {
+        constexpr std::uint8_t vertex_count = 6u;
+        std::array<icosahedron::face::ijk, vertex_count> vertices;
+        const auto class_2_res = icosahedron::face::to_vertices(center_fijk, res, vertices);
+
+        // one more iteration for the entire loop, in case of a distortion vertex on the last edge
+        const std::uint8_t additional_iteration = length == vertex_count ? 1u : 0u;
 
-        for (std::size_t i {}; i < num_vertices; ++i)
+        std::size_t written {};
+        auto last_face = center_fijk.face;
+        auto last_overage = icosahedron::face::overage_t::none;
+        for (std::uint8_t vert = start; vert != start + length + additional_iteration; ++vert)
         {
-            // 1. Determine the vertex's FaceIJK coordinates.
-            //    Start with the cell center and add the direction vector to the next vertex.
-            icosahedron::face::ijk vertex_fijk = center_fijk;
-            vertex_fijk.ijk_coords += directions[i];
-
-            // 2. For pentagons, the grid is distorted. When moving from a pentagon
-            //    center to a vertex, a counter-clockwise rotation is applied to account
-            //    for the "missing" wedge of the grid.
-            if (is_pentagon)
-                vertex_fijk.ijk_coords.rotate_60ccw();
-
-            // 3. Normalize the vertex coordinates. This is especially important around
-            //    pentagons where the addition and rotation may create non-canonical IJK values.
-            vertex_fijk.ijk_coords.normalize();
-
-            // 4. Convert the vertex's FaceIJK to a geographic coordinate.
-            //    This is the most complex step, involving projection from the icosahedron face
-            //    to the sphere. We delegate this to a dedicated function.
-            //
-            //    NOTE: The `to_wgs` function must correctly handle cases where a vertex
-            //    crosses an icosahedron face boundary (overage), which is critical around
-            //    pentagons. This implementation assumes `to_wgs` is robust.
-            if (icosahedron::face::to_wgs(vertex_fijk, res, out_vertices[vertices_written]) == error_t::none)
-                vertices_written++;
-            else
+            const auto v = vert % vertex_count;
+            auto fijk = vertices[v];
+            const auto overage = icosahedron::face::adjust_overage(fijk, class_2_res, false, true);
+
+            // A Class III cell edge crossing an icosahedron edge gets an additional vertex at the crossing, so each part of
+            // the edge is projected with its face. Class II cell edges have their vertices on the face edges.
+            if (is_class_3(res) && (vert > start) && (fijk.face != last_face) && (last_overage != icosahedron::face::overage_t::face_edge))
             {
-                // If any vertex calculation fails, we cannot produce a valid boundary.
-                // Clear the output and return an error.
-                out_vertices = {};
-                return error_t::failed;
+                const auto last_v = (v + vertex_count - 1u) % vertex_count;
+                const auto p0 = coordinate::to_vec2<double>(vertices[last_v].ijk_coords);
+                const auto p1 = coordinate::to_vec2<double>(vertices[v].ijk_coords);
+                const auto other_face = last_face == center_fijk.face ? fijk.face : last_face;
+                const auto crossing = face_edge_intersection(p0, p1, center_fijk.face, other_face, class_2_res);
+
+                // a crossing at a cell vertex needs no additional vertex
+                if (!almost_equals(p0, crossing) && !almost_equals(p1, crossing))
+                {
+                    if (written == out.size())
+                        return error_t::memory_bounds;
+
+                    projection::from_hex2d(crossing, center_fijk.face, class_2_res, true, out[written++]);
+                }
+            }
+
+            // the last iteration only tests for a crossing on the last edge
+            if (vert < start + vertex_count)
+            {
+                if (written == out.size())
+                    return error_t::memory_bounds;
+
+                projection::from_hex2d(coordinate::to_vec2<double>(fijk.ijk_coords), fijk.face, class_2_res, true, out[written++]);
             }
+
+            last_face = fijk.face;
+            last_overage = overage;
         }
 
-        // Adjust the output span's size to match the number of vertices actually written.
-        // This is a crucial step for the caller to know the correct boundary size.
-        out_vertices = out_vertices.subspan(0, vertices_written);
+        out = out.first(written);
+        return error_t::none;
+    }
+
+    /// @ref _faceIjkPentToCellBoundary
+    static error_t get_pentagon_vertices(const icosahedron::face::ijk& center_fijk, const resolution_t res, const std::uint8_t start,
+                                         const std::uint8_t length, std::span<gis::wgs84::coordinate>& out) noexcept
+    {
+        constexpr std::uint8_t vertex_count = 5u;
+        std::array<icosahedron::face::ijk, 6u> vertices;
+        const auto class_2_res = icosahedron::face::to_vertices(center_fijk, res, vertices);
+
+        // one more iteration for the entire loop, in case of a distortion vertex on the last edge
+        const std::uint8_t additional_iteration = length == vertex_count ? 1u : 0u;
 
+        std::size_t written {};
+        icosahedron::face::ijk last_fijk;
+        for (std::uint8_t vert = start; vert != start + length + additional_iteration; ++vert)
+        {
+            const auto v = vert % vertex_count;
+            auto fijk = vertices[v];
+            icosahedron::face::adjust_pentagon_vertex_overage(fijk, class_2_res);
+
+            // all Class III pentagon edges cross icosahedron edges
+            if (is_class_3(res) && (vert > start))
+            {
+                // the last vertex, in the frame of the current face
+                const auto p0 = coordinate::to_vec2<double>(last_fijk.ijk_coords);
+                const auto quadrant = icosahedron::face::adjacent_quadrant(fijk.face, last_fijk.face);
+                const auto& orientation = icosahedron::face::neighbor(fijk.face, quadrant.value_or(icosahedron::face::quadrant_t::center));
+
+                auto current = fijk.ijk_coords;
+                for (std::int8_t i {}; i != orientation.ccw_rotations_60; ++i)
+                    current.rotate_60ccw();
+
+                current += orientation.ijk_coords * (icosahedron::face::unit_scale(class_2_res) * 3);
+                current.normalize();
+
+                const auto p1 = coordinate::to_vec2<double>(current);
+                const auto crossing = face_edge_intersection(p0, p1, orientation.face, fijk.face, class_2_res);
+
+                if (written == out.size())
+                    return error_t::memory_bounds;
+
+                projection::from_hex2d(crossing, orientation.face, class_2_res, true, out[written++]);
+            }
+
+            // the last iteration only tests for a crossing on the last edge
+            if (vert < start + vertex_count)
+            {
+                if (written == out.size())
+                    return error_t::memory_bounds;
+
+                projection::from_hex2d(coordinate::to_vec2<double>(fijk.ijk_coords), fijk.face, class_2_res, true, out[written++]);
+            }
+
+            last_fijk = fijk;
+        }
+
+        out = out.first(written);
         return error_t::none;
     }
 
-    // This is the public-facing function from the header.
-    // It remains the same, acting as a high-level wrapper.
+    error_t get_vertices(const icosahedron::face::ijk& center_fijk, const index cell_index,
+                         std::span<gis::wgs84::coordinate>& out_vertices) noexcept
+    {
+        return get_vertices(center_fijk, cell_index, 0u, cell_index.is_pentagon() ? 5u : 6u, out_vertices);
+    }
+
+    error_t get_vertices(const icosahedron::face::ijk& center_fijk, const index cell_index, const std::uint8_t start,
+                         const std::uint8_t length, std::span<gis::wgs84::coordinate>& out_vertices) noexcept
+    {
+        const auto res = cell_index.resolution();
+        if (cell_index.is_pentagon())
+            return length > 5u ? error_t::domain : get_pentagon_vertices(center_fijk, res, start, length, out_vertices);
+
+        return length > 6u ? error_t::domain : get_hexagon_vertices(center_fijk, res, start, length, out_vertices);
+    }
+
     error_t get(const index index, std::span<gis::wgs84::coordinate>& out) noexcept
     {
-        // 1. Validate the H3 cell index.
         if (!index.is_valid())
             return error_t::cell_invalid;
 
-        // 2. Convert H3 cell index to its center FaceIJK representation.
         icosahedron::face::ijk cell_center_fijk;
         const auto fijk_err = icosahedron::face::from_index(index, cell_center_fijk);
         if (fijk_err != error_t::none)
             return fijk_err;
 
-        // 3. Get the boundary vertices using the core logic.
         return get_vertices(cell_center_fijk, index, out);
     }
 }
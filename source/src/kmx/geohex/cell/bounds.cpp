@@ -0,0 +1,276 @@
+/// @file geohex/cell/bounds.cpp
+#include "kmx/geohex/cell/bounds.hpp"
+#include "kmx/geohex/cell/boundary.hpp"
+#include "kmx/geohex/geo_projection.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
+namespace kmx::geohex::cell::bounds
+{
+    /// @brief The largest distance from a cell center to its boundary, times the square root of 7 to the power of the
+    /// resolution, measured over every cell of resolutions 0 to 6 and rounded up.
+    static constexpr std::array<double, 7u> scaled_radii {
+        0.217054045, 0.220019590, 0.220455265, 0.220517758, 0.220526691, 0.220527967, 0.220528150,
+    };
+
+    /// @brief Bound of the scaled radii of the finer resolutions: they grow 7 times less from a resolution to the next.
+    static constexpr double scaled_radius_limit = 0.2205282;
+
+    /// @brief Distance to a pole (in radians) below which a cell center is near it.
+    static constexpr double polar_band = 1e-4;
+
+    static constexpr double half_pi = std::numbers::pi_v<double> / 2.0;
+
+    /// @brief The base cell 0, at resolution 0.
+    static constexpr index::value_t base_cell_0 = 0x8001fffffffffffu;
+
+    /// @brief The radii of every resolution.
+    static const std::array<double, resolution_count> radii = []
+    {
+        std::array<double, resolution_count> result {};
+        for (std::size_t res {}; res != resolution_count; ++res)
+            result[res] = (res < scaled_radii.size() ? scaled_radii[res] : scaled_radius_limit) / std::pow(std::sqrt(7.0), res);
+        return result;
+    }();
+
+    /// @brief Gets the cap radius of a cell from its center.
+    static double radius(const index cell, const gis::wgs84::coordinate& center) noexcept
+    {
+        const double result = radii[+cell.resolution()];
+        return half_pi - std::fabs(center.latitude) < polar_band ? result + radius_margin : result;
+    }
+
+    /// @brief Brings a longitude difference into [-pi, pi].
+    static double wrap(const double longitude) noexcept
+    {
+        return std::remainder(longitude, 2.0 * std::numbers::pi_v<double>);
+    }
+
+    /// @brief Sets the longitudes of a box from offsets around a center longitude.
+    static void set_longitudes(const double center, const double west_offset, const double east_offset, box& out) noexcept
+    {
+        if (east_offset - west_offset >= 2.0 * std::numbers::pi_v<double>)
+        {
+            out.west = -std::numbers::pi_v<double>;
+            out.east = std::numbers::pi_v<double>;
+            return;
+        }
+
+        out.west = wrap(center + west_offset);
+        out.east = wrap(center + east_offset);
+    }
+
+    /// @brief Extends the latitudes of a box to the highest and lowest points of a great circle arc between two unit
+    /// vectors, where they are not at its ends.
+    static void extend_latitudes(const math::vector3d& a, const math::vector3d& b, box& out) noexcept
+    {
+        const auto normal = a.cross(b);
+        const auto horizontal = normal.magnitude();
+        if (horizontal <= 0.0)
+            return;
+
+        // the highest point of the great circle, along the projection of the axis of the poles on its plane
+        const auto unit_normal = normal * (1.0 / horizontal);
+        const math::vector3d top = (math::vector3d {0.0, 0.0, 1.0} - unit_normal * unit_normal.z).normalized();
+        if ((top.x == 0.0) && (top.y == 0.0) && (top.z == 0.0))
+            return;
+
+        // the highest point is on the arc when it is between its ends, the lowest one when its opposite is
+        const auto between = [&](const math::vector3d& point)
+        { return (a.cross(point).dot(normal) >= 0.0) && (point.cross(b).dot(normal) >= 0.0); };
+        const double latitude = std::atan2(top.z, std::hypot(top.x, top.y));
+        if (between(top))
+            out.north = std::max(out.north, latitude);
+        if (between(top * -1.0))
+            out.south = std::min(out.south, -latitude);
+    }
+
+    /// @brief Checks whether a cell holds a pole.
+    static bool holds_pole(const index cell, const double latitude) noexcept
+    {
+        index pole_cell;
+        return (from_wgs({latitude, 0.0}, cell.resolution(), pole_cell) == error_t::none) && (pole_cell == cell);
+    }
+
+    bool cap::contains(const math::vector3d& point) const noexcept
+    {
+        return std::atan2(center.cross(point).magnitude(), center.dot(point)) <= radius;
+    }
+
+    bool box::contains(const gis::wgs84::coordinate& coord) const noexcept
+    {
+        if ((coord.latitude < south) || (coord.latitude > north))
+            return false;
+
+        return is_transmeridian() ? (coord.longitude >= west) || (coord.longitude <= east)
+                                  : (coord.longitude >= west) && (coord.longitude <= east);
+    }
+
+    double max_radius(const resolution_t resolution) noexcept
+    {
+        return +resolution < resolution_count ? radii[+resolution] : 0.0;
+    }
+
+    const std::array<base_center, base::count>& base_cells() noexcept
+    {
+        static const auto result = []
+        {
+            std::array<base_center, base::count> cells;
+            for (base::id_t i {}; i != base::count; ++i)
+            {
+                cells[i].cell = base_cell_0;
+                cells[i].cell.set_base_cell(i);
+                to_wgs(cells[i].cell, cells[i].center);
+            }
+            return cells;
+        }();
+        return result;
+    }
+
+    void center_reaches(const resolution_t resolution, const std::span<double, resolution_count> out) noexcept
+    {
+        // the child distances of each resolution up from the resolution
+        out[+resolution] = 0.0;
+        for (auto res = +resolution; res != 0u; --res)
+            out[res - 1u] = out[res] + max_child_distance / std::pow(std::sqrt(7.0), res);
+    }
+
+    void reaches(const resolution_t resolution, const std::span<double, resolution_count> out) noexcept
+    {
+        // the descendant centers, then the radius around them
+        center_reaches(resolution, out);
+        const double radius = max_radius(resolution) + radius_margin;
+        for (auto res = 0u; res <= +resolution; ++res)
+            out[res] += radius;
+    }
+
+    error_t get(const index cell, cap& out) noexcept
+    {
+        gis::wgs84::coordinate center;
+        const auto err = to_wgs(cell, center);
+        if (err != error_t::none)
+            return err;
+
+        projection::to_v3d(center, out.center);
+        out.radius = radius(cell, center);
+        return error_t::none;
+    }
+
+    /// @brief Gets the box of a cell from its center and boundary.
+    static error_t get(const index cell, const gis::wgs84::coordinate& center, box& out) noexcept
+    {
+        std::array<gis::wgs84::coordinate, boundary::max_vertices> vertices;
+        std::span<gis::wgs84::coordinate> boundary {vertices};
+        const auto err = boundary::get(cell, boundary);
+        if (err != error_t::none)
+            return err;
+
+        // a cell holding a pole spans all the longitudes; it cannot hold one unless its cap does
+        const double cap_radius = radius(cell, center);
+        const bool north_pole = (center.latitude + cap_radius >= half_pi) && holds_pole(cell, half_pi);
+        const bool south_pole = (center.latitude - cap_radius <= -half_pi) && holds_pole(cell, -half_pi);
+
+        // elsewhere the longitude is monotonic along each edge: its extremes are at vertices
+        out.south = out.north = center.latitude;
+        double west_offset {}, east_offset {};
+        std::array<math::vector3d, boundary::max_vertices> points;
+        for (std::size_t i {}; i != boundary.size(); ++i)
+        {
+            out.south = std::min(out.south, boundary[i].latitude);
+            out.north = std::max(out.north, boundary[i].latitude);
+            const double offset = wrap(boundary[i].longitude - center.longitude);
+            west_offset = std::min(west_offset, offset);
+            east_offset = std::max(east_offset, offset);
+            projection::to_v3d(boundary[i], points[i]);
+        }
+
+        for (std::size_t i {}; i != boundary.size(); ++i)
+            extend_latitudes(points[i], points[(i + 1u) % boundary.size()], out);
+
+        if (north_pole || south_pole)
+        {
+            if (north_pole)
+                out.north = half_pi;
+            if (south_pole)
+                out.south = -half_pi;
+            west_offset = -std::numbers::pi_v<double>;
+            east_offset = std::numbers::pi_v<double>;
+        }
+
+        set_longitudes(center.longitude, west_offset, east_offset, out);
+        return error_t::none;
+    }
+
+    error_t get(const index cell, box& out) noexcept
+    {
+        gis::wgs84::coordinate center;
+        const auto err = to_wgs(cell, center);
+        if (err != error_t::none)
+            return err;
+
+        return get(cell, center, out);
+    }
+
+    box to_box(const gis::wgs84::coordinate& center, const double radius) noexcept
+    {
+        box result;
+        result.south = std::max(center.latitude - radius, -half_pi);
+        result.north = std::min(center.latitude + radius, half_pi);
+
+        // the meridians tangent to the cap, unless it holds a pole
+        const double sin_offset = std::sin(radius) / std::cos(center.latitude);
+        const double offset = (result.north < half_pi) && (result.south > -half_pi) && (sin_offset < 1.0)
+                                  ? std::asin(sin_offset)
+                                  : std::numbers::pi_v<double>;
+        set_longitudes(center.longitude, -offset, offset, result);
+        return result;
+    }
+
+    box to_box(const cap& cap) noexcept
+    {
+        gis::wgs84::coordinate center;
+        projection::from_v3d(cap.center, center);
+        return to_box(center, cap.radius);
+    }
+
+    error_t get(std::span<const index> cells, std::span<cap> caps) noexcept
+    {
+        if (caps.size() < cells.size())
+            return error_t::memory_bounds;
+
+        for (std::size_t i {}; i != cells.size(); ++i)
+        {
+            const auto err = get(cells[i], caps[i]);
+            if (err != error_t::none)
+                return err;
+        }
+
+        return error_t::none;
+    }
+
+    error_t get(std::span<const index> cells, std::span<box> boxes, const fit_t fit) noexcept
+    {
+        if (boxes.size() < cells.size())
+            return error_t::memory_bounds;
+
+        for (std::size_t i {}; i != cells.size(); ++i)
+        {
+            gis::wgs84::coordinate center;
+            auto err = to_wgs(cells[i], center);
+            if (err != error_t::none)
+                return err;
+
+            if (fit == fit_t::tight)
+                err = get(cells[i], center, boxes[i]);
+            else
+                boxes[i] = to_box(center, radius(cells[i], center));
+
+            if (err != error_t::none)
+                return err;
+        }
+
+        return error_t::none;
+    }
+}
@@ -0,0 +1,266 @@
+/// @file geohex/codec.cpp
+#include "kmx/geohex/codec.hpp"
+#include "kmx/geohex/cell.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+namespace kmx::geohex::codec
+{
+    /// @brief Tells an encoded set ("GHXC" read as a little endian value).
+    static constexpr std::uint32_t magic = 0x43584847u;
+
+    /// @brief The version of the layout.
+    static constexpr std::uint8_t version = 1u;
+
+    /// @brief Bytes of the header.
+    static constexpr std::size_t header_size = 16u;
+
+    /// @brief Bytes of an entry of the skip table.
+    static constexpr std::size_t skip_size = 16u;
+
+    /// @brief Lanes of packed words per block.
+    static constexpr std::size_t lane_count = 4u;
+
+    /// @brief Gets the packed words of each lane of a block whose gaps have a width.
+    static constexpr std::size_t words_per_lane(const unsigned width) noexcept
+    {
+        return (block_size / lane_count * width + 63u) / 64u;
+    }
+
+    /// @brief Reads a little endian value.
+    template <typename T>
+    static T load(const std::byte* data) noexcept
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        if constexpr (std::endian::native == std::endian::big)
+            value = std::byteswap(value);
+        return value;
+    }
+
+    /// @brief Appends a little endian value.
+    template <typename T>
+    static void store(std::vector<std::byte>& data, T value)
+    {
+        if constexpr (std::endian::native == std::endian::big)
+            value = std::byteswap(value);
+        const auto size = data.size();
+        data.resize(size + sizeof(T));
+        std::memcpy(data.data() + size, &value, sizeof(T));
+    }
+
+    error_t encode(const std::span<const index> cells, std::vector<std::byte>& data)
+    {
+        const auto resolution = cells.empty() ? 0u : +cells.front().resolution();
+        for (std::size_t i {}; i != cells.size(); ++i)
+        {
+            if (!cells[i].is_valid())
+                return error_t::cell_invalid;
+            if (+cells[i].resolution() != resolution)
+                return error_t::res_mismatch;
+            if ((i != 0u) && (cells[i] <= cells[i - 1u]))
+                return error_t::domain;
+        }
+
+        // the skip table and the packed words of each block
+        std::vector<std::byte> skips;
+        std::vector<std::uint64_t> words;
+        std::array<std::uint64_t, block_size> gaps;
+        for (std::size_t first {}; first < cells.size(); first += block_size)
+        {
+            const auto count = std::min(block_size, cells.size() - first);
+            std::uint64_t previous = cell::to_number(cells[first]);
+            gaps.fill(0u);
+            std::uint64_t all_gaps {};
+            for (std::size_t i = 1u; i != count; ++i)
+            {
+                const auto key = cell::to_number(cells[first + i]);
+                gaps[i] = key - previous - 1u;
+                all_gaps |= gaps[i];
+                previous = key;
+            }
+
+            const auto width = static_cast<unsigned>(std::bit_width(all_gaps));
+            if (words.size() > std::numeric_limits<std::uint32_t>::max())
+                return error_t::domain;
+
+            store<std::uint64_t>(skips, cell::to_number(cells[first]));
+            store<std::uint32_t>(skips, static_cast<std::uint32_t>(words.size()));
+            store<std::uint32_t>(skips, width);
+
+            // a block of consecutive numbers has no words
+            if (width == 0u)
+                continue;
+
+            const auto offset = words.size();
+            words.resize(offset + lane_count * words_per_lane(width));
+            auto* const lanes = words.data() + offset;
+            for (std::size_t i {}; i != block_size; ++i)
+            {
+                const auto bit = i / lane_count * width;
+                const auto word = bit / 64u;
+                const auto shift = bit % 64u;
+                const auto lane = i % lane_count;
+                lanes[lane_count * word + lane] |= gaps[i] << shift;
+                if (shift + width > 64u)
+                    lanes[lane_count * (word + 1u) + lane] |= gaps[i] >> (64u - shift);
+            }
+        }
+
+        store<std::uint32_t>(data, magic);
+        store<std::uint32_t>(data, version | (resolution << 8u));
+        store<std::uint64_t>(data, cells.size());
+        data.insert(data.end(), skips.begin(), skips.end());
+        for (const auto word: words)
+            store<std::uint64_t>(data, word);
+
+        return error_t::none;
+    }
+
+    error_t view::open(const std::span<const std::byte> data) noexcept
+    {
+        if ((data.size() < header_size) || (load<std::uint32_t>(data.data()) != magic))
+            return error_t::domain;
+
+        const auto format = load<std::uint32_t>(data.data() + 4u);
+        const auto count = load<std::uint64_t>(data.data() + 8u);
+        const auto resolution = (format >> 8u) & 0xFFu;
+        if (((format & 0xFFu) != version) || ((format >> 16u) != 0u) || (resolution >= resolution_count))
+            return error_t::domain;
+
+        // each block has its words right after those of the block before
+        const auto rest = data.subspan(header_size);
+        const auto blocks = count / block_size + (count % block_size != 0u);
+        if (blocks > rest.size() / skip_size)
+            return error_t::domain;
+
+        std::uint64_t total {};
+        for (std::size_t block {}; block != blocks; ++block)
+        {
+            const auto* const skip = rest.data() + block * skip_size;
+            const auto width = load<std::uint32_t>(skip + 12u);
+            if ((load<std::uint32_t>(skip + 8u) != total) || (width > 64u))
+                return error_t::domain;
+            total += lane_count * words_per_lane(width);
+        }
+
+        const auto skips = rest.first(blocks * skip_size);
+        if (total > (rest.size() - skips.size()) / sizeof(std::uint64_t))
+            return error_t::domain;
+
+        count_ = count;
+        resolution_ = static_cast<resolution_t>(resolution);
+        skips_ = skips;
+        words_ = rest.subspan(skips.size(), total * sizeof(std::uint64_t));
+        return error_t::none;
+    }
+
+    std::uint64_t view::first_key(const std::size_t block) const noexcept
+    {
+        return load<std::uint64_t>(skips_.data() + block * skip_size);
+    }
+
+    std::size_t view::decode_keys(const std::size_t block, std::uint64_t* keys) const noexcept
+    {
+        const auto* const skip = skips_.data() + block * skip_size;
+        const auto offset = load<std::uint32_t>(skip + 8u);
+        const auto width = load<std::uint32_t>(skip + 12u);
+
+        std::array<std::uint64_t, block_size> gaps {};
+        if (width != 0u)
+        {
+            std::array<std::uint64_t, lane_count * words_per_lane(64u)> lanes;
+            const auto word_count = lane_count * words_per_lane(width);
+            for (std::size_t i {}; i != word_count; ++i)
+                lanes[i] = load<std::uint64_t>(words_.data() + (offset + i) * sizeof(std::uint64_t));
+
+            // the gaps of a step share their shifts, one per lane: the inner loop is a vector operation
+            const auto mask = width == 64u ? ~std::uint64_t {} : (std::uint64_t {1u} << width) - 1u;
+            for (std::size_t step {}; step != block_size / lane_count; ++step)
+            {
+                const auto bit = step * width;
+                const auto word = bit / 64u;
+                const auto shift = bit % 64u;
+                const auto* const low = lanes.data() + lane_count * word;
+                if (shift + width > 64u)
+                {
+                    const auto* const high = low + lane_count;
+                    for (std::size_t lane {}; lane != lane_count; ++lane)
+                        gaps[lane_count * step + lane] = ((low[lane] >> shift) | (high[lane] << (64u - shift))) & mask;
+                }
+                else
+                    for (std::size_t lane {}; lane != lane_count; ++lane)
+                        gaps[lane_count * step + lane] = (low[lane] >> shift) & mask;
+            }
+        }
+
+        const auto count = std::min(block_size, count_ - block * block_size);
+        keys[0] = first_key(block);
+        for (std::size_t i = 1u; i != count; ++i)
+            keys[i] = keys[i - 1u] + gaps[i] + 1u;
+        return count;
+    }
+
+    std::size_t view::decode(const std::size_t block, const std::span<index, block_size> cells) const noexcept
+    {
+        std::array<std::uint64_t, block_size> keys;
+        const auto count = decode_keys(block, keys.data());
+        for (std::size_t i {}; i != count; ++i)
+            cells[i] = cell::from_number(keys[i], resolution_);
+        return count;
+    }
+
+    void view::decode(std::vector<index>& cells) const
+    {
+        cells.resize(count_);
+        std::array<std::uint64_t, block_size> keys;
+        for (std::size_t block {}; block != block_count(); ++block)
+        {
+            const auto count = decode_keys(block, keys.data());
+            for (std::size_t i {}; i != count; ++i)
+                cells[block * block_size + i] = cell::from_number(keys[i], resolution_);
+        }
+    }
+
+    index view::at(const std::size_t rank) const noexcept
+    {
+        if (rank >= count_)
+            return index {0u};
+
+        std::array<std::uint64_t, block_size> keys;
+        decode_keys(rank / block_size, keys.data());
+        return cell::from_number(keys[rank % block_size], resolution_);
+    }
+
+    bool view::contains(const index cell) const noexcept
+    {
+        if ((count_ == 0u) || (cell.resolution() != resolution_))
+            return false;
+
+        // only the cells whose number gives them back belong to the resolution
+        const auto key = cell::to_number(cell);
+        if (cell::from_number(key, resolution_) != cell)
+            return false;
+
+        // the last block starting at the number or before
+        std::size_t low {}, high = block_count();
+        while (low != high)
+        {
+            const auto middle = low + (high - low) / 2u;
+            if (first_key(middle) <= key)
+                low = middle + 1u;
+            else
+                high = middle;
+        }
+
+        if (low == 0u)
+            return false;
+
+        std::array<std::uint64_t, block_size> keys;
+        const auto count = decode_keys(low - 1u, keys.data());
+        return std::binary_search(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(count), key);
+    }
+}
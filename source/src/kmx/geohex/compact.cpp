@@ -0,0 +1,245 @@
+/// @file geohex/compact.cpp
+#include "kmx/geohex/compact.hpp"
+#include "kmx/geohex/cell.hpp"
+#include <algorithm>
+
+namespace kmx::geohex::compact
+{
+    /// @brief A cell with the range of numbers of its descendants at resolution 15.
+    struct range
+    {
+        std::uint64_t first;
+        std::uint64_t last;
+        index cell;
+
+        /// @brief Orders by first number, then a cell before its descendants.
+        bool operator<(const range& other) const noexcept
+        {
+            return first != other.first ? first < other.first : last > other.last;
+        }
+
+        bool contains(const range& other) const noexcept { return (first <= other.first) && (other.last <= last); }
+    };
+
+    /// @brief The bits of the digits below a resolution.
+    static unsigned shift_of(const index cell) noexcept
+    {
+        return 3u * (resolution_count - 1u - +cell.resolution());
+    }
+
+    /// @brief Gets a cell with its range.
+    static range range_of(const index cell) noexcept
+    {
+        const auto shift = shift_of(cell);
+        const auto first = cell::to_number(cell) << shift;
+        return {first, first | ((std::uint64_t {1u} << shift) - 1u), cell};
+    }
+
+    /// @brief Gets the ranges of a set, sorted, without those inside another one.
+    static error_t to_ranges(const std::span<const index> cells, std::vector<range>& ranges)
+    {
+        ranges.clear();
+        ranges.reserve(cells.size());
+        for (const auto cell: cells)
+        {
+            if (!cell.is_valid())
+                return error_t::cell_invalid;
+            ranges.push_back(range_of(cell));
+        }
+
+        if (!std::is_sorted(ranges.begin(), ranges.end()))
+            std::sort(ranges.begin(), ranges.end());
+
+        // sorted, a range inside another one comes after it, before any range after it
+        std::size_t kept {};
+        for (const auto& item: ranges)
+            if ((kept == 0u) || !ranges[kept - 1u].contains(item))
+                ranges[kept++] = item;
+        ranges.resize(kept);
+        return error_t::none;
+    }
+
+    /// @brief Appends sorted ranges apart from each other as cells, replacing complete sets of siblings by their parent.
+    class compactor
+    {
+    public:
+        explicit compactor(std::vector<index>& cells) noexcept: cells_ {cells} { cells_.clear(); }
+
+        void push(index cell)
+        {
+            cells_.push_back(cell);
+
+            // the siblings of a set come one after another: a complete set ends with its last child
+            while (cell.resolution() != resolution_t::r0)
+            {
+                const auto parent = cell::parent(cell, static_cast<resolution_t>(+cell.resolution() - 1u));
+                const auto count = static_cast<std::size_t>(cell::children_count(parent, cell.resolution()));
+                const auto is_sibling = [&](const index other)
+                { return (other.resolution() == cell.resolution()) && (cell::parent(other, parent.resolution()) == parent); };
+                if ((cells_.size() < count) || !std::all_of(cells_.end() - static_cast<std::ptrdiff_t>(count), cells_.end(), is_sibling))
+                    break;
+
+                cells_.resize(cells_.size() - count);
+                cells_.push_back(parent);
+                cell = parent;
+            }
+        }
+
+    private:
+        std::vector<index>& cells_;
+    };
+
+    error_t normalize(const std::span<const index> cells, std::vector<index>& result)
+    {
+        std::vector<range> ranges;
+        const auto err = to_ranges(cells, ranges);
+        if (err != error_t::none)
+            return err;
+
+        std::vector<index> out;
+        compactor compact {out};
+        for (const auto& item: ranges)
+            compact.push(item.cell);
+
+        result = std::move(out);
+        return error_t::none;
+    }
+
+    /// @brief Gets the ranges of two sets.
+    static error_t to_ranges(const std::span<const index> a, const std::span<const index> b, std::vector<range>& a_ranges,
+                             std::vector<range>& b_ranges)
+    {
+        const auto err = to_ranges(a, a_ranges);
+        return err != error_t::none ? err : to_ranges(b, b_ranges);
+    }
+
+    error_t unite(const std::span<const index> a, const std::span<const index> b, std::vector<index>& result)
+    {
+        std::vector<range> a_ranges, b_ranges;
+        const auto err = to_ranges(a, b, a_ranges, b_ranges);
+        if (err != error_t::none)
+            return err;
+
+        std::vector<range> ranges(a_ranges.size() + b_ranges.size());
+        std::merge(a_ranges.begin(), a_ranges.end(), b_ranges.begin(), b_ranges.end(), ranges.begin());
+
+        std::vector<index> out;
+        compactor compact {out};
+        const range* last {};
+        for (const auto& item: ranges)
+            if ((last == nullptr) || !last->contains(item))
+            {
+                compact.push(item.cell);
+                last = &item;
+            }
+
+        result = std::move(out);
+        return error_t::none;
+    }
+
+    error_t intersect(const std::span<const index> a, const std::span<const index> b, std::vector<index>& result)
+    {
+        std::vector<range> a_ranges, b_ranges;
+        const auto err = to_ranges(a, b, a_ranges, b_ranges);
+        if (err != error_t::none)
+            return err;
+
+        // the ranges of each set are apart: the smaller of two nested ranges is in both sets, the first of two ranges
+        // apart meets nothing more
+        std::vector<index> out;
+        compactor compact {out};
+        auto i = a_ranges.begin();
+        auto j = b_ranges.begin();
+        while ((i != a_ranges.end()) && (j != b_ranges.end()))
+        {
+            if (i->contains(*j))
+                compact.push((j++)->cell);
+            else if (j->contains(*i))
+                compact.push((i++)->cell);
+            else if (i->first < j->first)
+                ++i;
+            else
+                ++j;
+        }
+
+        result = std::move(out);
+        return error_t::none;
+    }
+
+    /// @brief Appends the part of a cell outside sorted ranges apart from each other, all meeting it.
+    static void subtract(const range& cell, const std::span<const range> holes, compactor& out)
+    {
+        if (holes.empty())
+        {
+            out.push(cell.cell);
+            return;
+        }
+
+        if (holes.front().contains(cell))
+            return;
+
+        // the holes are inside the cell: each child keeps those inside it
+        auto first = holes.begin();
+        cell::for_each_child(cell.cell,
+                             [&](const index child)
+                             {
+                                 const auto child_range = range_of(child);
+                                 auto last = first;
+                                 while ((last != holes.end()) && (last->first <= child_range.last))
+                                     ++last;
+                                 subtract(child_range, {first, last}, out);
+                                 first = last;
+                             });
+    }
+
+    error_t subtract(const std::span<const index> a, const std::span<const index> b, std::vector<index>& result)
+    {
+        std::vector<range> a_ranges, b_ranges;
+        const auto err = to_ranges(a, b, a_ranges, b_ranges);
+        if (err != error_t::none)
+            return err;
+
+        std::vector<index> out;
+        compactor compact {out};
+        auto hole = b_ranges.begin();
+        for (const auto& item: a_ranges)
+        {
+            // the holes ending before the cell meet no later one either
+            while ((hole != b_ranges.end()) && (hole->last < item.first))
+                ++hole;
+
+            auto last = hole;
+            while ((last != b_ranges.end()) && (last->first <= item.last))
+                ++last;
+            subtract(item, {hole, last}, compact);
+        }
+
+        result = std::move(out);
+        return error_t::none;
+    }
+
+    error_t covers(const std::span<const index> a, const std::span<const index> b, bool& result)
+    {
+        // complete sets of siblings in a replaced by their parent, which a cell of b may be
+        std::vector<index> compacted;
+        auto err = normalize(a, compacted);
+        if (err != error_t::none)
+            return err;
+
+        std::vector<range> a_ranges, b_ranges;
+        err = to_ranges(compacted, b, a_ranges, b_ranges);
+        if (err != error_t::none)
+            return err;
+
+        // each range of b in the range of a ending at it or after, the first one that may hold it
+        auto i = a_ranges.begin();
+        result = std::all_of(b_ranges.begin(), b_ranges.end(),
+                             [&](const range& item)
+                             {
+                                 while ((i != a_ranges.end()) && (i->last < item.first))
+                                     ++i;
+                                 return (i != a_ranges.end()) && i->contains(item);
+                             });
+        return error_t::none;
+    }
+}
@@ -67,16 +67,99 @@ namespace kmx::geohex::coordinate
 
     void ijk::normalize() noexcept
     {
-        // The sum of the components must be 0 for a valid cube coordinate.
-        // This process rounds the values to the nearest valid integer coordinate.
-        if (i + j + k != 0)
+        // remove any negative values
+        if (i < 0)
         {
-            value i_out, j_out, k_out;
-            cube_round<value, value>(i, j, k, i_out, j_out, k_out);
-            i = i_out;
-            j = j_out;
-            k = k_out;
+            j -= i;
+            k -= i;
+            i = 0;
         }
+
+        if (j < 0)
+        {
+            i -= j;
+            k -= j;
+            j = 0;
+        }
+
+        if (k < 0)
+        {
+            i -= k;
+            j -= k;
+            k = 0;
+        }
+
+        // remove the min value if needed
+        const auto min_value = std::min({i, j, k});
+        if (min_value > 0)
+        {
+            i -= min_value;
+            j -= min_value;
+            k -= min_value;
+        }
+    }
+
+    ijk ijk::from_hex2d(const vector2& v) noexcept
+    {
+        constexpr double inverse_sin60 = 1.0 / sqrt3_2;
+
+        // first do a reverse conversion
+        const double a1 = std::abs(v.x);
+        const double a2 = std::abs(v.y);
+        const double x2 = a2 * inverse_sin60;
+        const double x1 = a1 + x2 / 2.0;
+
+        // check if we have the center of a hex, otherwise round correctly
+        const auto m1 = static_cast<value>(x1);
+        const auto m2 = static_cast<value>(x2);
+        const double r1 = x1 - m1;
+        const double r2 = x2 - m2;
+
+        ijk result {0, 0, 0};
+        if (r1 < 0.5)
+        {
+            if (r1 < 1.0 / 3.0)
+            {
+                result.i = m1;
+                result.j = (r2 < (1.0 + r1) / 2.0) ? m2 : m2 + 1;
+            }
+            else
+            {
+                result.j = (r2 < (1.0 - r1)) ? m2 : m2 + 1;
+                result.i = (((1.0 - r1) <= r2) && (r2 < (2.0 * r1))) ? m1 + 1 : m1;
+            }
+        }
+        else
+        {
+            if (r1 < 2.0 / 3.0)
+            {
+                result.j = (r2 < (1.0 - r1)) ? m2 : m2 + 1;
+                result.i = (((2.0 * r1 - 1.0) < r2) && (r2 < (1.0 - r1))) ? m1 : m1 + 1;
+            }
+            else
+            {
+                result.i = m1 + 1;
+                result.j = (r2 < (r1 / 2.0)) ? m2 : m2 + 1;
+            }
+        }
+
+        // now fold across the axes if necessary
+        if (v.x < 0.0)
+        {
+            if ((result.j % 2) == 0)
+                result.i -= 2 * (result.i - result.j / 2);
+            else
+                result.i -= 2 * (result.i - (result.j + 1) / 2) + 1;
+        }
+
+        if (v.y < 0.0)
+        {
+            result.i -= (2 * result.j + 1) / 2;
+            result.j = -result.j;
+        }
+
+        result.normalize();
+        return result;
     }
 
     direction_t ijk::to_digit() const noexcept
@@ -93,57 +176,63 @@ namespace kmx::geohex::coordinate
         return direction_t::invalid;
     }
 
+    /// @brief Replaces a coordinate by its combination of the images of the unit vectors, then normalizes it.
+    static void transform(ijk& item, const ijk& i_vector, const ijk& j_vector, const ijk& k_vector) noexcept
+    {
+        item = i_vector * item.i + j_vector * item.j + k_vector * item.k;
+        item.normalize();
+    }
+
     void ijk::up_ap7() noexcept
     {
-        // This is the fast algebraic simplification of the Class II parent-finding matrix transform.
-        const double i_prime = static_cast<double>(i);
-        const double j_prime = static_cast<double>(j);
-        const double k_prime = static_cast<double>(k);
-        i = static_cast<value>(std::round((3.0 * i_prime - 1.0 * j_prime - 1.0 * k_prime) / 7.0));
-        j = static_cast<value>(std::round((-1.0 * i_prime + 3.0 * j_prime - 1.0 * k_prime) / 7.0));
-        k = static_cast<value>(std::round((-1.0 * i_prime - 1.0 * j_prime + 3.0 * k_prime) / 7.0));
+        // convert to IJ and apply the inverse of the aperture 7 counter-clockwise transform
+        const auto i_prime = static_cast<double>(i - k);
+        const auto j_prime = static_cast<double>(j - k);
+        i = static_cast<value>(std::lround((3.0 * i_prime - j_prime) / 7.0));
+        j = static_cast<value>(std::lround((i_prime + 2.0 * j_prime) / 7.0));
+        k = 0;
         normalize();
     }
 
     void ijk::up_ap7r() noexcept
     {
-        // This is the fast algebraic simplification of the Class III parent-finding matrix transform.
-        const double i_prime = static_cast<double>(i);
-        const double j_prime = static_cast<double>(j);
-        const double k_prime = static_cast<double>(k);
-        i = static_cast<value>(std::round((2.0 * i_prime + 1.0 * j_prime - 1.0 * k_prime) / 7.0));
-        j = static_cast<value>(std::round((-1.0 * i_prime + 2.0 * j_prime + 1.0 * k_prime) / 7.0));
-        k = static_cast<value>(std::round((1.0 * i_prime - 1.0 * j_prime + 2.0 * k_prime) / 7.0));
+        // convert to IJ and apply the inverse of the aperture 7 clockwise transform
+        const auto i_prime = static_cast<double>(i - k);
+        const auto j_prime = static_cast<double>(j - k);
+        i = static_cast<value>(std::lround((2.0 * i_prime + j_prime) / 7.0));
+        j = static_cast<value>(std::lround((3.0 * j_prime - i_prime) / 7.0));
+        k = 0;
         normalize();
     }
 
     void ijk::down_ap7() noexcept
     {
-        // Optimized replacement for the transform method, using the inverse matrix of up_ap7.
-        const value i_prime = i;
-        const value j_prime = j;
-        i = 2 * i_prime - j_prime - k;
-        j = -i_prime + 2 * j_prime - k;
-        k = -i_prime - j_prime + 2 * k;
+        // res r unit vectors in res r+1
+        transform(*this, {3, 0, 1}, {1, 3, 0}, {0, 1, 3});
     }
 
     void ijk::down_ap7r() noexcept
     {
-        // Optimized replacement for the transform method, using the inverse matrix of up_ap7r.
-        const value i_prime = i;
-        const value j_prime = j;
-        i = 2 * i_prime + j_prime - k;
-        j = -i_prime + 2 * j_prime + k;
-        k = i_prime - j_prime + 2 * k;
+        transform(*this, {3, 1, 0}, {0, 3, 1}, {1, 0, 3});
+    }
+
+    void ijk::down_ap3() noexcept
+    {
+        transform(*this, {2, 0, 1}, {1, 2, 0}, {0, 1, 2});
+    }
+
+    void ijk::down_ap3r() noexcept
+    {
+        transform(*this, {2, 1, 0}, {0, 2, 1}, {1, 0, 2});
     }
 
     ijk ijk::down_ap7(const bool is_class_3) const noexcept
     {
         ijk next_ijk = *this;
         if (is_class_3)
-            next_ijk.down_ap7r();
-        else
             next_ijk.down_ap7();
+        else
+            next_ijk.down_ap7r();
 
         return next_ijk;
     }
@@ -152,67 +241,62 @@ namespace kmx::geohex::coordinate
     {
         ijk next_ijk = *this;
         if (is_class_3)
-            next_ijk.up_ap7r();
-        else
             next_ijk.up_ap7();
+        else
+            next_ijk.up_ap7r();
 
         return next_ijk;
     }
 
     void ijk::to_neighbor(const direction_t digit) noexcept
     {
-        *this += to_ijk(digit);
+        if ((digit != direction_t::center) && (+digit < direction_count))
+        {
+            *this += to_ijk(digit);
+            normalize();
+        }
     }
 
     ijk ijk::neighbor(const direction_t digit) const noexcept
     {
-        return *this + to_ijk(digit);
+        ijk result = *this;
+        result.to_neighbor(digit);
+        return result;
     }
 
     void ijk::rotate_60ccw() noexcept
     {
-        // A 60-degree counter-clockwise rotation in cube coordinates is (i, j, k) -> (-j, -k, -i).
-        const value temp_i = i;
-        i = -j;
-        j = -k;
-        k = -temp_i;
+        transform(*this, {1, 1, 0}, {0, 1, 1}, {1, 0, 1});
     }
 
     void ijk::rotate_60cw() noexcept
     {
-        // A 60-degree clockwise rotation in cube coordinates is (i, j, k) -> (-k, -i, -j).
-        const value temp_i = i;
-        i = -k;
-        k = -j;
-        j = -temp_i;
+        transform(*this, {1, 0, 1}, {1, 1, 0}, {0, 1, 1});
     }
 
     int ijk::distance_to(const ijk& b) const noexcept
     {
-        const ijk diff = *this - b;
-        // The distance in a hexagonal grid is the max of the absolute differences
-        // of the cube coordinates.
-        const ijk abs_diff {std::abs(diff.i), std::abs(diff.j), std::abs(diff.k)};
-        return std::max({abs_diff.i, abs_diff.j, abs_diff.k});
+        ijk diff = *this - b;
+        diff.normalize();
+        return std::max({std::abs(diff.i), std::abs(diff.j), std::abs(diff.k)});
     }
 
     direction_t ijk::leading_digit(const resolution_t res) const noexcept
     {
+        direction_t result = direction_t::center;
         ijk current_ijk = *this;
         for (resolution_t r = res; +r > 0u; r = static_cast<resolution_t>(+r - 1u))
         {
             const ijk parent_ijk = current_ijk.up_ap7_copy(is_class_3(r));
             const ijk child_at_parent_res = parent_ijk.down_ap7(is_class_3(r));
-            const ijk diff = current_ijk - child_at_parent_res;
-
-            const direction_t digit = diff.to_digit();
+            const direction_t digit = (current_ijk - child_at_parent_res).to_digit();
             if (digit != direction_t::center)
-                return digit;
+                result = digit;
 
             current_ijk = parent_ijk;
         }
 
-        return direction_t::center;
+        return result;
     }
 
 } // namespace kmx::geohex::coordinate
@@ -0,0 +1,254 @@
+/// @file geohex/coverer.cpp
+#include "kmx/geohex/coverer.hpp"
+#include "kmx/geohex/cell.hpp"
+#include "kmx/geohex/cell/bounds.hpp"
+#include "kmx/geohex/polygon/prepared.hpp"
+#include <algorithm>
+#include <array>
+#include <queue>
+#include <vector>
+
+namespace kmx::geohex::coverer
+{
+    /// @brief The position of a cell against a region.
+    enum class status_t : std::uint8_t
+    {
+        outside,  ///< The cell does not meet the region.
+        inside,   ///< The cell is in the region.
+        boundary, ///< The cell may meet the boundary of the region.
+    };
+
+    /// @brief A polygon, whose boundary a cell meets when it may pass within the reach of its center.
+    class polygon_region
+    {
+    public:
+        explicit polygon_region(const polygon::prepared& polygon) noexcept: polygon_ {polygon} {}
+
+        status_t classify(const index cell, const double reach) const noexcept
+        {
+            gis::wgs84::coordinate center;
+            if (to_wgs(cell, center) != error_t::none)
+                return status_t::outside;
+
+            if (polygon_.crosses(center, reach))
+                return status_t::boundary;
+
+            return polygon_.contains(center) ? status_t::inside : status_t::outside;
+        }
+
+    private:
+        const polygon::prepared& polygon_;
+    };
+
+    /// @brief A spherical cap, against the cap of the reach around a cell center.
+    class cap_region
+    {
+    public:
+        explicit cap_region(const cap::item& cap) noexcept: cap_ {cap} {}
+
+        status_t classify(const index cell, const double reach) const noexcept
+        {
+            switch (cap_.classify(cell, reach))
+            {
+                case cap::position_t::outside:
+                    return status_t::outside;
+                case cap::position_t::inside:
+                    return status_t::inside;
+                default:
+                    return status_t::boundary;
+            }
+        }
+
+    private:
+        const cap::region cap_;
+    };
+
+    /// @brief Refines the cells of a region greedily, within a budget of cells.
+    template <typename Region>
+    class builder
+    {
+    public:
+        builder(const Region& region, const resolution_t min_resolution, const resolution_t max_resolution,
+                const std::size_t max_cells) noexcept:
+            region_ {region},
+            min_resolution_ {min_resolution},
+            max_resolution_ {max_resolution},
+            max_cells_ {max_cells}
+        {
+            // a cell meets the region when one of its descendants of the finest resolution may: the children of a cell
+            // stick out of it, so its own bounds would miss some
+            cell::bounds::reaches(max_resolution, reaches_);
+        }
+
+        std::vector<index> build()
+        {
+            // 1. The cells of the coarsest resolution meeting the region.
+            for (const auto& base: cell::bounds::base_cells())
+                start(base.cell, classify(base.cell));
+
+            // 2. The boundary cells, refined while their children meeting the region fit in the budget.
+            while (!queue_.empty())
+            {
+                // a copy, as the candidates grow below
+                const auto next = candidates_[queue_.top().position];
+                queue_.pop();
+
+                if ((next.child_count == 0u) || (next.inside_count == next.sibling_count))
+                {
+                    // no child meets the region, or all are inside it
+                    if (next.child_count != 0u)
+                        result_.push_back(next.cell);
+                    else
+                        --size_;
+                }
+                else if (size_ + next.child_count - 1u <= max_cells_)
+                {
+                    size_ += next.child_count - 1u;
+                    for (std::uint8_t i {}; i != next.child_count; ++i)
+                        add(next.children[i], next.statuses[i]);
+                }
+                else
+                    result_.push_back(next.cell);
+            }
+
+            std::sort(result_.begin(), result_.end());
+            return std::move(result_);
+        }
+
+    private:
+        /// @brief A boundary cell with its children meeting the region.
+        struct candidate
+        {
+            index cell;
+            std::array<index, 7u> children;
+            std::array<status_t, 7u> statuses;
+            std::uint8_t child_count;
+            std::uint8_t inside_count;
+            std::uint8_t sibling_count;
+        };
+
+        /// @brief A candidate in the queue: the coarsest first, then the one adding the fewest cells.
+        struct entry
+        {
+            std::uint8_t resolution;
+            std::uint8_t child_count;
+            std::size_t position;
+
+            bool operator<(const entry& other) const noexcept
+            {
+                // std::priority_queue pops the greatest entry
+                if (resolution != other.resolution)
+                    return resolution > other.resolution;
+                if (child_count != other.child_count)
+                    return child_count > other.child_count;
+                return position > other.position;
+            }
+        };
+
+        status_t classify(const index cell) const noexcept { return region_.classify(cell, reaches_[+cell.resolution()]); }
+
+        /// @brief Walks down to the coarsest resolution, adding its cells meeting the region.
+        void start(const index cell, const status_t status)
+        {
+            if (status == status_t::outside)
+                return;
+
+            if (cell.resolution() == min_resolution_)
+            {
+                ++size_;
+                add(cell, status);
+                return;
+            }
+
+            cell::for_each_child(cell, [&](const index child)
+                                 { start(child, status == status_t::inside ? status : classify(child)); });
+        }
+
+        /// @brief Adds a cell meeting the region, counted in the size already: a boundary cell that can be refined
+        /// becomes a candidate.
+        void add(const index cell, const status_t status)
+        {
+            if ((status == status_t::inside) || (cell.resolution() == max_resolution_))
+            {
+                result_.push_back(cell);
+                return;
+            }
+
+            candidate next {cell, {}, {}, 0u, 0u, 0u};
+            cell::for_each_child(cell,
+                                 [&](const index child)
+                                 {
+                                     ++next.sibling_count;
+                                     const auto child_status = classify(child);
+                                     if (child_status == status_t::outside)
+                                         return;
+
+                                     next.inside_count += child_status == status_t::inside;
+                                     next.children[next.child_count] = child;
+                                     next.statuses[next.child_count++] = child_status;
+                                 });
+
+            queue_.push({static_cast<std::uint8_t>(+cell.resolution()), next.child_count, candidates_.size()});
+            candidates_.push_back(next);
+        }
+
+        const Region& region_;
+        const resolution_t min_resolution_;
+        const resolution_t max_resolution_;
+        const std::size_t max_cells_;
+        std::size_t size_ {};
+        std::vector<index> result_;
+        std::vector<candidate> candidates_;
+        std::priority_queue<entry> queue_;
+        double reaches_[resolution_count] {};
+    };
+
+    template <typename Region>
+    static std::vector<index> cover(const Region& region, const resolution_t min_resolution, const resolution_t max_resolution,
+                                    const std::size_t max_cells)
+    {
+        builder<Region> build {region, min_resolution, max_resolution, max_cells};
+        return build.build();
+    }
+
+    /// @brief Checks a pair of resolutions.
+    static bool is_valid(const resolution_t min_resolution, const resolution_t max_resolution) noexcept
+    {
+        return (+max_resolution < resolution_count) && (+min_resolution <= +max_resolution);
+    }
+
+    error_t to_cells(const polygon::prepared& polygon, const resolution_t min_resolution, const resolution_t max_resolution,
+                     const std::size_t max_cells, std::vector<index>& cells)
+    {
+        if (!is_valid(min_resolution, max_resolution))
+            return error_t::res_domain;
+
+        if (!polygon.is_finite())
+            return error_t::latlng_domain;
+
+        if (polygon.edges(0u).size() < 3u)
+        {
+            cells.clear();
+            return error_t::none;
+        }
+
+        cells = cover(polygon_region {polygon}, min_resolution, max_resolution, max_cells);
+        return error_t::none;
+    }
+
+    error_t to_cells(const cap::item& cap, const resolution_t min_resolution, const resolution_t max_resolution,
+                     const std::size_t max_cells, std::vector<index>& cells)
+    {
+        if (!is_valid(min_resolution, max_resolution))
+            return error_t::res_domain;
+
+        if (!std::isfinite(cap.center.latitude) || !std::isfinite(cap.center.longitude))
+            return error_t::latlng_domain;
+
+        if (!std::isfinite(cap.radius) || (cap.radius < 0.0))
+            return error_t::domain;
+
+        cells = cover(cap_region {cap}, min_resolution, max_resolution, max_cells);
+        return error_t::none;
+    }
+}
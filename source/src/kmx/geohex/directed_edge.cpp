@@ -1,6 +1,223 @@
-#include "h3plus/directed_edge.hpp"
+/// @file geohex/directed_edge.cpp
+#include "kmx/geohex/directed_edge.hpp"
+#include "kmx/geohex/cell/boundary.hpp"
+#include "kmx/geohex/grid/neighbor.hpp"
+#include "kmx/geohex/icosahedron/face.hpp"
+#include "kmx/geohex/vertex.hpp"
+#include <array>
 
-namespace h3plus
+namespace kmx::geohex::directed_edge
 {
+    bool is_valid(const index edge) noexcept
+    {
+        const auto dir = direction(edge);
+        if ((edge.mode() != index_mode_t::edge_unidirectional) || (dir == direction_t::center) || (+dir >= direction_count))
+            return false;
 
+        const auto cell = origin(edge);
+        if (cell.is_pentagon() && (dir == direction_t::k_axes))
+            return false;
+
+        return cell.is_valid();
+    }
+
+    direction_t direction(const index edge) noexcept
+    {
+        return static_cast<direction_t>(edge.mode_dependent());
+    }
+
+    error_t create(const index origin, const index destination, index& out) noexcept
+    {
+        if (origin.resolution() != destination.resolution())
+            return error_t::res_mismatch;
+
+        const auto dir = grid::neighbor::direction_to(origin, destination);
+        if (dir == direction_t::invalid)
+            return error_t::not_neighbors;
+
+        out = origin;
+        out.set_mode(index_mode_t::edge_unidirectional);
+        out.set_mode_dependent(+dir);
+        return error_t::none;
+    }
+
+    index origin(const index edge) noexcept
+    {
+        index result = edge;
+        result.set_mode(index_mode_t::cell);
+        result.set_mode_dependent(0u);
+        return result;
+    }
+
+    error_t destination(const index edge, index& out) noexcept
+    {
+        if (!is_valid(edge))
+            return error_t::dir_edge_invalid;
+
+        int rotations {};
+        return grid::neighbor::get(origin(edge), direction(edge), rotations, out);
+    }
+
+    error_t to_cells(const index edge, std::span<index, 2u> out) noexcept
+    {
+        out[0u] = origin(edge);
+        return destination(edge, out[1u]);
+    }
+
+    /// @brief Writes the edges of a valid cell, skipping the deleted k direction of pentagons.
+    static std::size_t write_edges(const index origin, index* dest) noexcept
+    {
+        index edge = origin;
+        edge.set_mode(index_mode_t::edge_unidirectional);
+
+        const auto first = origin.is_pentagon() ? direction_t::j_axes : direction_t::k_axes;
+        for (auto d = +first; d != direction_count; ++d, ++dest)
+        {
+            edge.set_mode_dependent(d);
+            *dest = edge;
+        }
+
+        return direction_count - +first;
+    }
+
+    error_t of(const index origin, std::span<index>& out) noexcept
+    {
+        if (!origin.is_valid())
+        {
+            out = {};
+            return error_t::cell_invalid;
+        }
+
+        if (out.size() < max_count)
+            return error_t::memory_bounds;
+
+        out = out.first(write_edges(origin, out.data()));
+        return error_t::none;
+    }
+
+    error_t of(std::span<const index> cells, std::span<index>& out) noexcept
+    {
+        if (out.size() < max_size(cells.size()))
+            return error_t::memory_bounds;
+
+        std::size_t written {};
+        for (const auto cell: cells)
+        {
+            if (!cell.is_valid())
+            {
+                out = out.first(written);
+                return error_t::cell_invalid;
+            }
+
+            written += write_edges(cell, out.data() + written);
+        }
+
+        out = out.first(written);
+        return error_t::none;
+    }
+
+    /// @brief Calculates the vertices of an edge whose origin was already decoded.
+    static error_t get_vertices(const icosahedron::face::ijk& center_fijk, const index edge,
+                                std::span<gis::wgs84::coordinate>& out) noexcept
+    {
+        const auto cell = origin(edge);
+        const auto start = vertex::number_for_direction(cell, direction(edge));
+        if (start == vertex::invalid_number)
+            return error_t::dir_edge_invalid;
+
+        return cell::boundary::get_vertices(center_fijk, cell, static_cast<std::uint8_t>(start), 2u, out);
+    }
+
+    error_t boundary(const index edge, std::span<gis::wgs84::coordinate>& out) noexcept
+    {
+        if (!is_valid(edge))
+            return error_t::dir_edge_invalid;
+
+        icosahedron::face::ijk center_fijk;
+        const auto err = icosahedron::face::from_index(origin(edge), center_fijk);
+        if (err != error_t::none)
+            return err;
+
+        return get_vertices(center_fijk, edge, out);
+    }
+
+    error_t boundaries(std::span<const index> edges, boundary_columns& out) noexcept
+    {
+        const auto count = edges.size();
+        if ((out.start_latitudes.size() < count) || (out.start_longitudes.size() < count) || (out.end_latitudes.size() < count) ||
+            (out.end_longitudes.size() < count))
+            return error_t::memory_bounds;
+
+        const auto finish = [&out](const std::size_t rows, const error_t result) noexcept
+        {
+            out.start_latitudes = out.start_latitudes.first(rows);
+            out.start_longitudes = out.start_longitudes.first(rows);
+            out.end_latitudes = out.end_latitudes.first(rows);
+            out.end_longitudes = out.end_longitudes.first(rows);
+            return result;
+        };
+
+        index decoded_origin {};
+        icosahedron::face::ijk center_fijk;
+        std::array<gis::wgs84::coordinate, max_boundary_count> vertices;
+        for (std::size_t i {}; i != count; ++i)
+        {
+            const auto edge = edges[i];
+            if (!is_valid(edge))
+                return finish(i, error_t::dir_edge_invalid);
+
+            // Edges of the same origin arrive together: decode the shared cell center once.
+            const auto cell = origin(edge);
+            if ((i == 0u) || (cell != decoded_origin))
+            {
+                const auto err = icosahedron::face::from_index(cell, center_fijk);
+                if (err != error_t::none)
+                    return finish(i, err);
+
+                decoded_origin = cell;
+            }
+
+            std::span<gis::wgs84::coordinate> vertices_span {vertices};
+            const auto err = get_vertices(center_fijk, edge, vertices_span);
+            if (err != error_t::none)
+                return finish(i, err);
+
+            out.start_latitudes[i] = vertices[0u].latitude;
+            out.start_longitudes[i] = vertices[0u].longitude;
+            out.end_latitudes[i] = vertices_span.back().latitude;
+            out.end_longitudes[i] = vertices_span.back().longitude;
+        }
+
+        return finish(count, error_t::none);
+    }
+
+    error_t length_rads(const index edge, double& out) noexcept
+    {
+        std::array<gis::wgs84::coordinate, max_boundary_count> vertices;
+        std::span<gis::wgs84::coordinate> vertices_span {vertices};
+        const auto err = boundary(edge, vertices_span);
+        if (err != error_t::none)
+            return err;
+
+        out = 0.0;
+        for (std::size_t i = 1u; i < vertices_span.size(); ++i)
+            out += vertices_span[i - 1u].haversine_distance_to(vertices_span[i], 1.0);
+        return error_t::none;
+    }
+
+    error_t length_km(const index edge, double& out) noexcept
+    {
+        const auto err = length_rads(edge, out);
+        if (err == error_t::none)
+            out *= earth_radius_km;
+        return err;
+    }
+
+    error_t length_m(const index edge, double& out) noexcept
+    {
+        const auto err = length_rads(edge, out);
+        if (err == error_t::none)
+            out *= earth_radius_km * meters_per_km;
+        return err;
+    }
 }
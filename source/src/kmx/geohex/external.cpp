@@ -0,0 +1,346 @@
+/// @file geohex/external.cpp
+#include "kmx/geohex/external.hpp"
+#include "kmx/geohex/radix.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace kmx::geohex::external
+{
+    /// @brief A record as stored in a run.
+    struct record
+    {
+        std::uint64_t cell;
+        std::uint64_t payload;
+    };
+
+    /// @brief The memory per record gathered: the records, then the buffers of their radix sort.
+    static constexpr std::size_t gather_cost = 48u;
+
+    static constexpr std::size_t min_memory_limit = std::size_t {64u} << 10u;
+
+    /// @brief The most runs merged at once.
+    static constexpr std::size_t max_fan_in = 128u;
+
+    /// @brief Records read or written at once, at least.
+    static constexpr std::size_t min_block_size = 256u;
+
+    /// @brief Records written at once.
+    static constexpr std::size_t write_block_size = 4096u;
+
+    /// @brief Combines the payloads of two records of a cell, the first one added first.
+    static std::uint64_t combine(const duplicates mode, const std::uint64_t a, const std::uint64_t b) noexcept
+    {
+        switch (mode)
+        {
+            case duplicates::sum:
+                return a + b;
+            case duplicates::min:
+                return std::min(a, b);
+            case duplicates::max:
+                return std::max(a, b);
+            default:
+                return a;
+        }
+    }
+
+    struct file_closer
+    {
+        void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+    };
+
+    using file_ptr = std::unique_ptr<std::FILE, file_closer>;
+
+    /// @brief Records read from a run in blocks, or all in memory.
+    struct source
+    {
+        file_ptr file; ///< Null once read to the end, or for records in memory.
+        std::vector<record> buffer;
+        std::size_t position {};
+        std::size_t block_size {};
+        bool failed {};
+
+        /// @brief Opens a run.
+        error_t open(const std::filesystem::path& path, const std::size_t size)
+        {
+            file.reset(std::fopen(path.string().c_str(), "rb"));
+            if (!file)
+                return error_t::failed;
+
+            block_size = size;
+            refill();
+            return failed ? error_t::failed : error_t::none;
+        }
+
+        /// @brief Gets the next record, or null at the end.
+        const record* head() const noexcept { return position != buffer.size() ? &buffer[position] : nullptr; }
+
+        void advance()
+        {
+            if ((++position == buffer.size()) && file)
+                refill();
+        }
+
+        void refill()
+        {
+            buffer.resize(block_size);
+            const auto count = std::fread(buffer.data(), sizeof(record), block_size, file.get());
+            failed |= (count != block_size) && (std::ferror(file.get()) != 0);
+            buffer.resize(count);
+            position = 0u;
+            if (count != block_size)
+                file.reset();
+        }
+    };
+
+    /// @brief Merges sorted sources with a loser tree.
+    /// @details The tree has the sources as leaves `k` to `2k - 1` and keeps in each inner node the source that lost
+    /// there, the one with the greater head; node 0 holds the winner. Taking a record replays the path of its source to
+    /// the root, one comparison per level. Equal cells come in source order, which keeps the merge stable.
+    class merger
+    {
+    public:
+        explicit merger(std::vector<source> sources): sources_ {std::move(sources)}, nodes_(std::max<std::size_t>(sources_.size(), 1u))
+        {
+            if (!sources_.empty())
+                nodes_[0] = build(1u);
+        }
+
+        /// @brief Takes the next record, combining those of its cell unless all are kept.
+        /// @return False at the end.
+        bool next(const duplicates mode, record& item)
+        {
+            const auto* first = head();
+            if (first == nullptr)
+                return false;
+
+            item = *first;
+            pop();
+            if (mode != duplicates::keep)
+                for (const record* other; ((other = head()) != nullptr) && (other->cell == item.cell); pop())
+                    item.payload = combine(mode, item.payload, other->payload);
+            return true;
+        }
+
+        bool failed() const noexcept
+        {
+            return std::any_of(sources_.begin(), sources_.end(), [](const source& item) { return item.failed; });
+        }
+
+    private:
+        const record* head() const noexcept { return sources_.empty() ? nullptr : sources_[nodes_[0]].head(); }
+
+        void pop()
+        {
+            const auto winner = nodes_[0];
+            sources_[winner].advance();
+            replay(winner);
+        }
+
+        /// @brief Orders sources by head, the ended ones last, then by source.
+        bool less(const std::size_t a, const std::size_t b) const noexcept
+        {
+            const auto* item_a = sources_[a].head();
+            const auto* item_b = sources_[b].head();
+            if ((item_a == nullptr) || (item_b == nullptr))
+                return (item_a != nullptr) || ((item_b == nullptr) && (a < b));
+            return item_a->cell != item_b->cell ? item_a->cell < item_b->cell : a < b;
+        }
+
+        /// @brief Plays the matches of a subtree, keeping the losers.
+        /// @return The winner.
+        std::size_t build(const std::size_t node)
+        {
+            const auto count = sources_.size();
+            if (node >= count)
+                return node - count;
+
+            const auto left = build(2u * node);
+            const auto right = build(2u * node + 1u);
+            const bool right_wins = less(right, left);
+            nodes_[node] = right_wins ? left : right;
+            return right_wins ? right : left;
+        }
+
+        /// @brief Replays the matches of a source up to the root.
+        void replay(std::size_t winner) noexcept
+        {
+            for (auto node = (winner + sources_.size()) / 2u; node != 0u; node /= 2u)
+                if (less(nodes_[node], winner))
+                    std::swap(nodes_[node], winner);
+            nodes_[0] = winner;
+        }
+
+        std::vector<source> sources_;
+        std::vector<std::size_t> nodes_;
+    };
+
+    /// @brief Writes the records of a merge as a run.
+    static error_t write_run(merger& input, const duplicates mode, const std::filesystem::path& path)
+    {
+        const file_ptr file {std::fopen(path.string().c_str(), "wbx")};
+        if (!file)
+            return error_t::failed;
+
+        std::vector<record> block;
+        block.reserve(write_block_size);
+        bool done {};
+        while (!done)
+        {
+            record item;
+            done = !input.next(mode, item);
+            if (!done)
+                block.push_back(item);
+            if ((done || (block.size() == write_block_size)) && !block.empty())
+            {
+                if (std::fwrite(block.data(), sizeof(record), block.size(), file.get()) != block.size())
+                    return error_t::failed;
+                block.clear();
+            }
+        }
+
+        return input.failed() || (std::fflush(file.get()) != 0) ? error_t::failed : error_t::none;
+    }
+
+    /// @brief Opens runs for a merge, sharing the memory budget between them.
+    static error_t open_runs(const std::span<const std::filesystem::path> runs, const std::size_t memory_limit,
+                             std::vector<source>& sources)
+    {
+        const auto block_size = std::max(min_block_size, memory_limit / sizeof(record) / runs.size());
+        sources.resize(runs.size());
+        for (std::size_t i {}; i != runs.size(); ++i)
+            if (sources[i].open(runs[i], block_size) != error_t::none)
+                return error_t::failed;
+        return error_t::none;
+    }
+
+    sorter::sorter(std::filesystem::path directory, const std::size_t memory_limit, const duplicates mode):
+        directory_ {std::move(directory)},
+        memory_limit_ {std::max(memory_limit, min_memory_limit)},
+        mode_ {mode},
+        name_ {std::random_device {}()}
+    {
+        name_ = (name_ << 32u) | std::random_device {}();
+    }
+
+    sorter::~sorter()
+    {
+        merger_.reset();
+        std::error_code ignored;
+        for (const auto& run: runs_)
+            std::filesystem::remove(run, ignored);
+    }
+
+    std::filesystem::path sorter::new_run_path()
+    {
+        return directory_ / ("geohex-" + std::to_string(name_) + "-" + std::to_string(run_count_++) + ".run");
+    }
+
+    /// @brief Gets sorted records in memory as a source.
+    static source to_source(std::vector<index>& cells, std::vector<std::uint64_t>& payloads)
+    {
+        radix::sort(cells, payloads);
+        source result;
+        result.buffer.resize(cells.size());
+        for (std::size_t i {}; i != cells.size(); ++i)
+            result.buffer[i] = {cells[i], payloads[i]};
+
+        cells = {};
+        payloads = {};
+        return result;
+    }
+
+    error_t sorter::spill()
+    {
+        std::vector<source> sources;
+        sources.push_back(to_source(cells_, payloads_));
+        merger input {std::move(sources)};
+        runs_.push_back(new_run_path());
+        return write_run(input, mode_, runs_.back());
+    }
+
+    error_t sorter::add(const index cell, const std::uint64_t payload)
+    {
+        if (finished_)
+            return error_t::failed;
+
+        cells_.push_back(cell);
+        payloads_.push_back(payload);
+        ++size_;
+        return cells_.size() * gather_cost >= memory_limit_ ? spill() : error_t::none;
+    }
+
+    error_t sorter::finish()
+    {
+        if (finished_)
+            return error_t::failed;
+        finished_ = true;
+
+        std::vector<source> sources;
+        if (runs_.empty())
+        {
+            sources.push_back(to_source(cells_, payloads_));
+            merger_ = std::make_unique<merger>(std::move(sources));
+            return error_t::none;
+        }
+
+        if (!cells_.empty() && (spill() != error_t::none))
+            return error_t::failed;
+
+        // passes merging groups of runs into one, in order, until one merge takes them all
+        while (runs_.size() > max_fan_in)
+        {
+            std::vector<std::filesystem::path> merged;
+            for (std::size_t first {}; first < runs_.size(); first += max_fan_in)
+            {
+                const std::span<const std::filesystem::path> group {runs_.begin() + static_cast<std::ptrdiff_t>(first),
+                                                                    std::min(max_fan_in, runs_.size() - first)};
+                std::vector<source> group_sources;
+                auto err = open_runs(group, memory_limit_, group_sources);
+                if (err == error_t::none)
+                {
+                    merger input {std::move(group_sources)};
+                    merged.push_back(new_run_path());
+                    err = write_run(input, mode_, merged.back());
+                }
+
+                std::error_code ignored;
+                for (const auto& run: group)
+                    std::filesystem::remove(run, ignored);
+                if (err != error_t::none)
+                {
+                    runs_.erase(runs_.begin(), runs_.begin() + static_cast<std::ptrdiff_t>(first + group.size()));
+                    runs_.insert(runs_.begin(), merged.begin(), merged.end());
+                    return err;
+                }
+            }
+            runs_ = std::move(merged);
+        }
+
+        const auto err = open_runs(runs_, memory_limit_, sources);
+        if (err != error_t::none)
+            return err;
+
+        merger_ = std::make_unique<merger>(std::move(sources));
+        return error_t::none;
+    }
+
+    bool sorter::next(index& cell, std::uint64_t& payload)
+    {
+        record item;
+        if (!merger_ || !merger_->next(mode_, item))
+            return false;
+
+        cell = item.cell;
+        payload = item.payload;
+        return true;
+    }
+
+    error_t sorter::error() const noexcept
+    {
+        return merger_ && merger_->failed() ? error_t::failed : error_t::none;
+    }
+}
@@ -1,10 +1,53 @@
-/// @file geohex/cell.cpp
+/// @file geohex/geo_projection.cpp
 #include "kmx/geohex/geo_projection.hpp"
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
 namespace kmx::geohex::projection
 {
+    /// @ref EPSILON
+    static constexpr double epsilon = 0.0000000000000001;
+
+    /// @ref RES0_U_GNOMONIC
+    static constexpr double res0_u_gnomonic = 0.38196601125010500003;
+
+    /// @ref M_AP7_ROT_RADS
+    static constexpr double ap7_rotation_rads = 0.333473172251832115336090755351601070065900389;
+
+    /// @ref INV_RES0_U_GNOMONIC
+    static constexpr double inverse_res0_u_gnomonic = 2.61803398874989588842;
+
+    /// @ref M_SQRT7
+    static constexpr double sqrt7 = 2.6457513110645905905016157536392604257102;
+
+    /// @ref M_RSQRT7
+    static constexpr double inverse_sqrt7 = 0.37796447300922722721451653623418006081576;
+
+    /// @ref M_ONETHIRD
+    static constexpr double one_third = 0.333333333333333333333333333333333333333;
+
+    static constexpr double two_pi = 2.0 * std::numbers::pi_v<double>;
+
+    /// @ref _posAngleRads
+    static double positive_angle(const double rads) noexcept
+    {
+        const double result = rads < 0.0 ? rads + two_pi : rads;
+        return result >= two_pi ? result - two_pi : result;
+    }
+
+    /// @ref constrainLng
+    static double constrain_longitude(double longitude) noexcept
+    {
+        while (longitude > std::numbers::pi_v<double>)
+            longitude -= two_pi;
+
+        while (longitude < -std::numbers::pi_v<double>)
+            longitude += two_pi;
+
+        return longitude;
+    }
+
     /// @ref _v3dToGeo (H3 C internal from algos.c)
     void from_v3d(const math::vector3d& v3, gis::wgs84::coordinate& out_coord) noexcept
     {
@@ -22,109 +65,140 @@ namespace kmx::geohex::projection
         out_v3.z = std::sin(geo_coord.latitude);
     }
 
-    /// @ref _faceIjkToXYZ (H3 C internal, related to _faceIjkToGeoEx from faceijk.c)
-    /// @brief Converts FaceIJK coordinates (cell center or vertex) to a 3D Cartesian vector.
-    error_t face_ijk_to_v3d(const icosahedron::face::ijk& fijk_coords, resolution_t res, math::vector3d& out_v3) noexcept
+    void destination(const gis::wgs84::coordinate& origin, double azimuth, const double distance, gis::wgs84::coordinate& out_coord) noexcept
     {
-        // 1. Convert IJK to a 2D vector on the canonical hex grid.
-        math::vector2d v2d = coordinate::to_vec2<double>(fijk_coords.ijk_coords);
+        if (distance < epsilon)
+        {
+            out_coord = origin;
+            return;
+        }
 
-        // 2. Scale by resolution-specific factor.
-        v2d *= scaling_factor(res);
+        constexpr double half_pi = std::numbers::pi_v<double> / 2.0;
+        azimuth = positive_angle(azimuth);
 
-        // 3. Rotate for Class III (odd) resolutions.
-        if (is_class_3(res))
+        // check for due north/south azimuth
+        if ((azimuth < epsilon) || (std::abs(azimuth - std::numbers::pi_v<double>) < epsilon))
         {
-            constexpr double angle_rad = std::numbers::pi_v<double> / 6.0; // 30 degrees CCW
-            const double cs = std::cos(angle_rad);
-            const double sn = std::sin(angle_rad);
-            const double old_x = v2d.x;
-            v2d.x = old_x * cs - v2d.y * sn;
-            v2d.y = old_x * sn + v2d.y * cs;
+            out_coord.latitude = azimuth < epsilon ? origin.latitude + distance : origin.latitude - distance;
+            out_coord.longitude = constrain_longitude(origin.longitude);
         }
-
-        // 4. Project from the face's 2D gnomonic plane to the 3D sphere.
-        // NOTE: This is a simplified projection. A production-quality implementation
-        // requires porting the full `FaceOrient` data structures from H3, which define
-        // the precise 3D orientation and projection parameters for each face.
-        const auto face_center_v3 = icosahedron::face::center_point(fijk_coords.face);
-
-        // Create an ad-hoc orthonormal basis for the tangent plane at the face center.
-        // This is the most complex part to port correctly without the H3 tables.
-        // We'll use a standard approach to create a basis from a single vector.
-        math::vector3d u_vec, v_vec;
-        if (std::abs(face_center_v3.x) > std::abs(face_center_v3.y))
-            u_vec = math::vector3d(-face_center_v3.z, 0, face_center_v3.x).normalized();
         else
-            u_vec = math::vector3d(0, face_center_v3.z, -face_center_v3.y).normalized();
+        {
+            const double sin_latitude = std::clamp(std::sin(origin.latitude) * std::cos(distance) +
+                                                       std::cos(origin.latitude) * std::sin(distance) * std::cos(azimuth),
+                                                   -1.0, 1.0);
+            out_coord.latitude = std::asin(sin_latitude);
+            if ((std::abs(out_coord.latitude - half_pi) >= epsilon) && (std::abs(out_coord.latitude + half_pi) >= epsilon))
+            {
+                const double inverse_cos_latitude = 1.0 / std::cos(out_coord.latitude);
+                const double sin_longitude = std::clamp(std::sin(azimuth) * std::sin(distance) * inverse_cos_latitude, -1.0, 1.0);
+                const double cos_longitude = std::clamp((std::cos(distance) - std::sin(origin.latitude) * std::sin(out_coord.latitude)) /
+                                                            std::cos(origin.latitude) * inverse_cos_latitude,
+                                                        -1.0, 1.0);
+                out_coord.longitude = constrain_longitude(origin.longitude + std::atan2(sin_longitude, cos_longitude));
+            }
+        }
 
-        v_vec = face_center_v3.cross(u_vec);
-        out_v3 = (face_center_v3 + (u_vec * v2d.x) + (v_vec * v2d.y)).normalized();
-        return error_t::none;
+        // the poles have no longitude
+        if (std::abs(out_coord.latitude - half_pi) < epsilon)
+            out_coord = {half_pi, 0.0};
+        else if (std::abs(out_coord.latitude + half_pi) < epsilon)
+            out_coord = {-half_pi, 0.0};
     }
 
-    error_t convert_face_uv_to_ijk(const math::vector2d& raw_uv_on_face, const resolution_t res, coordinate::ijk& out_ijk) noexcept
+    /// @brief Projects a coordinate on a face, given its squared chord length to the face center.
+    static void to_hex2d(const gis::wgs84::coordinate& coord, const double sqd, const icosahedron::face::id_t face, const resolution_t res,
+                         math::vector2d& out_v2d) noexcept
     {
-        math::vector2d processed_uv = raw_uv_on_face;
-
-        // Inverse Class III rotation
-        if (is_class_3(res))
+        // cos(r) = 1 - 2 * sin^2(r/2) = 1 - 2 * (sqd / 4) = 1 - sqd/2
+        double r = std::acos(1.0 - sqd / 2.0);
+        if (r < epsilon)
         {
-            constexpr auto angle_rad = -std::numbers::pi_v<double> / 6.0; // -30 degrees
-            double cs = std::cos(angle_rad);
-            double sn = std::sin(angle_rad);
-            double old_x = processed_uv.x;
-            processed_uv.x = old_x * cs - processed_uv.y * sn;
-            processed_uv.y = old_x * sn + processed_uv.y * cs;
+            out_v2d = {0.0, 0.0};
+            return;
         }
 
-        // Inverse scaling
-        const double inv_scale_factor = 1.0 / scaling_factor(res);
-        processed_uv.x *= inv_scale_factor;
-        processed_uv.y *= inv_scale_factor;
+        // now find the counter-clockwise theta from the Class II i-axis
+        const auto center = icosahedron::face::center_wgs(face);
+        double theta = positive_angle(icosahedron::face::axis_azimuth(face) - positive_angle(center.azimuth_to(coord)));
 
-        // Convert hex 2D coordinates to axial cube coordinates
-        double j_axial = processed_uv.y / sqrt3_2;
-        double i_axial = processed_uv.x - 0.5 * j_axial;
+        // adjust theta for Class III (odd resolutions)
+        if (is_class_3(res))
+            theta = positive_angle(theta - ap7_rotation_rads);
 
-        // Round to integer cube coordinates
-        coordinate::ijk::value i_int, j_int, k_int;
-        cube_round(i_axial, j_axial, -(i_axial + j_axial), i_int, j_int, k_int);
+        // perform gnomonic scaling of r, then scale for the unit length of the resolution
+        r = std::tan(r) * inverse_res0_u_gnomonic;
+        for (std::uint8_t i {}; i != +res; ++i)
+            r *= sqrt7;
 
-        out_ijk = {i_int, j_int, k_int};
-        return error_t::none;
+        out_v2d = {r * std::cos(theta), r * std::sin(theta)};
     }
 
-    /// @ref _v3dToFaceV2d
-    /// @brief Projects a 3D point on the sphere to 2D UV coordinates on a specified face's plane.
-    error_t project_v3d_to_face_uv(const math::vector3d& v3d, const icosahedron::face::id_t face_num, math::vector2d& out_uv) noexcept
+    void to_hex2d(const gis::wgs84::coordinate& coord, const resolution_t res, icosahedron::face::id_t& out_face,
+                  math::vector2d& out_v2d) noexcept
     {
-        // This is the inverse of face_ijk_to_v3d, performing a gnomonic projection.
-        const auto face_center = icosahedron::face::center_point(face_num);
+        // find the closest face; the squared chord length gives the angular distance to its center
+        math::vector3d v3d;
+        to_v3d(coord, v3d);
 
-        // The point must be on the same hemisphere as the face center for gnomonic projection.
-        if (v3d.dot(face_center) < 0.0)
-            return error_t::failed; // Or a more specific error like DOMAIN
+        double sqd = 5.0;
+        for (icosahedron::face::no_t i {}; i != icosahedron::face::count; ++i)
+        {
+            const auto face = static_cast<icosahedron::face::id_t>(i);
+            const auto delta = icosahedron::face::center_point(face) - v3d;
+            const double face_sqd = delta.dot(delta);
+            if (face_sqd < sqd)
+            {
+                out_face = face;
+                sqd = face_sqd;
+            }
+        }
 
-        // Use the same ad-hoc basis as in face_ijk_to_v3d for consistency.
-        math::vector3d u_vec, v_vec;
-        if (std::abs(face_center.x) > std::abs(face_center.y))
-            u_vec = math::vector3d(-face_center.z, 0, face_center.x).normalized();
-        else
-            u_vec = math::vector3d(0, face_center.z, -face_center.y).normalized();
+        to_hex2d(coord, sqd, out_face, res, out_v2d);
+    }
 
-        v_vec = face_center.cross(u_vec);
+    void to_hex2d(const gis::wgs84::coordinate& coord, const icosahedron::face::id_t face, const resolution_t res,
+                  math::vector2d& out_v2d) noexcept
+    {
+        math::vector3d v3d;
+        to_v3d(coord, v3d);
+        const auto delta = icosahedron::face::center_point(face) - v3d;
+        to_hex2d(coord, delta.dot(delta), face, res, out_v2d);
+    }
+
+    void from_hex2d(const math::vector2d& v2d, const icosahedron::face::id_t face, const std::uint8_t res, const bool substrate,
+                    gis::wgs84::coordinate& out_coord) noexcept
+    {
+        double r = std::sqrt(v2d.x * v2d.x + v2d.y * v2d.y);
+        if (r < epsilon)
+        {
+            out_coord = icosahedron::face::center_wgs(face);
+            return;
+        }
 
-        // Project v3d onto the tangent plane by scaling it to the plane.
-        const math::vector3d p_prime = v3d / v3d.dot(face_center);
+        double theta = std::atan2(v2d.y, v2d.x);
+
+        // scale for the unit length of the resolution, and for the substrate grid
+        for (std::uint8_t i {}; i != res; ++i)
+            r *= inverse_sqrt7;
+
+        const bool class_3 = (res % 2u) != 0u;
+        if (substrate)
+        {
+            r *= one_third;
+            if (class_3)
+                r *= inverse_sqrt7;
+        }
 
-        // The vector from the plane's origin (face center) to the projected point.
-        const math::vector3d p_prime_on_plane = p_prime - face_center;
+        // perform inverse gnomonic scaling of r
+        r = std::atan(r * res0_u_gnomonic);
 
-        // Project onto the basis vectors to get the 2D coordinates.
-        out_uv.x = p_prime_on_plane.dot(u_vec);
-        out_uv.y = p_prime_on_plane.dot(v_vec);
+        // adjust theta for Class III; a substrate grid is already adjusted
+        if (!substrate && class_3)
+            theta = positive_angle(theta + ap7_rotation_rads);
 
-        return error_t::none;
+        // find theta as an azimuth, then the point at (r, theta) from the face center
+        theta = positive_angle(icosahedron::face::axis_azimuth(face) - theta);
+        destination(icosahedron::face::center_wgs(face), theta, r, out_coord);
     }
 }
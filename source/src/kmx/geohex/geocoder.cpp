@@ -0,0 +1,334 @@
+/// @file geohex/geocoder.cpp
+#include "kmx/geohex/geocoder.hpp"
+#include "kmx/geohex/cell.hpp"
+#include "kmx/geohex/cell/bounds.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <kmx/parallel.hpp>
+#include <utility>
+
+namespace kmx::geohex::geocoder
+{
+    using id_t = store::id_t;
+
+    /// @brief The bit of an entry telling its cell is on the boundary of the polygon, which then needs a test.
+    static constexpr id_t candidate_flag = id_t {1u} << 31u;
+
+    /// @brief Tells a saved store ("GHRG" in little endian order) and the byte order it was saved in.
+    static constexpr std::uint32_t magic = 0x47524847u;
+
+    /// @brief The version of the saved layout.
+    static constexpr std::uint32_t version = 1u;
+
+    /// @brief A cell of the cover of a polygon.
+    struct entry
+    {
+        index cell;
+        id_t id {};
+
+        /// @brief Orders by cell, then the interior entries before the candidates.
+        bool operator<(const entry& other) const noexcept
+        {
+            return cell != other.cell ? cell < other.cell : id < other.id;
+        }
+    };
+
+    /// @brief Checks the offsets of a batch of polygons, each with its outer ring.
+    static bool are_valid(const polygon::batch::polygons& polygons) noexcept
+    {
+        const auto ring_count = polygons.ring_offsets.empty() ? 0u : polygons.ring_offsets.size() - 1u;
+        if (!are_valid_offsets(polygons.ring_offsets, polygons.coordinates.size()) ||
+            !are_valid_offsets(polygons.polygon_offsets, ring_count))
+            return false;
+
+        return std::adjacent_find(polygons.polygon_offsets.begin(), polygons.polygon_offsets.end()) == polygons.polygon_offsets.end();
+    }
+
+    /// @brief Walks a polygon down the cell hierarchy.
+    class walker
+    {
+    public:
+        explicit walker(const resolution_t resolution) noexcept: resolution_ {resolution}
+        {
+            // every point of the cells of the resolution below a cell is within this distance of its center
+            cell::bounds::reaches(resolution, reaches_);
+        }
+
+        /// @brief Appends the cover of a polygon: the coarsest cells inside it, then the cells of the resolution its
+        /// boundary may pass through, as candidates.
+        void cover(const polygon::prepared& polygon, const id_t id, std::vector<entry>& out) const
+        {
+            for (const auto& [cell, center]: cell::bounds::base_cells())
+                descend(polygon, id, cell, center, out);
+        }
+
+    private:
+        void descend(const polygon::prepared& polygon, const id_t id, const index cell, const gis::wgs84::coordinate& center,
+                     std::vector<entry>& out) const
+        {
+            if (!polygon.crosses(center, reaches_[+cell.resolution()]))
+            {
+                // the boundary stays away from the cell and its descendants: they are all in or all out
+                if (polygon.contains(center))
+                    out.push_back({cell, id});
+                return;
+            }
+
+            if (cell.resolution() == resolution_)
+            {
+                out.push_back({cell, id | candidate_flag});
+                return;
+            }
+
+            cell::for_each_child(cell,
+                                 [&](const index child)
+                                 {
+                                     gis::wgs84::coordinate child_center;
+                                     if (to_wgs(child, child_center) == error_t::none)
+                                         descend(polygon, id, child, child_center, out);
+                                 });
+        }
+
+        const resolution_t resolution_;
+        double reaches_[resolution_count] {};
+    };
+
+    /// @brief Appends values to a buffer, as they are in memory.
+    template <typename T>
+    static void put(std::vector<std::byte>& data, const std::span<const T> values)
+    {
+        const auto size = data.size();
+        data.resize(size + values.size_bytes());
+        if (!values.empty())
+            std::memcpy(data.data() + size, values.data(), values.size_bytes());
+    }
+
+    /// @brief Appends sizes to a buffer as 64 bit values.
+    static void put_sizes(std::vector<std::byte>& data, const std::span<const std::size_t> sizes)
+    {
+        std::vector<std::uint64_t> values(sizes.begin(), sizes.end());
+        put<std::uint64_t>(data, values);
+    }
+
+    /// @brief Reads values from a buffer, advancing it.
+    /// @return False, with the values and the buffer untouched, for a buffer too short.
+    template <typename T>
+    static bool take(std::span<const std::byte>& data, const std::span<T> values) noexcept
+    {
+        if (data.size() < values.size_bytes())
+            return false;
+
+        if (!values.empty())
+            std::memcpy(values.data(), data.data(), values.size_bytes());
+        data = data.subspan(values.size_bytes());
+        return true;
+    }
+
+    /// @brief Reads sizes saved as 64 bit values from a buffer, advancing it.
+    static bool take_sizes(std::span<const std::byte>& data, std::vector<std::size_t>& sizes)
+    {
+        std::vector<std::uint64_t> values(sizes.size());
+        if (!take<std::uint64_t>(data, values))
+            return false;
+
+        std::copy(values.begin(), values.end(), sizes.begin());
+        return true;
+    }
+
+    error_t store::build(const polygon::batch::polygons& polygons, const resolution_t resolution)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        const auto count = polygons.size();
+        if (!are_valid(polygons) || (count >= candidate_flag))
+            return error_t::domain;
+
+        store result;
+        result.resolution_ = resolution;
+        result.coordinates_.assign(polygons.coordinates.begin(), polygons.coordinates.end());
+        result.ring_offsets_.assign(polygons.ring_offsets.begin(), polygons.ring_offsets.end());
+        result.polygon_offsets_.assign(polygons.polygon_offsets.begin(), polygons.polygon_offsets.end());
+        auto err = result.prepare();
+        if (err != error_t::none)
+            return err;
+
+        // 1. The covers of the chunks of polygons, each in its own entries.
+        std::vector<std::vector<entry>> chunks((count + chunk_size - 1u) / chunk_size);
+        const walker walk {resolution};
+        for_each_chunk(count,
+                       [&](const std::size_t first, const std::size_t last, const std::size_t chunk)
+                       {
+                           for (auto i = first; i != last; ++i)
+                               walk.cover(result.polygons_[i], static_cast<id_t>(i), chunks[chunk]);
+                       });
+
+        // 2. The entries of all the chunks, sorted into the map.
+        std::vector<entry> entries;
+        std::size_t total {};
+        for (const auto& chunk: chunks)
+            total += chunk.size();
+        entries.reserve(total);
+        for (auto& chunk: chunks)
+        {
+            entries.insert(entries.end(), chunk.begin(), chunk.end());
+            chunk = {};
+        }
+
+        std::sort(entries.begin(), entries.end());
+        result.entries_.reserve(entries.size());
+        for (const auto& item: entries)
+        {
+            if (result.cells_.empty() || (result.cells_.back() != item.cell))
+            {
+                result.cells_.push_back(item.cell);
+                result.offsets_.push_back(result.entries_.size());
+            }
+            result.entries_.push_back(item.id);
+        }
+        result.offsets_.push_back(result.entries_.size());
+
+        for (const auto cell: result.cells_)
+            result.resolutions_ |= static_cast<std::uint16_t>(1u << +cell.resolution());
+
+        *this = std::move(result);
+        return error_t::none;
+    }
+
+    error_t store::prepare()
+    {
+        const polygon::batch::polygons input {coordinates_, ring_offsets_, polygon_offsets_};
+        const auto count = input.size();
+        polygons_.clear();
+        polygons_.resize(count);
+
+        std::vector<error_t> errors((count + chunk_size - 1u) / chunk_size);
+        for_each_chunk(count,
+                       [&](const std::size_t first, const std::size_t last, const std::size_t chunk)
+                       {
+                           const auto ring_of = [&input](const std::size_t ring)
+                           {
+                               const auto offset = input.ring_offsets[ring];
+                               return input.coordinates.subspan(offset, input.ring_offsets[ring + 1u] - offset);
+                           };
+
+                           std::vector<polygon::span_based::item> holes;
+                           for (auto i = first; i != last; ++i)
+                           {
+                               holes.clear();
+                               for (auto ring = input.polygon_offsets[i] + 1u; ring < input.polygon_offsets[i + 1u]; ++ring)
+                                   holes.push_back(ring_of(ring));
+
+                               polygons_[i].assign(ring_of(input.polygon_offsets[i]), holes);
+                               if (!polygons_[i].is_finite())
+                                   errors[chunk] = error_t::latlng_domain;
+                           }
+                       });
+
+        const auto failed = std::find_if(errors.begin(), errors.end(), [](const error_t err) { return err != error_t::none; });
+        return failed != errors.end() ? *failed : error_t::none;
+    }
+
+    id_t store::find(const gis::wgs84::coordinate& coord) const noexcept
+    {
+        index finest;
+        if (cells_.empty() || (from_wgs(coord, resolution_, finest) != error_t::none))
+            return none;
+
+        // the coarsest cells first: a point inside a polygon usually finds it without a test, the candidates are all at
+        // the finest resolution, after the interior entries of their cell
+        for (std::uint32_t res {}; res <= +resolution_; ++res)
+        {
+            if ((resolutions_ & (1u << res)) == 0u)
+                continue;
+
+            const auto key = cell::parent(finest, static_cast<resolution_t>(res));
+            const auto found = std::lower_bound(cells_.begin(), cells_.end(), key);
+            if ((found == cells_.end()) || (*found != key))
+                continue;
+
+            const auto i = static_cast<std::size_t>(found - cells_.begin());
+            for (auto j = offsets_[i]; j != offsets_[i + 1u]; ++j)
+            {
+                const auto id = entries_[j] & ~candidate_flag;
+                if (((entries_[j] & candidate_flag) == 0u) || polygons_[id].contains(coord))
+                    return id;
+            }
+        }
+
+        return none;
+    }
+
+    void store::save(std::vector<std::byte>& data) const
+    {
+        const std::array<std::uint32_t, 4u> header {magic, version, +resolution_, 0u};
+        put<std::uint32_t>(data, header);
+
+        const std::array<std::uint64_t, 5u> sizes {coordinates_.size(), ring_offsets_.size(), polygon_offsets_.size(), cells_.size(),
+                                                   entries_.size()};
+        put<std::uint64_t>(data, sizes);
+
+        put<gis::wgs84::coordinate>(data, coordinates_);
+        put_sizes(data, ring_offsets_);
+        put_sizes(data, polygon_offsets_);
+
+        std::vector<index::value_t> cells(cells_.begin(), cells_.end());
+        put<index::value_t>(data, cells);
+        put_sizes(data, offsets_);
+        put<id_t>(data, entries_);
+    }
+
+    error_t store::load(std::span<const std::byte>& data)
+    {
+        auto input = data;
+        std::array<std::uint32_t, 4u> header {};
+        std::array<std::uint64_t, 5u> sizes {};
+        if (!take<std::uint32_t>(input, header) || (header[0] != magic) || (header[1] != version) || (header[2] >= resolution_count) ||
+            !take<std::uint64_t>(input, sizes))
+            return error_t::domain;
+
+        // sizes that could not fit in the data are rejected before anything is allocated
+        const auto [coordinate_count, ring_count, polygon_count, cell_count, entry_count] = sizes;
+        if ((coordinate_count > input.size() / sizeof(gis::wgs84::coordinate)) || (ring_count > input.size() / sizeof(std::uint64_t)) ||
+            (polygon_count > input.size() / sizeof(std::uint64_t)) || (cell_count >= input.size() / sizeof(std::uint64_t)) ||
+            (entry_count > input.size() / sizeof(id_t)))
+            return error_t::domain;
+
+        store result;
+        result.resolution_ = static_cast<resolution_t>(header[2]);
+        result.coordinates_.resize(coordinate_count);
+        result.ring_offsets_.resize(ring_count);
+        result.polygon_offsets_.resize(polygon_count);
+        std::vector<index::value_t> cells(cell_count);
+        result.offsets_.resize(cell_count + 1u);
+        result.entries_.resize(entry_count);
+        if (!take<gis::wgs84::coordinate>(input, result.coordinates_) || !take_sizes(input, result.ring_offsets_) ||
+            !take_sizes(input, result.polygon_offsets_) || !take<index::value_t>(input, cells) || !take_sizes(input, result.offsets_) ||
+            !take<id_t>(input, result.entries_))
+            return error_t::domain;
+
+        const polygon::batch::polygons polygons {result.coordinates_, result.ring_offsets_, result.polygon_offsets_};
+        if (!are_valid(polygons) || !are_valid_offsets(result.offsets_, entry_count) ||
+            std::adjacent_find(cells.begin(), cells.end(), std::greater_equal {}) != cells.end())
+            return error_t::domain;
+
+        result.cells_.assign(cells.begin(), cells.end());
+        for (const auto cell: result.cells_)
+        {
+            if (!cell.is_valid() || (cell.resolution() > result.resolution_))
+                return error_t::domain;
+            result.resolutions_ |= static_cast<std::uint16_t>(1u << +cell.resolution());
+        }
+
+        if (std::any_of(result.entries_.begin(), result.entries_.end(),
+                        [&polygons](const id_t id) { return (id & ~candidate_flag) >= polygons.size(); }) ||
+            (result.prepare() != error_t::none))
+            return error_t::domain;
+
+        *this = std::move(result);
+        data = input;
+        return error_t::none;
+    }
+}
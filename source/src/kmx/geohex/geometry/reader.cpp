@@ -0,0 +1,473 @@
+/// @file geohex/geometry/reader.cpp
+#include "kmx/geohex/geometry/reader.hpp"
+#include "kmx/geohex/util.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
+namespace kmx::geohex::geometry
+{
+    /// @brief Appends the rings and parts of a geometry to an item.
+    class builder
+    {
+    public:
+        builder(item& out, const unit_t unit) noexcept: out_ {out}, scale_ {unit == unit_t::degrees ? pi_180 : 1.0} {}
+
+        void start(const type_t type)
+        {
+            out_.type = type;
+            out_.coordinates.clear();
+            out_.ring_offsets.assign(1u, 0u);
+            out_.part_offsets.assign(1u, 0u);
+        }
+
+        void add(const double x, const double y) { out_.coordinates.emplace_back(y * scale_, x * scale_); }
+
+        /// @param closed Whether the ring repeats its first vertex at the end, to drop.
+        void end_ring(const bool closed)
+        {
+            const auto first = out_.ring_offsets.back();
+            auto& coordinates = out_.coordinates;
+            if (closed && (coordinates.size() - first > 1u) && (coordinates[first].latitude == coordinates.back().latitude) &&
+                (coordinates[first].longitude == coordinates.back().longitude))
+                coordinates.pop_back();
+
+            out_.ring_offsets.push_back(coordinates.size());
+        }
+
+        /// @brief Ends a part, unless it has no ring.
+        void end_part()
+        {
+            const auto ring_count = out_.ring_offsets.size() - 1u;
+            if (ring_count != out_.part_offsets.back())
+                out_.part_offsets.push_back(ring_count);
+        }
+
+    private:
+        item& out_;
+        const double scale_;
+    };
+
+    /// @brief The single type of the parts of a multi type, or the type itself.
+    static constexpr type_t part_type(const type_t type) noexcept
+    {
+        return +type >= +type_t::multi_point ? static_cast<type_t>(+type - 3u) : type;
+    }
+
+    /// @brief Reads WKB values, each geometry in its own byte order.
+    class wkb_reader
+    {
+    public:
+        wkb_reader(const std::span<const std::byte> data, builder& out) noexcept: data_ {data}, out_ {out} {}
+
+        std::size_t position() const noexcept { return position_; }
+
+        /// @brief Reads a geometry, starting the output with its type.
+        bool geometry()
+        {
+            type_t type {};
+            if (!header(type))
+                return false;
+
+            out_.start(type);
+            if (type == part_type(type))
+                return part(type);
+
+            std::uint32_t count {};
+            if (!read(count))
+                return false;
+
+            for (std::uint32_t i {}; i != count; ++i)
+            {
+                type_t item_type {};
+                if (!header(item_type) || (item_type != part_type(type)) || !part(item_type))
+                    return false;
+            }
+
+            return true;
+        }
+
+    private:
+        /// @brief Reads the byte order, type and dimensions of a geometry.
+        bool header(type_t& type)
+        {
+            std::uint8_t order {};
+            if (!read(order) || (order > 1u))
+                return false;
+
+            swap_ = (order == 1u) != (std::endian::native == std::endian::little);
+
+            std::uint32_t code {};
+            if (!read(code))
+                return false;
+
+            // extended WKB flags, then ISO WKB dimensions in the thousands
+            const bool z = (code & 0x80000000u) != 0u;
+            const bool m = (code & 0x40000000u) != 0u;
+            const bool srid = (code & 0x20000000u) != 0u;
+            code &= 0x0fffffffu;
+            const auto iso = code / 1000u;
+            code %= 1000u;
+            if ((iso > 3u) || ((z || m) && (iso != 0u)) || (code < +type_t::point) || (code > +type_t::multi_polygon))
+                return false;
+
+            std::uint32_t srid_value {};
+            if (srid && !read(srid_value))
+                return false;
+
+            extra_ = static_cast<std::uint8_t>(z) + static_cast<std::uint8_t>(m) + (iso == 3u ? 2u : iso != 0u ? 1u : 0u);
+            type = static_cast<type_t>(code);
+            return true;
+        }
+
+        /// @brief Reads the body of a geometry of a single type, as a part.
+        bool part(const type_t type)
+        {
+            switch (type)
+            {
+                case type_t::point:
+                {
+                    double x {}, y {};
+                    if (!read(x) || !read(y) || !skip_extra())
+                        return false;
+
+                    if (!std::isnan(x) || !std::isnan(y))
+                    {
+                        out_.add(x, y);
+                        out_.end_ring(false);
+                    }
+                    break;
+                }
+                case type_t::line_string:
+                    if (!ring(false))
+                        return false;
+                    break;
+                case type_t::polygon:
+                {
+                    std::uint32_t ring_count {};
+                    if (!read(ring_count))
+                        return false;
+
+                    for (std::uint32_t i {}; i != ring_count; ++i)
+                        if (!ring(true))
+                            return false;
+                    break;
+                }
+                default:
+                    return false;
+            }
+
+            out_.end_part();
+            return true;
+        }
+
+        bool ring(const bool closed)
+        {
+            std::uint32_t count {};
+            if (!read(count))
+                return false;
+
+            // a count beyond the data fails before anything is appended
+            const auto point_size = (2u + extra_) * sizeof(double);
+            if (count > (data_.size() - position_) / point_size)
+                return false;
+
+            for (std::uint32_t i {}; i != count; ++i)
+            {
+                double x {}, y {};
+                read(x);
+                read(y);
+                position_ += extra_ * sizeof(double);
+                out_.add(x, y);
+            }
+
+            out_.end_ring(closed);
+            return true;
+        }
+
+        bool skip_extra() noexcept
+        {
+            const auto size = extra_ * sizeof(double);
+            if (size > data_.size() - position_)
+                return false;
+
+            position_ += size;
+            return true;
+        }
+
+        template <typename T>
+        bool read(T& value) noexcept
+        {
+            if (sizeof(T) > data_.size() - position_)
+                return false;
+
+            using bits_t = std::conditional_t<sizeof(T) == 8u, std::uint64_t,
+                                              std::conditional_t<sizeof(T) == 4u, std::uint32_t, std::uint8_t>>;
+            bits_t bits;
+            std::memcpy(&bits, data_.data() + position_, sizeof(T));
+            position_ += sizeof(T);
+            if (swap_)
+                bits = std::byteswap(bits);
+            value = std::bit_cast<T>(bits);
+            return true;
+        }
+
+        const std::span<const std::byte> data_;
+        builder& out_;
+        std::size_t position_ {};
+        std::uint8_t extra_ {}; ///< The Z and M values following X and Y.
+        bool swap_ {};
+    };
+
+    /// @brief Reads WKT tokens.
+    class wkt_reader
+    {
+    public:
+        wkt_reader(const std::string_view text, builder& out) noexcept: text_ {text}, out_ {out} {}
+
+        std::size_t position() const noexcept { return position_; }
+
+        /// @brief Reads a geometry, starting the output with its type.
+        bool geometry()
+        {
+            // an extended WKT spatial reference, ignored
+            skip_space();
+            if (keyword_is("SRID"))
+            {
+                position_ += 4u;
+                if (!consume('='))
+                    return false;
+
+                double srid {};
+                if (!number(srid) || !consume(';'))
+                    return false;
+            }
+
+            type_t type {};
+            if (!header(type))
+                return false;
+
+            out_.start(type);
+            if (empty())
+                return true;
+
+            if (type == part_type(type))
+                return part(type);
+
+            if (!consume('('))
+                return false;
+
+            do
+            {
+                // the points of a multi point may go without parentheses
+                if ((type == type_t::multi_point) && !peek('('))
+                {
+                    if (!empty() && !point())
+                        return false;
+
+                    out_.end_part();
+                    continue;
+                }
+
+                if (!empty() && !part(part_type(type)))
+                    return false;
+            } while (consume(','));
+
+            return consume(')');
+        }
+
+    private:
+        /// @brief Reads the type and dimensions of a geometry.
+        bool header(type_t& type)
+        {
+            static constexpr std::array<std::string_view, 6u> names {
+                "POINT", "LINESTRING", "POLYGON", "MULTIPOINT", "MULTILINESTRING", "MULTIPOLYGON",
+            };
+
+            const auto name = word();
+            const auto found =
+                std::find_if(names.begin(), names.end(), [&name](const std::string_view item) { return equals(name, item); });
+            if (found == names.end())
+                return false;
+
+            type = static_cast<type_t>(found - names.begin() + 1);
+
+            // the Z and M values are skipped whatever the dimensions
+            const auto mark = position_;
+            const auto dimensions = word();
+            if (!equals(dimensions, "Z") && !equals(dimensions, "M") && !equals(dimensions, "ZM"))
+                position_ = mark;
+
+            return true;
+        }
+
+        /// @brief Reads the body of a geometry of a single type, as a part.
+        bool part(const type_t type)
+        {
+            switch (type)
+            {
+                case type_t::point:
+                    if (!consume('(') || !point() || !consume(')'))
+                        return false;
+                    break;
+                case type_t::line_string:
+                    if (!ring(false))
+                        return false;
+                    break;
+                case type_t::polygon:
+                    if (!consume('('))
+                        return false;
+
+                    do
+                    {
+                        if (!ring(true))
+                            return false;
+                    } while (consume(','));
+
+                    if (!consume(')'))
+                        return false;
+                    break;
+                default:
+                    return false;
+            }
+
+            out_.end_part();
+            return true;
+        }
+
+        bool ring(const bool closed)
+        {
+            if (!consume('('))
+                return false;
+
+            do
+            {
+                if (!vertex())
+                    return false;
+            } while (consume(','));
+
+            out_.end_ring(closed);
+            return consume(')');
+        }
+
+        /// @brief Reads a point as a ring of its own.
+        bool point()
+        {
+            if (!vertex())
+                return false;
+
+            out_.end_ring(false);
+            return true;
+        }
+
+        /// @brief Reads a vertex, skipping its Z and M values.
+        bool vertex()
+        {
+            double x {}, y {};
+            if (!number(x) || !number(y))
+                return false;
+
+            for (double extra {}; !peek(',') && !peek(')');)
+                if (!number(extra))
+                    return false;
+
+            out_.add(x, y);
+            return true;
+        }
+
+        bool empty()
+        {
+            const auto mark = position_;
+            if (equals(word(), "EMPTY"))
+                return true;
+
+            position_ = mark;
+            return false;
+        }
+
+        std::string_view word() noexcept
+        {
+            skip_space();
+            const auto first = position_;
+            while ((position_ != text_.size()) && std::isalpha(static_cast<unsigned char>(text_[position_])))
+                ++position_;
+            return text_.substr(first, position_ - first);
+        }
+
+        bool keyword_is(const std::string_view keyword) const noexcept
+        {
+            return equals(text_.substr(position_, keyword.size()), keyword);
+        }
+
+        static bool equals(const std::string_view a, const std::string_view b) noexcept
+        {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                              [](const char x, const char y) { return std::toupper(static_cast<unsigned char>(x)) == y; });
+        }
+
+        bool number(double& value) noexcept
+        {
+            skip_space();
+            if ((position_ != text_.size()) && (text_[position_] == '+'))
+                ++position_;
+
+            const auto [end, error] = std::from_chars(text_.data() + position_, text_.data() + text_.size(), value);
+            if (error != std::errc {})
+                return false;
+
+            position_ = static_cast<std::size_t>(end - text_.data());
+            return true;
+        }
+
+        bool peek(const char c) noexcept
+        {
+            skip_space();
+            return (position_ != text_.size()) && (text_[position_] == c);
+        }
+
+        bool consume(const char c) noexcept
+        {
+            if (!peek(c))
+                return false;
+
+            ++position_;
+            return true;
+        }
+
+        void skip_space() noexcept
+        {
+            while ((position_ != text_.size()) && std::isspace(static_cast<unsigned char>(text_[position_])))
+                ++position_;
+        }
+
+        const std::string_view text_;
+        builder& out_;
+        std::size_t position_ {};
+    };
+
+    error_t read_wkb(std::span<const std::byte>& data, const unit_t unit, item& out)
+    {
+        builder output {out, unit};
+        wkb_reader reader {data, output};
+        if (!reader.geometry())
+            return error_t::domain;
+
+        data = data.subspan(reader.position());
+        return error_t::none;
+    }
+
+    error_t read_wkt(std::string_view& text, const unit_t unit, item& out)
+    {
+        builder output {out, unit};
+        wkt_reader reader {text, output};
+        if (!reader.geometry())
+            return error_t::domain;
+
+        text.remove_prefix(reader.position());
+        return error_t::none;
+    }
+}
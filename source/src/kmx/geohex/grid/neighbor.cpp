@@ -0,0 +1,203 @@
+/// @file geohex/grid/neighbor.cpp
+#include "kmx/geohex/grid/neighbor.hpp"
+#include "kmx/geohex/cell/base.hpp"
+#include "kmx/geohex/cell/pentagon.hpp"
+#include "kmx/geohex/icosahedron/face.hpp"
+#include <array>
+
+namespace kmx::geohex::grid::neighbor
+{
+    using digit_table_t = std::array<std::array<std::uint8_t, direction_count>, direction_count>;
+
+    /// @brief New digit after moving in a direction (column) from a digit (row) of a Class III resolution.
+    /// @ref NEW_DIGIT_II
+    static constexpr digit_table_t class3_digits {{
+        {0u, 1u, 2u, 3u, 4u, 5u, 6u}, // center
+        {1u, 4u, 3u, 6u, 5u, 2u, 0u}, // k
+        {2u, 3u, 1u, 4u, 6u, 0u, 5u}, // j
+        {3u, 6u, 4u, 5u, 0u, 1u, 2u}, // jk
+        {4u, 5u, 6u, 0u, 2u, 3u, 1u}, // i
+        {5u, 2u, 0u, 1u, 3u, 6u, 4u}, // ik
+        {6u, 0u, 5u, 2u, 1u, 4u, 3u}, // ij
+    }};
+
+    /// @brief Direction carried to the parent resolution after moving from a digit of a Class III resolution.
+    /// @ref NEW_ADJUSTMENT_II
+    static constexpr digit_table_t class3_carries {{
+        {0u, 0u, 0u, 0u, 0u, 0u, 0u}, // center
+        {0u, 1u, 0u, 1u, 0u, 5u, 0u}, // k
+        {0u, 0u, 2u, 3u, 0u, 0u, 2u}, // j
+        {0u, 1u, 3u, 3u, 0u, 0u, 0u}, // jk
+        {0u, 0u, 0u, 0u, 4u, 4u, 6u}, // i
+        {0u, 5u, 0u, 0u, 4u, 5u, 0u}, // ik
+        {0u, 0u, 2u, 0u, 6u, 0u, 6u}, // ij
+    }};
+
+    /// @brief New digit after moving in a direction (column) from a digit (row) of a Class II resolution.
+    /// @ref NEW_DIGIT_III
+    static constexpr digit_table_t class2_digits {{
+        {0u, 1u, 2u, 3u, 4u, 5u, 6u}, // center
+        {1u, 2u, 3u, 4u, 5u, 6u, 0u}, // k
+        {2u, 3u, 4u, 5u, 6u, 0u, 1u}, // j
+        {3u, 4u, 5u, 6u, 0u, 1u, 2u}, // jk
+        {4u, 5u, 6u, 0u, 1u, 2u, 3u}, // i
+        {5u, 6u, 0u, 1u, 2u, 3u, 4u}, // ik
+        {6u, 0u, 1u, 2u, 3u, 4u, 5u}, // ij
+    }};
+
+    /// @brief Direction carried to the parent resolution after moving from a digit of a Class II resolution.
+    /// @ref NEW_ADJUSTMENT_III
+    static constexpr digit_table_t class2_carries {{
+        {0u, 0u, 0u, 0u, 0u, 0u, 0u}, // center
+        {0u, 1u, 0u, 3u, 0u, 1u, 0u}, // k
+        {0u, 0u, 2u, 2u, 0u, 0u, 6u}, // j
+        {0u, 3u, 2u, 3u, 0u, 0u, 0u}, // jk
+        {0u, 0u, 0u, 0u, 4u, 5u, 4u}, // i
+        {0u, 1u, 0u, 0u, 5u, 5u, 0u}, // ik
+        {0u, 0u, 6u, 0u, 4u, 0u, 6u}, // ij
+    }};
+
+    error_t get(const index origin, direction_t direction, int& rotations, index& out) noexcept
+    {
+        if (+direction >= direction_count)
+            return error_t::failed;
+
+        const auto old_base_cell = origin.base_cell();
+        if (old_base_cell >= cell::base::count)
+            return error_t::cell_invalid;
+
+        rotations %= 6;
+        for (int i {}; i < rotations; ++i)
+            direction = rotate_60ccw(direction);
+
+        index current = origin;
+        int new_rotations {};
+        const auto old_leading_digit = origin.leading_non_zero_digit();
+
+        // Replace the digits from the finest resolution up, carrying the move to the parent level until it is absorbed.
+        for (auto r = +origin.resolution();; --r)
+        {
+            if (r == 0u)
+            {
+                // The move escaped the base cell.
+                auto new_base_cell = cell::base::neighbor_of(old_base_cell, direction);
+                new_rotations = cell::base::rotations_60ccw(old_base_cell)[+direction];
+                if (new_base_cell == cell::base::invalid_index)
+                {
+                    // The deleted k vertex of a pentagon base cell: this edge actually borders the ik neighbor.
+                    new_base_cell = cell::base::neighbor_of(old_base_cell, direction_t::ik_axes);
+                    new_rotations = cell::base::rotations_60ccw(old_base_cell)[+direction_t::ik_axes];
+                    current.rotate_60ccw();
+                    ++rotations;
+                }
+
+                current.set_base_cell(new_base_cell);
+                break;
+            }
+
+            const auto digit_no = static_cast<index::digit_index>(r - 1u);
+            const auto old_digit = static_cast<std::uint8_t>(current.digit(digit_no));
+            if (old_digit >= direction_count)
+                return error_t::cell_invalid;
+
+            const bool class3 = is_class_3(static_cast<resolution_t>(r));
+            const auto& digits = class3 ? class3_digits : class2_digits;
+            const auto& carries = class3 ? class3_carries : class2_carries;
+            current.set_digit(digit_no, static_cast<index::digit_t>(digits[old_digit][+direction]));
+            direction = static_cast<direction_t>(carries[old_digit][+direction]);
+            if (direction == direction_t::center)
+                break;
+        }
+
+        const auto new_base_cell = current.base_cell();
+        if (cell::pentagon::check(new_base_cell))
+        {
+            bool already_adjusted_k_subsequence {};
+
+            // Force the rotation out of the missing k-axes subsequence.
+            if (current.leading_non_zero_digit() == direction_t::k_axes)
+            {
+                if (old_base_cell != new_base_cell)
+                {
+                    // Traversed into the deleted k subsequence of a pentagon from another base cell;
+                    // the way out depends on which side of the pentagon the origin face lies.
+                    if (icosahedron::face::is_cw_offset(new_base_cell, icosahedron::face::of(old_base_cell)))
+                        current.rotate_60cw();
+                    else
+                        current.rotate_60ccw();
+
+                    already_adjusted_k_subsequence = true;
+                }
+                else
+                {
+                    // Traversed into the deleted k subsequence from within the same pentagon base cell.
+                    switch (old_leading_digit)
+                    {
+                        case direction_t::center:
+                            return error_t::pentagon; // the k direction is deleted from here
+                        case direction_t::jk_axes:
+                            current.rotate_60ccw();
+                            ++rotations;
+                            break;
+                        case direction_t::ik_axes:
+                            current.rotate_60cw();
+                            rotations += 5;
+                            break;
+                        default:
+                            return error_t::failed;
+                    }
+                }
+            }
+
+            for (int i {}; i < new_rotations; ++i)
+                current.rotate_pentagon_60ccw();
+
+            // Account for the differing orientation of the base cells.
+            if (old_base_cell != new_base_cell)
+            {
+                if (cell::base::is_polar_pentagon(new_base_cell))
+                {
+                    // Polar pentagons have all i neighbors.
+                    if ((old_base_cell != 118u) && (old_base_cell != 8u) && (current.leading_non_zero_digit() != direction_t::jk_axes))
+                        ++rotations;
+                }
+                else if ((current.leading_non_zero_digit() == direction_t::ik_axes) && !already_adjusted_k_subsequence)
+                    ++rotations; // distortion introduced to the 5 neighbor by the deleted k subsequence
+            }
+        }
+        else
+        {
+            for (int i {}; i < new_rotations; ++i)
+                current.rotate_60ccw();
+        }
+
+        rotations = (rotations + new_rotations) % 6;
+        out = current;
+        return error_t::none;
+    }
+
+    direction_t direction_to(const index origin, const index destination) noexcept
+    {
+        // Skip the center, which is the origin itself, and the deleted k direction of pentagons.
+        const auto first = origin.is_pentagon() ? direction_t::j_axes : direction_t::k_axes;
+        for (auto d = +first; d != direction_count; ++d)
+        {
+            const auto direction = static_cast<direction_t>(d);
+            int rotations {};
+            index neighbor;
+            if ((get(origin, direction, rotations, neighbor) == error_t::none) && (neighbor == destination))
+                return direction;
+        }
+
+        return direction_t::invalid;
+    }
+
+    bool check(const index origin, const index destination) noexcept
+    {
+        if ((origin.mode() != index_mode_t::cell) || (destination.mode() != index_mode_t::cell) ||
+            (origin.resolution() != destination.resolution()) || (origin == destination))
+            return false;
+
+        return direction_to(origin, destination) != direction_t::invalid;
+    }
+}
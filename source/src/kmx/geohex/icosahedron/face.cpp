@@ -1,9 +1,9 @@
 /// @file geohex/icosahedron/face.cpp
 #include "kmx/geohex/icosahedron/face.hpp"
 #include "kmx/geohex/cell/base.hpp"
-#include "kmx/geohex/cell/boundary.hpp"
 #include "kmx/geohex/geo_projection.hpp"
 #include <array>
+#include <bitset>
 
 namespace kmx::geohex::icosahedron::face
 {
@@ -209,6 +209,93 @@ namespace kmx::geohex::icosahedron::face
         return {result[0u], result[1u]};
     }
 
+    /// @ref faceAxesAzRadsCII
+    static constexpr std::array<double, count> axis_azimuth_data {
+        5.619958268523939882, // face 0
+        5.760339081714187279, // face 1
+        0.780213654393430055, // face 2
+        0.430469363979999913, // face 3
+        6.130269123335111400, // face 4
+        2.692877706530642877, // face 5
+        2.982963003477243874, // face 6
+        3.532912002790141181, // face 7
+        3.494305004259568154, // face 8
+        3.003214169499538391, // face 9
+        5.930472956509811562, // face 10
+        0.138378484090254847, // face 11
+        0.448714947059150361, // face 12
+        0.158629650112549365, // face 13
+        5.891865957979238535, // face 14
+        2.711123289609793325, // face 15
+        3.294508837434268316, // face 16
+        3.804819692245439833, // face 17
+        3.664438879055192436, // face 18
+        2.361378999196363184  // face 19
+    };
+
+    double axis_azimuth(const id_t face) noexcept
+    {
+        return axis_azimuth_data[+face];
+    }
+
+    /// @ref faceNeighbors
+    static constexpr std::array<std::array<oriented_ijk, quadrant_count>, count> neighbor_data {{
+        {{{{{0, 0, 0}, id_t::f0}, 0}, {{{2, 0, 2}, id_t::f4}, 1}, {{{2, 2, 0}, id_t::f1}, 5}, {{{0, 2, 2}, id_t::f5}, 3}}},      // face 0
+        {{{{{0, 0, 0}, id_t::f1}, 0}, {{{2, 0, 2}, id_t::f0}, 1}, {{{2, 2, 0}, id_t::f2}, 5}, {{{0, 2, 2}, id_t::f6}, 3}}},      // face 1
+        {{{{{0, 0, 0}, id_t::f2}, 0}, {{{2, 0, 2}, id_t::f1}, 1}, {{{2, 2, 0}, id_t::f3}, 5}, {{{0, 2, 2}, id_t::f7}, 3}}},      // face 2
+        {{{{{0, 0, 0}, id_t::f3}, 0}, {{{2, 0, 2}, id_t::f2}, 1}, {{{2, 2, 0}, id_t::f4}, 5}, {{{0, 2, 2}, id_t::f8}, 3}}},      // face 3
+        {{{{{0, 0, 0}, id_t::f4}, 0}, {{{2, 0, 2}, id_t::f3}, 1}, {{{2, 2, 0}, id_t::f0}, 5}, {{{0, 2, 2}, id_t::f9}, 3}}},      // face 4
+        {{{{{0, 0, 0}, id_t::f5}, 0}, {{{2, 2, 0}, id_t::f10}, 3}, {{{2, 0, 2}, id_t::f14}, 3}, {{{0, 2, 2}, id_t::f0}, 3}}},    // face 5
+        {{{{{0, 0, 0}, id_t::f6}, 0}, {{{2, 2, 0}, id_t::f11}, 3}, {{{2, 0, 2}, id_t::f10}, 3}, {{{0, 2, 2}, id_t::f1}, 3}}},    // face 6
+        {{{{{0, 0, 0}, id_t::f7}, 0}, {{{2, 2, 0}, id_t::f12}, 3}, {{{2, 0, 2}, id_t::f11}, 3}, {{{0, 2, 2}, id_t::f2}, 3}}},    // face 7
+        {{{{{0, 0, 0}, id_t::f8}, 0}, {{{2, 2, 0}, id_t::f13}, 3}, {{{2, 0, 2}, id_t::f12}, 3}, {{{0, 2, 2}, id_t::f3}, 3}}},    // face 8
+        {{{{{0, 0, 0}, id_t::f9}, 0}, {{{2, 2, 0}, id_t::f14}, 3}, {{{2, 0, 2}, id_t::f13}, 3}, {{{0, 2, 2}, id_t::f4}, 3}}},    // face 9
+        {{{{{0, 0, 0}, id_t::f10}, 0}, {{{2, 2, 0}, id_t::f5}, 3}, {{{2, 0, 2}, id_t::f6}, 3}, {{{0, 2, 2}, id_t::f15}, 3}}},    // face 10
+        {{{{{0, 0, 0}, id_t::f11}, 0}, {{{2, 2, 0}, id_t::f6}, 3}, {{{2, 0, 2}, id_t::f7}, 3}, {{{0, 2, 2}, id_t::f16}, 3}}},    // face 11
+        {{{{{0, 0, 0}, id_t::f12}, 0}, {{{2, 2, 0}, id_t::f7}, 3}, {{{2, 0, 2}, id_t::f8}, 3}, {{{0, 2, 2}, id_t::f17}, 3}}},    // face 12
+        {{{{{0, 0, 0}, id_t::f13}, 0}, {{{2, 2, 0}, id_t::f8}, 3}, {{{2, 0, 2}, id_t::f9}, 3}, {{{0, 2, 2}, id_t::f18}, 3}}},    // face 13
+        {{{{{0, 0, 0}, id_t::f14}, 0}, {{{2, 2, 0}, id_t::f9}, 3}, {{{2, 0, 2}, id_t::f5}, 3}, {{{0, 2, 2}, id_t::f19}, 3}}},    // face 14
+        {{{{{0, 0, 0}, id_t::f15}, 0}, {{{2, 0, 2}, id_t::f16}, 1}, {{{2, 2, 0}, id_t::f19}, 5}, {{{0, 2, 2}, id_t::f10}, 3}}},  // face 15
+        {{{{{0, 0, 0}, id_t::f16}, 0}, {{{2, 0, 2}, id_t::f17}, 1}, {{{2, 2, 0}, id_t::f15}, 5}, {{{0, 2, 2}, id_t::f11}, 3}}},  // face 16
+        {{{{{0, 0, 0}, id_t::f17}, 0}, {{{2, 0, 2}, id_t::f18}, 1}, {{{2, 2, 0}, id_t::f16}, 5}, {{{0, 2, 2}, id_t::f12}, 3}}},  // face 17
+        {{{{{0, 0, 0}, id_t::f18}, 0}, {{{2, 0, 2}, id_t::f19}, 1}, {{{2, 2, 0}, id_t::f17}, 5}, {{{0, 2, 2}, id_t::f13}, 3}}},  // face 18
+        {{{{{0, 0, 0}, id_t::f19}, 0}, {{{2, 0, 2}, id_t::f15}, 1}, {{{2, 2, 0}, id_t::f18}, 5}, {{{0, 2, 2}, id_t::f14}, 3}}},  // face 19
+    }};
+
+    const oriented_ijk& neighbor(const id_t face, const quadrant_t quadrant) noexcept
+    {
+        return neighbor_data[+face][+quadrant];
+    }
+
+    std::optional<quadrant_t> adjacent_quadrant(const id_t face, const id_t other) noexcept
+    {
+        for (std::uint8_t i {}; i != quadrant_count; ++i)
+            if (neighbor_data[+face][i].face == other)
+                return static_cast<quadrant_t>(i);
+
+        return {};
+    }
+
+    /// @brief Powers of 7 by Class II resolution; a Class II grid is the Class II grid two resolutions coarser
+    /// scaled by 7.
+    static constexpr std::int32_t class_2_scale(const std::uint8_t class_2_res) noexcept
+    {
+        std::int32_t result = 1;
+        for (std::uint8_t i {}; i != class_2_res / 2u; ++i)
+            result *= 7;
+        return result;
+    }
+
+    std::int32_t max_dimension(const std::uint8_t class_2_res) noexcept
+    {
+        return 2 * class_2_scale(class_2_res);
+    }
+
+    std::int32_t unit_scale(const std::uint8_t class_2_res) noexcept
+    {
+        return class_2_scale(class_2_res);
+    }
+
     /// @ref getIcosahedronFaces
     /// @brief Determines the set of icosahedron faces a given H3 cell intersects.
     error_t get_intersected(const index index, std::span<no_t>& output) noexcept
@@ -219,61 +306,47 @@ namespace kmx::geohex::icosahedron::face
             return error_t::cell_invalid;
         }
 
-        // Use a bitset for highly efficient, O(1) tracking of unique faces.
-        std::bitset<count> faces_found;
-
-        // 1. Get the cell's boundary vertices.
-        // We create a span of the full buffer to pass to the function.
-        std::array<gis::wgs84::coordinate, cell::boundary::max_vertices> boundary_data;
-        std::span<gis::wgs84::coordinate> boundary_span = boundary_data;
-
-        // We assume cell::boundary::get will resize `boundary_span` to the actual count.
-        const error_t boundary_err = cell::boundary::get(index, boundary_span);
-        if (boundary_err != error_t::none)
+        // All the vertices of a Class II pentagon lie on face edges; its center child crosses the same faces.
+        const auto pentagon = index.is_pentagon();
+        if (pentagon && !is_class_3(index.resolution()))
         {
-            output = {};
-            return boundary_err;
+            auto child = index;
+            child.set_resolution(static_cast<resolution_t>(+index.resolution() + 1u));
+            child.set_digit(static_cast<geohex::index::digit_index>(+index.resolution()), +direction_t::center);
+            return get_intersected(child, output);
         }
 
-        // 2. Collect faces from all relevant points (vertices + center).
-        for (const auto& vertex_coord: boundary_span)
-            faces_found.set(+from_wgs(vertex_coord));
-
-        // Also check the cell center, which is essential for cells entirely within one face.
-        gis::wgs84::coordinate cell_center;
-        // Assuming the index can provide its center coordinate. This is a common requirement.
-        // A free function to_wgs(index, out) is also plausible.
-        const error_t center_err = to_wgs(index, cell_center);
-        if (center_err != error_t::none)
+        ijk center;
+        const auto err = from_index(index, center);
+        if (err != error_t::none)
         {
             output = {};
-            return center_err;
+            return err;
         }
 
-        faces_found.set(+from_wgs(cell_center));
-
-        // 3. Write the unique faces found into the output buffer.
-        std::size_t faces_written {};
-        const std::size_t output_capacity = output.size();
+        // The faces of the vertices, moved onto the face they lie on; a vertex exactly on a face edge counts for the face
+        // it was expressed on, like in H3.
+        std::array<ijk, 6u> vertices;
+        const auto class_2_res = to_vertices(center, index.resolution(), vertices);
 
-        // Iterate through all possible face IDs (0-19).
-        for (no_t i {}; i < count; ++i)
+        std::bitset<count> faces_found;
+        for (std::uint8_t i {}; i != (pentagon ? 5u : 6u); ++i)
         {
-            if (faces_found.test(i))
-            {
-                if (faces_written < output_capacity)
-                    output[faces_written++] = i;
-                else
-                    // The provided buffer is full. Stop writing but do not return an error,
-                    // as the operation was successful. The caller receives a truncated result.
-                    break;
-            }
+            auto& vertex = vertices[i];
+            if (pentagon)
+                adjust_pentagon_vertex_overage(vertex, class_2_res);
+            else
+                adjust_overage(vertex, class_2_res, false, true);
+
+            faces_found.set(+vertex.face);
         }
 
-        // 4. Resize the caller's span to reflect the actual number of faces written.
-        // This is the idiomatic way to return the count with this signature.
-        output = output.subspan(0u, faces_written);
+        std::size_t faces_written {};
+        for (no_t i {}; (i < count) && (faces_written < output.size()); ++i)
+            if (faces_found.test(i))
+                output[faces_written++] = i;
 
+        output = output.first(faces_written);
         return error_t::none;
     }
 
@@ -450,453 +523,232 @@ namespace kmx::geohex::icosahedron::face
         return {coordinate::ijk {unique_pseudo_ijk_array[item.index]}, item.face};
     }
 
-    /// @ref _h3ToFaceIjk (H3 C internal)
-    /// @brief Converts an H3 cell index to its corresponding FaceIJK representation.
-    /// @param index The H3 cell index.
-    /// @param out Output: The FaceIJK representation.
-    /// @return error_t::none on success, or an error code.
-    error_t from(const index index, ijk& out) noexcept
+    /// @brief Base cell orientation on a face.
+    struct base_cell_orientation
     {
-        if (!index.is_valid())
-            return error_t::cell_invalid;
-
-        const auto base_cell = index.base_cell();
-        const auto res = index.resolution();
-
-        // 1. Get the base cell's canonical orientation using direct lookups.
-        // This is far more efficient than a hash map.
-        oriented_ijk fijk_oriented;
-        fijk_oriented.face = of(base_cell);                                                  // from the existing `face_data` array
-        fijk_oriented.ijk_coords = {};                                                       // by definition
-        fijk_oriented.ccw_rotations_60 = cell::pentagon::clockwise_offsets(base_cell).first; // from the new array
-
-        // 2. From res 1 up to the cell's resolution, apply child digits to descend the tree.
-        for (resolution_t r = resolution_t::r1; +r <= +res; r = static_cast<resolution_t>(+r + 1u))
-        {
-            // Move to the center of the finer resolution grid.
-            auto& ijk_coords = fijk_oriented.ijk_coords;
-            if (is_class_3(r))
-                ijk_coords.down_ap7r();
-            else
-                ijk_coords.down_ap7();
-
-            const auto digit = static_cast<direction_t>(index.digit(+r - 1));
-
-            // Rotate the child digit to match the base cell's orientation
-            auto rotated_digit_ijk = coordinate::to_ijk(digit);
-            for (int i = 0; i < fijk_oriented.ccw_rotations_60; ++i)
-                rotated_digit_ijk.rotate_60ccw();
-
-            // Apply child digit vector
-            fijk_oriented.ijk_coords += rotated_digit_ijk;
-
-            // For pentagons, we must also apply local rotations based on the direction taken.
-            if (cell::pentagon::check(base_cell))
-            {
-                const auto& local_rots = cell::base::rotations_60ccw(base_cell);
-                for (int i = 0; i < local_rots[+digit]; ++i)
-                    fijk_oriented.ijk_coords.rotate_60ccw();
+        cell::base::id_t base_cell;     ///< The base cell.
+        std::uint8_t ccw_rotations_60;  ///< Counter-clockwise 60 deg rotations from the face frame to the base cell frame.
+    };
 
-                // TODO: A full implementation would call `adjust_overage` here if crossing face boundaries.
-            }
+    /// @brief The base cell at each resolution 0 coordinate of a face (which may lie on a neighboring face), indexed by
+    /// i * 9 + j * 3 + k.
+    /// @ref faceIjkBaseCells
+    static constexpr std::array<std::array<base_cell_orientation, 27u>, count> base_cell_data {{
+        {{ // face 0
+            {16u, 0u}, {18u, 0u}, {24u, 0u}, {33u, 0u}, {30u, 0u}, {32u, 3u}, {49u, 1u}, {48u, 3u}, {50u, 3u}, // i 0
+            {8u, 0u}, {5u, 5u}, {10u, 5u}, {22u, 0u}, {16u, 0u}, {18u, 0u}, {41u, 1u}, {33u, 0u}, {30u, 0u}, // i 1
+            {4u, 0u}, {0u, 5u}, {2u, 5u}, {15u, 1u}, {8u, 0u}, {5u, 5u}, {31u, 1u}, {22u, 0u}, {16u, 0u}, // i 2
+        }},
+        {{ // face 1
+            {2u, 0u}, {6u, 0u}, {14u, 0u}, {10u, 0u}, {11u, 0u}, {17u, 3u}, {24u, 1u}, {23u, 3u}, {25u, 3u}, // i 0
+            {0u, 0u}, {1u, 5u}, {9u, 5u}, {5u, 0u}, {2u, 0u}, {6u, 0u}, {18u, 1u}, {10u, 0u}, {11u, 0u}, // i 1
+            {4u, 1u}, {3u, 5u}, {7u, 5u}, {8u, 1u}, {0u, 0u}, {1u, 5u}, {16u, 1u}, {5u, 0u}, {2u, 0u}, // i 2
+        }},
+        {{ // face 2
+            {7u, 0u}, {21u, 0u}, {38u, 0u}, {9u, 0u}, {19u, 0u}, {34u, 3u}, {14u, 1u}, {20u, 3u}, {36u, 3u}, // i 0
+            {3u, 0u}, {13u, 5u}, {29u, 5u}, {1u, 0u}, {7u, 0u}, {21u, 0u}, {6u, 1u}, {9u, 0u}, {19u, 0u}, // i 1
+            {4u, 2u}, {12u, 5u}, {26u, 5u}, {0u, 1u}, {3u, 0u}, {13u, 5u}, {2u, 1u}, {1u, 0u}, {7u, 0u}, // i 2
+        }},
+        {{ // face 3
+            {26u, 0u}, {42u, 0u}, {58u, 0u}, {29u, 0u}, {43u, 0u}, {62u, 3u}, {38u, 1u}, {47u, 3u}, {64u, 3u}, // i 0
+            {12u, 0u}, {28u, 5u}, {44u, 5u}, {13u, 0u}, {26u, 0u}, {42u, 0u}, {21u, 1u}, {29u, 0u}, {43u, 0u}, // i 1
+            {4u, 3u}, {15u, 5u}, {31u, 5u}, {3u, 1u}, {12u, 0u}, {28u, 5u}, {7u, 1u}, {13u, 0u}, {26u, 0u}, // i 2
+        }},
+        {{ // face 4
+            {31u, 0u}, {41u, 0u}, {49u, 0u}, {44u, 0u}, {53u, 0u}, {61u, 3u}, {58u, 1u}, {65u, 3u}, {75u, 3u}, // i 0
+            {15u, 0u}, {22u, 5u}, {33u, 5u}, {28u, 0u}, {31u, 0u}, {41u, 0u}, {42u, 1u}, {44u, 0u}, {53u, 0u}, // i 1
+            {4u, 4u}, {8u, 5u}, {16u, 5u}, {12u, 1u}, {15u, 0u}, {22u, 5u}, {26u, 1u}, {28u, 0u}, {31u, 0u}, // i 2
+        }},
+        {{ // face 5
+            {50u, 0u}, {48u, 0u}, {49u, 3u}, {32u, 0u}, {30u, 3u}, {33u, 3u}, {24u, 3u}, {18u, 3u}, {16u, 3u}, // i 0
+            {70u, 0u}, {67u, 0u}, {66u, 3u}, {52u, 3u}, {50u, 0u}, {48u, 0u}, {37u, 3u}, {32u, 0u}, {30u, 3u}, // i 1
+            {83u, 0u}, {87u, 3u}, {85u, 3u}, {74u, 3u}, {70u, 0u}, {67u, 0u}, {57u, 3u}, {52u, 3u}, {50u, 0u}, // i 2
+        }},
+        {{ // face 6
+            {25u, 0u}, {23u, 0u}, {24u, 3u}, {17u, 0u}, {11u, 3u}, {10u, 3u}, {14u, 3u}, {6u, 3u}, {2u, 3u}, // i 0
+            {45u, 0u}, {39u, 0u}, {37u, 3u}, {35u, 3u}, {25u, 0u}, {23u, 0u}, {27u, 3u}, {17u, 0u}, {11u, 3u}, // i 1
+            {63u, 0u}, {59u, 3u}, {57u, 3u}, {56u, 3u}, {45u, 0u}, {39u, 0u}, {46u, 3u}, {35u, 3u}, {25u, 0u}, // i 2
+        }},
+        {{ // face 7
+            {36u, 0u}, {20u, 0u}, {14u, 3u}, {34u, 0u}, {19u, 3u}, {9u, 3u}, {38u, 3u}, {21u, 3u}, {7u, 3u}, // i 0
+            {55u, 0u}, {40u, 0u}, {27u, 3u}, {54u, 3u}, {36u, 0u}, {20u, 0u}, {51u, 3u}, {34u, 0u}, {19u, 3u}, // i 1
+            {72u, 0u}, {60u, 3u}, {46u, 3u}, {73u, 3u}, {55u, 0u}, {40u, 0u}, {71u, 3u}, {54u, 3u}, {36u, 0u}, // i 2
+        }},
+        {{ // face 8
+            {64u, 0u}, {47u, 0u}, {38u, 3u}, {62u, 0u}, {43u, 3u}, {29u, 3u}, {58u, 3u}, {42u, 3u}, {26u, 3u}, // i 0
+            {84u, 0u}, {69u, 0u}, {51u, 3u}, {82u, 3u}, {64u, 0u}, {47u, 0u}, {76u, 3u}, {62u, 0u}, {43u, 3u}, // i 1
+            {97u, 0u}, {89u, 3u}, {71u, 3u}, {98u, 3u}, {84u, 0u}, {69u, 0u}, {96u, 3u}, {82u, 3u}, {64u, 0u}, // i 2
+        }},
+        {{ // face 9
+            {75u, 0u}, {65u, 0u}, {58u, 3u}, {61u, 0u}, {53u, 3u}, {44u, 3u}, {49u, 3u}, {41u, 3u}, {31u, 3u}, // i 0
+            {94u, 0u}, {86u, 0u}, {76u, 3u}, {81u, 3u}, {75u, 0u}, {65u, 0u}, {66u, 3u}, {61u, 0u}, {53u, 3u}, // i 1
+            {107u, 0u}, {104u, 3u}, {96u, 3u}, {101u, 3u}, {94u, 0u}, {86u, 0u}, {85u, 3u}, {81u, 3u}, {75u, 0u}, // i 2
+        }},
+        {{ // face 10
+            {57u, 0u}, {59u, 0u}, {63u, 3u}, {74u, 0u}, {78u, 3u}, {79u, 3u}, {83u, 3u}, {92u, 3u}, {95u, 3u}, // i 0
+            {37u, 0u}, {39u, 3u}, {45u, 3u}, {52u, 0u}, {57u, 0u}, {59u, 0u}, {70u, 3u}, {74u, 0u}, {78u, 3u}, // i 1
+            {24u, 0u}, {23u, 3u}, {25u, 3u}, {32u, 3u}, {37u, 0u}, {39u, 3u}, {50u, 3u}, {52u, 0u}, {57u, 0u}, // i 2
+        }},
+        {{ // face 11
+            {46u, 0u}, {60u, 0u}, {72u, 3u}, {56u, 0u}, {68u, 3u}, {80u, 3u}, {63u, 3u}, {77u, 3u}, {90u, 3u}, // i 0
+            {27u, 0u}, {40u, 3u}, {55u, 3u}, {35u, 0u}, {46u, 0u}, {60u, 0u}, {45u, 3u}, {56u, 0u}, {68u, 3u}, // i 1
+            {14u, 0u}, {20u, 3u}, {36u, 3u}, {17u, 3u}, {27u, 0u}, {40u, 3u}, {25u, 3u}, {35u, 0u}, {46u, 0u}, // i 2
+        }},
+        {{ // face 12
+            {71u, 0u}, {89u, 0u}, {97u, 3u}, {73u, 0u}, {91u, 3u}, {103u, 3u}, {72u, 3u}, {88u, 3u}, {105u, 3u}, // i 0
+            {51u, 0u}, {69u, 3u}, {84u, 3u}, {54u, 0u}, {71u, 0u}, {89u, 0u}, {55u, 3u}, {73u, 0u}, {91u, 3u}, // i 1
+            {38u, 0u}, {47u, 3u}, {64u, 3u}, {34u, 3u}, {51u, 0u}, {69u, 3u}, {36u, 3u}, {54u, 0u}, {71u, 0u}, // i 2
+        }},
+        {{ // face 13
+            {96u, 0u}, {104u, 0u}, {107u, 3u}, {98u, 0u}, {110u, 3u}, {115u, 3u}, {97u, 3u}, {111u, 3u}, {119u, 3u}, // i 0
+            {76u, 0u}, {86u, 3u}, {94u, 3u}, {82u, 0u}, {96u, 0u}, {104u, 0u}, {84u, 3u}, {98u, 0u}, {110u, 3u}, // i 1
+            {58u, 0u}, {65u, 3u}, {75u, 3u}, {62u, 3u}, {76u, 0u}, {86u, 3u}, {64u, 3u}, {82u, 0u}, {96u, 0u}, // i 2
+        }},
+        {{ // face 14
+            {85u, 0u}, {87u, 0u}, {83u, 3u}, {101u, 0u}, {102u, 3u}, {100u, 3u}, {107u, 3u}, {112u, 3u}, {114u, 3u}, // i 0
+            {66u, 0u}, {67u, 3u}, {70u, 3u}, {81u, 0u}, {85u, 0u}, {87u, 0u}, {94u, 3u}, {101u, 0u}, {102u, 3u}, // i 1
+            {49u, 0u}, {48u, 3u}, {50u, 3u}, {61u, 3u}, {66u, 0u}, {67u, 3u}, {75u, 3u}, {81u, 0u}, {85u, 0u}, // i 2
+        }},
+        {{ // face 15
+            {95u, 0u}, {92u, 0u}, {83u, 0u}, {79u, 0u}, {78u, 0u}, {74u, 3u}, {63u, 1u}, {59u, 3u}, {57u, 3u}, // i 0
+            {109u, 0u}, {108u, 0u}, {100u, 5u}, {93u, 1u}, {95u, 0u}, {92u, 0u}, {77u, 1u}, {79u, 0u}, {78u, 0u}, // i 1
+            {117u, 4u}, {118u, 5u}, {114u, 5u}, {106u, 1u}, {109u, 0u}, {108u, 0u}, {90u, 1u}, {93u, 1u}, {95u, 0u}, // i 2
+        }},
+        {{ // face 16
+            {90u, 0u}, {77u, 0u}, {63u, 0u}, {80u, 0u}, {68u, 0u}, {56u, 3u}, {72u, 1u}, {60u, 3u}, {46u, 3u}, // i 0
+            {106u, 0u}, {93u, 0u}, {79u, 5u}, {99u, 1u}, {90u, 0u}, {77u, 0u}, {88u, 1u}, {80u, 0u}, {68u, 0u}, // i 1
+            {117u, 3u}, {109u, 5u}, {95u, 5u}, {113u, 1u}, {106u, 0u}, {93u, 0u}, {105u, 1u}, {99u, 1u}, {90u, 0u}, // i 2
+        }},
+        {{ // face 17
+            {105u, 0u}, {88u, 0u}, {72u, 0u}, {103u, 0u}, {91u, 0u}, {73u, 3u}, {97u, 1u}, {89u, 3u}, {71u, 3u}, // i 0
+            {113u, 0u}, {99u, 0u}, {80u, 5u}, {116u, 1u}, {105u, 0u}, {88u, 0u}, {111u, 1u}, {103u, 0u}, {91u, 0u}, // i 1
+            {117u, 2u}, {106u, 5u}, {90u, 5u}, {121u, 1u}, {113u, 0u}, {99u, 0u}, {119u, 1u}, {116u, 1u}, {105u, 0u}, // i 2
+        }},
+        {{ // face 18
+            {119u, 0u}, {111u, 0u}, {97u, 0u}, {115u, 0u}, {110u, 0u}, {98u, 3u}, {107u, 1u}, {104u, 3u}, {96u, 3u}, // i 0
+            {121u, 0u}, {116u, 0u}, {103u, 5u}, {120u, 1u}, {119u, 0u}, {111u, 0u}, {112u, 1u}, {115u, 0u}, {110u, 0u}, // i 1
+            {117u, 1u}, {113u, 5u}, {105u, 5u}, {118u, 1u}, {121u, 0u}, {116u, 0u}, {114u, 1u}, {120u, 1u}, {119u, 0u}, // i 2
+        }},
+        {{ // face 19
+            {114u, 0u}, {112u, 0u}, {107u, 0u}, {100u, 0u}, {102u, 0u}, {101u, 3u}, {83u, 1u}, {87u, 3u}, {85u, 3u}, // i 0
+            {118u, 0u}, {120u, 0u}, {115u, 5u}, {108u, 1u}, {114u, 0u}, {112u, 0u}, {92u, 1u}, {100u, 0u}, {102u, 0u}, // i 1
+            {117u, 0u}, {121u, 5u}, {119u, 5u}, {109u, 1u}, {118u, 0u}, {120u, 0u}, {95u, 1u}, {108u, 1u}, {114u, 0u}, // i 2
+        }},
+    }};
 
-            ijk_coords.normalize();
-        }
+    cell::base::id_t to_base_cell(const ijk& fijk) noexcept
+    {
+        const auto& coords = fijk.ijk_coords;
+        if ((coords.i > 2) || (coords.j > 2) || (coords.k > 2))
+            return cell::base::invalid_index;
 
-        out = fijk_oriented; // Copy face and ijk_coords
-        return error_t::none;
+        return base_cell_data[+fijk.face][coords.i * 9 + coords.j * 3 + coords.k].base_cell;
     }
 
-    static constexpr std::array<math::vector3d, 12u> icosahedron_vertices {{
-        {0.85065080835204, 0.00000000000000, 0.52573111211913},
-        {0.85065080835204, 0.00000000000000, -0.52573111211913},
-        {0.52573111211913, -0.85065080835204, 0.00000000000000},
-        {0.00000000000000, -0.52573111211913, 0.85065080835204},
-        {-0.52573111211913, -0.85065080835204, 0.00000000000000},
-        {-0.85065080835204, 0.00000000000000, 0.52573111211913},
-        {-0.52573111211913, 0.85065080835204, 0.00000000000000},
-        {0.00000000000000, 0.52573111211913, 0.85065080835204},
-        {0.52573111211913, 0.85065080835204, 0.00000000000000},
-        {-0.85065080835204, 0.00000000000000, -0.52573111211913},
-        {0.00000000000000, -0.52573111211913, -0.85065080835204},
-        {0.00000000000000, 0.52573111211913, -0.85065080835204},
-    }};
-
-    /// @brief Defines which 3 of the 12 vertices form each of the 20 faces.
-    /// The vertex indices are ordered counter-clockwise.
-    using face_vertices_t = std::array<std::int8_t, 3u>;
-    static constexpr std::array<face_vertices_t, count> face_to_vertices {
-        {{{0, 8, 7}},  {{0, 3, 2}},  {{0, 2, 1}},  {{0, 7, 5}},  {{0, 5, 3}},   {{8, 0, 1}},  {{2, 3, 4}},
-         {{3, 5, 4}},  {{5, 7, 6}},  {{7, 8, 6}},  {{1, 2, 10}}, {{4, 2, 10}},  {{9, 5, 6}},  {{4, 5, 9}},
-         {{6, 8, 11}}, {{8, 1, 11}}, {{9, 6, 11}}, {{10, 2, 4}}, {{1, 10, 11}}, {{9, 11, 10}}}};
-
-    /// @brief For each face, lists its 3 neighboring faces in CCW order.
-    /// A value of -1 indicates no neighbor in that direction (should not happen).
-    using face_neighbors_t = std::array<std::int8_t, 3u>;
-    static constexpr std::array<face_neighbors_t, count> face_neighbors {
-        {{{15, 9, 1}},  {{0, 2, 4}},  {{1, 10, 5}},   {{0, 4, 8}},    {{1, 3, 7}},    {{0, 10, 2}},  {{9, 8, 14}},
-         {{4, 13, 11}}, {{3, 12, 6}}, {{0, 14, 7}},   {{1, 5, 11}},   {{7, 17, 10}},  {{8, 16, 13}}, {{7, 12, 17}},
-         {{9, 16, 15}}, {{0, 18, 9}}, {{12, 14, 18}}, {{11, 13, 19}}, {{15, 16, 19}}, {{17, 18, 16}}}};
-
-    /// @brief Gets the neighboring face by traversing across a shared vertex.
-    /// @param face The starting face.
-    /// @param vertex The index of the vertex on the starting face (0, 1, or 2).
-    /// @return The ID of the neighboring face.
-    static id_t get_neighbor_face(const id_t face, const std::int8_t vertex) noexcept
+    int to_base_cell_rotations(const ijk& fijk) noexcept
     {
-        return static_cast<id_t>(face_neighbors[+face][vertex]);
+        const auto& coords = fijk.ijk_coords;
+        return base_cell_data[+fijk.face][coords.i * 9 + coords.j * 3 + coords.k].ccw_rotations_60;
     }
 
-    /// @ref _geoToFaceIjk (H3 C internal)
-    /// @brief Converts geographic WGS84 coordinates (radians) to FaceIJK representation.
-    error_t from_wgs(const gis::wgs84::coordinate& coord, const resolution_t res, ijk& out_fijk) noexcept
+    int base_cell_rotations(const cell::base::id_t base_cell, const id_t face) noexcept
     {
-        math::vector3d v3d;
-        projection::to_v3d(coord, v3d);
-        id_t center_face = from_wgs(coord);
+        for (const auto& item: base_cell_data[+face])
+            if (item.base_cell == base_cell)
+                return item.ccw_rotations_60;
 
-        math::vector2d uv;
-        if (projection::project_v3d_to_face_uv(v3d, center_face, uv) != error_t::none)
-            return error_t::failed;
-
-        coordinate::ijk center_ijk_coords;
-        if (projection::convert_face_uv_to_ijk(uv, res, center_ijk_coords) != error_t::none)
-            return error_t::failed;
+        return -1;
+    }
 
-        const auto center_v2d = coordinate::to_vec2<double>(center_ijk_coords);
-        double min_dist_sq = hex2d_distance_sq(uv, center_v2d);
+    overage_t adjust_overage(ijk& fijk, const std::uint8_t class_2_res, const bool pentagon_leading_4, const bool substrate) noexcept
+    {
+        auto& coords = fijk.ijk_coords;
 
-        out_fijk.face = center_face;
-        out_fijk.ijk_coords = center_ijk_coords;
+        // get the maximum dimension value; scale if a substrate grid
+        const auto max_dim = max_dimension(class_2_res) * (substrate ? 3 : 1);
+        const auto sum = coords.i + coords.j + coords.k;
+        if (substrate && (sum == max_dim))
+            return overage_t::face_edge;
 
-        std::array<id_t, count> face_queue;
-        int queue_pos = 0;
-        int queue_len = 1;
-        face_queue[0] = center_face;
-        std::array<bool, count> checked_faces {};
-        checked_faces[+center_face] = true;
+        if (sum <= max_dim)
+            return overage_t::none;
 
-        while (queue_pos < queue_len)
+        quadrant_t quadrant = quadrant_t::ij;
+        if (coords.k > 0)
         {
-            const id_t current_face = face_queue[queue_pos++];
-            for (int i = 0; i < 3; ++i)
+            if (coords.j > 0)
+                quadrant = quadrant_t::jk;
+            else
             {
-                id_t neighbor_face = get_neighbor_face(current_face, i);
-                if (checked_faces[+neighbor_face])
-                    continue;
-                checked_faces[+neighbor_face] = true;
-
-                math::vector2d neighbor_uv;
-                if (projection::project_v3d_to_face_uv(v3d, neighbor_face, neighbor_uv) != error_t::none)
-                    continue;
+                quadrant = quadrant_t::ki;
 
-                coordinate::ijk neighbor_ijk_coords;
-                projection::convert_face_uv_to_ijk(neighbor_uv, res, neighbor_ijk_coords);
-
-                const auto neighbor_v2d = coordinate::to_vec2<double>(neighbor_ijk_coords);
-                const double dist_sq = hex2d_distance_sq(neighbor_uv, neighbor_v2d);
-
-                if (dist_sq < min_dist_sq)
-                {
-                    min_dist_sq = dist_sq;
-                    out_fijk.face = neighbor_face;
-                    out_fijk.ijk_coords = neighbor_ijk_coords;
-                    queue_pos = 0;
-                    queue_len = 1;
-                    face_queue[0] = out_fijk.face;
-                    checked_faces.fill(false);
-                    checked_faces[+out_fijk.face] = true;
-                    break;
-                }
-                if (queue_len < count)
+                // adjust for the pentagonal missing sequence
+                if (pentagon_leading_4)
                 {
-                    face_queue[queue_len++] = neighbor_face;
+                    // translate the origin to the center of the pentagon, rotate, then translate back
+                    const coordinate::ijk origin {max_dim, 0, 0};
+                    auto tmp = coords - origin;
+                    tmp.rotate_60cw();
+                    coords = tmp + origin;
                 }
             }
         }
 
-        const auto final_base_cell = to_base_cell(out_fijk, res);
-        if (cell::pentagon::check(final_base_cell) && !is_class_3(res))
-        {
-            coordinate::ijk temp_ijk = out_fijk.ijk_coords;
-            temp_ijk.normalize();
-            if (temp_ijk.leading_digit(res) == direction_t::ik_axes)
-            {
-                out_fijk.ijk_coords.rotate_60cw();
-            }
-        }
-        return error_t::none;
-    }
+        const auto& orientation = neighbor(fijk.face, quadrant);
+        fijk.face = orientation.face;
 
-    std::optional<ijk> get(const std::uint8_t pentagon_no, const direction_t direction) noexcept
-    {
-        using ijk_tuple = std::tuple<std::int8_t, std::int8_t, std::int8_t>;
-        using face_ijk_tuple = std::tuple<ijk_tuple, id_t>;
-        using face_ijk_tuple_array_t = std::array<face_ijk_tuple, direction_count - 2u>;
-        using table_t = std::array<face_ijk_tuple_array_t, cell::pentagon::count>;
-
-        static constexpr table_t data //
-                                      // Pentagon 0 (BC 4)
-            {{{{
-                  {{2, 0, 0}, id_t::f4}, // J
-                  {{0, 2, 0}, id_t::f8}, // JK
-                  {{0, 0, 2}, id_t::f0}, // I
-                  {{0, 0, 2}, id_t::f3}, // IK
-                  {{2, 0, 0}, id_t::f1}  // IJ
-              }},
-              // Pentagon 1 (BC 14)
-              {{
-                  {{0, 0, 2}, id_t::f1},  // J
-                  {{2, 0, 0}, id_t::f6},  // JK
-                  {{0, 0, 2}, id_t::f11}, // I
-                  {{2, 0, 0}, id_t::f7},  // IK
-                  {{0, 2, 0}, id_t::f2}   // IJ
-              }},
-              // Pentagon 2 (BC 24)
-              {{
-                  {{2, 0, 0}, id_t::f5},  // J
-                  {{0, 2, 0}, id_t::f0},  // JK
-                  {{0, 0, 2}, id_t::f10}, // I
-                  {{0, 2, 0}, id_t::f1},  // IK
-                  {{0, 0, 2}, id_t::f6}   // IJ
-              }},
-              // Pentagon 3 (BC 38)
-              {{
-                  {{0, 0, 2}, id_t::f2},  // J
-                  {{0, 0, 2}, id_t::f7},  // JK
-                  {{0, 0, 2}, id_t::f12}, // I
-                  {{2, 0, 0}, id_t::f3},  // IK
-                  {{0, 2, 0}, id_t::f8}   // IJ
-              }},
-              // Pentagon 4 (BC 49)
-              {{
-                  {{2, 0, 0}, id_t::f9},  // J
-                  {{0, 2, 0}, id_t::f4},  // JK
-                  {{0, 0, 2}, id_t::f14}, // I
-                  {{2, 0, 0}, id_t::f0},  // IK
-                  {{0, 0, 2}, id_t::f5}   // IJ
-              }},
-              // Pentagon 5 (BC 58)
-              {{
-                  {{0, 2, 0}, id_t::f3},  // J
-                  {{0, 0, 2}, id_t::f4},  // JK
-                  {{0, 0, 2}, id_t::f13}, // I
-                  {{2, 0, 0}, id_t::f8},  // IK
-                  {{0, 2, 0}, id_t::f9}   // IJ
-              }},
-              // Pentagon 6 (BC 63)
-              {{
-                  {{0, 2, 0}, id_t::f16}, // J
-                  {{2, 0, 0}, id_t::f11}, // JK
-                  {{0, 0, 2}, id_t::f6},  // I
-                  {{2, 0, 0}, id_t::f1},  // IK
-                  {{0, 0, 2}, id_t::f15}  // IJ
-              }},
-              // Pentagon 7 (BC 72)
-              {{
-                  {{0, 2, 0}, id_t::f17}, // J
-                  {{2, 0, 0}, id_t::f12}, // JK
-                  {{0, 0, 2}, id_t::f7},  // I
-                  {{2, 0, 0}, id_t::f2},  // IK
-                  {{0, 0, 2}, id_t::f16}  // IJ
-              }},
-              // Pentagon 8 (BC 83)
-              {{
-                  {{0, 2, 0}, id_t::f19}, // J
-                  {{2, 0, 0}, id_t::f14}, // JK
-                  {{0, 0, 2}, id_t::f5},  // I
-                  {{0, 2, 0}, id_t::f0},  // IK
-                  {{0, 0, 2}, id_t::f10}  // IJ
-              }},
-              // Pentagon 9 (BC 97)
-              {{
-                  {{0, 2, 0}, id_t::f18}, // J
-                  {{2, 0, 0}, id_t::f13}, // JK
-                  {{0, 0, 2}, id_t::f8},  // I
-                  {{0, 2, 0}, id_t::f3},  // IK
-                  {{0, 0, 2}, id_t::f17}  // IJ
-              }},
-              // Pentagon 10 (BC 107)
-              {{
-                  {{2, 0, 0}, id_t::f19}, // J
-                  {{2, 0, 0}, id_t::f18}, // JK
-                  {{0, 0, 2}, id_t::f9},  // I
-                  {{2, 0, 0}, id_t::f4},  // IK
-                  {{0, 0, 2}, id_t::f14}  // IJ
-              }},
-              // Pentagon 11 (BC 117)
-              {{
-                  {{2, 0, 0}, id_t::f10}, // J
-                  {{2, 0, 0}, id_t::f5},  // JK
-                  {{0, 0, 2}, id_t::f19}, // I
-                  {{0, 2, 0}, id_t::f9},  // IK
-                  {{2, 0, 0}, id_t::f15}  // IJ
-              }}}};
-
-        if (pentagon_no < count)
-            switch (direction)
-            {
-                case direction_t::j_axes:
-                case direction_t::jk_axes:
-                case direction_t::i_axes:
-                case direction_t::ik_axes:
-                case direction_t::ij_axes:
-                {
-                    constexpr std::uint8_t direction_offset = 2u;
-                    const auto& source = data[pentagon_no][+direction - direction_offset];
-                    return ijk {std::get<0>(source), std::get<1>(source)};
-                }
-                default:
-                    break;
-            };
+        // rotate and translate for the adjacent face
+        for (std::int8_t i {}; i != orientation.ccw_rotations_60; ++i)
+            coords.rotate_60ccw();
 
-        return {};
-    }
+        coords += orientation.ijk_coords * (unit_scale(class_2_res) * (substrate ? 3 : 1));
+        coords.normalize();
 
-    using radians_array_t = std::array<double, count>;
+        // overage points on pentagon boundaries can end up on edges
+        if (substrate && (coords.i + coords.j + coords.k == max_dim))
+            return overage_t::face_edge;
 
-    /// @brief Icosahedron face ijk axes as azimuth in radians from face center to vertex 0.
-    /// @ref faceAxesAzRadsCII
-    static constexpr radians_array_t azimuth_rads_c2_vertex0 {
-        5.619958268523939882, // face 0
-        5.760339081714187279, // face 1
-        0.780213654393430055, // face 2
-        0.430469363979999913, // face 3
-        6.130269123335111400, // face 4
-        2.692877706530642877, // face 5
-        2.982963003477243874, // face 6
-        3.532912002790141181, // face 7
-        3.494305004259568154, // face 8
-        3.003214169499538391, // face 9
-        5.930472956509811562, // face 10
-        0.138378484090254847, // face 11
-        0.448714947059150361, // face 12
-        0.158629650112549365, // face 13
-        5.891865957979238535, // face 14
-        2.711123289609793325, // face 15
-        3.294508837434268316, // face 16
-        3.804819692245439833, // face 17
-        3.664438879055192436, // face 18
-        2.361378999196363184  // face 19
-    };
+        return overage_t::new_face;
+    }
 
-    /// @brief Icosahedron face ijk axes as azimuth in radians from face center to vertex 1.
-    /// @ref faceAxesAzRadsCII
-    static constexpr radians_array_t azimuth_rads_c2_vertex1 {
-        3.525563166130744542, // face 0
-        3.665943979320991689, // face 1
-        4.969003859179821079, // face 2
-        4.619259568766391033, // face 3
-        4.035874020941915804, // face 4
-        0.598482604137447119, // face 5
-        0.888567901084048369, // face 6
-        1.438516900396945656, // face 7
-        1.399909901866372864, // face 8
-        0.908819067106342928, // face 9
-        3.836077854116615875, // face 10
-        4.327168688876645809, // face 11
-        4.637505151845541521, // face 12
-        4.347419854898940135, // face 13
-        3.797470855586042958, // face 14
-        0.616728187216597771, // face 15
-        1.200113735041072948, // face 16
-        1.710424589852244509, // face 17
-        1.570043776661997111, // face 18
-        0.266983896803167583  // face 19
-    };
+    overage_t adjust_pentagon_vertex_overage(ijk& fijk, const std::uint8_t class_2_res) noexcept
+    {
+        overage_t result;
+        do
+            result = adjust_overage(fijk, class_2_res, false, true);
+        while (result == overage_t::new_face);
 
-    /// @brief Icosahedron face ijk axes as azimuth in radians from face center to vertex 2.
-    /// @ref faceAxesAzRadsCII
-    static constexpr radians_array_t azimuth_rads_c2_vertex2 {
-        1.431168063737548730, // face 0
-        1.571548876927796127, // face 1
-        2.874608756786625655, // face 2
-        2.524864466373195467, // face 3
-        1.941478918548720291, // face 4
-        4.787272808923838195, // face 5
-        5.077358105870439581, // face 6
-        5.627307105183336758, // face 7
-        5.588700106652763840, // face 8
-        5.097609271892733906, // face 9
-        1.741682751723420374, // face 10
-        2.232773586483450311, // face 11
-        2.543110049452346120, // face 12
-        2.253024752505744869, // face 13
-        1.703075753192847583, // face 14
-        4.805518392002988683, // face 15
-        5.388903939827463911, // face 16
-        5.899214794638635174, // face 17
-        5.758833981448388027, // face 18
-        4.455774101589558636  // face 19
-    };
+        return result;
+    }
 
-    /// @brief A flat array of all base cell IDs, pre-sorted by their home face ID.
-    static constexpr std::array<cell::base::id_t, cell::base::count> flat_data_sorted_by_face //
-        {{                                                                                    //
-          // Face 0 (7)
-          4u, 8u, 16u, 18u, 22u, 30u, 33u,
-          // Face 1 (6)
-          0u, 2u, 5u, 6u, 10u, 11u,
-          // Face 2 (6)
-          1u, 3u, 7u, 9u, 19u, 21u,
-          // Face 3 (6)
-          12u, 13u, 26u, 29u, 42u, 43u,
-          // Face 4 (6)
-          15u, 28u, 31u, 41u, 44u, 53u,
-          // Face 5 (6)
-          32u, 48u, 50u, 67u, 70u, 83u,
-          // Face 6 (6)
-          17u, 23u, 25u, 39u, 45u, 63u,
-          // Face 7 (6)
-          20u, 34u, 36u, 40u, 55u, 72u,
-          // Face 8 (6)
-          47u, 62u, 64u, 69u, 84u, 97u,
-          // Face 9 (6)
-          61u, 65u, 75u, 86u, 94u, 107u,
-          // Face 10 (6)
-          24u, 37u, 52u, 57u, 59u, 74u,
-          // Face 11 (6)
-          14u, 27u, 35u, 46u, 56u, 60u,
-          // Face 12 (6)
-          38u, 51u, 54u, 71u, 73u, 89u,
-          // Face 13 (6)
-          58u, 76u, 82u, 96u, 98u, 104u,
-          // Face 14 (6)
-          49u, 66u, 81u, 85u, 87u, 101u,
-          // Face 15 (6)
-          78u, 79u, 92u, 95u, 108u, 109u,
-          // Face 16 (6)
-          68u, 77u, 80u, 90u, 93u, 106u,
-          // Face 17 (6)
-          88u, 91u, 99u, 103u, 105u, 113u,
-          // Face 18 (6)
-          110u, 111u, 115u, 116u, 119u, 121u,
-          // Face 19 (7)
-          100u, 102u, 112u, 114u, 117u, 118u, 120u}};
-
-    /// @brief A `constexpr` array of spans, providing direct access to base cells for a given face.
-    static constexpr std::array<std::span<const cell::base::id_t>, count> face_lookup_spans {{
-        std::span(flat_data_sorted_by_face.data() + 0u, 7u),   // Face 0
-        std::span(flat_data_sorted_by_face.data() + 7u, 6u),   // Face 1
-        std::span(flat_data_sorted_by_face.data() + 13u, 6u),  // Face 2
-        std::span(flat_data_sorted_by_face.data() + 19u, 6u),  // Face 3
-        std::span(flat_data_sorted_by_face.data() + 25u, 6u),  // Face 4
-        std::span(flat_data_sorted_by_face.data() + 31u, 6u),  // Face 5
-        std::span(flat_data_sorted_by_face.data() + 37u, 6u),  // Face 6
-        std::span(flat_data_sorted_by_face.data() + 43u, 6u),  // Face 7
-        std::span(flat_data_sorted_by_face.data() + 49u, 6u),  // Face 8
-        std::span(flat_data_sorted_by_face.data() + 55u, 6u),  // Face 9
-        std::span(flat_data_sorted_by_face.data() + 61u, 6u),  // Face 10
-        std::span(flat_data_sorted_by_face.data() + 67u, 6u),  // Face 11
-        std::span(flat_data_sorted_by_face.data() + 73u, 6u),  // Face 12
-        std::span(flat_data_sorted_by_face.data() + 79u, 6u),  // Face 13
-        std::span(flat_data_sorted_by_face.data() + 85u, 6u),  // Face 14
-        std::span(flat_data_sorted_by_face.data() + 91u, 6u),  // Face 15
-        std::span(flat_data_sorted_by_face.data() + 97u, 6u),  // Face 16
-        std::span(flat_data_sorted_by_face.data() + 103u, 6u), // Face 17
-        std::span(flat_data_sorted_by_face.data() + 109u, 6u), // Face 18
-        std::span(flat_data_sorted_by_face.data() + 115u, 7u)  // Face 19
-    }};
+    std::uint8_t to_vertices(const ijk& fijk, const resolution_t res, std::span<ijk, 6u> out) noexcept
+    {
+        // The vertices of an origin-centered cell on the substrate grid: the aperture 3 gets us the vertices, and the
+        // 3r (and 7r for Class III) gets us back to Class II. A pentagon uses the first 5.
+        static constexpr std::array<std::array<pseudo_ijk, 6u>, 2u> substrate_vertices {{
+            {{{2, 1, 0}, {1, 2, 0}, {0, 2, 1}, {0, 1, 2}, {1, 0, 2}, {2, 0, 1}}}, // Class II
+            {{{5, 4, 0}, {1, 5, 0}, {0, 5, 4}, {0, 1, 5}, {4, 0, 5}, {5, 0, 1}}}, // Class III
+        }};
+
+        // adjust the center point to be in an aperture 33r substrate grid
+        auto center = fijk.ijk_coords;
+        center.down_ap3();
+        center.down_ap3r();
+
+        // if res is Class III we need to add a cw aperture 7 to get to icosahedral Class II
+        if (is_class_3(res))
+            center.down_ap7r();
+
+        const auto& vertices = substrate_vertices[is_class_3(res)];
+        for (std::uint8_t i {}; i != out.size(); ++i)
+        {
+            out[i].face = fijk.face;
+            out[i].ijk_coords = center + coordinate::ijk {vertices[i]};
+            out[i].ijk_coords.normalize();
+        }
+
+        return class_2_resolution(res);
+    }
 
     error_t from_index(const index index, ijk& out) noexcept
     {
@@ -904,496 +756,119 @@ namespace kmx::geohex::icosahedron::face
             return error_t::cell_invalid;
 
         const auto base_cell = index.base_cell();
-        const auto res = index.resolution();
-
-        oriented_ijk fijk_oriented;
-        fijk_oriented.face = of(base_cell);
+        const bool pentagon = cell::pentagon::check(base_cell);
 
-        auto& ijk_coords = fijk_oriented.ijk_coords;
-        ijk_coords = {};
+        // adjust for the pentagonal missing sequence; all of sub-sequence 5 needs to be adjusted
+        auto cell = index;
+        if (pentagon && (cell.leading_non_zero_digit() == direction_t::ik_axes))
+            cell.rotate_60cw();
 
-        fijk_oriented.ccw_rotations_60 = cell::base::get_canonical_orientation(base_cell);
+        // start with the home face and ijk of the base cell; a hexagon base cell centered on its home face holds its
+        // whole hierarchy on that face
+        out = home(base_cell);
+        const auto res = cell.resolution();
+        const bool possible_overage = pentagon || ((res != resolution_t::r0) && !out.ijk_coords.is_origin());
 
-        for (resolution_t r = resolution_t::r1; +r <= +res; r = static_cast<resolution_t>(+r + 1u))
+        auto& coords = out.ijk_coords;
+        for (std::uint8_t r = 1u; r <= +res; ++r)
         {
-            if (is_class_3(r))
-                ijk_coords.down_ap7r();
+            if (is_class_3(static_cast<resolution_t>(r)))
+                coords.down_ap7();
             else
-                ijk_coords.down_ap7();
+                coords.down_ap7r();
 
-            const auto digit = static_cast<direction_t>(index.digit(+r - 1u));
-            auto rotated_digit_ijk = coordinate::to_ijk(digit);
-            for (int i {}; i < fijk_oriented.ccw_rotations_60; ++i)
-                rotated_digit_ijk.rotate_60ccw();
-
-            ijk_coords += rotated_digit_ijk;
-            if (cell::pentagon::check(base_cell))
-            {
-                const auto& local_rots = cell::base::rotations_60ccw(base_cell);
-                for (int i {}; i < local_rots[+digit]; ++i)
-                    fijk_oriented.ijk_coords.rotate_60ccw();
-            }
-
-            fijk_oriented.ijk_coords.normalize();
+            coords.to_neighbor(static_cast<direction_t>(cell.digit(r - 1u)));
         }
 
-        out = fijk_oriented;
-        return error_t::none;
-    }
-
-    // This is the full inverse of `from_index`. It takes a FaceIJK and produces
-    // a valid H3 index. This is the missing link needed for vertex creation.
-    // In a real project, this would live in the `icosahedron::face` namespace.
-    error_t to_index(const ijk& fijk, const resolution_t res, index& out_index) noexcept
-    {
-        // 1. First, determine the base cell for the given FaceIJK.
-        cell::base::id_t base_cell;
-        int orientation; // This will be the orientation of the path *from* the base cell.
-        if (to_base_cell_and_orientation(fijk, res, base_cell, orientation) != error_t::none)
-            return error_t::failed;
+        if (!possible_overage)
+            return error_t::none;
 
-        // 2. Set the constant parts of the output index.
-        out_index.set_resolution(res);
-        out_index.set_base_cell(base_cell);
-        out_index.set_mode(index_mode_t::cell); // Assuming cell mode for now.
+        // if we're in Class III, drop into the next finer Class II grid
+        const auto original = coords;
+        const auto class_2_res = class_2_resolution(res);
+        if (class_2_res != +res)
+            coords.down_ap7r();
 
-        // 3. Now, determine the digits for each resolution from 1 to `res`.
-        for (resolution_t r = resolution_t::r1; +r <= +res; r = static_cast<resolution_t>(+r + 1u))
+        // a pentagon base cell with a leading 4 digit requires special handling
+        const bool pentagon_leading_4 = pentagon && (cell.leading_non_zero_digit() == direction_t::i_axes);
+        if (adjust_overage(out, class_2_res, pentagon_leading_4, false) != overage_t::none)
         {
-            // a. Find the IJK coordinates of our target `fijk` at the current resolution `r`.
-            coordinate::ijk ijk_at_res_r;
-            if (to_ijk_at_resolution(fijk, res, r, ijk_at_res_r) != error_t::none)
-                return error_t::failed;
-
-            // b. Find the IJK coordinates of the parent cell (at resolution r-1).
-            coordinate::ijk parent_ijk;
-            if (to_ijk_at_resolution(fijk, res, static_cast<resolution_t>(+r - 1u), parent_ijk) != error_t::none)
-                return error_t::failed;
-
-            // c. Scale the parent's IJK down to the grid of resolution `r`.
-            parent_ijk = parent_ijk.down_ap7(is_class_3(r));
-
-            // d. The difference between the cell and its scaled parent is the digit.
-            const coordinate::ijk diff = ijk_at_res_r - parent_ijk;
+            // if the base cell is a pentagon we have the potential for secondary overages
+            if (pentagon)
+                while (adjust_overage(out, class_2_res, false, false) != overage_t::none)
+                {
+                }
 
-            out_index.set_digit(+r - 1u, +diff.to_digit());
+            if (class_2_res != +res)
+                coords.up_ap7r();
         }
+        else if (class_2_res != +res)
+            coords = original;
 
         return error_t::none;
     }
 
-    error_t to_wgs(const ijk& fijk, const resolution_t res, gis::wgs84::coordinate& out_coord) noexcept
-    {
-        math::vector3d v3d;
-        if (projection::face_ijk_to_v3d(fijk, res, v3d) != error_t::none)
-            return error_t::failed;
-
-        projection::from_v3d(v3d, out_coord);
-        return error_t::none;
-    }
-
-    error_t to_base_cell_and_orientation(const ijk& fijk, const resolution_t res, cell::base::id_t& out_base_cell,
-                                         int& out_orientation) noexcept
+    error_t to_index(const ijk& fijk, const resolution_t res, index& out_index) noexcept
     {
-        oriented_ijk fijk_oriented;
-        fijk_oriented.face = fijk.face;
-        fijk_oriented.ijk_coords = fijk.ijk_coords;
-        fijk_oriented.ccw_rotations_60 = {};
+        /// @ref H3_INIT
+        static constexpr index::value_t unused_digits = 35184372088831u; // every digit 7
 
-        auto& ijk_coords = fijk_oriented.ijk_coords;
+        index result {unused_digits};
+        result.set_mode(index_mode_t::cell);
+        result.set_resolution(res);
 
-        // Ascend the grid from the cell's resolution up to resolution 0.
-        for (resolution_t r = res; +r > 0u; r = static_cast<resolution_t>(+r - 1u))
+        // build the digits from the finest resolution up; this leaves the base cell coordinate in the frame of the face
+        ijk base_fijk = fijk;
+        auto& coords = base_fijk.ijk_coords;
+        for (auto r = +res; r != 0u; --r)
         {
-            coordinate::ijk last_ijk = ijk_coords;
-            if (is_class_3(r))
-                ijk_coords.up_ap7r();
-            else
-                ijk_coords.up_ap7();
-
-            coordinate::ijk diff = last_ijk - ijk_coords;
-            diff.scale(is_class_3(r) ? 3 : 7);
-            coordinate::ijk rotated_parent_ijk = last_ijk - diff;
+            const auto last = coords;
+            const bool class_3 = is_class_3(static_cast<resolution_t>(r));
+            coords = coords.up_ap7_copy(class_3);
+            result.set_digit(r - 1u, static_cast<index::digit_t>(+(last - coords.down_ap7(class_3)).to_digit()));
+        }
 
-            if (ijk_coords != rotated_parent_ijk)
-            {
-                coordinate::ijk tmp = ijk_coords;
-                int rotations {};
-                while (tmp != rotated_parent_ijk)
-                {
-                    tmp.rotate_60ccw();
-                    rotations++;
-                    if (rotations > 6)
-                        return error_t::failed;
-                }
+        const auto base_cell = to_base_cell(base_fijk);
+        if (base_cell == cell::base::invalid_index)
+            return error_t::failed;
 
-                fijk_oriented.ccw_rotations_60 = (fijk_oriented.ccw_rotations_60 + rotations) % 6;
-            }
-        }
+        result.set_base_cell(base_cell);
 
-        // At res 0, look up the base cell using the compile-time generated table.
-        // This now refers directly to `face_lookup_spans` for maximum clarity.
-        const auto& candidates = face_lookup_spans[+fijk_oriented.face];
-        for (const cell::base::id_t candidate_bc: candidates)
+        // rotate to the canonical orientation of the base cell
+        const auto rotations = to_base_cell_rotations(base_fijk);
+        if (cell::pentagon::check(base_cell))
         {
-            // A res 0 FaceIJK from a valid ascent must have ijk coords {0,0,0}.
-            if (fijk_oriented.ijk_coords.is_origin())
+            // force rotation out of the missing k-axes sub-sequence, clockwise on a clockwise offset face
+            if (result.leading_non_zero_digit() == direction_t::k_axes)
             {
-                out_base_cell = candidate_bc;
-                int canonical_orientation = cell::base::get_canonical_orientation(out_base_cell);
-                out_orientation = (canonical_orientation + fijk_oriented.ccw_rotations_60) % 6;
-                return error_t::none;
+                if (is_cw_offset(base_cell, base_fijk.face))
+                    result.rotate_60cw();
+                else
+                    result.rotate_60ccw();
             }
-        }
-
-        return error_t::cell_invalid;
-    }
-
-    cell::base::id_t to_base_cell(const ijk& fijk, const resolution_t res) noexcept
-    {
-        cell::base::id_t base_cell = cell::base::invalid_index;
-        int orientation {};
-        if (to_base_cell_and_orientation(fijk, res, base_cell, orientation) == error_t::none)
-            return base_cell;
-
-        return cell::base::invalid_index;
-    }
-
-    error_t to_ijk_at_resolution(const ijk& fijk_higher_res, const resolution_t res_higher, const resolution_t res_lower,
-                                 coordinate::ijk& out_ijk_lower_res) noexcept
-    {
-        // To convert from a high-res IJK to a low-res IJK, we can't just scale.
-        // The most robust way is to convert the high-res FaceIJK to a 3D vector,
-        // then re-project that vector onto the same face and convert it back to IJK
-        // at the desired *lower* resolution.
-
-        // 1. Convert the high-resolution FaceIJK to a 3D vector.
-        math::vector3d v3d;
-        if (projection::face_ijk_to_v3d(fijk_higher_res, res_higher, v3d) != error_t::none)
-            return error_t::failed;
-
-        // 2. Project that 3D vector onto the same face's 2D gnomonic plane.
-        math::vector2d uv;
-        if (projection::project_v3d_to_face_uv(v3d, fijk_higher_res.face, uv) != error_t::none)
-            return error_t::failed;
-
-        // 3. Convert the 2D UV coordinates to an IJK grid at the desired *lower* resolution.
-        return projection::convert_face_uv_to_ijk(uv, res_lower, out_ijk_lower_res);
-    }
-
-    /// @brief Rotations to apply when moving from a pentagon to a neighboring face.
-    /// @details This is a port of `PENTAGON_ROTATIONS` from H3's `pentagon.c`.
-    static constexpr std::array<std::int8_t, cell::pentagon::count> pentagon_leading_digit_rotations = {1, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 2};
-
-    /// @brief Standard face-to-face rotations for hexagon-to-hexagon overage.
-    /// @details Port of `adjFaceRotations` from H3's `faceijk.c`.
-    static constexpr std::array<std::array<int, 3u>, count> adj_face_rotations = {
-        {{3, 0, 0}, {0, 0, 3}, {0, 3, 0}, {0, 0, 3}, {0, 3, 0}, {3, 0, 0}, {0, 0, 3}, {0, 3, 0}, {0, 0, 3}, {3, 0, 0},
-         {3, 0, 0}, {0, 3, 0}, {3, 0, 0}, {0, 3, 0}, {0, 0, 3}, {0, 0, 3}, {3, 0, 0}, {0, 3, 0}, {3, 0, 0}, {0, 3, 0}}};
-
-    /// @brief Standard face-to-face coordinate translations for hexagon-to-hexagon overage.
-    /// @details Port of `adjFaceOffsets` from H3's `faceijk.c`.
-    static constexpr std::array<std::array<pseudo_ijk, 3u>, count> adj_face_offsets {{
-        {{{1, 1, 0}, {2, 0, 0}, {1, 0, 1}}}, // Face 0
-        {{{0, 0, 1}, {0, 1, 1}, {1, 1, 0}}}, // Face 1
-        {{{0, 1, 0}, {1, 1, 0}, {0, 0, 1}}}, // Face 2
-        {{{1, 0, 1}, {0, 0, 1}, {1, 1, 0}}}, // Face 3
-        {{{0, 1, 1}, {1, 0, 1}, {1, 0, 0}}}, // Face 4
-        {{{2, 0, 0}, {0, 1, 0}, {0, 1, 1}}}, // Face 5
-        {{{0, 1, 1}, {1, 1, 0}, {1, 0, 1}}}, // Face 6
-        {{{1, 0, 0}, {1, 1, 0}, {0, 1, 0}}}, // Face 7
-        {{{1, 0, 1}, {0, 1, 0}, {0, 1, 1}}}, // Face 8
-        {{{2, 0, 0}, {1, 0, 1}, {0, 1, 1}}}, // Face 9
-        {{{2, 0, 0}, {0, 1, 0}, {0, 0, 1}}}, // Face 10
-        {{{1, 0, 0}, {0, 1, 1}, {0, 1, 0}}}, // Face 11
-        {{{2, 0, 0}, {1, 0, 1}, {0, 1, 1}}}, // Face 12
-        {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}}, // Face 13
-        {{{0, 1, 1}, {1, 1, 0}, {1, 0, 1}}}, // Face 14
-        {{{2, 0, 0}, {1, 1, 0}, {0, 0, 1}}}, // Face 15
-        {{{1, 0, 0}, {1, 0, 1}, {1, 1, 0}}}, // Face 16
-        {{{2, 0, 0}, {0, 1, 1}, {0, 0, 1}}}, // Face 17
-        {{{0, 1, 0}, {1, 1, 0}, {1, 0, 1}}}, // Face 18
-        {{{1, 0, 0}, {0, 1, 0}, {0, 1, 1}}}  // Face 19
-    }};
-
-    /// @brief Helper to find the local index of a vertex on a face's edge.
-    std::int8_t find_vertex_on_face(const id_t face, const std::int8_t vertex_to_find) noexcept
-    {
-        const auto& vertices = face_to_vertices[+face];
-        for (std::int8_t i {}; i < 3; ++i)
-            if (vertices[i] == vertex_to_find)
-                return i;
-
-        return -1; // Should not happen
-    }
-
-    /// @brief Adjusts FaceIJK coordinates when a grid traversal from a HEXAGON crosses an icosahedron face boundary.
-    /// @details This function handles the simpler, non-distorted case of face overage. It finds the
-    ///          neighboring base cell on the new face and calculates the required rotation to translate
-    ///          the IJK coordinates into the new face's system.
-    /// @note    This is a low-level helper, intended to be called by a higher-level neighbor-finding algorithm
-    ///          after it has detected an overage.
-    /// @param[in] fijk The original FaceIJK with orientation, before the overage was detected.
-    /// @param res The resolution of the traversal.
-    /// @param digit The direction of movement that caused the overage.
-    /// @param[out] out_fijk The resulting FaceIJK on the new face.
-    static error_t adjust_hexagon_overage(const oriented_ijk& fijk, const resolution_t res, const direction_t digit,
-                                          oriented_ijk& out_fijk) noexcept
-    {
-        // 1. Determine the base cell of the original coordinates.
-        cell::base::id_t base_cell_id;
-        int orientation; // We need the base cell's rotation.
-        error_t err = to_base_cell_and_orientation(fijk, res, base_cell_id, orientation);
-        if (err != error_t::none)
-            return err;
-
-        // This function must not be called for pentagons.
-        if (cell::pentagon::check(base_cell_id))
-            return error_t::pentagon; // Logic error: wrong function called.
-
-        // 2. Find the neighboring base cell in the direction of movement.
-        const cell::base::id_t new_base_cell_id = cell::base::neighbor_of(base_cell_id, digit);
-        if (new_base_cell_id == cell::base::invalid_index)
-            return error_t::failed; // Should not happen for a valid hexagon and direction.
-
-        // 3. Find the rotation adjustment required to move between these two base cells.
-        const auto& rotations = cell::base::rotations_60ccw(base_cell_id);
-        const int new_rotation = rotations[+digit];
-
-        // 4. Create the new FaceIJK on the new face.
-        // The new face is the home face of the new base cell.
-        static_cast<ijk&>(out_fijk) = home(new_base_cell_id);
 
-        // 5. The original coordinates need to be rotated into the new system.
-        out_fijk.ijk_coords = fijk.ijk_coords;
-        for (int i {}; i < new_rotation; ++i)
-            out_fijk.ijk_coords.rotate_60ccw();
+            for (int i {}; i != rotations; ++i)
+                result.rotate_pentagon_60ccw();
+        }
+        else
+            for (int i {}; i != rotations; ++i)
+                result.rotate_60ccw();
 
-        // 6. The overall system rotation also accumulates this change.
-        out_fijk.ccw_rotations_60 = (fijk.ccw_rotations_60 + new_rotation + 6) % 6;
+        out_index = result;
         return error_t::none;
     }
 
-    error_t find_neighbor_face_ijk(const oriented_ijk& start_fijk, const resolution_t res, const direction_t dir,
-                                   oriented_ijk& out_neighbor_fijk) noexcept
-    {
-        if ((dir == direction_t::center) || (dir == direction_t::invalid))
-            return error_t::domain; // Cannot find a neighbor in the center or an invalid direction.
-
-        // 1. Perform a naive translation in the current face's IJK system.
-        out_neighbor_fijk = start_fijk;
-        out_neighbor_fijk.ijk_coords += coordinate::to_ijk(dir);
-        out_neighbor_fijk.ijk_coords.normalize();
-
-        // 2. Check for "overage" - has the new coordinate spilled outside the current face's system?
-        // The maximum coordinate for a given resolution defines the boundary.
-        // This is equivalent to H3's `MAX_FACE_COORD`.
-        const auto max_coord = 3 * unsafe_ipow<int>(7, +res);
-
-        if ((std::abs(out_neighbor_fijk.ijk_coords.i) <= max_coord) && (std::abs(out_neighbor_fijk.ijk_coords.j) <= max_coord) &&
-            (std::abs(out_neighbor_fijk.ijk_coords.k) <= max_coord))
-            // No overage occurred. The neighbor is on the same face. We are done.
-            return error_t::none;
-
-        // 3. Overage occurred. The neighbor is on a new face. We must correct the coordinates.
-        // The type of correction depends on whether the *origin* cell is a pentagon or a hexagon.
-        const cell::base::id_t original_base_cell = to_base_cell(start_fijk, res);
-        if (original_base_cell == cell::base::invalid_index)
-            return error_t::cell_invalid; // Could not determine the base cell of the origin.
-
-        if (cell::pentagon::check(original_base_cell))
-            // Case A: The traversal originated from a pentagon.
-            // Use the complex pentagon-specific adjustment logic.
-            // This call will fix the `out_neighbor_fijk` in-place.
-            return adjust_overage(out_neighbor_fijk, res, dir);
-
-        // Case B: The traversal originated from a regular hexagon.
-        // Use the simpler hexagon-to-hexagon face crossing logic.
-        return adjust_hexagon_overage(start_fijk, res, dir, out_neighbor_fijk);
-    }
-
-    /// @brief H3 internal lookup table `pentagonDirectionFaces`.
-    /// @details This table is critical for grid traversal across icosahedron face
-    /// boundaries near pentagons. For a given pentagon (by its local 0-11 index)
-    /// and a neighbor direction, it provides the `FaceIJK` coordinates on the
-    /// adjacent face.
-    ///
-    /// The table is indexed by `[local_pentagon_index][+direction - 1]`.
-    /// The direction index maps as follows:
-    /// 0: k_axes, 1: j_axes, 2: jk_axes, 3: i_axes, 4: ik_axes, 5: ij_axes
-    static constexpr std::array<std::array<ijk, 6u>, cell::pentagon::count> pentagon_neighbor_faces {{
-        // P0 (BC 4, I-axes)
-        {{{{0, 0, 1}, id_t::f4},
-          {{0, 1, 0}, id_t::f3},
-          {{0, 1, 0}, id_t::f2},
-          {{0, 1, 0}, id_t::f1},
-          {{0, 1, 0}, id_t::f0},
-          {{1, 0, 0}, id_t::f5}}},
-        // P1 (BC 14, I-axes)
-        {{{{0, 0, 1}, id_t::f0},
-          {{0, 1, 0}, id_t::f5},
-          {{1, 0, 0}, id_t::f6},
-          {{0, 0, 1}, id_t::f2},
-          {{0, 1, 0}, id_t::f1},
-          {{1, 0, 0}, id_t::f10}}},
-        // P2 (BC 24, I-axes)
-        {{{{0, 0, 1}, id_t::f1},
-          {{0, 0, 1}, id_t::f6},
-          {{1, 0, 0}, id_t::f7},
-          {{0, 0, 1}, id_t::f3},
-          {{0, 1, 0}, id_t::f2},
-          {{1, 0, 0}, id_t::f0}}},
-        // P3 (BC 38, I-axes)
-        {{{{0, 0, 1}, id_t::f2},
-          {{0, 0, 1}, id_t::f7},
-          {{1, 0, 0}, id_t::f8},
-          {{0, 0, 1}, id_t::f4},
-          {{0, 1, 0}, id_t::f3},
-          {{1, 0, 0}, id_t::f1}}},
-        // P4 (BC 49, I-axes)
-        {{{{0, 0, 1}, id_t::f3},
-          {{0, 0, 1}, id_t::f8},
-          {{1, 0, 0}, id_t::f9},
-          {{0, 0, 1}, id_t::f0},
-          {{0, 1, 0}, id_t::f4},
-          {{1, 0, 0}, id_t::f2}}},
-        // P5 (BC 58, K-axes)
-        {{{{0, 1, 0}, id_t::f10},
-          {{0, 1, 0}, id_t::f9},
-          {{0, 0, 1}, id_t::f8},
-          {{0, 1, 0}, id_t::f7},
-          {{0, 1, 0}, id_t::f6},
-          {{1, 0, 0}, id_t::f11}}},
-        // P6 (BC 63, J-axes)
-        {{{{0, 0, 1}, id_t::f11},
-          {{0, 0, 1}, id_t::f5},
-          {{1, 0, 0}, id_t::f1},
-          {{1, 0, 0}, id_t::f2},
-          {{1, 0, 0}, id_t::f7},
-          {{1, 0, 0}, id_t::f15}}},
-        // P7 (BC 72, K-axes)
-        {{{{0, 1, 0}, id_t::f15},
-          {{0, 0, 1}, id_t::f6},
-          {{1, 0, 0}, id_t::f2},
-          {{1, 0, 0}, id_t::f3},
-          {{1, 0, 0}, id_t::f8},
-          {{1, 0, 0}, id_t::f12}}},
-        // P8 (BC 83, J-axes)
-        {{{{0, 0, 1}, id_t::f12},
-          {{0, 1, 0}, id_t::f7},
-          {{1, 0, 0}, id_t::f3},
-          {{1, 0, 0}, id_t::f4},
-          {{1, 0, 0}, id_t::f9},
-          {{1, 0, 0}, id_t::f16}}},
-        // P9 (BC 97, K-axes)
-        {{{{0, 1, 0}, id_t::f16},
-          {{0, 1, 0}, id_t::f8},
-          {{1, 0, 0}, id_t::f4},
-          {{1, 0, 0}, id_t::f0},
-          {{0, 1, 0}, id_t::f5},
-          {{1, 0, 0}, id_t::f13}}},
-        // P10 (BC 107, I-axes)
-        {{{{1, 0, 0}, id_t::f14},
-          {{0, 1, 0}, id_t::f13},
-          {{0, 0, 1}, id_t::f9},
-          {{0, 0, 1}, id_t::f5},
-          {{1, 0, 0}, id_t::f1},
-          {{1, 0, 0}, id_t::f18}}},
-        // P11 (BC 117, J-axes)
-        {{{{1, 0, 0}, id_t::f17},
-          {{0, 0, 1}, id_t::f18},
-          {{0, 0, 1}, id_t::f14},
-          {{0, 0, 1}, id_t::f10},
-          {{1, 0, 0}, id_t::f5},
-          {{0, 1, 0}, id_t::f19}}},
-    }};
-
-    /// @brief For a given pentagon and neighbor direction, gets the corresponding FaceIJK on the adjacent face.
-    /// @details This is essential for grid traversal algorithms that cross icosahedron face boundaries
-    /// originating from a pentagonal cell. A pentagon has only 5 neighbors; attempting to move in the
-    /// `ij_axes` direction is invalid and will return no result.
-    /// @param pentagon_no The local index of the pentagon (0-11).
-    /// @param direction The direction of movement away from the pentagon.
-    /// @return An optional containing the `FaceIJK` of the neighbor if the direction is valid for a pentagon,
-    /// otherwise `std::nullopt`.
-    std::optional<ijk> get_pentagon_face_ijk(const std::uint8_t pentagon_no, const direction_t direction) noexcept
-    {
-        // A pentagon's local index must be in the range [0, 11].
-        if (pentagon_no >= cell::pentagon::count)
-            return std::nullopt;
-
-        const auto dir_val = +direction;
-
-        // Valid neighbor directions for a pentagon are K, J, JK, I, IK (values 1-5).
-        // The `ij_axes` direction (6) is the "missing" neighbor.
-        // `center` (0) and `invalid` (7) are also not neighbor directions.
-        if (dir_val < +direction_t::k_axes || dir_val > +direction_t::ik_axes)
-            return {};
-
-        // The lookup table is 0-indexed by `direction - 1`.
-        const auto dir_idx = dir_val - 1u;
-
-        return pentagon_neighbor_faces[pentagon_no][dir_idx];
-    }
-
-    /// @ref _adjustOverageClassII and _adjustOverageClassIII (H3 C internal)
-    error_t adjust_overage(id_t& current_face, std::int8_t& current_ccw_rotations_60, coordinate::ijk& ijk_coords_to_adjust,
-                           const cell::base::id_t base_cell_id, const direction_t digit_moved) noexcept
+    error_t to_wgs(const ijk& fijk, const resolution_t res, gis::wgs84::coordinate& out_coord) noexcept
     {
-        // This function is only for handling pentagon-specific overage.
-        // It should only be called by a higher-level algorithm that has already
-        // determined an overage has occurred from a pentagon base cell.
-
-        if ((digit_moved == direction_t::center) || (digit_moved == direction_t::invalid))
-            return error_t::domain;
-
-        // Fast path: No special adjustment is needed if the base cell is not a pentagon.
-        // The calling function handles simple hexagon-to-hexagon face crossing.
-        if (!cell::pentagon::check(base_cell_id))
-            return error_t::none;
-
-        // The H3 algorithm for pentagon distortion is complex. It involves
-        // looking up pre-computed new face data and rotations.
-        const auto optional_local_pent_idx = cell::pentagon::get_index(base_cell_id);
-        if (!optional_local_pent_idx)
-            // This should be impossible if pentagon::check passed.
-            return error_t::cell_invalid;
-
-        // Find the adjacent face by looking up the result for moving from this
-        // pentagon in the specified direction.
-        const std::optional<ijk> new_face_data = get(static_cast<std::uint8_t>(*optional_local_pent_idx), digit_moved);
-        if (!new_face_data)
-            // Attempted to move into the "missing" neighbor of a pentagon.
-            return error_t::pentagon;
-
-        // Look up the required rotation for this specific face crossing.
-        // H3 has precomputed tables for this (`_pentagonCwOffset`).
-        const auto [cw_offset_face, cw_offset_rot] = cell::pentagon::clockwise_offsets(base_cell_id);
-
-        // Apply the pre-computed adjustment from the lookup tables.
-        current_face = new_face_data->face;
-
-        // The new coordinates are simply the coordinates on the new face's system.
-        // The H3 tables store these as simple unit vectors.
-        ijk_coords_to_adjust = new_face_data->ijk_coords;
-
-        // Update the system's rotation.
-        // A full circle is 6 rotations, so we use modulo arithmetic.
-        current_ccw_rotations_60 = (current_ccw_rotations_60 + cw_offset_rot + 6) % 6;
+        projection::from_hex2d(coordinate::to_vec2<double>(fijk.ijk_coords), fijk.face, +res, false, out_coord);
         return error_t::none;
     }
 
-    error_t adjust_overage(oriented_ijk& fijk, const resolution_t res, const direction_t digit) noexcept
+    error_t from_wgs(const gis::wgs84::coordinate& coord, const resolution_t res, ijk& out_fijk) noexcept
     {
-        // First, determine the base cell for the current FaceIJK coordinates.
-        cell::base::id_t base_cell_id;
-        int orientation; // Not used here, but required by the function
-
-        const error_t base_cell_err = to_base_cell_and_orientation(fijk, res, base_cell_id, orientation);
-        if (base_cell_err != error_t::none)
-            return base_cell_err;
-
-        // Now, delegate to the core "worker" function.
-        return adjust_overage(fijk.face, fijk.ccw_rotations_60, fijk.ijk_coords, base_cell_id, digit);
+        math::vector2d v2d;
+        projection::to_hex2d(coord, res, out_fijk.face, v2d);
+        out_fijk.ijk_coords = coordinate::ijk::from_hex2d(v2d);
+        return error_t::none;
     }
 }
@@ -1,7 +1,10 @@
 /// @file geohex/index.cpp
 #include "kmx/geohex/index.hpp"
 #include "kmx/geohex/cell/pentagon.hpp"
+#include "kmx/geohex/icosahedron/face.hpp"
 #include <algorithm>
+#include <cmath>
+#include <kmx/gis/wgs84/coordinate.hpp>
 
 namespace kmx::geohex
 {
@@ -31,7 +34,7 @@ namespace kmx::geohex
     {
         // NOTE: res check is needed because we can't shift by 64
         const auto res = +ress;
-        if (res < resolution_count)
+        if (res < +resolution_t::r15)
         {
             const auto shift = 19u + 3u * res;
             const auto hh = ~h;
@@ -67,7 +70,7 @@ namespace kmx::geohex
             const auto hh = (h << 19u) >> 19u;
             if (hh == 0u)
                 return false; // all zeros: res 15 pentagon
-            return (first_one_index(h) % 3u) == 0u;
+            return (first_one_index(hh) % 3u) == 0u;
         }
 
         return false;
@@ -76,8 +79,8 @@ namespace kmx::geohex
     bool index::is_valid() const noexcept
     {
         const auto v = value();
-        return has_good_top_bits(v) && (base_cell_ < cell::base::count) && has_any_7_up_to_resolution(v, resolution()) &&
-               !has_deleted_subsequence(v, base_cell_);
+        return has_good_top_bits(v) && (base_cell_ < cell::base::count) && !has_any_7_up_to_resolution(v, resolution()) &&
+               has_all_7_after_resolution(v, resolution()) && !has_deleted_subsequence(v, base_cell_);
     }
 
     bool index::is_pentagon() const noexcept
@@ -96,6 +99,17 @@ namespace kmx::geohex
         mode_ = +item & mask;
     }
 
+    std::uint8_t index::mode_dependent() const noexcept
+    {
+        return static_cast<std::uint8_t>(mode_dependent_);
+    }
+
+    void index::set_mode_dependent(const std::uint8_t item) noexcept
+    {
+        static constexpr std::uint8_t mask = (1u << field_mode_dependent_size) - 1u;
+        mode_dependent_ = item & mask;
+    }
+
     resolution_t index::resolution() const noexcept
     {
         return static_cast<resolution_t>(resolution_);
@@ -188,7 +202,7 @@ namespace kmx::geohex
         if (index < digit_count())
         {
             const auto shift_value = shift(index);
-            const auto new_data = (value() & (~digit_mask << shift_value)) | ((item & digit_mask) << shift_value);
+            const auto new_data = (value() & ~(digit_mask << shift_value)) | ((item & digit_mask) << shift_value);
             set_value(new_data);
         }
     }
@@ -221,6 +235,38 @@ namespace kmx::geohex
         return direction_t::center;
     }
 
+    void index::rotate_60ccw() noexcept
+    {
+        const auto count = static_cast<digit_index>(resolution_);
+        for (digit_index i {}; i != count; ++i)
+            set_digit(i, +geohex::rotate_60ccw(static_cast<direction_t>(raw_digit(i))));
+    }
+
+    void index::rotate_60cw() noexcept
+    {
+        const auto count = static_cast<digit_index>(resolution_);
+        for (digit_index i {}; i != count; ++i)
+            set_digit(i, +geohex::rotate_60cw(static_cast<direction_t>(raw_digit(i))));
+    }
+
+    void index::rotate_pentagon_60ccw() noexcept
+    {
+        const auto count = static_cast<digit_index>(resolution_);
+        bool found_first_non_zero_digit {};
+        for (digit_index i {}; i != count; ++i)
+        {
+            set_digit(i, +geohex::rotate_60ccw(static_cast<direction_t>(raw_digit(i))));
+
+            // The rotation may not land on the deleted k-axes subsequence: rotate once more to skip it.
+            if (!found_first_non_zero_digit && (raw_digit(i) != 0))
+            {
+                found_first_non_zero_digit = true;
+                if (leading_non_zero_digit() == direction_t::k_axes)
+                    rotate_60ccw();
+            }
+        }
+    }
+
     void index::get_number(number_span& span) const noexcept
     {
         auto dest = span.begin();
@@ -241,7 +287,22 @@ namespace kmx::geohex
             return err;
 
         // Convert the FaceIJK coordinates to geographic coordinates.
-        // return icosahedron::face::to_geo(fijk, index.resolution(), coord);
         return icosahedron::face::to_wgs(fijk, index.resolution(), coord);
     }
+
+    error_t from_wgs(const gis::wgs84::coordinate& coord, const resolution_t res, index& out) noexcept
+    {
+        if (+res >= resolution_count)
+            return error_t::res_domain;
+
+        if (!std::isfinite(coord.latitude) || !std::isfinite(coord.longitude))
+            return error_t::latlng_domain;
+
+        icosahedron::face::ijk fijk;
+        const auto err = icosahedron::face::from_wgs(coord, res, fijk);
+        if (err != error_t::none)
+            return err;
+
+        return icosahedron::face::to_index(fijk, res, out);
+    }
 }
@@ -0,0 +1,202 @@
+/// @file geohex/join.cpp
+#include "kmx/geohex/join.hpp"
+#include "kmx/geohex/cell.hpp"
+#include "kmx/geohex/cell/base.hpp"
+#include "kmx/geohex/radix.hpp"
+#include <algorithm>
+#include <kmx/parallel.hpp>
+#include <numeric>
+#include <thread>
+
+namespace kmx::geohex::join
+{
+    /// @brief Points per chunk indexed by a thread.
+    static constexpr std::size_t chunk_size = 4096u;
+
+    /// @brief Fewer points than this are handled on the calling thread.
+    static constexpr std::size_t min_parallel_size = 4u * chunk_size;
+
+    /// @brief The bits of the digits of resolution 15 below the base cell in a number.
+    static constexpr unsigned base_shift = 3u * (resolution_count - 1u);
+
+    /// @brief A layer cell with the range of numbers of its descendants at resolution 15.
+    struct range
+    {
+        std::uint64_t first;
+        std::uint64_t last;
+        id_t id;
+
+        /// @brief Orders by first number, then a cell before its descendants.
+        bool operator<(const range& other) const noexcept
+        {
+            return first != other.first ? first < other.first : last > other.last;
+        }
+    };
+
+    /// @brief Gets the number at resolution 15 of the first descendant of a cell.
+    static std::uint64_t first_of(const index cell) noexcept
+    {
+        return cell::to_number(cell) << (3u * (resolution_count - 1u - +cell.resolution()));
+    }
+
+    /// @brief Gets the threads for a number of points.
+    static std::size_t thread_count_of(const std::size_t count, const std::size_t task_count) noexcept
+    {
+        return count < min_parallel_size ? 1u : std::min<std::size_t>(task_count, std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    /// @brief Gets the ranges of the layer cells not finer than a resolution, sorted.
+    static error_t to_ranges(const std::span<const index> layer, const std::span<const id_t> ids, const resolution_t resolution,
+                             std::vector<range>& ranges)
+    {
+        if (layer.size() != ids.size())
+            return error_t::domain;
+
+        ranges.clear();
+        ranges.reserve(layer.size());
+        for (std::size_t i {}; i != layer.size(); ++i)
+        {
+            const auto cell = layer[i];
+            if (!cell.is_valid())
+                return error_t::cell_invalid;
+
+            if (+cell.resolution() <= +resolution)
+            {
+                const auto first = first_of(cell);
+                const auto shift = 3u * (resolution_count - 1u - +cell.resolution());
+                ranges.push_back({first, first | ((std::uint64_t {1u} << shift) - 1u), ids[i]});
+            }
+        }
+
+        std::sort(ranges.begin(), ranges.end());
+        return error_t::none;
+    }
+
+    /// @brief Merges the sorted points of a base cell with its sorted ranges.
+    static void merge(const std::span<const index> points, const std::span<const std::uint64_t> positions,
+                      const std::span<const range> ranges, std::vector<match>& out)
+    {
+        // the ranges around the current point, each inside the one below it
+        std::vector<const range*> stack;
+        auto next = ranges.begin();
+        for (std::size_t i {}; i != points.size(); ++i)
+        {
+            const auto number = first_of(points[i]);
+            for (; (next != ranges.end()) && (next->first <= number); ++next)
+            {
+                while (!stack.empty() && (stack.back()->last < next->first))
+                    stack.pop_back();
+                stack.push_back(&*next);
+            }
+
+            while (!stack.empty() && (stack.back()->last < number))
+                stack.pop_back();
+
+            for (const auto* item: stack)
+                out.push_back({positions[i], item->id});
+        }
+    }
+
+    /// @brief Joins sorted points of one resolution, partitioned by base cell.
+    static void join_sorted(const std::span<const index> points, const std::span<const std::uint64_t> positions,
+                            const std::span<const range> ranges, std::vector<match>& result)
+    {
+        std::vector<std::vector<match>> parts(cell::base::count);
+        run_parallel(cell::base::count, thread_count_of(points.size(), cell::base::count),
+                     [&](const std::size_t base)
+                     {
+                         const auto by_base = [](const index cell, const std::size_t value) { return cell.base_cell() < value; };
+                         const auto first = std::lower_bound(points.begin(), points.end(), base, by_base);
+                         const auto last = std::lower_bound(first, points.end(), base + 1u, by_base);
+                         if (first == last)
+                             return;
+
+                         const auto by_number = [](const range& item, const std::uint64_t value) { return item.first < value; };
+                         const auto low = std::lower_bound(ranges.begin(), ranges.end(), std::uint64_t {base} << base_shift, by_number);
+                         const auto high = std::lower_bound(low, ranges.end(), std::uint64_t {base + 1u} << base_shift, by_number);
+                         const auto offset = static_cast<std::size_t>(first - points.begin());
+                         merge({first, last}, positions.subspan(offset, static_cast<std::size_t>(last - first)), {low, high},
+                               parts[base]);
+                     });
+
+        std::size_t total {};
+        for (const auto& part: parts)
+            total += part.size();
+
+        result.clear();
+        result.reserve(total);
+        for (auto& part: parts)
+        {
+            result.insert(result.end(), part.begin(), part.end());
+            part = {};
+        }
+    }
+
+    error_t cells(const std::span<const index> points, const std::span<const index> layer, const std::span<const id_t> ids,
+                  std::vector<match>& result)
+    {
+        const auto resolution = points.empty() ? resolution_t {} : points.front().resolution();
+        for (const auto cell: points)
+        {
+            if (!cell.is_valid())
+                return error_t::cell_invalid;
+            if (cell.resolution() != resolution)
+                return error_t::res_mismatch;
+        }
+
+        std::vector<range> ranges;
+        const auto err = to_ranges(layer, ids, resolution, ranges);
+        if (err != error_t::none)
+            return err;
+
+        std::vector<index> sorted(points.begin(), points.end());
+        std::vector<std::uint64_t> positions(points.size());
+        std::iota(positions.begin(), positions.end(), std::uint64_t {});
+        radix::sort(sorted, positions);
+        join_sorted(sorted, positions, ranges, result);
+        return error_t::none;
+    }
+
+    error_t points(const std::span<const gis::wgs84::coordinate> points, const std::span<const index> layer,
+                   const std::span<const id_t> ids, std::vector<match>& result)
+    {
+        // the points are indexed at the finest resolution of the layer
+        std::uint32_t finest {};
+        for (const auto cell: layer)
+            finest = std::max<std::uint32_t>(finest, +cell.resolution());
+        const auto resolution = static_cast<resolution_t>(finest);
+
+        std::vector<range> ranges;
+        const auto err = to_ranges(layer, ids, resolution, ranges);
+        if (err != error_t::none)
+            return err;
+
+        const auto count = points.size();
+        const auto chunk_count = (count + chunk_size - 1u) / chunk_size;
+        std::vector<index> cells(count);
+        std::vector<error_t> errors(chunk_count);
+        run_parallel(chunk_count, thread_count_of(count, chunk_count),
+                     [&](const std::size_t chunk)
+                     {
+                         for (auto i = chunk * chunk_size; i != std::min(count, (chunk + 1u) * chunk_size); ++i)
+                         {
+                             const auto point_err = from_wgs(points[i], resolution, cells[i]);
+                             if (point_err != error_t::none)
+                             {
+                                 errors[chunk] = point_err;
+                                 return;
+                             }
+                         }
+                     });
+
+        const auto failed = std::find_if(errors.begin(), errors.end(), [](const error_t item) { return item != error_t::none; });
+        if (failed != errors.end())
+            return *failed;
+
+        std::vector<std::uint64_t> positions(count);
+        std::iota(positions.begin(), positions.end(), std::uint64_t {});
+        radix::sort(cells, positions);
+        join_sorted(cells, positions, ranges, result);
+        return error_t::none;
+    }
+}
@@ -0,0 +1,94 @@
+/// @file geohex/mesh.cpp
+#include "kmx/geohex/mesh.hpp"
+#include "kmx/geohex/cell/boundary.hpp"
+#include "kmx/geohex/geo_projection.hpp"
+#include "kmx/geohex/icosahedron/face.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace kmx::geohex::mesh
+{
+    /// @brief Computes the unit vectors of sorted vertices, decoding each owner cell once for all its vertices.
+    static error_t compute_positions(std::span<const index> vertices, std::span<math::vector3f> out) noexcept
+    {
+        index decoded_owner {};
+        icosahedron::face::ijk center_fijk;
+        std::array<gis::wgs84::coordinate, 1u> coordinates;
+        for (std::size_t i {}; i != vertices.size(); ++i)
+        {
+            const auto owner = vertex::owner(vertices[i]);
+            if ((i == 0u) || (owner != decoded_owner))
+            {
+                const auto err = icosahedron::face::from_index(owner, center_fijk);
+                if (err != error_t::none)
+                    return err;
+
+                decoded_owner = owner;
+            }
+
+            std::span<gis::wgs84::coordinate> coordinates_span {coordinates};
+            const auto start = static_cast<std::uint8_t>(vertex::number(vertices[i]));
+            const auto err = cell::boundary::get_vertices(center_fijk, owner, start, 1u, coordinates_span);
+            if (err != error_t::none)
+                return err;
+
+            math::vector3d v3;
+            projection::to_v3d(coordinates.front(), v3);
+            out[i] = {static_cast<float>(v3.x), static_cast<float>(v3.y), static_cast<float>(v3.z)};
+        }
+
+        return error_t::none;
+    }
+
+    error_t build(std::span<const index> cells, indexed& out)
+    {
+        // 1. The canonical vertices of every cell, in boundary order; the sixth slot of a pentagon stays empty.
+        std::vector<index> corners(cells.size() * vertex::max_count);
+        for (std::size_t i {}; i != cells.size(); ++i)
+        {
+            std::span<index> cell_corners {corners.data() + i * vertex::max_count, vertex::max_count};
+            const auto err = vertex::of(cells[i], cell_corners);
+            if (err != error_t::none)
+                return err;
+        }
+
+        // 2. Deduplicate: a vertex is shared by up to three cells of the set.
+        auto& vertices = out.vertices;
+        vertices.assign(corners.begin(), corners.end());
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        if (!vertices.empty() && (vertices.front() == index {}))
+            vertices.erase(vertices.begin());
+
+        if (vertices.size() > std::numeric_limits<std::uint32_t>::max())
+            return error_t::memory_bounds;
+
+        // 3. Positions, once per distinct vertex.
+        out.positions.resize(vertices.size());
+        const auto err = compute_positions(vertices, out.positions);
+        if (err != error_t::none)
+            return err;
+
+        // 4. Fan triangulation of every cell over the distinct vertices.
+        out.triangles.clear();
+        out.triangles.reserve(max_triangle_count(cells.size()) * 3u);
+        const auto position_of = [&vertices](const index item) noexcept
+        { return static_cast<std::uint32_t>(std::lower_bound(vertices.begin(), vertices.end(), item) - vertices.begin()); };
+
+        for (std::size_t i {}; i != cells.size(); ++i)
+        {
+            const auto* cell_corners = corners.data() + i * vertex::max_count;
+            const auto first = position_of(cell_corners[0u]);
+            auto previous = position_of(cell_corners[1u]);
+            for (std::uint8_t j = 2u; j != vertex::count(cells[i]); ++j)
+            {
+                const auto current = position_of(cell_corners[j]);
+                out.triangles.insert(out.triangles.end(), {first, previous, current});
+                previous = current;
+            }
+        }
+
+        return error_t::none;
+    }
+}
@@ -0,0 +1,82 @@
+/// @file geohex/polygon/batch.cpp
+#include "kmx/geohex/polygon/batch.hpp"
+#include "kmx/geohex/polygon/prepared.hpp"
+#include "kmx/geohex/polygon/span_based.hpp"
+#include <kmx/parallel.hpp>
+#include <vector>
+
+namespace kmx::geohex::polygon::batch
+{
+    /// @brief The cells of a chunk of polygons.
+    using chunk_cells = chunk_output<index, error_t>;
+
+    /// @brief The buffers a thread reuses from one polygon to the next.
+    class worker
+    {
+    public:
+        explicit worker(const polygons& input) noexcept: input_ {input} {}
+
+        /// @brief Fills the polygons of a chunk.
+        void fill(const std::size_t first, const std::size_t last, const resolution_t resolution, chunk_cells& out)
+        {
+            out.counts.reserve(last - first);
+            for (auto i = first; i != last; ++i)
+            {
+                const auto first_ring = input_.polygon_offsets[i];
+                const auto last_ring = input_.polygon_offsets[i + 1u];
+                holes_.clear();
+                for (auto ring = first_ring + 1u; ring < last_ring; ++ring)
+                    holes_.push_back(ring_of(ring));
+
+                polygon_.assign(ring_of(first_ring), holes_);
+                const auto size = span_based::max_size(polygon_, resolution);
+                if (buffer_.size() < size)
+                    buffer_.resize(size);
+
+                std::span<index> cells {buffer_.data(), size};
+                out.error = span_based::to_cells(polygon_, resolution, cells);
+                if (out.error != error_t::none)
+                    return;
+
+                out.items.insert(out.items.end(), cells.begin(), cells.end());
+                out.counts.push_back(cells.size());
+            }
+        }
+
+    private:
+        span_based::item ring_of(const std::size_t ring) const noexcept
+        {
+            const auto first = input_.ring_offsets[ring];
+            return input_.coordinates.subspan(first, input_.ring_offsets[ring + 1u] - first);
+        }
+
+        const polygons& input_;
+        prepared polygon_;
+        std::vector<span_based::item> holes_;
+        std::vector<index> buffer_;
+    };
+
+    error_t to_cells(const polygons& polygons, const resolution_t resolution, cells& cells)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        const auto ring_count = polygons.ring_offsets.empty() ? 0u : polygons.ring_offsets.size() - 1u;
+        if (!are_valid_offsets(polygons.ring_offsets, polygons.coordinates.size()) ||
+            !are_valid_offsets(polygons.polygon_offsets, ring_count))
+            return error_t::domain;
+
+        // every polygon has its outer ring
+        const auto count = polygons.size();
+        for (std::size_t i {}; i != count; ++i)
+            if (polygons.polygon_offsets[i] == polygons.polygon_offsets[i + 1u])
+                return error_t::domain;
+
+        // each thread with its own buffers
+        return map_chunks<index, error_t>(
+            count, [&polygons] { return worker {polygons}; },
+            [resolution](worker& scratch, const std::size_t first, const std::size_t last, chunk_cells& out)
+            { scratch.fill(first, last, resolution, out); },
+            cells.items, cells.offsets);
+    }
+}
@@ -0,0 +1,421 @@
+/// @file geohex/polygon/prepared.cpp
+#include "kmx/geohex/polygon/prepared.hpp"
+#include "kmx/geohex/geo_projection.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <kmx/gis/wgs84/coordinate.hpp>
+
+namespace kmx::geohex::polygon
+{
+    static constexpr double pi = std::numbers::pi_v<double>;
+    static constexpr double two_pi = 2.0 * pi;
+    static constexpr double half_pi = 0.5 * pi;
+
+    /// @brief Most latitude bands of a ring; a ring gets one band per two edges up to this.
+    static constexpr std::size_t max_band_count = 1u << 20u;
+
+    /// @brief Edges of a node per cell of the node.
+    static constexpr std::size_t cell_size = 8u;
+
+    /// @brief Distance (in radians) kept between a point and the edges it does not visit.
+    static constexpr double margin = 1e-8;
+
+    /// @brief Distance (in radians) to a visited edge below which a point gets the exact test of H3; far above the moves
+    /// of the point by that test, a DBL_EPSILON per edge level with it, and below the margin.
+    static constexpr double tolerance = 1e-9;
+
+    bool prepared::edge::crosses(const double south, const double north, const double west, const double east) const noexcept
+    {
+        const double d_latitude = north_latitude - south_latitude;
+        const double d_longitude = north_longitude - south_longitude;
+        const std::array<std::array<double, 2u>, 4u> bounds {{
+            {-d_latitude, south_latitude - south},
+            {d_latitude, north - south_latitude},
+            {-d_longitude, south_longitude - west},
+            {d_longitude, east - south_longitude},
+        }};
+
+        double t0 = 0.0, t1 = 1.0;
+        for (const auto& [p, q]: bounds)
+        {
+            if (p == 0.0)
+            {
+                if (q < 0.0)
+                    return false;
+            }
+            else if (p < 0.0)
+                t0 = std::max(t0, q / p);
+            else
+                t1 = std::min(t1, q / p);
+        }
+
+        return t0 <= t1;
+    }
+
+    bool prepared::bounding_box::contains(const gis::wgs84::coordinate& coord) const noexcept
+    {
+        return (coord.latitude >= south) && (coord.latitude <= north) &&
+               (is_transmeridian() ? (coord.longitude >= west) || (coord.longitude <= east)
+                                   : (coord.longitude >= west) && (coord.longitude <= east));
+    }
+
+    void prepared::ring_index::index_edges()
+    {
+        west_ = DBL_MAX;
+        east_ = -DBL_MAX;
+        for (const auto& item: edges_)
+        {
+            west_ = std::min({west_, item.south_longitude, item.north_longitude});
+            east_ = std::max({east_, item.south_longitude, item.north_longitude});
+        }
+
+        const auto band_count = std::bit_floor(std::clamp<std::size_t>(edges_.size() / 2u, 1u, max_band_count));
+        const double height = bounds_.north - bounds_.south;
+        band_scale_ = height > 0.0 ? static_cast<double>(band_count) / height : 0.0;
+
+        // An edge ends in the bands of its ends, and is across the bands in between with the margin on both sides
+        // (band_of is monotonic); those make a range of bands, split among the nodes of the tree covering it.
+        const auto distribute = [this, band_count](const edge& item, auto&& to_band, auto&& to_node)
+        {
+            const auto first_across = band_of(item.south_latitude + margin) + 1u;
+            const auto last_across = std::max(band_of(item.north_latitude - margin), first_across);
+            for (auto band = band_of(item.south_latitude); band <= band_of(item.north_latitude); ++band)
+                if ((band < first_across) || (band >= last_across))
+                    to_band(band);
+
+            for (auto l = first_across + band_count, r = last_across + band_count; l < r; l >>= 1u, r >>= 1u)
+            {
+                if ((l & 1u) != 0u)
+                    to_node(l++);
+                if ((r & 1u) != 0u)
+                    to_node(--r);
+            }
+        };
+
+        // 1. Counting sort of the edges into the bands where they end and into the nodes, in ring order within each.
+        const auto node_count = 2u * band_count;
+        std::vector<std::uint32_t> node_offsets(node_count + 1u);
+        band_offsets_.assign(band_count + 1u, 0u);
+        for (const auto& item: edges_)
+            distribute(item, [this](const std::size_t band) { ++band_offsets_[band + 1u]; },
+                       [&node_offsets](const std::size_t node) { ++node_offsets[node + 1u]; });
+
+        for (std::size_t i {}; i != band_count; ++i)
+            band_offsets_[i + 1u] += band_offsets_[i];
+        for (std::size_t i {}; i != node_count; ++i)
+            node_offsets[i + 1u] += node_offsets[i];
+
+        band_edges_.resize(band_offsets_.back());
+        std::vector<std::uint32_t> node_edges(node_offsets.back());
+        auto band_cursors = band_offsets_;
+        auto node_cursors = node_offsets;
+        for (std::uint32_t i {}; i != edges_.size(); ++i)
+            distribute(edges_[i], [&, i](const std::size_t band) { band_edges_[band_cursors[band]++] = i; },
+                       [&, i](const std::size_t node) { node_edges[node_cursors[node]++] = i; });
+
+        // 2. The cells of each node, split at the quantiles of the longitudes of its edges, with the edges reaching each
+        // cell; the cells west of an edge count it in their parity.
+        struct longitude_range
+        {
+            double west;
+            double east;
+        };
+
+        std::vector<longitude_range> ranges;
+        std::vector<double> middles;
+        std::vector<std::uint8_t> starts;
+        node_cells_.assign(node_count + 1u, 0u);
+        cell_wests_.clear();
+        cell_offsets_.assign(1u, 0u);
+        for (std::size_t node {1u}; node != node_count; ++node)
+        {
+            // the longitudes of the edges between the latitudes of the node, widened by the margin
+            const auto level = static_cast<unsigned>(std::bit_width(node)) - 1u;
+            const auto first_band = (node - (std::size_t {1u} << level)) * (band_count >> level);
+            const double south = static_cast<double>(first_band) / band_scale_ + bounds_.south - margin;
+            const double north = static_cast<double>(first_band + (band_count >> level)) / band_scale_ + bounds_.south + margin;
+            ranges.clear();
+            middles.clear();
+            for (auto i = node_offsets[node]; i != node_offsets[node + 1u]; ++i)
+            {
+                const auto& item = edges_[node_edges[i]];
+                const double slope = (item.north_longitude - item.south_longitude) / (item.north_latitude - item.south_latitude);
+                const double a = item.south_longitude + (std::max(south, item.south_latitude) - item.south_latitude) * slope;
+                const double b = item.south_longitude + (std::min(north, item.north_latitude) - item.south_latitude) * slope;
+                ranges.push_back({std::min(a, b) - margin, std::max(a, b) + margin});
+                middles.push_back(0.5 * (a + b));
+            }
+
+            std::sort(middles.begin(), middles.end());
+            const auto cell_count = std::max<std::size_t>(1u, ranges.size() / cell_size);
+            cell_wests_.push_back(-DBL_MAX);
+            for (std::size_t i {1u}; i != cell_count; ++i)
+                cell_wests_.push_back(middles[i * middles.size() / cell_count]);
+
+            const auto first_cell = node_cells_[node];
+            const auto last_cell = first_cell + static_cast<std::uint32_t>(cell_count);
+            node_cells_[node + 1u] = last_cell;
+
+            starts.assign(cell_count, 0u);
+            cell_offsets_.resize(last_cell + 1u, 0u);
+            for (const auto& range: ranges)
+            {
+                const auto first = cell_of(node, range.west);
+                for (auto cell = first; cell <= cell_of(node, range.east); ++cell)
+                    ++cell_offsets_[cell + 1u];
+                starts[first - first_cell] ^= 1u;
+            }
+
+            for (auto cell = first_cell; cell != last_cell; ++cell)
+                cell_offsets_[cell + 1u] += cell_offsets_[cell];
+
+            cell_edges_.resize(cell_offsets_.back());
+            std::vector<std::uint32_t> cursors(cell_offsets_.begin() + first_cell, cell_offsets_.end() - 1);
+            for (std::size_t i {}; i != ranges.size(); ++i)
+                for (auto cell = cell_of(node, ranges[i].west); cell <= cell_of(node, ranges[i].east); ++cell)
+                    cell_edges_[cursors[cell - first_cell]++] = node_edges[node_offsets[node] + i];
+
+            std::uint8_t parity {};
+            cell_parities_.resize(last_cell);
+            for (auto cell = last_cell; cell-- != first_cell;)
+            {
+                cell_parities_[cell] = parity;
+                parity ^= starts[cell - first_cell];
+            }
+        }
+    }
+
+    std::size_t prepared::ring_index::band_of(const double latitude) const noexcept
+    {
+        const auto band = (latitude - bounds_.south) * band_scale_;
+        return std::min(static_cast<std::size_t>(std::max(band, 0.0)), band_offsets_.size() - 2u);
+    }
+
+    std::size_t prepared::ring_index::cell_of(const std::size_t node, const double longitude) const noexcept
+    {
+        // the last cell whose west bound is not east of the longitude
+        const auto first = cell_wests_.begin() + node_cells_[node];
+        const auto last = cell_wests_.begin() + node_cells_[node + 1u];
+        return static_cast<std::size_t>(std::upper_bound(first + 1, last, longitude) - cell_wests_.begin()) - 1u;
+    }
+
+    bool prepared::ring_index::contains(const gis::wgs84::coordinate& coord) const
+    {
+        if (!bounds_.contains(coord))
+            return false;
+
+        // The edges a point visits are those with an end in its band and those of its cells; the others stay over a
+        // margin away. Unless the point comes near a visited edge, or level with one of its ends, the moves of the
+        // point by the test of H3 change no crossing, and neither does the order of the edges.
+        const double latitude = coord.latitude;
+        const double longitude = bounds_.normalize(coord.longitude);
+        bool result = false;
+        bool near = false;
+        const auto visit = [&](const edge& item)
+        {
+            if ((std::abs(latitude - item.south_latitude) <= tolerance) || (std::abs(latitude - item.north_latitude) <= tolerance))
+                near = true;
+            else if ((latitude > item.south_latitude) && (latitude < item.north_latitude))
+            {
+                const double ratio = (latitude - item.south_latitude) / (item.north_latitude - item.south_latitude);
+                const double crossing = item.south_longitude + (item.north_longitude - item.south_longitude) * ratio;
+                near = near || (std::abs(crossing - longitude) <= tolerance);
+                result = result != (crossing > longitude);
+            }
+        };
+
+        const auto band = band_of(latitude);
+        for (auto i = band_offsets_[band]; i != band_offsets_[band + 1u]; ++i)
+            visit(edges_[band_edges_[i]]);
+
+        const auto band_count = band_offsets_.size() - 1u;
+        for (auto node = band + band_count; node != 0u; node >>= 1u)
+        {
+            const auto cell = cell_of(node, longitude);
+            result = result != (cell_parities_[cell] != 0u);
+            for (auto i = cell_offsets_[cell]; i != cell_offsets_[cell + 1u]; ++i)
+                visit(edges_[cell_edges_[i]]);
+        }
+
+        return near ? contains_exactly(coord) : result;
+    }
+
+    bool prepared::ring_index::contains_exactly(const gis::wgs84::coordinate& coord) const
+    {
+        // the edges of the band: those ending in it, and every edge of the nodes above it
+        const auto band = band_of(coord.latitude);
+        std::vector<std::uint32_t> ids(band_edges_.begin() + band_offsets_[band], band_edges_.begin() + band_offsets_[band + 1u]);
+        for (auto node = band + band_offsets_.size() - 1u; node != 0u; node >>= 1u)
+            ids.insert(ids.end(), cell_edges_.begin() + cell_offsets_[node_cells_[node]],
+                       cell_edges_.begin() + cell_offsets_[node_cells_[node + 1u]]);
+
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+        bool result = false;
+        double latitude = coord.latitude;
+        double longitude = bounds_.normalize(coord.longitude);
+        for (const auto id: ids)
+        {
+            const auto& item = edges_[id];
+
+            // a ray through a vertex would cross both of its edges: move it north
+            if ((latitude == item.south_latitude) || (latitude == item.north_latitude))
+                latitude += DBL_EPSILON;
+
+            if ((latitude < item.south_latitude) || (latitude > item.north_latitude))
+                continue;
+
+            // a point on a vertex longitude is moved west
+            if ((item.south_longitude == longitude) || (item.north_longitude == longitude))
+                longitude -= DBL_EPSILON;
+
+            const double ratio = (latitude - item.south_latitude) / (item.north_latitude - item.south_latitude);
+            const double crossing = bounds_.normalize(item.south_longitude + (item.north_longitude - item.south_longitude) * ratio);
+            if (crossing > longitude)
+                result = !result;
+        }
+
+        return result;
+    }
+
+    bool prepared::ring_index::crosses(const double south, const double north, const double longitude,
+                                       const double half_width) const noexcept
+    {
+        if ((south > bounds_.north) || (north < bounds_.south))
+            return false;
+
+        const auto band_count = band_offsets_.size() - 1u;
+        const auto first_band = band_of(south);
+        const auto last_band = band_of(north);
+
+        // the box in the plane of the edges, and its copies a turn away
+        const double center = bounds_.normalize(longitude);
+        for (const double shift: {0.0, -two_pi, two_pi})
+        {
+            const double west = center - half_width + shift;
+            const double east = center + half_width + shift;
+            if ((west > east_) || (east < west_))
+                continue;
+
+            const auto crosses_box = [&](const std::uint32_t id) { return edges_[id].crosses(south, north, west, east); };
+            for (auto band = first_band; band <= last_band; ++band)
+            {
+                if (std::any_of(band_edges_.begin() + band_offsets_[band], band_edges_.begin() + band_offsets_[band + 1u], crosses_box))
+                    return true;
+
+                // the nodes above the band, but those already above the previous band
+                for (auto node = band + band_count, previous = band - 1u + band_count; node != 0u; node >>= 1u, previous >>= 1u)
+                {
+                    if ((band != first_band) && (node == previous))
+                        break;
+
+                    const auto first = cell_offsets_[cell_of(node, west)];
+                    const auto last = cell_offsets_[cell_of(node, east) + 1u];
+                    if (std::any_of(cell_edges_.begin() + first, cell_edges_.begin() + last, crosses_box))
+                        return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    static math::vector3d to_unit_vector(const gis::wgs84::coordinate& coord) noexcept
+    {
+        math::vector3d result;
+        projection::to_v3d(coord, result);
+        return result;
+    }
+
+    /// @brief Gets the faces whose center is within `max_face_distance` of a point, as a bit set.
+    static std::uint32_t near_faces(const gis::wgs84::coordinate& coord) noexcept
+    {
+        static const double min_dot = std::cos(prepared::max_face_distance);
+        const auto point = to_unit_vector(coord);
+        std::uint32_t result {};
+        for (icosahedron::face::no_t i {}; i != icosahedron::face::count; ++i)
+            if (point.dot(icosahedron::face::center_point(static_cast<icosahedron::face::id_t>(i))) >= min_dot)
+                result |= 1u << i;
+        return result;
+    }
+
+    /// @brief Gets the faces near any end of the pieces of an edge, as a bit set.
+    static std::uint32_t near_faces(const prepared::edge& item) noexcept
+    {
+        const gis::wgs84::coordinate a {item.south_latitude, item.south_longitude};
+        const gis::wgs84::coordinate b {item.north_latitude, item.north_longitude};
+        const double length = std::max(std::abs(b.latitude - a.latitude), std::abs(b.longitude - a.longitude));
+        const auto piece_count = std::max<std::size_t>(1u, static_cast<std::size_t>(std::ceil(length / prepared::max_piece_length)));
+
+        std::uint32_t result = near_faces(a) | near_faces(b);
+        for (std::size_t piece {1u}; piece < piece_count; ++piece)
+        {
+            const double t = static_cast<double>(piece) / static_cast<double>(piece_count);
+            const gis::wgs84::coordinate point {a.latitude + (b.latitude - a.latitude) * t, a.longitude + (b.longitude - a.longitude) * t};
+            result |= near_faces(point);
+        }
+
+        return result;
+    }
+
+    void prepared::index_faces()
+    {
+        face_offsets_ = {};
+        face_edges_.clear();
+        vertex_count_ = 0u;
+        for (const auto& ring: rings_)
+            vertex_count_ += ring.edges().size();
+
+        // counting sort of the edges into the faces they come near
+        std::vector<std::uint32_t> faces;
+        faces.reserve(vertex_count_);
+        for (const auto& ring: rings_)
+            for (const auto& item: ring.edges())
+            {
+                faces.push_back(near_faces(item));
+                for (icosahedron::face::no_t i {}; i != icosahedron::face::count; ++i)
+                    face_offsets_[i + 1u] += (faces.back() >> i) & 1u;
+            }
+
+        for (icosahedron::face::no_t i {}; i != icosahedron::face::count; ++i)
+            face_offsets_[i + 1u] += face_offsets_[i];
+
+        face_edges_.resize(face_offsets_.back());
+        auto cursors = face_offsets_;
+        std::size_t next {};
+        for (const auto& ring: rings_)
+            for (const auto& item: ring.edges())
+            {
+                for (icosahedron::face::no_t i {}; i != icosahedron::face::count; ++i)
+                    if ((faces[next] >> i) & 1u)
+                        face_edges_[cursors[i]++] = item;
+                ++next;
+            }
+    }
+
+    std::span<const prepared::edge> prepared::edges_near(const icosahedron::face::id_t face) const noexcept
+    {
+        return std::span<const edge> {face_edges_}.subspan(face_offsets_[+face], face_offsets_[+face + 1u] - face_offsets_[+face]);
+    }
+
+    bool prepared::contains(const gis::wgs84::coordinate& coord) const
+    {
+        if (rings_.empty() || !rings_.front().contains(coord))
+            return false;
+
+        return std::none_of(rings_.begin() + 1, rings_.end(), [&coord](const ring_index& hole) { return hole.contains(coord); });
+    }
+
+    bool prepared::crosses(const gis::wgs84::coordinate& center, const double radius) const noexcept
+    {
+        // the latitude/longitude box of the cap, whose widest parallel is at its latitude closest to a pole
+        const double south = std::max(center.latitude - radius, -half_pi);
+        const double north = std::min(center.latitude + radius, half_pi);
+        const double max_cos = std::cos(std::max(std::abs(north), std::abs(south)));
+        const double half_width = max_cos > std::sin(radius) ? std::asin(std::sin(radius) / max_cos) : pi;
+        return std::any_of(rings_.begin(), rings_.end(), [&](const ring_index& ring)
+                           { return ring.crosses(south, north, center.longitude, half_width); });
+    }
+}
@@ -0,0 +1,830 @@
+/// @file geohex/polygon/span_based.cpp
+#include "kmx/geohex/polygon/span_based.hpp"
+#include "kmx/geohex/cell.hpp"
+#include "kmx/geohex/cell/bounds.hpp"
+#include "kmx/geohex/coordinate/ijk.hpp"
+#include "kmx/geohex/geo_projection.hpp"
+#include "kmx/geohex/icosahedron/face.hpp"
+#include "kmx/geohex/polygon/prepared.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <kmx/parallel.hpp>
+#include <numbers>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace kmx::geohex::polygon::span_based
+{
+    static constexpr double pi = std::numbers::pi_v<double>;
+    static constexpr double two_pi = 2.0 * pi;
+    static constexpr double half_pi = 0.5 * pi;
+
+    /// @brief Half width (in cells) of the band around a polygon edge where cells are tested one by one.
+    static constexpr double edge_band = 0.5;
+
+    /// @brief Distance (in cells) beyond the face edges still scanned, to reach the cells straddling them.
+    static constexpr double face_margin = 2.0;
+
+    /// @brief Distance (in cells) inside the face edges from which a cell surely belongs to the face.
+    static constexpr double face_interior = 1.5;
+
+    /// @brief Below this resolution the faces hold so few cells that every one is tested.
+    static constexpr resolution_t min_scanline_resolution = resolution_t::r2;
+
+    /// @brief Lower bound of the area of a resolution 0 cell (a pentagon), in steradians; each finer resolution divides
+    /// it by 7.
+    static constexpr double min_cell_area_r0 = 0.05;
+
+    /// @ref POLYGON_TO_CELLS_BUFFER
+    static constexpr std::size_t size_buffer = 12u;
+
+    /// @brief Fewer cells than this are filled on the calling thread.
+    static constexpr std::size_t min_parallel_size = 1u << 16u;
+
+    /// @brief A piece of a polygon edge projected on a face, as a straight line of its grid.
+    struct segment
+    {
+        math::vector2d a;
+        math::vector2d b;
+        double y_min;
+        double y_max;
+    };
+
+    /// @brief The rows of the grid of a face, with the polygon edges crossing them.
+    struct face_plan
+    {
+        icosahedron::face::id_t face;
+        std::array<math::vector2d, 3u> corners;            ///< The face vertices in the grid.
+        std::array<std::array<double, 3u>, 3u> edge_lines; ///< Inward unit normal and offset of each face edge.
+        std::vector<segment> segments;                     ///< Sorted by `y_min`.
+        std::int64_t first_row;
+        std::int64_t last_row;
+        bool exhaustive; ///< Every cell is tested, at coarse resolutions.
+    };
+
+    /// @brief A range of rows of a face, filled by one task.
+    struct row_range
+    {
+        const face_plan* plan;
+        std::int64_t first;
+        std::int64_t last;
+    };
+
+    static math::vector3d to_unit_vector(const gis::wgs84::coordinate& coord) noexcept
+    {
+        math::vector3d result;
+        projection::to_v3d(coord, result);
+        return result;
+    }
+
+    /// @brief Gets the point of a ring edge at a parameter, along the straight line of the latitude/longitude plane.
+    static gis::wgs84::coordinate interpolate(const gis::wgs84::coordinate& a, const gis::wgs84::coordinate& b, const double t) noexcept
+    {
+        return {a.latitude + (b.latitude - a.latitude) * t, a.longitude + (b.longitude - a.longitude) * t};
+    }
+
+    /// @brief Projects a piece of a ring edge on a face, split until each segment stays within a tenth of the band of
+    /// the projected curve.
+    static void project_piece(const gis::wgs84::coordinate& a, const gis::wgs84::coordinate& b, const math::vector2d& pa,
+                              const math::vector2d& pb, const face_plan& plan, const resolution_t res, const std::uint8_t depth,
+                              std::vector<segment>& out)
+    {
+        const auto middle = interpolate(a, b, 0.5);
+        math::vector2d pm;
+        projection::to_hex2d(middle, plan.face, res, pm);
+
+        const auto chord_middle = (pa + pb) * 0.5;
+        const auto deviation = pm - chord_middle;
+        if ((depth != 0u) && ((deviation.x * deviation.x + deviation.y * deviation.y) > 0.01 * edge_band * edge_band))
+        {
+            project_piece(a, middle, pa, pm, plan, res, depth - 1u, out);
+            project_piece(middle, b, pm, pb, plan, res, depth - 1u, out);
+            return;
+        }
+
+        out.push_back({pa, pb, std::min(pa.y, pb.y), std::max(pa.y, pb.y)});
+    }
+
+    /// @brief Projects the edges of a polygon near a face on the grid of the face.
+    static void project_edges(const prepared& polygon, face_plan& plan, const resolution_t res)
+    {
+        const auto center = icosahedron::face::center_point(plan.face);
+        const double min_dot = std::cos(prepared::max_face_distance);
+        for (const auto& edge: polygon.edges_near(plan.face))
+        {
+            // the edge is a straight line of the plane where the ring longitudes are continuous
+            const gis::wgs84::coordinate a {edge.south_latitude, edge.south_longitude};
+            const gis::wgs84::coordinate b {edge.north_latitude, edge.north_longitude};
+
+            const double length = std::max(std::abs(b.latitude - a.latitude), std::abs(b.longitude - a.longitude));
+            const auto piece_count = std::max<std::size_t>(1u, static_cast<std::size_t>(std::ceil(length / prepared::max_piece_length)));
+            auto from = a;
+            bool from_near = to_unit_vector(from).dot(center) >= min_dot;
+            for (std::size_t piece {1u}; piece <= piece_count; ++piece)
+            {
+                const auto to = piece == piece_count ? b : interpolate(a, b, static_cast<double>(piece) / static_cast<double>(piece_count));
+                const bool to_near = to_unit_vector(to).dot(center) >= min_dot;
+                if (from_near || to_near)
+                {
+                    math::vector2d pa, pb;
+                    projection::to_hex2d(from, plan.face, res, pa);
+                    projection::to_hex2d(to, plan.face, res, pb);
+                    project_piece(from, to, pa, pb, plan, res, 16u, plan.segments);
+                }
+
+                from = to;
+                from_near = to_near;
+            }
+        }
+    }
+
+    /// @brief Computes the grid of a face at a resolution: its vertices, edges and rows.
+    static face_plan make_face_grid(const icosahedron::face::id_t face, const resolution_t res)
+    {
+        face_plan plan {};
+        plan.face = face;
+
+        // the face vertices, from the substrate grid of resolution 0
+        const double corner_distance = 3.0 * icosahedron::face::max_dimension(0u);
+        const std::array<math::vector2d, 3u> substrate_corners {{
+            {corner_distance, 0.0},
+            {-0.5 * corner_distance, sqrt3_2 * corner_distance},
+            {-0.5 * corner_distance, -sqrt3_2 * corner_distance},
+        }};
+
+        for (std::uint8_t i {}; i != 3u; ++i)
+        {
+            gis::wgs84::coordinate corner;
+            projection::from_hex2d(substrate_corners[i], plan.face, 0u, true, corner);
+            projection::to_hex2d(corner, plan.face, res, plan.corners[i]);
+        }
+
+        for (std::uint8_t i {}; i != 3u; ++i)
+        {
+            const auto& a = plan.corners[i];
+            const auto& b = plan.corners[(i + 1u) % 3u];
+            const auto along = b - a;
+            const double length = std::sqrt(along.x * along.x + along.y * along.y);
+
+            // the face center is the origin, on the inner side of every edge
+            math::vector2d normal {-along.y / length, along.x / length};
+            if ((normal.x * a.x + normal.y * a.y) > 0.0)
+                normal = normal * -1.0;
+
+            plan.edge_lines[i] = {normal.x, normal.y, -(normal.x * a.x + normal.y * a.y)};
+        }
+
+        double y_min = DBL_MAX, y_max = -DBL_MAX;
+        for (const auto& corner: plan.corners)
+        {
+            y_min = std::min(y_min, corner.y);
+            y_max = std::max(y_max, corner.y);
+        }
+
+        plan.first_row = static_cast<std::int64_t>(std::ceil((y_min - face_margin) / sqrt3_2));
+        plan.last_row = static_cast<std::int64_t>(std::floor((y_max + face_margin) / sqrt3_2));
+        plan.exhaustive = +res < +min_scanline_resolution;
+        return plan;
+    }
+
+    /// @brief Gets the grid of a face at a resolution, computed for every face and resolution on first use.
+    static const face_plan& face_grid(const icosahedron::face::id_t face, const resolution_t res)
+    {
+        static const auto grids = []
+        {
+            std::vector<face_plan> result;
+            result.reserve(icosahedron::face::count * resolution_count);
+            for (icosahedron::face::no_t i {}; i != icosahedron::face::count; ++i)
+                for (std::uint8_t r {}; r != resolution_count; ++r)
+                    result.push_back(make_face_grid(static_cast<icosahedron::face::id_t>(i), static_cast<resolution_t>(r)));
+            return result;
+        }();
+
+        return grids[+face * resolution_count + +res];
+    }
+
+    /// @brief The faces whose cells a polygon may reach.
+    /// @details The cells of a face have their centers within `face_margin` cells of it, and the faces split the sphere
+    /// as the nearest face centers do; a face is only skipped when the bounding cap of the polygon stays farther than
+    /// that from the points nearer to its center than to the center of the face holding the cap center.
+    class face_filter
+    {
+    public:
+        face_filter(const prepared& polygon, const resolution_t res) noexcept
+        {
+            // the cap around the outer ring bounding box, through its farthest corner
+            const auto& bounds = polygon.bounds(0u);
+            const double east = bounds.is_transmeridian() ? bounds.east + two_pi : bounds.east;
+            const gis::wgs84::coordinate center {0.5 * (bounds.north + bounds.south), 0.5 * (bounds.west + east)};
+            center_ = to_unit_vector(center);
+            double radius {};
+            for (const auto latitude: {bounds.south, bounds.north})
+                for (const auto longitude: {bounds.west, east})
+                    radius = std::max(radius, std::acos(std::clamp(center_.dot(to_unit_vector({latitude, longitude})), -1.0, 1.0)));
+
+            if (radius > max_filtered_radius)
+                return;
+
+            const double cell_width = 2.0 * cell::bounds::max_radius(res);
+            const double margin = (face_margin + edge_band + 1.0) * cell_width;
+            reach_ = std::sin(std::min(radius + margin, half_pi));
+            double best = -DBL_MAX;
+            for (icosahedron::face::no_t i {}; i != icosahedron::face::count; ++i)
+            {
+                const double dot = center_.dot(icosahedron::face::center_point(static_cast<icosahedron::face::id_t>(i)));
+                if (dot > best)
+                {
+                    best = dot;
+                    home_ = static_cast<icosahedron::face::id_t>(i);
+                }
+            }
+
+            filtered_ = true;
+        }
+
+        /// @brief Checks whether the cells of a face may be in the polygon.
+        bool reaches(const icosahedron::face::id_t face) const noexcept
+        {
+            if (!filtered_ || (face == home_))
+                return true;
+
+            // the sine of the distance from the cap center to the plane between the two face centers
+            const auto home_center = icosahedron::face::center_point(home_);
+            const auto face_center = icosahedron::face::center_point(face);
+            const auto between = home_center - face_center;
+            return center_.dot(between) <= reach_ * std::sqrt(between.dot(between));
+        }
+
+    private:
+        /// @brief Caps wider than this (in radians) reach every face.
+        static constexpr double max_filtered_radius = 0.1;
+
+        math::vector3d center_;
+        double reach_ {};
+        icosahedron::face::id_t home_ {};
+        bool filtered_ {};
+    };
+
+    /// @brief Prepares the scan of a face, or returns false when the polygon does not reach it.
+    static bool plan_face(const prepared& polygon, const resolution_t res, face_plan& plan)
+    {
+        if (plan.exhaustive)
+            return true;
+
+        project_edges(polygon, plan, res);
+
+        // without an edge near the face, the face is entirely inside or outside the polygon
+        if (plan.segments.empty() && !polygon.contains(icosahedron::face::center_wgs(plan.face)))
+            return false;
+
+        std::sort(plan.segments.begin(), plan.segments.end(), [](const segment& a, const segment& b) { return a.y_min < b.y_min; });
+        return true;
+    }
+
+    /// @brief Scans a range of rows of a face.
+    class row_scanner
+    {
+    public:
+        row_scanner(const prepared& polygon, const resolution_t res, std::vector<index>& out) noexcept:
+            polygon_ {polygon}, res_ {res}, out_ {out}
+        {
+        }
+
+        void scan(const row_range& range)
+        {
+            const auto& plan = *range.plan;
+            plan_ = &plan;
+            active_.clear();
+
+            std::size_t next_segment {};
+            const auto& segments = plan.segments;
+            bool known_empty_status = false;
+            bool empty_status = false;
+            for (auto row = range.first; row <= range.last; ++row)
+            {
+                const double y = static_cast<double>(row) * sqrt3_2;
+
+                // update the segments within the band of the row
+                while ((next_segment != segments.size()) && (segments[next_segment].y_min - edge_band <= y))
+                    active_.push_back(&segments[next_segment++]);
+
+                std::erase_if(active_, [y](const segment* item) { return item->y_max + edge_band < y; });
+
+                std::int64_t first, last;
+                if (!row_extent(row, y, first, last))
+                    continue;
+
+                if (plan.exhaustive)
+                {
+                    for (auto i = first; i <= last; ++i)
+                        test_cell(i, row);
+                    continue;
+                }
+
+                if (active_.empty())
+                {
+                    // no polygon edge between the last rows without one: their status holds
+                    if (!known_empty_status)
+                    {
+                        empty_status = contains(first, row);
+                        known_empty_status = true;
+                    }
+
+                    if (empty_status)
+                        emit_run(first, last, row);
+                    else if (next_segment != segments.size())
+                    {
+                        // skip to the row where the next edge starts
+                        const auto next_row = static_cast<std::int64_t>(std::ceil((segments[next_segment].y_min - edge_band) / sqrt3_2));
+                        row = std::max(row, std::min(next_row, range.last + 1) - 1);
+                    }
+                    else
+                        break;
+
+                    continue;
+                }
+
+                known_empty_status = false;
+                scan_row(row, y, first, last);
+            }
+        }
+
+    private:
+        /// @brief Gets the cells of a row within the margin of the face.
+        bool row_extent(const std::int64_t row, const double y, std::int64_t& first, std::int64_t& last) const noexcept
+        {
+            double x_min = DBL_MAX, x_max = -DBL_MAX;
+            const auto& corners = plan_->corners;
+            const double y_low = y - face_margin, y_high = y + face_margin;
+            for (std::uint8_t i {}; i != 3u; ++i)
+                clip_x(corners[i], corners[(i + 1u) % 3u], y_low, y_high, x_min, x_max);
+
+            if (x_min > x_max)
+                return false;
+
+            // the cell (i, row) is centered at x = i - row / 2
+            const double offset = 0.5 * static_cast<double>(row);
+            first = static_cast<std::int64_t>(std::ceil(x_min - face_margin + offset));
+            last = static_cast<std::int64_t>(std::floor(x_max + face_margin + offset));
+            return first <= last;
+        }
+
+        /// @brief Extends an x range with the part of a segment between two heights.
+        static void clip_x(const math::vector2d& a, const math::vector2d& b, const double y_low, const double y_high, double& x_min,
+                           double& x_max) noexcept
+        {
+            const double dy = b.y - a.y;
+            double t0 = 0.0, t1 = 1.0;
+            if (dy != 0.0)
+            {
+                t0 = (y_low - a.y) / dy;
+                t1 = (y_high - a.y) / dy;
+                if (t0 > t1)
+                    std::swap(t0, t1);
+
+                t0 = std::max(t0, 0.0);
+                t1 = std::min(t1, 1.0);
+                if (t0 > t1)
+                    return;
+            }
+            else if ((a.y < y_low) || (a.y > y_high))
+                return;
+
+            const double x0 = a.x + (b.x - a.x) * t0;
+            const double x1 = a.x + (b.x - a.x) * t1;
+            x_min = std::min({x_min, x0, x1});
+            x_max = std::max({x_max, x0, x1});
+        }
+
+        /// @brief Scans a row crossed by polygon edges: the cells in their bands are tested one by one, each run of
+        /// cells between the bands takes the status of its first cell.
+        void scan_row(const std::int64_t row, const double y, const std::int64_t first, const std::int64_t last)
+        {
+            const double offset = 0.5 * static_cast<double>(row);
+            bands_.clear();
+            for (const auto* item: active_)
+            {
+                double x_min = DBL_MAX, x_max = -DBL_MAX;
+                clip_x(item->a, item->b, y - edge_band, y + edge_band, x_min, x_max);
+                if (x_min > x_max)
+                    continue;
+
+                const auto band_first = static_cast<std::int64_t>(std::ceil(x_min - edge_band + offset));
+                const auto band_last = static_cast<std::int64_t>(std::floor(x_max + edge_band + offset));
+                if ((band_first <= last) && (band_last >= first) && (band_first <= band_last))
+                    bands_.emplace_back(std::max(band_first, first), std::min(band_last, last));
+            }
+
+            std::sort(bands_.begin(), bands_.end());
+            auto i = first;
+            for (std::size_t b {}; i <= last;)
+            {
+                // merge the overlapping bands starting before the current cell
+                if ((b != bands_.size()) && (bands_[b].first <= i))
+                {
+                    auto band_last = bands_[b].second;
+                    while ((++b != bands_.size()) && (bands_[b].first <= band_last + 1))
+                        band_last = std::max(band_last, bands_[b].second);
+
+                    for (; i <= band_last; ++i)
+                        test_cell(i, row);
+                    continue;
+                }
+
+                const auto run_last = b != bands_.size() ? bands_[b].first - 1 : last;
+                if (contains(i, row))
+                    emit_run(i, run_last, row);
+                i = run_last + 1;
+            }
+        }
+
+        /// @brief Gets the signed distance of a cell center to the closest face edge, positive inside the face.
+        double face_distance(const math::vector2d& v) const noexcept
+        {
+            double result = DBL_MAX;
+            for (const auto& line: plan_->edge_lines)
+                result = std::min(result, line[0u] * v.x + line[1u] * v.y + line[2u]);
+            return result;
+        }
+
+        static math::vector2d center_of(const std::int64_t i, const std::int64_t j) noexcept
+        {
+            const auto v = static_cast<double>(j);
+            return {static_cast<double>(i) - 0.5 * v, v * sqrt3_2};
+        }
+
+        bool contains(const std::int64_t i, const std::int64_t j) const noexcept
+        {
+            gis::wgs84::coordinate center;
+            projection::from_hex2d(center_of(i, j), plan_->face, +res_, false, center);
+            return polygon_.contains(center);
+        }
+
+        void test_cell(const std::int64_t i, const std::int64_t j)
+        {
+            if ((face_distance(center_of(i, j)) >= -face_margin) && contains(i, j))
+                emit(i, j);
+        }
+
+        void emit_run(const std::int64_t first, const std::int64_t last, const std::int64_t j)
+        {
+            for (auto i = first; i <= last; ++i)
+                emit(i, j);
+        }
+
+        /// @brief Emits the cell at a grid position, unless another face holds its center.
+        void emit(const std::int64_t i, const std::int64_t j)
+        {
+            const double distance = face_distance(center_of(i, j));
+            if (distance < -face_margin)
+                return;
+
+            coordinate::ijk coords {static_cast<coordinate::ijk::value>(i), static_cast<coordinate::ijk::value>(j), 0};
+            coords.normalize();
+
+            const icosahedron::face::ijk fijk {coords, plan_->face};
+            index cell;
+            if (icosahedron::face::to_index(fijk, res_, cell) != error_t::none)
+                return;
+
+            // near the face edges the cell is emitted from the face of its canonical coordinates only
+            if (distance < face_interior)
+            {
+                icosahedron::face::ijk canonical;
+                if ((icosahedron::face::from_index(cell, canonical) != error_t::none) || (canonical != fijk))
+                    return;
+            }
+
+            out_.push_back(cell);
+        }
+
+        const prepared& polygon_;
+        const resolution_t res_;
+        std::vector<index>& out_;
+        const face_plan* plan_ {};
+        std::vector<const segment*> active_;
+        std::vector<std::pair<std::int64_t, std::int64_t>> bands_;
+    };
+
+    /// @brief Fills a polygon down the cell hierarchy, into a compacted cover.
+    class hierarchy_filler
+    {
+    public:
+        hierarchy_filler(const prepared& polygon, const resolution_t res) noexcept: polygon_ {polygon}, res_ {res}
+        {
+            cell::bounds::center_reaches(res, reaches_);
+        }
+
+        /// @brief The position of a cell against the polygon.
+        enum class status_t : std::uint8_t
+        {
+            outside,  ///< No descendant center is in the polygon.
+            inside,   ///< Every descendant center is in the polygon.
+            boundary, ///< The polygon boundary passes among the descendant centers.
+        };
+
+        /// @brief Classifies a cell from the cap holding the centers of its descendants at the target resolution.
+        status_t classify(const index cell) const noexcept
+        {
+            gis::wgs84::coordinate center;
+            if (to_wgs(cell, center) != error_t::none)
+                return status_t::outside;
+
+            // without the polygon boundary in the cap, the descendant centers all share the status of the center
+            const auto res = +cell.resolution();
+            if ((res != +res_) && polygon_.crosses(center, reaches_[res]))
+                return status_t::boundary;
+
+            return polygon_.contains(center) ? status_t::inside : status_t::outside;
+        }
+
+        /// @brief Fills the descendants of a cell, down to the cells handed to `leaf`.
+        /// @param leaf Fills a cell of `leaf_res` and tells whether all its descendants are in the polygon.
+        /// @param halted Tells whether to give up the fill.
+        /// @return True when all the descendants are in the polygon: the cell itself was then emitted.
+        template <typename Leaf, typename Halted>
+        bool descend(const index cell, const resolution_t leaf_res, std::vector<index>& out, Leaf&& leaf, Halted&& halted) const
+        {
+            if (halted())
+                return false;
+
+            if (cell.resolution() == leaf_res)
+                return leaf(cell, out);
+
+            switch (classify(cell))
+            {
+                case status_t::outside:
+                    return false;
+                case status_t::inside:
+                    out.push_back(cell);
+                    return true;
+                default:
+                    break;
+            }
+
+            const auto first = out.size();
+            bool full = true;
+            cell::for_each_child(cell, [&](const index child) { full = descend(child, leaf_res, out, leaf, halted) && full; });
+
+            // a complete set of children is replaced by its parent
+            if (full)
+            {
+                out.resize(first);
+                out.push_back(cell);
+            }
+
+            return full;
+        }
+
+        /// @brief Fills the descendants of a cell down to the target resolution.
+        /// @param capacity Stops once the cells cannot fit this many items any more.
+        /// @return True when all the descendants are in the polygon.
+        bool fill(const index cell, std::vector<index>& out, const std::size_t capacity, const std::atomic<bool>& stop) const
+        {
+            // Compacting a set of siblings removes at most 6 cells from the output, once per resolution of the path
+            // being filled: beyond that margin, the output cannot shrink back under the capacity.
+            const auto limit = capacity + 6u * resolution_count;
+            return descend(
+                cell, res_, out,
+                [this](const index leaf, std::vector<index>& leaf_out)
+                {
+                    if (classify(leaf) != status_t::inside)
+                        return false;
+
+                    leaf_out.push_back(leaf);
+                    return true;
+                },
+                [&] { return stop || (out.size() > limit); });
+        }
+
+    private:
+        const prepared& polygon_;
+        const resolution_t res_;
+        double reaches_[resolution_count] {};
+    };
+
+    /// @brief Upper bound of the cells of a polygon, from its bounding box and number of vertices.
+    static std::size_t max_size(const prepared::bounding_box& bounds, const std::size_t vertex_count,
+                                const resolution_t resolution) noexcept
+    {
+        // The cells centered in the polygon are disjoint and lie within its bounding box grown by a cell radius, so
+        // their number is below the area of that box divided by the smallest cell area.
+        const double radius = cell::bounds::max_radius(resolution) + cell::bounds::radius_margin;
+        const double north = std::min(bounds.north + radius, half_pi);
+        const double south = std::max(bounds.south - radius, -half_pi);
+
+        double width = bounds.is_transmeridian() ? bounds.east - bounds.west + two_pi : bounds.east - bounds.west;
+        const double max_cos = std::cos(std::max(std::abs(north), std::abs(south)));
+        width += (max_cos > std::sin(radius)) ? 2.0 * std::asin(std::sin(radius) / max_cos) : two_pi;
+        width = std::min(width, two_pi);
+
+        const double area = width * (std::sin(north) - std::sin(south));
+        const double cells = std::ceil(area / (min_cell_area_r0 / std::pow(7.0, +resolution)));
+
+        /// @ref getNumCells
+        const double total = 2.0 + 120.0 * std::pow(7.0, +resolution);
+        return static_cast<std::size_t>(std::min(cells, total)) + vertex_count + size_buffer;
+    }
+
+    std::size_t max_size(const item& polygon, const resolution_t resolution) noexcept
+    {
+        return max_size(polygon, {}, resolution);
+    }
+
+    std::size_t max_size(const item& polygon, const span& holes, const resolution_t resolution) noexcept
+    {
+        if ((+resolution >= resolution_count) || polygon.empty())
+            return 0u;
+
+        std::size_t vertex_count = polygon.size();
+        for (const auto& hole: holes)
+            vertex_count += hole.size();
+
+        return max_size(prepared::bounding_box::of(polygon), vertex_count, resolution);
+    }
+
+    std::size_t max_size(const prepared& polygon, const resolution_t resolution) noexcept
+    {
+        if ((+resolution >= resolution_count) || (polygon.ring_count() == 0u) || polygon.edges(0u).empty())
+            return 0u;
+
+        return max_size(polygon.bounds(0u), polygon.vertex_count(), resolution);
+    }
+
+    error_t to_cells(const item& polygon, const resolution_t resolution, std::span<index>& cells)
+    {
+        return to_cells(polygon, {}, resolution, cells);
+    }
+
+    error_t to_cells(const item& polygon, const span& holes, const resolution_t resolution, std::span<index>& cells)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        return to_cells(prepared {polygon, holes}, resolution, cells);
+    }
+
+    error_t to_cells(const prepared& polygon, const resolution_t resolution, std::span<index>& cells)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        if (!polygon.is_finite())
+            return error_t::latlng_domain;
+
+        if (polygon.edges(0u).size() < 3u)
+        {
+            cells = cells.first(0u);
+            return error_t::none;
+        }
+
+        // 1. The faces reached by the polygon, with its edges projected on their grids.
+        const face_filter filter {polygon, resolution};
+        std::vector<face_plan> plans;
+        for (icosahedron::face::no_t i {}; i != icosahedron::face::count; ++i)
+        {
+            const auto face = static_cast<icosahedron::face::id_t>(i);
+            if (!filter.reaches(face))
+                continue;
+
+            auto plan = face_grid(face, resolution);
+            if (plan_face(polygon, resolution, plan))
+                plans.push_back(std::move(plan));
+        }
+
+        // 2. Rows ranges to fill, several per face when the polygon is large.
+        const auto parallel = max_size(polygon, resolution) >= min_parallel_size;
+        const auto thread_count = parallel ? std::max(1u, std::thread::hardware_concurrency()) : 1u;
+        const std::int64_t splits = thread_count == 1u ? 1 : 4 * static_cast<std::int64_t>(thread_count);
+
+        std::vector<row_range> ranges;
+        for (const auto& plan: plans)
+        {
+            const auto row_count = plan.last_row - plan.first_row + 1;
+            const auto step = std::max<std::int64_t>(1, (row_count + splits - 1) / splits);
+            for (auto first = plan.first_row; first <= plan.last_row; first += step)
+                ranges.push_back({&plan, first, std::min(first + step - 1, plan.last_row)});
+        }
+
+        // 3. The fill, into one buffer per range so the cells come out in range order.
+        std::vector<std::vector<index>> results(ranges.size());
+        run_parallel(ranges.size(), std::clamp<std::size_t>(ranges.size(), 1u, thread_count),
+                     [&](const std::size_t task)
+                     {
+                         row_scanner scanner {polygon, resolution, results[task]};
+                         scanner.scan(ranges[task]);
+                     });
+
+        std::size_t total {};
+        for (const auto& result: results)
+            total += result.size();
+
+        if (total > cells.size())
+        {
+            cells = cells.first(0u);
+            return error_t::memory_bounds;
+        }
+
+        auto dest = cells.begin();
+        for (const auto& result: results)
+            dest = std::copy(result.begin(), result.end(), dest);
+
+        cells = cells.first(total);
+        return error_t::none;
+    }
+
+    error_t to_compact_cells(const item& polygon, const resolution_t resolution, std::span<index>& cells)
+    {
+        return to_compact_cells(polygon, {}, resolution, cells);
+    }
+
+    error_t to_compact_cells(const item& polygon, const span& holes, const resolution_t resolution, std::span<index>& cells)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        return to_compact_cells(prepared {polygon, holes}, resolution, cells);
+    }
+
+    error_t to_compact_cells(const prepared& polygon, const resolution_t resolution, std::span<index>& cells)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        if (!polygon.is_finite())
+            return error_t::latlng_domain;
+
+        if (polygon.edges(0u).size() < 3u)
+        {
+            cells = cells.first(0u);
+            return error_t::none;
+        }
+
+        const hierarchy_filler filler {polygon, resolution};
+        const auto parallel = max_size(polygon, resolution) >= min_parallel_size;
+        const auto thread_count = parallel ? std::max(1u, std::thread::hardware_concurrency()) : 1u;
+
+        // 1. The subtrees filled by tasks: the base cells, or the boundary cells of the first resolution where they
+        // are numerous enough to share between the threads.
+        std::vector<index> roots;
+        for (const auto& base: cell::bounds::base_cells())
+            roots.push_back(base.cell);
+
+        auto roots_res = resolution_t::r0;
+        while ((thread_count > 1u) && (roots_res != resolution) && (roots.size() < 8u * thread_count))
+        {
+            std::vector<index> children;
+            for (const auto root: roots)
+                if (filler.classify(root) == hierarchy_filler::status_t::boundary)
+                    cell::for_each_child(root, [&children](const index child) { children.push_back(child); });
+
+            roots = std::move(children);
+            roots_res = static_cast<resolution_t>(+roots_res + 1u);
+        }
+
+        // 2. The subtrees, each into its own buffer. A subtree that is not full ends up unchanged in the result, so
+        // once those exceed the capacity the fill stops.
+        std::vector<std::vector<index>> results(roots.size());
+        std::vector<std::uint8_t> full(roots.size());
+        std::atomic<std::size_t> total {};
+        std::atomic<bool> stop {};
+        run_parallel(roots.size(), std::clamp<std::size_t>(roots.size(), 1u, thread_count),
+                     [&](const std::size_t task)
+                     {
+                         full[task] = filler.fill(roots[task], results[task], cells.size(), stop);
+                         if (!full[task] && ((total += results[task].size()) > cells.size()))
+                             stop = true;
+                     });
+
+        // 3. The resolutions above the subtrees, merging the complete sets of siblings across them.
+        std::vector<index> result;
+        if (!stop)
+        {
+            std::size_t next_root {};
+            const auto take_root = [&](const index, std::vector<index>& out)
+            {
+                const auto& root_result = results[next_root];
+                out.insert(out.end(), root_result.begin(), root_result.end());
+                return full[next_root++] != 0u;
+            };
+
+            for (const auto& base: cell::bounds::base_cells())
+                filler.descend(base.cell, roots_res, result, take_root, [] { return false; });
+        }
+
+        if (stop || (result.size() > cells.size()))
+        {
+            cells = cells.first(0u);
+            return error_t::memory_bounds;
+        }
+
+        std::copy(result.begin(), result.end(), cells.begin());
+        cells = cells.first(result.size());
+        return error_t::none;
+    }
+}
@@ -0,0 +1,469 @@
+/// @file geohex/polygon/vector_based.cpp
+#include "kmx/geohex/polygon/vector_based.hpp"
+#include "kmx/geohex/polygon/prepared.hpp"
+#include "kmx/geohex/polygon/span_based.hpp"
+#include "kmx/geohex/cell/base.hpp"
+#include "kmx/geohex/cell/boundary.hpp"
+#include "kmx/geohex/directed_edge.hpp"
+#include "kmx/geohex/geo_projection.hpp"
+#include "kmx/geohex/icosahedron/face.hpp"
+#include "kmx/geohex/vertex.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <kmx/parallel.hpp>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <thread>
+
+namespace kmx::geohex::polygon::vector_based
+{
+    error_t to_cells(const item& polygon, const resolution_t resolution, std::vector<index>& cells)
+    {
+        return to_cells(polygon, {}, resolution, cells);
+    }
+
+    error_t to_cells(const item& polygon, const vector& holes, const resolution_t resolution, std::vector<index>& cells)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        const std::vector<span_based::item> hole_spans(holes.begin(), holes.end());
+        return to_cells(prepared {polygon, hole_spans}, resolution, cells);
+    }
+
+    error_t to_cells(const prepared& polygon, const resolution_t resolution, std::vector<index>& cells)
+    {
+        std::vector<index> result(span_based::max_size(polygon, resolution));
+        std::span<index> result_span {result};
+        const auto err = span_based::to_cells(polygon, resolution, result_span);
+        if (err != error_t::none)
+            return err;
+
+        result.resize(result_span.size());
+        cells = std::move(result);
+        return error_t::none;
+    }
+
+    /// @brief Initial capacity of a compacted cover, for its bound is often far above its size.
+    static constexpr std::size_t min_compact_capacity = 1u << 10u;
+
+    /// @brief Growth of the capacity of a compacted cover that does not fit; the work of the failed attempts stays a
+    /// fraction of the final one.
+    static constexpr std::size_t compact_growth = 8u;
+
+    error_t to_compact_cells(const item& polygon, const resolution_t resolution, std::vector<index>& cells)
+    {
+        return to_compact_cells(polygon, {}, resolution, cells);
+    }
+
+    error_t to_compact_cells(const item& polygon, const vector& holes, const resolution_t resolution, std::vector<index>& cells)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        const std::vector<span_based::item> hole_spans(holes.begin(), holes.end());
+        return to_compact_cells(prepared {polygon, hole_spans}, resolution, cells);
+    }
+
+    error_t to_compact_cells(const prepared& polygon, const resolution_t resolution, std::vector<index>& cells)
+    {
+        // The size of a compacted cover follows the length of the polygon boundary rather than its area, so the buffer
+        // grows from a small capacity up to the bound of the uncompacted cells.
+        const auto max_size = span_based::max_size(polygon, resolution);
+        std::vector<index> result(std::min(max_size, min_compact_capacity));
+        while (true)
+        {
+            std::span<index> result_span {result};
+            const auto err = span_based::to_compact_cells(polygon, resolution, result_span);
+            if ((err == error_t::memory_bounds) && (result.size() < max_size))
+            {
+                result.resize(std::min(result.size() * compact_growth, max_size));
+                continue;
+            }
+
+            if (err != error_t::none)
+                return err;
+
+            result.resize(result_span.size());
+            cells = std::move(result);
+            return error_t::none;
+        }
+    }
+
+    /// @brief Fewer cells than this are dissolved on the calling thread.
+    static constexpr std::size_t min_parallel_dissolve_size = 1u << 14u;
+
+    /// @brief Number of bits of the cell indexes splitting a dissolve into groups.
+    static constexpr int group_bits = 8;
+
+    /// @brief Number of groups of a dissolve.
+    static constexpr std::uint32_t group_count = 1u << group_bits;
+
+    /// @brief Number of boundary edges decoded by a task of a dissolve.
+    static constexpr std::size_t decode_chunk_size = 1u << 12u;
+
+    /// @brief A cell edge keyed by its canonical vertices.
+    struct edge_key
+    {
+        std::uint64_t first;  ///< The lower vertex; the start vertex once the edge is directed.
+        std::uint64_t second; ///< The higher vertex; the end vertex once the edge is directed.
+        std::uint32_t cell;   ///< The position of the cell among the grouped cells.
+        std::uint8_t number;  ///< The number of the start vertex on the cell.
+        bool reversed;        ///< The cell boundary runs from `second` to `first`.
+    };
+
+    /// @brief Sorts edge keys by their vertices, least significant byte first, skipping the bytes equal in every key
+    /// (the mode and resolution bits, the digits shared by a territory).
+    static void sort_keys(std::vector<edge_key>& keys, std::vector<edge_key>& buffer)
+    {
+        static constexpr std::size_t byte_count = 2u * sizeof(std::uint64_t);
+        const auto byte_of = [](const edge_key& key, const std::size_t byte) noexcept
+        {
+            const auto word = byte < sizeof(std::uint64_t) ? key.second : key.first;
+            return static_cast<std::size_t>((word >> (8u * (byte % sizeof(std::uint64_t)))) & 0xFFu);
+        };
+
+        if (keys.size() < 2u)
+            return;
+
+        std::vector<std::array<std::size_t, 256u>> counts(byte_count);
+        for (const auto& key: keys)
+            for (std::size_t byte {}; byte != byte_count; ++byte)
+                ++counts[byte][byte_of(key, byte)];
+
+        buffer.resize(keys.size());
+        for (std::size_t byte {}; byte != byte_count; ++byte)
+        {
+            auto& offsets = counts[byte];
+            if (offsets[byte_of(keys.front(), byte)] == keys.size())
+                continue;
+
+            std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), std::size_t {});
+            for (const auto& key: keys)
+                buffer[offsets[byte_of(key, byte)]++] = key;
+
+            keys.swap(buffer);
+        }
+    }
+
+    /// @brief Finds the representative of the cells joined to a cell, halving the path on the way.
+    static std::uint32_t find_root(std::vector<std::uint32_t>& parents, std::uint32_t cell) noexcept
+    {
+        while (parents[cell] != cell)
+        {
+            parents[cell] = parents[parents[cell]];
+            cell = parents[cell];
+        }
+
+        return cell;
+    }
+
+    /// @brief Cancels the sorted keys met on both sides of an edge between cells of one class, joining the cells, and
+    /// keeps the others: the edges of a single cell and the edges between two classes.
+    /// @return error_t::none on success, error_t::duplicate_input for an edge met twice on the same side.
+    static error_t cancel_pairs(std::span<const edge_key> keys, std::span<const std::uint32_t> classes, std::vector<std::uint32_t>& parents,
+                                std::vector<edge_key>& kept)
+    {
+        for (std::size_t i {}; i != keys.size();)
+        {
+            auto next = i + 1u;
+            while ((next != keys.size()) && (keys[next].first == keys[i].first) && (keys[next].second == keys[i].second))
+                ++next;
+
+            if (next - i == 1u)
+                kept.push_back(keys[i]);
+            else if ((next - i != 2u) || (keys[i].reversed == keys[i + 1u].reversed))
+                return error_t::duplicate_input;
+            else if (classes[keys[i].cell] != classes[keys[i + 1u].cell])
+                kept.insert(kept.end(), {keys[i], keys[i + 1u]});
+            else
+            {
+                const auto a = find_root(parents, keys[i].cell);
+                const auto b = find_root(parents, keys[i + 1u].cell);
+                parents[std::max(a, b)] = std::min(a, b);
+            }
+
+            i = next;
+        }
+
+        return error_t::none;
+    }
+
+    /// @brief Emits the keys of the edges of a cell, in boundary order.
+    static error_t emit_keys(const index cell, const std::uint32_t position, std::vector<edge_key>& keys) noexcept
+    {
+        std::array<index, vertex::max_count> buffer;
+        std::span<index> corners {buffer};
+        const auto err = vertex::of(cell, corners);
+        if (err != error_t::none)
+            return err;
+
+        for (std::uint8_t i {}; i != corners.size(); ++i)
+        {
+            const auto start = corners[i].value();
+            const auto end = corners[(i + 1u) % corners.size()].value();
+            keys.push_back({std::min(start, end), std::max(start, end), position, i, start > end});
+        }
+
+        return error_t::none;
+    }
+
+    /// @brief Gets the area (on the unit sphere, in steradians) on the left of a ring of great circle arcs, from the
+    /// turns at its vertices (Gauss-Bonnet): near 0 around a small region on the left, near 4 pi around a small region
+    /// on the right.
+    static double left_area(const item& ring) noexcept
+    {
+        std::vector<math::vector3d> points(ring.size());
+        for (std::size_t i {}; i != ring.size(); ++i)
+            projection::to_v3d(ring[i], points[i]);
+
+        double turn {};
+        for (std::size_t i {}; i != points.size(); ++i)
+        {
+            const auto& a = points[i];
+            const auto& b = points[(i + 1u) % points.size()];
+            const auto& c = points[(i + 2u) % points.size()];
+            const auto incoming = a.cross(b);
+            const auto outgoing = b.cross(c);
+            turn += std::atan2(incoming.cross(outgoing).dot(b), incoming.dot(outgoing));
+        }
+
+        return 2.0 * std::numbers::pi_v<double> - turn;
+    }
+
+    /// @brief Dissolves cells into the polygons of their classes (see `cells_to_multi_polygon`).
+    /// @param count The number of cells.
+    /// @param cell_of Gets a cell by its position.
+    /// @param class_of Gets the class of a cell by its position.
+    template <typename CellOf, typename ClassOf>
+    static error_t dissolve(const std::size_t count, CellOf&& cell_of, ClassOf&& class_of, std::vector<class_polygons>& polygons)
+    {
+        if (count > std::numeric_limits<std::uint32_t>::max())
+            return error_t::memory_bounds;
+
+        // 1. The cells grouped by the highest bits that differ among them (counting sort): the base cell, then the
+        // leading digits, so each group is a run of whole subtrees of the hierarchy, compact on the ground.
+        index::value_t varying {};
+        for (std::size_t i {}; i != count; ++i)
+        {
+            const auto cell = cell_of(i);
+            if (!cell.is_valid())
+                return error_t::cell_invalid;
+
+            if (cell.resolution() != cell_of(0u).resolution())
+                return error_t::res_mismatch;
+
+            varying |= cell.value() ^ cell_of(0u).value();
+        }
+
+        const auto shift = std::max(static_cast<int>(std::bit_width(varying)), group_bits) - group_bits;
+        const auto group_of = [shift](const index cell) noexcept { return (cell.value() >> shift) & (group_count - 1u); };
+        std::array<std::uint32_t, group_count + 1u> offsets {};
+        for (std::size_t i {}; i != count; ++i)
+            ++offsets[group_of(cell_of(i)) + 1u];
+
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<index> grouped(count);
+        std::vector<std::uint32_t> classes(count);
+        auto ends = offsets;
+        for (std::size_t i {}; i != count; ++i)
+        {
+            const auto position = ends[group_of(cell_of(i))]++;
+            grouped[position] = cell_of(i);
+            classes[position] = class_of(i);
+        }
+
+        // 2. The edges of each group, sorted and cancelled on their own; the edges on the seams between groups are kept
+        // with the boundary. A task only joins cells of its group.
+        std::vector<std::uint32_t> parents(count);
+        std::iota(parents.begin(), parents.end(), 0u);
+        std::vector<std::vector<edge_key>> kept(group_count);
+        std::array<error_t, group_count> errors {};
+        const auto hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+        const auto thread_count = count < min_parallel_dissolve_size ? 1u : hardware_threads;
+        run_parallel(group_count, thread_count,
+                     [&](const std::size_t task)
+                     {
+                         std::vector<edge_key> keys;
+                         keys.reserve((offsets[task + 1u] - offsets[task]) * vertex::max_count);
+                         for (auto i = offsets[task]; i != offsets[task + 1u]; ++i)
+                         {
+                             errors[task] = emit_keys(grouped[i], i, keys);
+                             if (errors[task] != error_t::none)
+                                 return;
+                         }
+
+                         std::vector<edge_key> buffer;
+                         sort_keys(keys, buffer);
+                         errors[task] = cancel_pairs(keys, classes, parents, kept[task]);
+                     });
+
+        for (const auto err: errors)
+            if (err != error_t::none)
+                return err;
+
+        // 3. The seams: the kept edges of all groups, sorted and cancelled together. The two sides of an edge between
+        // classes stay next to each other.
+        std::vector<edge_key> keys;
+        for (auto& items: kept)
+        {
+            keys.insert(keys.end(), items.begin(), items.end());
+            items = {};
+        }
+
+        std::vector<edge_key> buffer;
+        sort_keys(keys, buffer);
+        std::vector<edge_key> edges;
+        const auto err = cancel_pairs(keys, classes, parents, edges);
+        if (err != error_t::none)
+            return err;
+
+        // 4. The vertices of each boundary edge, along the boundary of its cell; an edge between classes is decoded on
+        // its first side only, the second side runs through the same vertices backwards.
+        const auto is_second_side = [&edges](const std::size_t i) noexcept
+        { return (i != 0u) && (edges[i].first == edges[i - 1u].first) && (edges[i].second == edges[i - 1u].second); };
+
+        std::vector<gis::wgs84::coordinate> points(edges.size() * directed_edge::max_boundary_count);
+        std::vector<std::uint8_t> point_counts(edges.size());
+        const auto chunk_count = (edges.size() + decode_chunk_size - 1u) / decode_chunk_size;
+        std::vector<error_t> chunk_errors(chunk_count);
+        run_parallel(chunk_count, std::clamp<std::size_t>(chunk_count, 1u, thread_count),
+                     [&](const std::size_t task)
+                     {
+                         const auto last = std::min(edges.size(), (task + 1u) * decode_chunk_size);
+                         for (auto i = task * decode_chunk_size; i != last; ++i)
+                         {
+                             if (is_second_side(i))
+                                 continue;
+
+                             const auto origin = grouped[edges[i].cell];
+                             icosahedron::face::ijk center_fijk;
+                             auto result = icosahedron::face::from_index(origin, center_fijk);
+                             std::span<gis::wgs84::coordinate> edge_points {points.data() + i * directed_edge::max_boundary_count,
+                                                                            directed_edge::max_boundary_count};
+                             if (result == error_t::none)
+                                 result = cell::boundary::get_vertices(center_fijk, origin, edges[i].number, 2u, edge_points);
+
+                             if (result != error_t::none)
+                             {
+                                 chunk_errors[task] = result;
+                                 return;
+                             }
+
+                             point_counts[i] = static_cast<std::uint8_t>(edge_points.size());
+                         }
+                     });
+
+        for (const auto chunk_error: chunk_errors)
+            if (chunk_error != error_t::none)
+                return chunk_error;
+
+        // 5. The boundary edges by start vertex: in a class, each vertex of the boundary starts exactly one of them, so
+        // a ring goes on with the edge of its class starting at its end.
+        const auto start_of = [](const edge_key& edge) noexcept { return edge.reversed ? edge.second : edge.first; };
+        const auto end_of = [](const edge_key& edge) noexcept { return edge.reversed ? edge.first : edge.second; };
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> starts(edges.size());
+        for (std::size_t i {}; i != edges.size(); ++i)
+            starts[i] = {start_of(edges[i]), static_cast<std::uint32_t>(i)};
+
+        std::sort(starts.begin(), starts.end());
+        const auto next_of = [&](const std::size_t edge) noexcept
+        {
+            const auto end = end_of(edges[edge]);
+            auto i = std::lower_bound(starts.begin(), starts.end(), std::pair {end, std::uint32_t {}});
+            while (classes[edges[i->second].cell] != classes[edges[edge].cell])
+                ++i;
+
+            return static_cast<std::size_t>(i->second);
+        };
+
+        // 6. The rings, each starting at its lowest vertex, with the class and the component of the cells they bound.
+        struct ring
+        {
+            std::uint32_t class_id;
+            std::uint32_t component;
+            double area;
+            item vertices;
+        };
+
+        std::vector<ring> rings;
+        std::vector<bool> visited(edges.size());
+        for (const auto& start: starts)
+        {
+            if (visited[start.second])
+                continue;
+
+            ring current {classes[edges[start.second].cell], find_root(parents, edges[start.second].cell), 0.0, {}};
+            for (std::size_t i = start.second; !visited[i]; i = next_of(i))
+            {
+                visited[i] = true;
+
+                // The end vertex starts the next edge.
+                if (is_second_side(i))
+                {
+                    const auto* edge_points = points.data() + (i - 1u) * directed_edge::max_boundary_count;
+                    for (auto j = point_counts[i - 1u] - 1u; j != 0u; --j)
+                        current.vertices.push_back(edge_points[j]);
+                }
+                else
+                {
+                    const auto* edge_points = points.data() + i * directed_edge::max_boundary_count;
+                    current.vertices.insert(current.vertices.end(), edge_points, edge_points + point_counts[i] - 1u);
+                }
+            }
+
+            current.area = left_area(current.vertices);
+            rings.push_back(std::move(current));
+        }
+
+        // 7. One polygon per component of joined cells. The cells lie on the left of every ring: the outer ring runs
+        // counterclockwise around them, the holes clockwise, so the outer ring has the smallest area on its left. On
+        // the sphere, this also picks the outer ring of a band around a pole (the one farther from it) or across the
+        // globe (the one around the largest hole), as H3 does.
+        std::stable_sort(rings.begin(), rings.end(), [](const ring& a, const ring& b)
+                         { return (a.class_id < b.class_id) || ((a.class_id == b.class_id) && (a.component < b.component)); });
+
+        std::vector<class_polygons> result;
+        for (auto first = rings.begin(); first != rings.end();)
+        {
+            const auto last = std::find_if(first, rings.end(), [first](const ring& item) { return item.component != first->component; });
+            const auto outer = std::min_element(first, last, [](const ring& a, const ring& b) { return a.area < b.area; });
+            if (result.empty() || (result.back().class_id != first->class_id))
+                result.push_back({first->class_id, {}});
+
+            auto& polygon = result.back().polygons.emplace_back();
+            polygon.outer = std::move(outer->vertices);
+            for (auto i = first; i != last; ++i)
+                if (i != outer)
+                    polygon.holes.push_back(std::move(i->vertices));
+
+            first = last;
+        }
+
+        polygons = std::move(result);
+        return error_t::none;
+    }
+
+    error_t cells_to_multi_polygon(std::span<const index> cells, multi& polygons)
+    {
+        const auto cell_of = [cells](const std::size_t i) noexcept { return cells[i]; };
+        const auto class_of = [](const std::size_t) noexcept { return 0u; };
+        std::vector<class_polygons> result;
+        const auto err = dissolve(cells.size(), cell_of, class_of, result);
+        if (err != error_t::none)
+            return err;
+
+        polygons = result.empty() ? multi {} : std::move(result.front().polygons);
+        return error_t::none;
+    }
+
+    error_t cells_to_multi_polygons(std::span<const class_cell> cells, std::vector<class_polygons>& polygons)
+    {
+        const auto cell_of = [cells](const std::size_t i) noexcept { return cells[i].cell; };
+        const auto class_of = [cells](const std::size_t i) noexcept { return cells[i].class_id; };
+        return dissolve(cells.size(), cell_of, class_of, polygons);
+    }
+}
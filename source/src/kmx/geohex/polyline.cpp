@@ -0,0 +1,178 @@
+/// @file geohex/polyline.cpp
+#include "kmx/geohex/polyline.hpp"
+#include "kmx/geohex/geo_projection.hpp"
+#include <algorithm>
+#include <cmath>
+#include <kmx/parallel.hpp>
+#include <numbers>
+
+namespace kmx::geohex::polyline
+{
+    /// @brief Lower bound of the length of a cell edge at resolution 0, in radians; each finer resolution divides it by
+    /// the square root of 7.
+    static constexpr double min_edge_length_r0 = 0.12;
+
+    /// @brief Arcs closer than this to half a turn (in radians) join antipodal vertices.
+    static constexpr double antipodal_tolerance = 1e-9;
+
+    /// @brief Length of the arc (in cell edges) within which the crossing from a cell to the next is located.
+    static constexpr double crossing_tolerance = 1.0 / 64.0;
+
+    /// @brief Most halvings of an arc, reached only for arcs through a cell vertex.
+    static constexpr std::uint8_t max_bisections = 48u;
+
+    /// @brief A great circle arc, read by its fraction of the way from its start.
+    class arc
+    {
+    public:
+        arc(const gis::wgs84::coordinate& from, const gis::wgs84::coordinate& to) noexcept
+        {
+            projection::to_v3d(from, from_);
+            projection::to_v3d(to, to_);
+            angle_ = std::atan2(from_.cross(to_).magnitude(), from_.dot(to_));
+        }
+
+        double angle() const noexcept { return angle_; }
+
+        gis::wgs84::coordinate at(const double t) const noexcept
+        {
+            // spherical linear interpolation
+            const double sin_angle = std::sin(angle_);
+            const auto point = sin_angle > 0.0
+                                   ? from_ * (std::sin((1.0 - t) * angle_) / sin_angle) + to_ * (std::sin(t * angle_) / sin_angle)
+                                   : from_;
+
+            gis::wgs84::coordinate result;
+            projection::from_v3d(point, result);
+            return result;
+        }
+
+    private:
+        math::vector3d from_;
+        math::vector3d to_;
+        double angle_ {};
+    };
+
+    /// @brief Appends the cells along the arcs of a polyline.
+    class tracer
+    {
+    public:
+        tracer(const resolution_t resolution, std::vector<index>& cells) noexcept:
+            resolution_ {resolution},
+            tolerance_ {crossing_tolerance * min_edge_length_r0 / std::pow(std::sqrt(7.0), +resolution)},
+            cells_ {cells}
+        {
+        }
+
+        error_t trace(const item& line)
+        {
+            if (line.empty())
+                return error_t::none;
+
+            if (!std::all_of(line.begin(), line.end(), [](const gis::wgs84::coordinate& coord)
+                             { return std::isfinite(coord.latitude) && std::isfinite(coord.longitude); }))
+                return error_t::latlng_domain;
+
+            index previous;
+            auto err = from_wgs(line.front(), resolution_, previous);
+            if (err != error_t::none)
+                return err;
+
+            cells_.push_back(previous);
+            for (std::size_t i = 1u; i < line.size(); ++i)
+            {
+                const arc segment {line[i - 1u], line[i]};
+                if (segment.angle() > std::numbers::pi_v<double> - antipodal_tolerance)
+                    return error_t::domain;
+
+                index cell;
+                err = from_wgs(line[i], resolution_, cell);
+                if (err != error_t::none)
+                    return err;
+
+                err = fill(segment, 0.0, previous, 1.0, cell, max_bisections);
+                if (err != error_t::none)
+                    return err;
+
+                previous = cell;
+            }
+
+            return error_t::none;
+        }
+
+    private:
+        /// @brief Appends the cells between two points of an arc, the second one included.
+        /// @details The cells are convex and the arc is straight in the gnomonic projection of a face: the arc between two
+        /// points of the same cell stays in it. The arc between points of different cells is halved until the crossing
+        /// between them is located within the tolerance, so every cell it passes through over more than that is found.
+        error_t fill(const arc& segment, const double from, const index from_cell, const double to, const index to_cell,
+                     const std::uint8_t depth)
+        {
+            if (to_cell == from_cell)
+                return error_t::none;
+
+            if ((depth == 0u) || ((to - from) * segment.angle() <= tolerance_))
+            {
+                if (cells_.back() != to_cell)
+                    cells_.push_back(to_cell);
+                return error_t::none;
+            }
+
+            const double middle = 0.5 * (from + to);
+            index middle_cell;
+            const auto err = from_wgs(segment.at(middle), resolution_, middle_cell);
+            if (err != error_t::none)
+                return err;
+
+            const auto first_err = fill(segment, from, from_cell, middle, middle_cell, depth - 1u);
+            if (first_err != error_t::none)
+                return first_err;
+
+            return fill(segment, middle, middle_cell, to, to_cell, depth - 1u);
+        }
+
+        const resolution_t resolution_;
+        const double tolerance_;
+        std::vector<index>& cells_;
+    };
+
+    error_t to_cells(const item& line, const resolution_t resolution, std::vector<index>& cells)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        std::vector<index> result;
+        tracer trace {resolution, result};
+        const auto err = trace.trace(line);
+        if (err == error_t::none)
+            cells = std::move(result);
+        return err;
+    }
+
+    error_t to_cells(const lines& lines, const resolution_t resolution, cells& cells)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        const auto& offsets = lines.offsets;
+        if (!are_valid_offsets(offsets, lines.coordinates.size()))
+            return error_t::domain;
+
+        // each chunk appending its polylines to its own cells
+        return map_chunks<index, error_t>(
+            lines.size(), [] { return 0; },
+            [&](int, const std::size_t first, const std::size_t last, chunk_output<index, error_t>& out)
+            {
+                tracer trace {resolution, out.items};
+                for (auto i = first; i != last; ++i)
+                {
+                    const auto size = out.items.size();
+                    out.error = trace.trace(lines.coordinates.subspan(offsets[i], offsets[i + 1u] - offsets[i]));
+                    if (out.error != error_t::none)
+                        return;
+                    out.counts.push_back(out.items.size() - size);
+                }
+            },
+            cells.items, cells.offsets);
+    }
+}
@@ -0,0 +1,108 @@
+/// @file geohex/pyramid.cpp
+#include "kmx/geohex/pyramid.hpp"
+#include "kmx/geohex/radix.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace kmx::geohex::pyramid
+{
+    /// @brief The position of the resolution in a cell value.
+    static constexpr unsigned resolution_shift = 52u;
+
+    /// @brief The resolution bits of a cell value.
+    static constexpr index::value_t resolution_mask = index::value_t {0xFu} << resolution_shift;
+
+    /// @brief The run of equal cells a level is summing.
+    struct run
+    {
+        index::value_t cell {};
+        std::uint64_t count {};
+        double sum {};
+    };
+
+    error_t build(const std::span<const index> cells, const std::span<const double> values, const resolution_t coarsest,
+                  std::vector<level>& levels)
+    {
+        if (cells.size() != values.size())
+            return error_t::domain;
+
+        if (cells.empty())
+        {
+            levels.clear();
+            return error_t::none;
+        }
+
+        const auto resolution = cells.front().resolution();
+        if (+coarsest > +resolution)
+            return error_t::res_domain;
+
+        for (const auto cell: cells)
+        {
+            if (!cell.is_valid())
+                return error_t::cell_invalid;
+            if (cell.resolution() != resolution)
+                return error_t::res_mismatch;
+        }
+
+        // the values in cell order
+        std::vector<std::uint64_t> order;
+        if (!std::is_sorted(cells.begin(), cells.end()))
+        {
+            std::vector<index> sorted(cells.begin(), cells.end());
+            order.resize(cells.size());
+            std::iota(order.begin(), order.end(), std::uint64_t {});
+            radix::sort(sorted, order);
+        }
+
+        // each level turns a cell into its ancestor with a mask: its resolution, its digits below it set to 7
+        const auto level_count = static_cast<std::size_t>(+resolution - +coarsest + 1u);
+        std::vector<level> result(level_count);
+        std::vector<index::value_t> digit_masks(level_count), resolution_bits(level_count);
+        for (std::size_t i {}; i != level_count; ++i)
+        {
+            const auto res = +resolution - static_cast<unsigned>(i);
+            result[i].resolution = static_cast<resolution_t>(res);
+            digit_masks[i] = (index::value_t {1u} << (3u * (resolution_count - 1u - res))) - 1u;
+            resolution_bits[i] = index::value_t {res} << resolution_shift;
+        }
+
+        std::vector<run> runs(level_count);
+        const auto flush = [&](const std::size_t i)
+        {
+            result[i].cells.push_back(runs[i].cell);
+            result[i].counts.push_back(runs[i].count);
+            result[i].sums.push_back(runs[i].sum);
+        };
+
+        for (std::size_t k {}; k != cells.size(); ++k)
+        {
+            const auto item = order.empty() ? k : static_cast<std::size_t>(order[k]);
+            const index::value_t cell = cells[item];
+            const auto value = values[item];
+            for (std::size_t i {}; i != level_count; ++i)
+            {
+                const auto ancestor = ((cell | digit_masks[i]) & ~resolution_mask) | resolution_bits[i];
+                if ((runs[i].count != 0u) && (runs[i].cell == ancestor))
+                {
+                    // the same ancestor at this level is the same at every coarser one
+                    for (auto j = i; j != level_count; ++j)
+                    {
+                        ++runs[j].count;
+                        runs[j].sum += value;
+                    }
+                    break;
+                }
+
+                if (runs[i].count != 0u)
+                    flush(i);
+                runs[i] = {ancestor, 1u, value};
+            }
+        }
+
+        for (std::size_t i {}; i != level_count; ++i)
+            flush(i);
+
+        levels = std::move(result);
+        return error_t::none;
+    }
+}
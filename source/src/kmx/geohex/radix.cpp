@@ -0,0 +1,129 @@
+/// @file geohex/radix.cpp
+#include "kmx/geohex/radix.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <kmx/parallel.hpp>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace kmx::geohex::radix
+{
+    /// @brief The bits sorted per pass.
+    static constexpr unsigned digit_bits = 11u;
+
+    static constexpr std::size_t bucket_count = std::size_t {1u} << digit_bits;
+
+    /// @brief Fewer indexes than this are sorted on the calling thread.
+    static constexpr std::size_t min_parallel_size = std::size_t {1u} << 16u;
+
+    /// @brief Indexes per thread, at least.
+    static constexpr std::size_t min_share_size = std::size_t {1u} << 14u;
+
+    /// @brief Sorts keys, with their values unless there are none, stably.
+    static void sort_keys(std::vector<index::value_t>& keys, std::vector<std::uint64_t>& values)
+    {
+        const auto size = keys.size();
+        const bool with_values = !values.empty();
+        const auto max_thread_count = static_cast<std::size_t>(std::max(1u, std::thread::hardware_concurrency()));
+        const auto thread_count =
+            size < min_parallel_size ? std::size_t {1u} : std::clamp<std::size_t>(size / min_share_size, 1u, max_thread_count);
+        const auto share = (size + thread_count - 1u) / thread_count;
+        const auto first_of = [&](const std::size_t thread) { return std::min(size, thread * share); };
+
+        // the bits that differ between keys
+        std::vector<index::value_t> ors(thread_count), ands(thread_count, ~index::value_t {});
+        run_parallel(thread_count, thread_count,
+                     [&](const std::size_t thread)
+                     {
+                         for (auto i = first_of(thread); i != first_of(thread + 1u); ++i)
+                         {
+                             ors[thread] |= keys[i];
+                             ands[thread] &= keys[i];
+                         }
+                     });
+
+        const auto varying = std::reduce(ors.begin(), ors.end(), index::value_t {}, std::bit_or {}) ^
+                             std::reduce(ands.begin(), ands.end(), ~index::value_t {}, std::bit_and {});
+        if (varying == 0u)
+            return;
+
+        std::vector<index::value_t> key_buffer(size);
+        std::vector<std::uint64_t> value_buffer(with_values ? size : 0u);
+        std::vector<std::array<std::size_t, bucket_count>> counts(thread_count);
+        const auto last_bit = static_cast<unsigned>(std::bit_width(varying));
+        for (auto shift = static_cast<unsigned>(std::countr_zero(varying)); shift < last_bit; shift += digit_bits)
+        {
+            const auto bucket_of = [shift](const index::value_t key)
+            { return static_cast<std::size_t>((key >> shift) & (bucket_count - 1u)); };
+
+            // 1. Each thread counts the keys of its share per bucket.
+            run_parallel(thread_count, thread_count,
+                         [&](const std::size_t thread)
+                         {
+                             auto& count = counts[thread];
+                             count.fill(0u);
+                             for (auto i = first_of(thread); i != first_of(thread + 1u); ++i)
+                                 ++count[bucket_of(keys[i])];
+                         });
+
+            // 2. The first place of the keys of each share in each bucket, the shares in order; a pass with every key in
+            // one bucket is skipped.
+            std::size_t offset {};
+            bool single_bucket {};
+            for (std::size_t bucket {}; bucket != bucket_count; ++bucket)
+                for (auto& count: counts)
+                {
+                    const auto items = count[bucket];
+                    single_bucket |= items == size;
+                    count[bucket] = offset;
+                    offset += items;
+                }
+
+            if (single_bucket)
+                continue;
+
+            // 3. Each thread moves the keys of its share.
+            run_parallel(thread_count, thread_count,
+                         [&](const std::size_t thread)
+                         {
+                             auto& place = counts[thread];
+                             for (auto i = first_of(thread); i != first_of(thread + 1u); ++i)
+                             {
+                                 const auto to = place[bucket_of(keys[i])]++;
+                                 key_buffer[to] = keys[i];
+                                 if (with_values)
+                                     value_buffer[to] = values[i];
+                             }
+                         });
+
+            keys.swap(key_buffer);
+            values.swap(value_buffer);
+        }
+    }
+
+    void sort(const std::span<index> cells)
+    {
+        std::vector<index::value_t> keys(cells.begin(), cells.end());
+        std::vector<std::uint64_t> values;
+        sort_keys(keys, values);
+        std::copy(keys.begin(), keys.end(), cells.begin());
+    }
+
+    error_t sort(const std::span<index> cells, const std::span<std::uint64_t> values)
+    {
+        if (cells.size() != values.size())
+            return error_t::domain;
+
+        if (cells.empty())
+            return error_t::none;
+
+        std::vector<index::value_t> keys(cells.begin(), cells.end());
+        std::vector<std::uint64_t> sorted_values(values.begin(), values.end());
+        sort_keys(keys, sorted_values);
+        std::copy(keys.begin(), keys.end(), cells.begin());
+        std::copy(sorted_values.begin(), sorted_values.end(), values.begin());
+        return error_t::none;
+    }
+}
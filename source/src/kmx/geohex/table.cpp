@@ -0,0 +1,216 @@
+/// @file geohex/table.cpp
+#include "kmx/geohex/table.hpp"
+#include "kmx/geohex/cell.hpp"
+#include "kmx/geohex/radix.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+
+namespace kmx::geohex::table
+{
+    /// @brief Tells a table ("GHXT" read as a little endian value).
+    static constexpr std::uint32_t magic = 0x54584847u;
+
+    /// @brief The version of the layout.
+    static constexpr std::uint32_t version = 1u;
+
+    /// @brief The alignment of the sections, a cache line.
+    static constexpr std::size_t section_alignment = 64u;
+
+    /// @brief The key padding the last block.
+    static constexpr std::uint64_t padding_key = ~std::uint64_t {};
+
+    /// @brief The header of a table.
+    struct header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t key_count;
+        std::uint64_t block_count;
+        std::uint64_t resolutions;
+        std::uint64_t summary;
+        std::uint64_t keys;
+        std::uint64_t payload_offsets;
+        std::uint64_t payloads;
+    };
+
+    static_assert(sizeof(header) == section_alignment);
+
+    /// @brief Rounds a size up to a multiple of the section alignment.
+    static constexpr std::size_t align(const std::size_t size) noexcept
+    {
+        return (size + section_alignment - 1u) / section_alignment * section_alignment;
+    }
+
+    /// @brief Fills the slots of a subtree of the summary with the first keys of the blocks, in order.
+    static void fill_summary(const std::span<std::uint64_t> slots, const std::size_t slot, const std::span<const std::uint64_t> keys,
+                             std::uint64_t& block)
+    {
+        const auto block_count = slots.size() / 2u - 1u;
+        if (slot > block_count)
+            return;
+
+        fill_summary(slots, 2u * slot, keys, block);
+        slots[2u * slot] = keys[block * block_size];
+        slots[2u * slot + 1u] = block++;
+        fill_summary(slots, 2u * slot + 1u, keys, block);
+    }
+
+    void writer::add(const index cell, const std::span<const std::byte> payload)
+    {
+        cells_.push_back(cell);
+        payloads_.insert(payloads_.end(), payload.begin(), payload.end());
+        offsets_.push_back(payloads_.size());
+    }
+
+    error_t writer::write(std::vector<std::byte>& data) const
+    {
+        if constexpr (std::endian::native != std::endian::little)
+            return error_t::domain;
+
+        if (!std::all_of(cells_.begin(), cells_.end(), [](const index cell) { return cell.is_valid(); }))
+            return error_t::cell_invalid;
+
+        // the order of the cells
+        std::vector<index> sorted(cells_.begin(), cells_.end());
+        std::vector<std::uint64_t> order(cells_.size());
+        std::iota(order.begin(), order.end(), std::uint64_t {});
+        radix::sort(sorted, order);
+        if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+            return error_t::duplicate_input;
+
+        // the sections, each padded to the alignment
+        const std::size_t key_count = cells_.size();
+        const std::size_t block_count = (key_count + block_size - 1u) / block_size;
+        std::vector<std::uint64_t> keys(block_count * block_size, padding_key);
+        std::vector<std::uint64_t> payload_offsets(key_count + 1u);
+        std::uint64_t resolutions {};
+        for (std::size_t i {}; i != key_count; ++i)
+        {
+            const auto cell = cells_[order[i]];
+            keys[i] = cell;
+            resolutions |= std::uint64_t {1u} << +cell.resolution();
+            payload_offsets[i + 1u] = payload_offsets[i] + (offsets_[order[i] + 1u] - offsets_[order[i]]);
+        }
+
+        std::vector<std::uint64_t> summary(2u * (block_count + 1u));
+        std::uint64_t block {};
+        fill_summary(summary, 1u, keys, block);
+
+        header head {};
+        head.magic = magic;
+        head.version = version;
+        head.key_count = key_count;
+        head.block_count = block_count;
+        head.resolutions = resolutions;
+        head.summary = sizeof(header);
+        head.keys = head.summary + align(summary.size() * sizeof(std::uint64_t));
+        head.payload_offsets = head.keys + keys.size() * sizeof(std::uint64_t);
+        head.payloads = head.payload_offsets + align(payload_offsets.size() * sizeof(std::uint64_t));
+
+        const auto start = align(data.size());
+        data.resize(start + head.payloads + payloads_.size());
+        auto* const table = data.data() + start;
+        std::memcpy(table, &head, sizeof(header));
+        std::memcpy(table + head.summary, summary.data(), summary.size() * sizeof(std::uint64_t));
+        if (!keys.empty())
+            std::memcpy(table + head.keys, keys.data(), keys.size() * sizeof(std::uint64_t));
+        std::memcpy(table + head.payload_offsets, payload_offsets.data(), payload_offsets.size() * sizeof(std::uint64_t));
+        auto* payload = table + head.payloads;
+        for (const auto i: order)
+        {
+            const auto size = offsets_[i + 1u] - offsets_[i];
+            std::copy_n(payloads_.data() + offsets_[i], size, payload);
+            payload += size;
+        }
+
+        return error_t::none;
+    }
+
+    error_t view::open(const std::span<const std::byte> data) noexcept
+    {
+        // the sections are read in place: the host must share their byte order and alignment
+        if constexpr (std::endian::native != std::endian::little)
+            return error_t::domain;
+
+        if ((data.size() < sizeof(header)) || (reinterpret_cast<std::uintptr_t>(data.data()) % alignof(std::uint64_t) != 0u))
+            return error_t::domain;
+
+        header head;
+        std::memcpy(&head, data.data(), sizeof(header));
+        if ((head.magic != magic) || (head.version != version))
+            return error_t::domain;
+
+        // each section fits before the next one, sized from the counts without overflow
+        const auto words = [](const std::uint64_t from, const std::uint64_t to)
+        { return from <= to ? (to - from) / sizeof(std::uint64_t) : std::uint64_t {}; };
+        if ((head.key_count > data.size()) || (head.block_count != (head.key_count + block_size - 1u) / block_size) ||
+            (head.summary < sizeof(header)) || (head.summary % alignof(std::uint64_t) != 0u) ||
+            (head.keys % alignof(std::uint64_t) != 0u) || (head.payload_offsets % alignof(std::uint64_t) != 0u) ||
+            (words(head.summary, head.keys) < 2u * (head.block_count + 1u)) ||
+            (words(head.keys, head.payload_offsets) < head.block_count * block_size) ||
+            (words(head.payload_offsets, head.payloads) < head.key_count + 1u) || (head.payloads > data.size()))
+            return error_t::domain;
+
+        const auto* const words_of = reinterpret_cast<const std::uint64_t*>(data.data());
+        const auto* const payload_offsets = words_of + head.payload_offsets / sizeof(std::uint64_t);
+        if (payload_offsets[head.key_count] > data.size() - head.payloads)
+            return error_t::domain;
+
+        key_count_ = head.key_count;
+        block_count_ = head.block_count;
+        resolutions_ = head.resolutions;
+        summary_ = {reinterpret_cast<const slot*>(data.data() + head.summary), block_count_ + 1u};
+        keys_ = words_of + head.keys / sizeof(std::uint64_t);
+        payload_offsets_ = payload_offsets;
+        payloads_ = data.subspan(head.payloads, payload_offsets[head.key_count]);
+        return error_t::none;
+    }
+
+    std::span<const std::byte> view::payload(const std::size_t rank) const noexcept
+    {
+        // offsets out of order in a damaged table give an empty payload rather than a read out of bounds
+        const auto first = payload_offsets_[rank];
+        const auto last = payload_offsets_[rank + 1u];
+        return (first <= last) && (last <= payloads_.size()) ? payloads_.subspan(first, last - first) : std::span<const std::byte> {};
+    }
+
+    std::size_t view::find(const index cell) const noexcept
+    {
+        const std::uint64_t key = cell;
+        if ((key_count_ == 0u) || (key == padding_key))
+            return key_count_;
+
+        // the first block starting after the key, down the summary tree; the key can only be in the block before
+        std::size_t slot = 1u;
+        while (slot <= block_count_)
+            slot = 2u * slot + (summary_[slot].first_key <= key);
+        slot >>= std::countr_one(slot) + 1u;
+
+        // a block number past the last one, from a damaged summary, finds nothing rather than reading out of bounds
+        const auto after = slot != 0u ? summary_[slot].block : block_count_;
+        if ((after == 0u) || (after > block_count_))
+            return key_count_;
+
+        const auto* const block = keys_ + (after - 1u) * block_size;
+        const auto* const found = std::lower_bound(block, block + block_size, key);
+        const auto rank = static_cast<std::size_t>(found - keys_);
+        return (found != block + block_size) && (*found == key) && (rank < key_count_) ? rank : key_count_;
+    }
+
+    std::size_t view::find_ancestor(const index cell) const noexcept
+    {
+        for (auto res = static_cast<int>(+cell.resolution()); res >= 0; --res)
+        {
+            if ((resolutions_ & (std::uint64_t {1u} << res)) == 0u)
+                continue;
+
+            const auto rank = find(cell::parent(cell, static_cast<resolution_t>(res)));
+            if (rank != key_count_)
+                return rank;
+        }
+
+        return key_count_;
+    }
+}
@@ -0,0 +1,215 @@
+/// @file geohex/tile.cpp
+#include "kmx/geohex/tile.hpp"
+#include "kmx/geohex/cell.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace kmx::geohex::tile
+{
+    static constexpr double pi = std::numbers::pi_v<double>;
+
+    static constexpr double half_pi = pi / 2.0;
+
+    /// @brief Gets the width of the longitudes of a box, from 0 to 2 pi.
+    static double width(const box& box) noexcept
+    {
+        return box.is_transmeridian() ? box.east - box.west + 2.0 * pi : box.east - box.west;
+    }
+
+    /// @brief Checks whether two boxes meet.
+    static bool overlaps(const box& a, const box& b) noexcept
+    {
+        if ((a.north < b.south) || (b.north < a.south))
+            return false;
+
+        // each longitude range starts within the other one, measured eastwards from its west longitude
+        const auto starts_in = [](const double longitude, const tile::box& range)
+        {
+            const double offset = longitude - range.west;
+            return (offset < 0.0 ? offset + 2.0 * pi : offset) <= width(range);
+        };
+        return starts_in(a.west, b) || starts_in(b.west, a);
+    }
+
+    /// @brief Checks whether a box holds another one.
+    static bool encloses(const box& outer, const box& inner) noexcept
+    {
+        if ((inner.south < outer.south) || (inner.north > outer.north))
+            return false;
+
+        const double offset = inner.west - outer.west;
+        return (offset < 0.0 ? offset + 2.0 * pi : offset) + width(inner) <= width(outer);
+    }
+
+    /// @brief Walks a box down the cell hierarchy.
+    class box_walker
+    {
+    public:
+        box_walker(const box& box, const resolution_t resolution) noexcept: box_ {box}, resolution_ {resolution}
+        {
+            // the cells of the resolution meeting the box have their center within their radius of it, and within the
+            // child distances of each resolution down to it from the center of their ancestor
+            cell::bounds::reaches(resolution, reaches_);
+        }
+
+        /// @brief Appends the descendants of a cell meeting the box: a cell whose descendants all do is not refined,
+        /// those of a cell whose descendants do not are skipped.
+        void descend(const index cell, const gis::wgs84::coordinate& center, std::vector<index>& out) const
+        {
+            // the box of the cap holding the cells of the resolution below the cell
+            const auto reach = cell::bounds::to_box(center, reaches_[+cell.resolution()]);
+            if (!overlaps(reach, box_))
+                return;
+
+            if ((cell.resolution() == resolution_) || encloses(box_, reach))
+            {
+                cell::for_each_descendant(cell, resolution_, [&out](const index descendant) { out.push_back(descendant); });
+                return;
+            }
+
+            cell::for_each_child(cell,
+                                 [&](const index child)
+                                 {
+                                     gis::wgs84::coordinate child_center;
+                                     if (to_wgs(child, child_center) == error_t::none)
+                                         descend(child, child_center, out);
+                                 });
+        }
+
+    private:
+        const box& box_;
+        const resolution_t resolution_;
+        double reaches_[resolution_count] {};
+    };
+
+    box to_box(const id& tile) noexcept
+    {
+        const double scale = std::ldexp(1.0, -tile.zoom);
+        const auto latitude = [&](const std::uint32_t y) { return std::atan(std::sinh(pi * (1.0 - 2.0 * y * scale))); };
+        return {latitude(tile.y + 1u), latitude(tile.y), 2.0 * pi * tile.x * scale - pi, 2.0 * pi * (tile.x + 1.0) * scale - pi};
+    }
+
+    error_t to_cells(const box& box, const resolution_t resolution, std::vector<index>& cells)
+    {
+        if (+resolution >= resolution_count)
+            return error_t::res_domain;
+
+        const auto in_range = [](const double value, const double limit) { return std::isfinite(value) && (std::fabs(value) <= limit); };
+        if (!in_range(box.south, half_pi) || !in_range(box.north, half_pi) || !in_range(box.west, pi) || !in_range(box.east, pi) ||
+            (box.south > box.north))
+            return error_t::latlng_domain;
+
+        // the cells come out sorted, as the walk follows the base cells then the digits in order
+        const box_walker walker {box, resolution};
+        std::vector<index> result;
+        for (const auto& [cell, center]: cell::bounds::base_cells())
+            walker.descend(cell, center, result);
+
+        cells = std::move(result);
+        return error_t::none;
+    }
+
+    error_t to_cells(const id& tile, const resolution_t resolution, std::vector<index>& cells)
+    {
+        if (!tile.is_valid())
+            return error_t::domain;
+
+        return to_cells(to_box(tile), resolution, cells);
+    }
+
+    error_t to_tiles(std::span<const index> cells, const std::uint8_t zoom, std::vector<id>& tiles)
+    {
+        if (zoom > max_zoom)
+            return error_t::domain;
+
+        const auto count = std::uint32_t {1u} << zoom;
+        const double scale = std::ldexp(1.0, zoom);
+        const auto clamp = [count](const double value) { return static_cast<std::uint32_t>(std::clamp(value, 0.0, count - 1.0)); };
+        const auto to_x = [&](const double longitude) { return clamp(std::floor((longitude + pi) / (2.0 * pi) * scale)); };
+        const auto to_y = [&](const double latitude)
+        { return clamp(std::floor((1.0 - std::asinh(std::tan(std::clamp(latitude, -half_pi, half_pi))) / pi) / 2.0 * scale)); };
+
+        std::vector<id> result;
+        for (const auto cell: cells)
+        {
+            box cell_box;
+            const auto err = cell::bounds::get(cell, cell_box);
+            if (err != error_t::none)
+                return err;
+
+            const auto add_columns = [&](const std::uint32_t first_x, const std::uint32_t last_x)
+            {
+                for (auto y = to_y(cell_box.north); y <= to_y(cell_box.south); ++y)
+                    for (auto x = first_x; x <= last_x; ++x)
+                        result.push_back({zoom, x, y});
+            };
+
+            if (cell_box.is_transmeridian())
+            {
+                add_columns(to_x(cell_box.west), count - 1u);
+                add_columns(0u, to_x(cell_box.east));
+            }
+            else
+                add_columns(to_x(cell_box.west), to_x(cell_box.east));
+        }
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        tiles = std::move(result);
+        return error_t::none;
+    }
+
+    error_t cache::get(const id& tile, const resolution_t resolution, cells& cells)
+    {
+        if (!tile.is_valid())
+            return error_t::domain;
+
+        auto& level = levels_[tile.zoom];
+        const auto find = [&]
+        {
+            return std::find_if(level.entries.begin(), level.entries.end(),
+                                [&](const entry& item) { return (item.tile == tile) && (item.resolution == resolution); });
+        };
+
+        {
+            const std::lock_guard lock {mutex_};
+            const auto found = find();
+            if (found != level.entries.end())
+            {
+                cells = found->items;
+                return error_t::none;
+            }
+        }
+
+        // computed without the lock, so threads asking for other tiles do not wait
+        auto items = std::make_shared<std::vector<index>>();
+        const auto err = to_cells(tile, resolution, *items);
+        if (err != error_t::none)
+            return err;
+
+        cells = items;
+        if (capacity_ == 0u)
+            return error_t::none;
+
+        // another thread may have cached the same cover meanwhile: a second copy would evict a live one
+        const std::lock_guard lock {mutex_};
+        const auto found = find();
+        if (found != level.entries.end())
+        {
+            cells = found->items;
+            return error_t::none;
+        }
+
+        if (level.entries.size() < capacity_)
+            level.entries.push_back({tile, resolution, std::move(items)});
+        else
+        {
+            level.entries[level.next] = {tile, resolution, std::move(items)};
+            level.next = (level.next + 1u) % capacity_;
+        }
+
+        return error_t::none;
+    }
+}
@@ -0,0 +1,122 @@
+/// @file geohex/trie.cpp
+#include "kmx/geohex/trie.hpp"
+#include "kmx/geohex/cell.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace kmx::geohex::trie
+{
+    error_t tree::assign(const std::span<const index> cells, const std::span<const double> values)
+    {
+        if (cells.size() != values.size())
+            return error_t::domain;
+        if (!std::all_of(cells.begin(), cells.end(), [](const index cell) { return cell.is_valid(); }))
+            return error_t::cell_invalid;
+
+        // inserted in the order of the ranges of their descendants, the nodes come in depth first order
+        const auto key_of = [](const index cell)
+        { return cell::to_number(cell) << (3u * (resolution_count - 1u - +cell.resolution())); };
+        std::vector<std::size_t> order(cells.size());
+        std::iota(order.begin(), order.end(), std::size_t {});
+        std::sort(order.begin(), order.end(),
+                  [&](const std::size_t a, const std::size_t b)
+                  {
+                      const auto key_a = key_of(cells[a]), key_b = key_of(cells[b]);
+                      return key_a != key_b ? key_a < key_b : cells[a].resolution() < cells[b].resolution();
+                  });
+
+        tree result;
+        result.nodes_.reserve(cells.size() + 1u);
+        for (const auto i: order)
+            result.insert(cells[i], values[i]);
+
+        *this = std::move(result);
+        return error_t::none;
+    }
+
+    error_t tree::insert(const index cell, const double value)
+    {
+        if (!cell.is_valid())
+            return error_t::cell_invalid;
+
+        // the first node is a placeholder, so 0 tells a missing node
+        if (nodes_.empty())
+            nodes_.emplace_back();
+
+        const auto add_node = [this]
+        {
+            nodes_.emplace_back();
+            return static_cast<std::uint32_t>(nodes_.size() - 1u);
+        };
+
+        auto& root = roots_[cell.base_cell()];
+        if (root == none)
+            root = add_node();
+
+        auto current = root;
+        nodes_[current].total.add(value);
+        for (std::uint32_t res {}; res != +cell.resolution(); ++res)
+        {
+            const auto digit = static_cast<std::size_t>(cell.digit(static_cast<index::digit_index>(res)));
+            if (nodes_[current].children[digit] == none)
+            {
+                const auto child = add_node();
+                nodes_[current].children[digit] = child;
+            }
+
+            current = nodes_[current].children[digit];
+            nodes_[current].total.add(value);
+        }
+
+        nodes_[current].own.add(value);
+        ++size_;
+        return error_t::none;
+    }
+
+    std::uint32_t tree::find(const index cell) const noexcept
+    {
+        if (!cell.is_valid())
+            return none;
+
+        auto current = roots_[cell.base_cell()];
+        for (std::uint32_t res {}; (res != +cell.resolution()) && (current != none); ++res)
+            current = nodes_[current].children[static_cast<std::size_t>(cell.digit(static_cast<index::digit_index>(res)))];
+        return current;
+    }
+
+    aggregate tree::total(const index cell) const noexcept
+    {
+        const auto node = find(cell);
+        return node != none ? nodes_[node].total : aggregate {};
+    }
+
+    aggregate tree::values(const index cell) const noexcept
+    {
+        const auto node = find(cell);
+        return node != none ? nodes_[node].own : aggregate {};
+    }
+
+    bool tree::find_ancestor(const index cell, index& found) const noexcept
+    {
+        if (!cell.is_valid())
+            return false;
+
+        // the finest node with values on the way down to the cell
+        auto current = roots_[cell.base_cell()];
+        int finest = -1;
+        for (std::uint32_t res {}; current != none; ++res)
+        {
+            if (nodes_[current].own.count != 0u)
+                finest = static_cast<int>(res);
+            if (res == +cell.resolution())
+                break;
+            current = nodes_[current].children[static_cast<std::size_t>(cell.digit(static_cast<index::digit_index>(res)))];
+        }
+
+        if (finest < 0)
+            return false;
+
+        found = cell::parent(cell, static_cast<resolution_t>(finest));
+        return true;
+    }
+}
@@ -0,0 +1,363 @@
+/// @file geohex/vertex.cpp
+#include "kmx/geohex/vertex.hpp"
+#include "kmx/geohex/cell/boundary.hpp"
+#include "kmx/geohex/cell/pentagon.hpp"
+#include "kmx/geohex/grid/neighbor.hpp"
+#include "kmx/geohex/icosahedron/face.hpp"
+#include <algorithm>
+#include <array>
+
+namespace kmx::geohex::vertex
+{
+    // The vertex numbers of a cell follow the frame of the face holding its center, while the directions to its
+    // neighbors follow the frame of its base cell; the rotations between the two frames convert one into the other.
+
+    /// @ref directionToVertexNumHex
+    static constexpr std::array<number_t, direction_count> hexagon_numbers {invalid_number, 3, 1, 2, 5, 4, 0};
+
+    /// @ref directionToVertexNumPent
+    static constexpr std::array<number_t, direction_count> pentagon_numbers {invalid_number, invalid_number, 1, 2, 4, 3, 0};
+
+    /// @ref vertexNumToDirectionHex
+    static constexpr std::array<direction_t, hexagon_count> hexagon_directions {
+        direction_t::ij_axes, direction_t::j_axes,  direction_t::jk_axes,
+        direction_t::k_axes,  direction_t::ik_axes, direction_t::i_axes,
+    };
+
+    /// @ref vertexNumToDirectionPent
+    static constexpr std::array<direction_t, pentagon_count> pentagon_directions {
+        direction_t::ij_axes, direction_t::j_axes, direction_t::jk_axes, direction_t::ik_axes, direction_t::i_axes,
+    };
+
+    /// @brief The faces in the directions of a pentagon base cell, from the j-axis to the ij-axis.
+    /// @ref PentagonDirectionFaces
+    struct pentagon_direction_faces
+    {
+        cell::base::id_t base_cell;
+        std::array<icosahedron::face::no_t, pentagon_count> faces;
+    };
+
+    /// @ref pentagonDirectionFaces
+    static constexpr std::array<pentagon_direction_faces, cell::pentagon::count> pentagon_faces {{
+        {4u, {4u, 0u, 2u, 1u, 3u}},
+        {14u, {6u, 11u, 2u, 7u, 1u}},
+        {24u, {5u, 10u, 1u, 6u, 0u}},
+        {38u, {7u, 12u, 3u, 8u, 2u}},
+        {49u, {9u, 14u, 0u, 5u, 4u}},
+        {58u, {8u, 13u, 4u, 9u, 3u}},
+        {63u, {11u, 6u, 15u, 10u, 16u}},
+        {72u, {12u, 7u, 16u, 11u, 17u}},
+        {83u, {10u, 5u, 19u, 14u, 15u}},
+        {97u, {13u, 8u, 17u, 12u, 18u}},
+        {107u, {14u, 9u, 18u, 13u, 19u}},
+        {117u, {15u, 19u, 17u, 18u, 16u}},
+    }};
+
+    /// @brief Gets the face in a direction of a pentagon base cell.
+    static icosahedron::face::id_t pentagon_face(const pentagon_direction_faces& item, const direction_t direction) noexcept
+    {
+        return static_cast<icosahedron::face::id_t>(item.faces[+direction - +direction_t::j_axes]);
+    }
+
+    /// @ref vertexRotations
+    /// @return The counter-clockwise 60 degree rotations from the frame of the face of the cell center to the frame
+    /// of the base cell of the cell.
+    static int frame_rotations(const index cell) noexcept
+    {
+        icosahedron::face::ijk fijk;
+        if (icosahedron::face::from_index(cell, fijk) != error_t::none)
+            return 0;
+
+        const auto base_cell = cell.base_cell();
+        auto result = icosahedron::face::base_cell_rotations(base_cell, fijk.face);
+        if (result < 0)
+            return 0;
+
+        if (cell::pentagon::check(base_cell))
+        {
+            const auto& faces = *std::find_if(pentagon_faces.begin(), pentagon_faces.end(),
+                                              [base_cell](const pentagon_direction_faces& item) { return item.base_cell == base_cell; });
+            const auto ik_face = pentagon_face(faces, direction_t::ik_axes);
+
+            // an additional rotation for the polar neighbors and the ik neighbor
+            if ((fijk.face != icosahedron::face::home(base_cell).face) && (cell::base::is_polar_pentagon(base_cell) || (fijk.face == ik_face)))
+                result = (result + 1) % 6;
+
+            // the cell crosses the deleted k subsequence
+            const auto leading = cell.leading_non_zero_digit();
+            if ((leading == direction_t::jk_axes) && (fijk.face == ik_face))
+                result = (result + 5) % 6;
+            else if ((leading == direction_t::ik_axes) && (fijk.face == pentagon_face(faces, direction_t::jk_axes)))
+                result = (result + 1) % 6;
+        }
+
+        return result;
+    }
+
+    /// @brief Gets the number of the first vertex of the edge in a direction, with the frame rotations of the origin.
+    static number_t number_for_direction(const index origin, const direction_t direction, const int frame) noexcept
+    {
+        if ((+direction >= direction_count) || (direction == direction_t::center))
+            return invalid_number;
+
+        if (origin.is_pentagon())
+        {
+            if (direction == direction_t::k_axes)
+                return invalid_number;
+
+            return static_cast<number_t>((pentagon_numbers[+direction] + pentagon_count - frame) % pentagon_count);
+        }
+
+        return static_cast<number_t>((hexagon_numbers[+direction] + hexagon_count - frame) % hexagon_count);
+    }
+
+    /// @brief Gets the direction of the edge starting at a vertex, with the frame rotations of the origin.
+    static direction_t direction_for_number(const index origin, const number_t number, const int frame) noexcept
+    {
+        if (number < 0)
+            return direction_t::invalid;
+
+        if (origin.is_pentagon())
+            return number < pentagon_count ? pentagon_directions[(number + frame) % pentagon_count] : direction_t::invalid;
+
+        return number < hexagon_count ? hexagon_directions[(number + frame) % hexagon_count] : direction_t::invalid;
+    }
+
+    number_t number_for_direction(const index origin, const direction_t direction) noexcept
+    {
+        if ((+direction >= direction_count) || (direction == direction_t::center))
+            return invalid_number;
+
+        return number_for_direction(origin, direction, frame_rotations(origin));
+    }
+
+    direction_t direction_for_number(const index origin, const number_t number) noexcept
+    {
+        if (number < 0)
+            return direction_t::invalid;
+
+        return direction_for_number(origin, number, frame_rotations(origin));
+    }
+
+    index owner(const index vertex) noexcept
+    {
+        index result = vertex;
+        result.set_mode(index_mode_t::cell);
+        result.set_mode_dependent(0u);
+        return result;
+    }
+
+    number_t number(const index vertex) noexcept
+    {
+        return static_cast<number_t>(vertex.mode_dependent());
+    }
+
+    /// @brief Neighbors of a cell computed on first use, so the vertices of a cell share the traversals and the frame
+    /// rotations, which each decode a cell.
+    class neighborhood
+    {
+    public:
+        explicit neighborhood(const index cell) noexcept: cell_ {cell} {}
+
+        error_t get(const direction_t direction, index& out, int& rotations) noexcept
+        {
+            const auto bit = 1u << +direction;
+            if ((known_ & bit) == 0u)
+            {
+                int new_rotations {};
+                const auto err = grid::neighbor::get(cell_, direction, new_rotations, items_[+direction]);
+                if (err != error_t::none)
+                    return err;
+
+                rotations_[+direction] = static_cast<std::int8_t>(new_rotations);
+                known_ |= bit;
+            }
+
+            out = items_[+direction];
+            rotations = rotations_[+direction];
+            return error_t::none;
+        }
+
+        index cell() const noexcept { return cell_; }
+
+        /// @brief Gets the frame rotations of the cell (in the center direction) or of a neighbor already reached.
+        int frame(const direction_t direction = direction_t::center) noexcept
+        {
+            const auto bit = 1u << +direction;
+            if ((known_frames_ & bit) == 0u)
+            {
+                const auto cell = direction == direction_t::center ? cell_ : items_[+direction];
+                frames_[+direction] = static_cast<std::int8_t>(frame_rotations(cell));
+                known_frames_ |= bit;
+            }
+
+            return frames_[+direction];
+        }
+
+    private:
+        index cell_;
+        std::array<index, direction_count> items_ {};
+        std::array<std::int8_t, direction_count> rotations_ {};
+        std::array<std::int8_t, direction_count> frames_ {};
+        std::uint8_t known_ {};
+        std::uint8_t known_frames_ {};
+    };
+
+    /// @brief Gets the number of the vertex of the edge shared with a neighbor, as seen from that neighbor.
+    /// @param direction The direction of the neighbor, already reached through `cells`.
+    /// @param rotations The rotations reported by the traversal to the neighbor.
+    /// @return The first vertex number of the shared edge on the neighbor.
+    static number_t neighbor_number(neighborhood& cells, const index neighbor, const direction_t direction, const int rotations) noexcept
+    {
+        // The direction back to the cell, expressed in the frame of the neighbor. The digit frames of the subsequences
+        // of a pentagon base cell do not line up across the deleted k subsequence, so the rotations are only reliable
+        // away from pentagon base cells; there the direction is searched instead.
+        const auto cell = cells.cell();
+        auto back = opposite(direction);
+        if (cell::pentagon::check(cell.base_cell()) || cell::pentagon::check(neighbor.base_cell()))
+            back = grid::neighbor::direction_to(neighbor, cell);
+        else
+            for (int i {}; i < rotations; ++i)
+                back = rotate_60ccw(back);
+
+        return number_for_direction(neighbor, back, cells.frame(direction));
+    }
+
+    /// @ref cellToVertex
+    static error_t canonical(neighborhood& cells, const number_t number, index& out) noexcept
+    {
+        const auto cell = cells.cell();
+        const auto vertex_count = static_cast<number_t>(count(cell));
+        if ((number < 0) || (number >= vertex_count))
+            return error_t::domain;
+
+        const auto res = +cell.resolution();
+        index owner = cell;
+        auto owner_number = number;
+
+        // A center child has a lower index than any cell it shares a vertex with, so it always owns its vertices.
+        if ((res == 0u) || (cell.digit(static_cast<index::digit_index>(res - 1u)) != +direction_t::center))
+        {
+            // The vertex is shared with the neighbors on the edges starting (left) and ending (right) at it.
+            const auto left = direction_for_number(cell, number, cells.frame());
+            if (left == direction_t::invalid)
+                return error_t::failed;
+
+            index left_neighbor;
+            int left_rotations {};
+            auto err = cells.get(left, left_neighbor, left_rotations);
+            if (err != error_t::none)
+                return err;
+
+            if (left_neighbor < owner)
+                owner = left_neighbor;
+
+            if ((res == 0u) || (left_neighbor.digit(static_cast<index::digit_index>(res - 1u)) != +direction_t::center))
+            {
+                const auto previous = static_cast<number_t>((number + vertex_count - 1) % vertex_count);
+                const auto right = direction_for_number(cell, previous, cells.frame());
+                if (right == direction_t::invalid)
+                    return error_t::failed;
+
+                index right_neighbor;
+                int right_rotations {};
+                err = cells.get(right, right_neighbor, right_rotations);
+                if (err != error_t::none)
+                    return err;
+
+                if (right_neighbor < owner)
+                {
+                    // The vertex starts the edge shared with the right neighbor.
+                    owner = right_neighbor;
+                    owner_number = neighbor_number(cells, owner, right, right_rotations);
+                }
+            }
+
+            if (owner == left_neighbor)
+            {
+                // The vertex ends the edge shared with the left neighbor.
+                const auto start = neighbor_number(cells, owner, left, left_rotations);
+                if (start == invalid_number)
+                    return error_t::failed;
+
+                owner_number = static_cast<number_t>((start + 1) % count(owner));
+            }
+        }
+
+        if (owner_number == invalid_number)
+            return error_t::failed;
+
+        out = owner;
+        out.set_mode(index_mode_t::vertex);
+        out.set_mode_dependent(static_cast<std::uint8_t>(owner_number));
+        return error_t::none;
+    }
+
+    error_t of(const index cell, const number_t number, index& out) noexcept
+    {
+        if (!cell.is_valid())
+            return error_t::cell_invalid;
+
+        neighborhood cells {cell};
+        return canonical(cells, number, out);
+    }
+
+    error_t of(const index cell, std::span<index>& out) noexcept
+    {
+        if (!cell.is_valid())
+        {
+            out = {};
+            return error_t::cell_invalid;
+        }
+
+        if (out.size() < max_count)
+            return error_t::memory_bounds;
+
+        neighborhood cells {cell};
+        const auto vertex_count = static_cast<number_t>(count(cell));
+        for (number_t i {}; i != vertex_count; ++i)
+        {
+            const auto err = canonical(cells, i, out[i]);
+            if (err != error_t::none)
+            {
+                out = out.first(i);
+                return err;
+            }
+        }
+
+        out = out.first(vertex_count);
+        return error_t::none;
+    }
+
+    bool is_valid(const index vertex) noexcept
+    {
+        if (vertex.mode() != index_mode_t::vertex)
+            return false;
+
+        const auto cell = owner(vertex);
+        if (!cell.is_valid() || (number(vertex) >= count(cell)))
+            return false;
+
+        index canonical_vertex;
+        return (of(cell, number(vertex), canonical_vertex) == error_t::none) && (canonical_vertex == vertex);
+    }
+
+    error_t to_wgs84(const index vertex, gis::wgs84::coordinate& out) noexcept
+    {
+        const auto cell = owner(vertex);
+        if ((vertex.mode() != index_mode_t::vertex) || !cell.is_valid() || (number(vertex) >= count(cell)))
+            return error_t::vertex_invalid;
+
+        icosahedron::face::ijk center_fijk;
+        const auto err = icosahedron::face::from_index(cell, center_fijk);
+        if (err != error_t::none)
+            return err;
+
+        std::array<gis::wgs84::coordinate, 1u> vertices;
+        std::span<gis::wgs84::coordinate> vertices_span {vertices};
+        const auto result = cell::boundary::get_vertices(center_fijk, cell, static_cast<std::uint8_t>(number(vertex)), 1u, vertices_span);
+        if (result == error_t::none)
+            out = vertices.front();
+        return result;
+    }
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <iterator>
+#include <kmx/geohex/bitmap.hpp>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <random>
+#include <vector>
+
+namespace kmx::geohex
+{
+    /// @brief Gets the resolution 9 descendants of a resolution 4 cell, dense enough for bitmap containers, with random
+    /// cells of the resolution around.
+    static std::vector<index> cells_around(const gis::wgs84::coordinate& center, const std::uint64_t seed)
+    {
+        std::vector<index> cells;
+        index patch;
+        REQUIRE(from_wgs(center, resolution_t::r4, patch) == error_t::none);
+        cell::for_each_descendant(patch, resolution_t::r9, [&cells](const index cell) { cells.push_back(cell); });
+
+        std::mt19937_64 random {seed};
+        std::normal_distribution<double> offset {0.0, 0.01};
+        for (std::size_t i {}; i != 3000u; ++i)
+        {
+            index cell;
+            const gis::wgs84::coordinate point {center.latitude + offset(random), center.longitude + offset(random)};
+            REQUIRE(from_wgs(point, resolution_t::r9, cell) == error_t::none);
+            cells.push_back(cell);
+        }
+
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+        return cells;
+    }
+
+    TEST_CASE("bitmap - set algebra")
+    {
+        const auto a_cells = cells_around(gis::wgs84::coordinate::from_degrees(37.77, -122.42), 1u);
+        const auto b_cells = cells_around(gis::wgs84::coordinate::from_degrees(37.80, -122.40), 2u);
+
+        bitmap::set a, b;
+        REQUIRE(a.assign(a_cells) == error_t::none);
+        REQUIRE(b.assign(b_cells) == error_t::none);
+        REQUIRE(a.size() == a_cells.size());
+        REQUIRE(a.resolution() == resolution_t::r9);
+        REQUIRE(a.contains(a_cells[a_cells.size() / 2u]));
+        REQUIRE(!a.contains(cell::parent(a_cells.front(), resolution_t::r7)));
+
+        std::vector<index> cells;
+        a.to_cells(cells);
+        REQUIRE(cells == a_cells);
+
+        const auto check = [&cells](const bitmap::set& result, const std::vector<index>& expected)
+        {
+            REQUIRE(result.size() == expected.size());
+            result.to_cells(cells);
+            REQUIRE(cells == expected);
+        };
+
+        std::vector<index> expected;
+        bitmap::set result;
+        REQUIRE(bitmap::unite(a, b, result) == error_t::none);
+        std::set_union(a_cells.begin(), a_cells.end(), b_cells.begin(), b_cells.end(), std::back_inserter(expected));
+        check(result, expected);
+
+        expected.clear();
+        REQUIRE(bitmap::intersect(a, b, result) == error_t::none);
+        std::set_intersection(a_cells.begin(), a_cells.end(), b_cells.begin(), b_cells.end(), std::back_inserter(expected));
+        REQUIRE(!expected.empty());
+        check(result, expected);
+
+        expected.clear();
+        REQUIRE(bitmap::subtract(a, b, result) == error_t::none);
+        std::set_difference(a_cells.begin(), a_cells.end(), b_cells.begin(), b_cells.end(), std::back_inserter(expected));
+        check(result, expected);
+
+        // in place, and with an empty set
+        REQUIRE(bitmap::subtract(a, a, a) == error_t::none);
+        REQUIRE(a.empty());
+        REQUIRE(bitmap::unite(a, b, a) == error_t::none);
+        check(a, b_cells);
+    }
+
+    TEST_CASE("bitmap - errors")
+    {
+        index a, b;
+        REQUIRE(from_wgs(gis::wgs84::coordinate::from_degrees(10.0, 10.0), resolution_t::r7, a) == error_t::none);
+        REQUIRE(from_wgs(gis::wgs84::coordinate::from_degrees(20.0, 20.0), resolution_t::r6, b) == error_t::none);
+
+        bitmap::set set_a, set_b, result;
+        REQUIRE(set_a.assign(std::vector<index> {a, b}) == error_t::res_mismatch);
+        REQUIRE(set_a.assign(std::vector<index> {index {0u}}) == error_t::cell_invalid);
+        REQUIRE(set_a.assign(std::vector<index> {a, a}) == error_t::none);
+        REQUIRE(set_a.size() == 1u);
+        REQUIRE(set_b.assign(std::vector<index> {b}) == error_t::none);
+        REQUIRE(bitmap::unite(set_a, set_b, result) == error_t::res_mismatch);
+    }
+}
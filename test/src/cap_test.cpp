@@ -0,0 +1,77 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <kmx/geohex/cap.hpp>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/cell/base.hpp>
+#include <kmx/geohex/polygon/vector_based.hpp>
+#include <kmx/geohex/util.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <limits>
+#include <vector>
+
+namespace kmx::geohex
+{
+    static const auto san_francisco = gis::wgs84::coordinate::from_degrees(37.7749, -122.4194);
+
+    static double distance_m(const index cell, const gis::wgs84::coordinate& center)
+    {
+        gis::wgs84::coordinate coord;
+        REQUIRE(to_wgs(cell, coord) == error_t::none);
+        return coord.haversine_distance_to(center, earth_radius_km * meters_per_km);
+    }
+
+    TEST_CASE("cap - to cells")
+    {
+        const cap::item cap {san_francisco, 2000.0};
+        std::vector<index> cells;
+        REQUIRE(cap::to_cells(cap, resolution_t::r9, cells) == error_t::none);
+        REQUIRE(cells.size() > 100u);
+        for (const auto cell: cells)
+            REQUIRE(distance_m(cell, cap.center) <= cap.radius);
+
+        // the same cells as filtering the cells of a square around the cap by their distance
+        const double half_side = degree::to_radian(0.03);
+        const polygon::vector_based::item square {
+            {san_francisco.latitude - half_side, san_francisco.longitude - half_side},
+            {san_francisco.latitude - half_side, san_francisco.longitude + half_side},
+            {san_francisco.latitude + half_side, san_francisco.longitude + half_side},
+            {san_francisco.latitude + half_side, san_francisco.longitude - half_side},
+        };
+        std::vector<index> expected;
+        REQUIRE(polygon::vector_based::to_cells(square, resolution_t::r9, expected) == error_t::none);
+        std::erase_if(expected, [&](const index cell) { return distance_m(cell, cap.center) > cap.radius; });
+
+        std::sort(cells.begin(), cells.end());
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(cells == expected);
+
+        REQUIRE(cap::to_cells({san_francisco, 0.0}, resolution_t::r9, cells) == error_t::none);
+        REQUIRE(cells.empty());
+    }
+
+    TEST_CASE("cap - to compact cells")
+    {
+        const cap::item cap {san_francisco, 2000.0};
+        std::vector<index> cells, compact;
+        REQUIRE(cap::to_cells(cap, resolution_t::r10, cells) == error_t::none);
+        REQUIRE(cap::to_compact_cells(cap, resolution_t::r10, compact) == error_t::none);
+        REQUIRE(compact.size() < cells.size());
+
+        std::size_t count {};
+        for (const auto cell: compact)
+            count += cell::children_count(cell, resolution_t::r10);
+        REQUIRE(count == cells.size());
+
+        // the whole sphere is the base cells
+        REQUIRE(cap::to_compact_cells({san_francisco, 3e7}, resolution_t::r15, compact) == error_t::none);
+        REQUIRE(compact.size() == cell::base::count);
+    }
+
+    TEST_CASE("cap - errors")
+    {
+        std::vector<index> cells;
+        REQUIRE(cap::to_cells({san_francisco, -1.0}, resolution_t::r9, cells) == error_t::domain);
+        REQUIRE(cap::to_cells({{std::numeric_limits<double>::quiet_NaN(), 0.0}, 1.0}, resolution_t::r9, cells) == error_t::latlng_domain);
+        REQUIRE(cap::to_cells({san_francisco, 1.0}, static_cast<resolution_t>(16), cells) == error_t::res_domain);
+    }
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/cell/base.hpp>
+#include <kmx/geohex/cell/boundary.hpp>
+#include <kmx/geohex/cell/bounds.hpp>
+#include <kmx/geohex/geo_projection.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <numbers>
+#include <vector>
+
+namespace kmx::geohex
+{
+    TEST_CASE("cell - children count")
+    {
+        // a hexagon of a pentagon base cell, and the pentagon itself
+        REQUIRE(cell::children_count(index {0x8108bffffffffffu}, resolution_t::r3) == 49u);
+        REQUIRE(cell::children_count(index {0x81083ffffffffffu}, resolution_t::r3) == 41u);
+        REQUIRE(cell::children_count(index {0x8108bffffffffffu}, resolution_t::r0) == 0u);
+    }
+
+    TEST_CASE("cell - bounds")
+    {
+        constexpr double half_pi = std::numbers::pi_v<double> / 2.0;
+
+        // a cell of San Francisco, a cell on the antimeridian, the cells of both poles and a pentagon
+        std::vector<index> cells(5u);
+        REQUIRE(from_wgs(gis::wgs84::coordinate::from_degrees(37.7749, -122.4194), resolution_t::r9, cells[0]) == error_t::none);
+        REQUIRE(from_wgs({0.0, std::numbers::pi_v<double>}, resolution_t::r4, cells[1]) == error_t::none);
+        REQUIRE(from_wgs({half_pi, 0.0}, resolution_t::r2, cells[2]) == error_t::none);
+        REQUIRE(from_wgs({-half_pi, 0.0}, resolution_t::r7, cells[3]) == error_t::none);
+        cells[4] = index {0x81083ffffffffffu};
+
+        std::vector<cell::bounds::cap> caps(cells.size());
+        std::vector<cell::bounds::box> boxes(cells.size()), bounding(cells.size());
+        REQUIRE(cell::bounds::get(cells, caps) == error_t::none);
+        REQUIRE(cell::bounds::get(cells, boxes) == error_t::none);
+        REQUIRE(cell::bounds::get(cells, bounding, cell::bounds::fit_t::bounding) == error_t::none);
+
+        for (std::size_t i {}; i != cells.size(); ++i)
+        {
+            std::array<gis::wgs84::coordinate, cell::boundary::max_vertices> vertices;
+            std::span<gis::wgs84::coordinate> boundary {vertices};
+            REQUIRE(cell::boundary::get(cells[i], boundary) == error_t::none);
+            for (const auto& vertex: boundary)
+            {
+                math::vector3d point;
+                projection::to_v3d(vertex, point);
+                REQUIRE(caps[i].contains(point));
+                REQUIRE(boxes[i].contains(vertex));
+                REQUIRE(bounding[i].contains(vertex));
+            }
+
+            REQUIRE(caps[i].radius >= cell::bounds::max_radius(cells[i].resolution()));
+            REQUIRE(boxes[i].south >= bounding[i].south);
+            REQUIRE(boxes[i].north <= bounding[i].north);
+        }
+
+        REQUIRE(!boxes[0].is_transmeridian());
+        REQUIRE(boxes[1].is_transmeridian());
+        REQUIRE(boxes[2].north == half_pi);
+        REQUIRE(boxes[2].west == -std::numbers::pi_v<double>);
+        REQUIRE(boxes[3].south == -half_pi);
+
+        std::vector<cell::bounds::box> small(1u);
+        REQUIRE(cell::bounds::get(cells, small) == error_t::memory_bounds);
+    }
+
+    TEST_CASE("cell - bounds reaches")
+    {
+        const auto& bases = cell::bounds::base_cells();
+        for (cell::base::id_t i {}; i != cell::base::count; ++i)
+        {
+            REQUIRE(bases[i].cell.is_valid());
+            REQUIRE(bases[i].cell.resolution() == resolution_t::r0);
+            REQUIRE(bases[i].cell.base_cell() == i);
+        }
+
+        // the vertices and centers of the resolution 5 descendants of a pentagon base cell, within the reaches of each
+        // ancestor
+        std::array<double, resolution_count> reaches {}, center_reaches {};
+        cell::bounds::reaches(resolution_t::r5, reaches);
+        cell::bounds::center_reaches(resolution_t::r5, center_reaches);
+        REQUIRE(center_reaches[5] == 0.0);
+        for (unsigned number {}; number != 7u * 7u * 7u * 7u * 7u; ++number)
+        {
+            // the descendant with the digits of the number, unless in the deleted subsequence of the pentagon
+            index descendant = bases[4].cell;
+            descendant.set_resolution(resolution_t::r5);
+            for (unsigned i {}, rest = number; i != 5u; ++i, rest /= 7u)
+                descendant.set_digit(i, rest % 7u);
+
+            if (!descendant.is_valid())
+                continue;
+
+            std::array<gis::wgs84::coordinate, cell::boundary::max_vertices> vertices;
+            std::span<gis::wgs84::coordinate> boundary {vertices};
+            REQUIRE(cell::boundary::get(descendant, boundary) == error_t::none);
+            gis::wgs84::coordinate descendant_center;
+            REQUIRE(to_wgs(descendant, descendant_center) == error_t::none);
+            math::vector3d descendant_point;
+            projection::to_v3d(descendant_center, descendant_point);
+            for (unsigned res {}; res <= 5u; ++res)
+            {
+                index ancestor = descendant;
+                for (unsigned i = res; i != 5u; ++i)
+                    ancestor.set_digit(i, 7u);
+                ancestor.set_resolution(static_cast<resolution_t>(res));
+
+                gis::wgs84::coordinate center;
+                REQUIRE(to_wgs(ancestor, center) == error_t::none);
+                math::vector3d axis;
+                projection::to_v3d(center, axis);
+                const double distance = std::atan2(axis.cross(descendant_point).magnitude(), axis.dot(descendant_point));
+                REQUIRE(distance <= center_reaches[res] + 1e-12);
+                for (const auto& vertex: boundary)
+                {
+                    math::vector3d point;
+                    projection::to_v3d(vertex, point);
+                    REQUIRE(std::acos(std::min(1.0, axis.dot(point))) <= reaches[res]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,135 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/cell/base.hpp>
+#include <kmx/geohex/codec.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace kmx::geohex
+{
+    TEST_CASE("codec - encode and decode")
+    {
+        // a dense patch, the resolution 9 descendants of a resolution 5 cell, with random cells over the globe
+        std::vector<index> cells;
+        index patch;
+        REQUIRE(from_wgs(gis::wgs84::coordinate::from_degrees(37.77, -122.42), resolution_t::r5, patch) == error_t::none);
+        cell::for_each_descendant(patch, resolution_t::r9, [&cells](const index cell) { cells.push_back(cell); });
+
+        // gaps of a few bits in the patch
+        std::vector<std::byte> data;
+        REQUIRE(codec::encode(cells, data) == error_t::none);
+        REQUIRE(data.size() * 10u < cells.size() * sizeof(index::value_t));
+
+        std::mt19937_64 random {5u};
+        std::uniform_real_distribution<double> latitude {-1.5, 1.5}, longitude {-std::numbers::pi, std::numbers::pi};
+        for (std::size_t i {}; i != 2000u; ++i)
+        {
+            index cell;
+            REQUIRE(from_wgs({latitude(random), longitude(random)}, resolution_t::r9, cell) == error_t::none);
+            cells.push_back(cell);
+        }
+
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+        data.clear();
+        REQUIRE(codec::encode(cells, data) == error_t::none);
+        REQUIRE(data.size() * 3u < cells.size() * sizeof(index::value_t));
+
+        codec::view view;
+        REQUIRE(view.open(data) == error_t::none);
+        REQUIRE(view.size() == cells.size());
+        REQUIRE(view.resolution() == resolution_t::r9);
+
+        std::vector<index> decoded;
+        view.decode(decoded);
+        REQUIRE(decoded == cells);
+        for (std::size_t i {}; i < cells.size(); i += 97u)
+        {
+            REQUIRE(view.at(i) == cells[i]);
+            REQUIRE(view.contains(cells[i]));
+        }
+
+        // the neighbours of the patch, its parent and a cell of another resolution are not in the set
+        index outside;
+        REQUIRE(from_wgs(gis::wgs84::coordinate::from_degrees(37.0, -121.0), resolution_t::r9, outside) == error_t::none);
+        REQUIRE(!view.contains(outside));
+        REQUIRE(!view.contains(patch));
+
+        std::array<index, codec::block_size> block;
+        REQUIRE(view.decode(view.block_count() - 1u, block) == (cells.size() - 1u) % codec::block_size + 1u);
+
+        data.clear();
+        REQUIRE(codec::encode({}, data) == error_t::none);
+        REQUIRE(view.open(data) == error_t::none);
+        REQUIRE(view.size() == 0u);
+        REQUIRE(!view.contains(patch));
+    }
+
+    TEST_CASE("codec - blocks without gaps")
+    {
+        /// @brief Encodes cells and checks they decode back.
+        const auto round_trip = [](const std::vector<index>& cells)
+        {
+            std::vector<std::byte> data;
+            REQUIRE(codec::encode(cells, data) == error_t::none);
+            codec::view view;
+            REQUIRE(view.open(data) == error_t::none);
+            std::vector<index> decoded;
+            view.decode(decoded);
+            REQUIRE(decoded == cells);
+            for (std::size_t i {}; i != cells.size(); ++i)
+            {
+                REQUIRE(view.at(i) == cells[i]);
+                REQUIRE(view.contains(cells[i]));
+            }
+            REQUIRE(view.at(cells.size()) == index {0u});
+        };
+
+        // one cell, three consecutive siblings, then every cell of resolution 0
+        index cell;
+        REQUIRE(from_wgs(gis::wgs84::coordinate::from_degrees(37.77, -122.42), resolution_t::r9, cell) == error_t::none);
+        round_trip({cell});
+
+        std::vector<index> siblings;
+        cell::for_each_child(cell::parent(cell, resolution_t::r8), [&siblings](const index child) { siblings.push_back(child); });
+        siblings.resize(3u);
+        round_trip(siblings);
+
+        std::vector<index> bases;
+        for (std::uint64_t number {}; number != cell::base::count; ++number)
+            bases.push_back(cell::from_number(number, resolution_t::r0));
+        round_trip(bases);
+
+        // full blocks with gaps, then a last block of one cell
+        std::vector<index> cells;
+        cell::for_each_descendant(cell::parent(cell, resolution_t::r6), resolution_t::r9,
+                                  [&cells](const index child) { cells.push_back(child); });
+        cells.resize(2u * codec::block_size + 1u);
+        round_trip(cells);
+    }
+
+    TEST_CASE("codec - errors")
+    {
+        index a, b;
+        REQUIRE(from_wgs(gis::wgs84::coordinate::from_degrees(10.0, 10.0), resolution_t::r7, a) == error_t::none);
+        REQUIRE(from_wgs(gis::wgs84::coordinate::from_degrees(20.0, 20.0), resolution_t::r7, b) == error_t::none);
+        const auto [low, high] = std::minmax(a, b);
+
+        std::vector<std::byte> data;
+        REQUIRE(codec::encode(std::vector<index> {high, low}, data) == error_t::domain);
+        REQUIRE(codec::encode(std::vector<index> {low, low}, data) == error_t::domain);
+        REQUIRE(codec::encode(std::vector<index> {cell::parent(low, resolution_t::r6), high}, data) == error_t::res_mismatch);
+        REQUIRE(codec::encode(std::vector<index> {index {0u}}, data) == error_t::cell_invalid);
+        REQUIRE(data.empty());
+
+        REQUIRE(codec::encode(std::vector<index> {low, high}, data) == error_t::none);
+        codec::view view;
+        REQUIRE(view.open(std::span {data}.first(data.size() - 1u)) == error_t::domain);
+        data[0] ^= std::byte {1u};
+        REQUIRE(view.open(data) == error_t::domain);
+    }
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <iterator>
+#include <kmx/geohex/cap.hpp>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/compact.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <vector>
+
+namespace kmx::geohex
+{
+    /// @brief Gets the cells of a resolution in a compacted set, sorted.
+    static std::vector<index> expand(const std::vector<index>& cells, const resolution_t resolution)
+    {
+        std::vector<index> result;
+        for (const auto cell: cells)
+            cell::for_each_descendant(cell, resolution, [&result](const index descendant) { result.push_back(descendant); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    TEST_CASE("compact - set algebra")
+    {
+        // two overlapping caps, compacted
+        std::vector<index> a, b;
+        REQUIRE(cap::to_compact_cells({gis::wgs84::coordinate::from_degrees(37.77, -122.42), 3000.0}, resolution_t::r9, a) ==
+                error_t::none);
+        REQUIRE(cap::to_compact_cells({gis::wgs84::coordinate::from_degrees(37.78, -122.40), 2500.0}, resolution_t::r9, b) ==
+                error_t::none);
+        const auto a_cells = expand(a, resolution_t::r9);
+        const auto b_cells = expand(b, resolution_t::r9);
+
+        // the results cover the cells of the operation and are compacted
+        const auto check = [](const std::vector<index>& result, const std::vector<index>& expected)
+        {
+            REQUIRE(expand(result, resolution_t::r9) == expected);
+            std::vector<index> normalized;
+            REQUIRE(compact::normalize(result, normalized) == error_t::none);
+            REQUIRE(normalized == result);
+        };
+
+        std::vector<index> result, expected;
+        REQUIRE(compact::unite(a, b, result) == error_t::none);
+        std::set_union(a_cells.begin(), a_cells.end(), b_cells.begin(), b_cells.end(), std::back_inserter(expected));
+        check(result, expected);
+        const auto both = result;
+
+        expected.clear();
+        REQUIRE(compact::intersect(a, b, result) == error_t::none);
+        std::set_intersection(a_cells.begin(), a_cells.end(), b_cells.begin(), b_cells.end(), std::back_inserter(expected));
+        REQUIRE(!expected.empty());
+        check(result, expected);
+
+        expected.clear();
+        REQUIRE(compact::subtract(a, b, result) == error_t::none);
+        std::set_difference(a_cells.begin(), a_cells.end(), b_cells.begin(), b_cells.end(), std::back_inserter(expected));
+        check(result, expected);
+
+        bool covered {};
+        REQUIRE(compact::covers(both, a, covered) == error_t::none);
+        REQUIRE(covered);
+        REQUIRE(compact::covers(a, both, covered) == error_t::none);
+        REQUIRE(!covered);
+
+        // the children of a cell with one of its descendants compact to the cell
+        const auto parent = cell::parent(a_cells.front(), resolution_t::r6);
+        std::vector<index> children;
+        cell::for_each_child(parent, [&children](const index child) { children.push_back(child); });
+        children.push_back(cell::parent(a_cells.front(), resolution_t::r8));
+        REQUIRE(compact::normalize(children, result) == error_t::none);
+        REQUIRE(result == std::vector<index> {parent});
+
+        // uncompacted children cover their parent, as do those of a pentagon
+        REQUIRE(compact::covers(children, std::vector<index> {parent}, covered) == error_t::none);
+        REQUIRE(covered);
+        children.erase(children.begin());
+        REQUIRE(compact::covers(children, std::vector<index> {parent}, covered) == error_t::none);
+        REQUIRE(!covered);
+
+        const index pentagon {0x8009fffffffffffu};
+        children.clear();
+        cell::for_each_child(pentagon, [&children](const index child) { children.push_back(child); });
+        REQUIRE(children.size() == 6u);
+        REQUIRE(compact::covers(children, std::vector<index> {pentagon}, covered) == error_t::none);
+        REQUIRE(covered);
+
+        REQUIRE(compact::unite(a, std::vector<index> {index {0u}}, result) == error_t::cell_invalid);
+    }
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/coverer.hpp>
+#include <kmx/geohex/polygon/prepared.hpp>
+#include <kmx/geohex/polygon/vector_based.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace kmx::geohex
+{
+    // The San Francisco polygon of the H3 polygonToCells tests, in radians.
+    static const gis::wgs84::coordinate::vector bay {
+        {0.659966917655, -2.1364398519396},  {0.6595011102219, -2.1359434279405}, {0.6583348114025, -2.1354884206045},
+        {0.6581220034068, -2.1382437718946}, {0.6594479998527, -2.1384597563896}, {0.6599990002976, -2.1376771158464},
+    };
+
+    /// @brief Checks whether a cell or one of its ancestors is in sorted cells.
+    static bool is_covered(const std::vector<index>& cells, const index cell)
+    {
+        for (auto res = +cell.resolution() + 1u; res-- != 0u;)
+        {
+            index ancestor = cell;
+            ancestor.set_resolution(static_cast<resolution_t>(res));
+            for (auto digit = res; digit != index::digit_count(); ++digit)
+                ancestor.set_digit(static_cast<index::digit_index>(digit), +direction_t::invalid);
+
+            if (std::binary_search(cells.begin(), cells.end(), ancestor))
+                return true;
+        }
+
+        return false;
+    }
+
+    TEST_CASE("coverer - polygon")
+    {
+        const polygon::prepared polygon {bay};
+        std::vector<index> filled;
+        REQUIRE(polygon::vector_based::to_cells(polygon, resolution_t::r10, filled) == error_t::none);
+
+        std::vector<index> coarse, fine;
+        for (const auto max_cells: {std::size_t {20u}, std::size_t {500u}})
+        {
+            std::vector<index> cells;
+            REQUIRE(coverer::to_cells(polygon, resolution_t::r5, resolution_t::r10, max_cells, cells) == error_t::none);
+            REQUIRE(cells.size() <= max_cells);
+            REQUIRE(std::is_sorted(cells.begin(), cells.end()));
+            for (const auto cell: cells)
+                REQUIRE((+cell.resolution() >= +resolution_t::r5 && +cell.resolution() <= +resolution_t::r10));
+
+            // every cell of the polygon is under a cell of the cover, as is the cell of every point of it
+            for (const auto cell: filled)
+                REQUIRE(is_covered(cells, cell));
+
+            std::mt19937_64 random {7u};
+            std::uniform_real_distribution<double> latitude {0.6581, 0.6600}, longitude {-2.1385, -2.1354};
+            for (std::size_t i {}; i != 20000u; ++i)
+            {
+                const gis::wgs84::coordinate point {latitude(random), longitude(random)};
+                index cell;
+                if (polygon.contains(point) && (from_wgs(point, resolution_t::r10, cell) == error_t::none))
+                    REQUIRE(is_covered(cells, cell));
+            }
+
+            (max_cells == 20u ? coarse : fine) = std::move(cells);
+        }
+
+        // a larger budget covers less beyond the polygon
+        const auto area = [](const std::vector<index>& cells)
+        {
+            cell::children_count_t result {};
+            for (const auto cell: cells)
+                result += cell::children_count(cell, resolution_t::r10);
+            return result;
+        };
+        REQUIRE(fine.size() > coarse.size());
+        REQUIRE(area(fine) < area(coarse));
+        REQUIRE(area(fine) < 2u * filled.size());
+    }
+
+    TEST_CASE("coverer - cap")
+    {
+        const cap::item cap {gis::wgs84::coordinate::from_degrees(37.7749, -122.4194), 3000.0};
+        std::vector<index> filled;
+        REQUIRE(cap::to_cells(cap, resolution_t::r9, filled) == error_t::none);
+
+        std::vector<index> cells;
+        REQUIRE(coverer::to_cells(cap, resolution_t::r3, resolution_t::r9, 100u, cells) == error_t::none);
+        REQUIRE(cells.size() <= 100u);
+        for (const auto cell: filled)
+            REQUIRE(is_covered(cells, cell));
+
+        // the coarsest cells are kept beyond the budget
+        REQUIRE(coverer::to_cells(cap, resolution_t::r9, resolution_t::r9, 1u, cells) == error_t::none);
+        REQUIRE(cells.size() > filled.size());
+    }
+
+    TEST_CASE("coverer - errors")
+    {
+        std::vector<index> cells;
+        const polygon::prepared polygon {bay};
+        REQUIRE(coverer::to_cells(polygon, resolution_t::r6, resolution_t::r5, 10u, cells) == error_t::res_domain);
+        REQUIRE(coverer::to_cells(polygon, resolution_t::r5, static_cast<resolution_t>(16), 10u, cells) == error_t::res_domain);
+
+        const cap::item invalid {{std::numeric_limits<double>::quiet_NaN(), 0.0}, 10.0};
+        REQUIRE(coverer::to_cells(invalid, resolution_t::r5, resolution_t::r6, 10u, cells) == error_t::latlng_domain);
+        REQUIRE(coverer::to_cells(cap::item {{}, -1.0}, resolution_t::r5, resolution_t::r6, 10u, cells) == error_t::domain);
+    }
+}
@@ -0,0 +1,161 @@
+#include <catch2/catch_all.hpp>
+#include <array>
+#include <cmath>
+#include <kmx/geohex/directed_edge.hpp>
+#include <kmx/geohex/grid/neighbor.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+
+namespace kmx::geohex
+{
+    TEST_CASE("directed edge - of hexagon")
+    {
+        const index origin {0x85283473fffffffu};
+        std::array<index, directed_edge::max_count> buffer {};
+        std::span<index> edges {buffer};
+        REQUIRE(directed_edge::of(origin, edges) == error_t::none);
+        REQUIRE(edges.size() == 6u);
+
+        constexpr std::array<index::value_t, 6u> expected_destinations {
+            0x85283477fffffffu, 0x8528347bfffffffu, 0x85283463fffffffu,
+            0x8528340bfffffffu, 0x8528340ffffffffu, 0x85283447fffffffu,
+        };
+
+        for (std::size_t i {}; i != edges.size(); ++i)
+        {
+            const auto edge = edges[i];
+            REQUIRE(directed_edge::is_valid(edge));
+            REQUIRE(directed_edge::origin(edge) == origin);
+
+            index destination;
+            REQUIRE(directed_edge::destination(edge, destination) == error_t::none);
+            REQUIRE(destination.value() == expected_destinations[i]);
+            REQUIRE(grid::neighbor::check(destination, origin));
+
+            index created;
+            REQUIRE(directed_edge::create(origin, destination, created) == error_t::none);
+            REQUIRE(created == edge);
+        }
+
+        REQUIRE(edges.front().value() == 0x115283473fffffffu);
+    }
+
+    TEST_CASE("directed edge - of pentagon")
+    {
+        const index origin {0x8009fffffffffffu};
+        std::array<index, directed_edge::max_count> buffer {};
+        std::span<index> edges {buffer};
+        REQUIRE(directed_edge::of(origin, edges) == error_t::none);
+        REQUIRE(edges.size() == 5u);
+
+        for (const auto edge: edges)
+            REQUIRE(directed_edge::direction(edge) != direction_t::k_axes);
+
+        index deleted = edges.front();
+        deleted.set_mode_dependent(+direction_t::k_axes);
+        REQUIRE(!directed_edge::is_valid(deleted));
+    }
+
+    TEST_CASE("directed edge - batch of")
+    {
+        const std::array<index, 2u> cells {index {0x85283473fffffffu}, index {0x8009fffffffffffu}};
+        std::array<index, directed_edge::max_size(cells.size())> buffer {};
+        std::span<index> edges {buffer};
+        REQUIRE(directed_edge::of(cells, edges) == error_t::none);
+        REQUIRE(edges.size() == 11u);
+        REQUIRE(directed_edge::origin(edges[5u]) == cells[0u]);
+        REQUIRE(directed_edge::origin(edges[6u]) == cells[1u]);
+    }
+
+    TEST_CASE("directed edge - invalid")
+    {
+        const index cell {0x85283473fffffffu};
+        REQUIRE(!directed_edge::is_valid(cell));
+
+        index destination;
+        REQUIRE(directed_edge::destination(cell, destination) == error_t::dir_edge_invalid);
+
+        index edge;
+        REQUIRE(directed_edge::create(cell, index {0x85283408fffffffu}, edge) == error_t::not_neighbors);
+        REQUIRE(directed_edge::create(cell, index {0x8009fffffffffffu}, edge) == error_t::res_mismatch);
+    }
+
+    /// @brief An edge with its boundary and length, from the H3 library (in radians and kilometers; the earth radius differs
+    ///        slightly, so lengths in kilometers compare relatively).
+    struct edge_sample
+    {
+        index::value_t edge;
+        std::array<gis::wgs84::coordinate, directed_edge::max_boundary_count> vertices;
+        std::size_t vertex_count;
+        double length_rads;
+        double length_km;
+    };
+
+    static const std::array<edge_sample, 3u> edge_samples {{
+        // an edge of a hexagon
+        {0x115283473fffffffu,
+         {{{0.6531044519454293, -2.1299602868027208}, {0.6516632883200014, -2.130879969983952}}},
+         2u,
+         0.0016158726232537036,
+         10.294736086198919},
+        // an edge of the pentagon of base cell 4
+        {0x16009fffffffffffu,
+         {{{1.1012164353766924, -0.18229924845325554}, {0.9722665253630551, 0.09640581900153923}}},
+         2u,
+         0.19076599177033976,
+         1215.3715034438692},
+        // an edge of a Class III pentagon, with a vertex where it crosses an icosahedron edge
+        {0x161083ffffffffffu,
+         {{{1.105265725786294, 0.07003344631228497}, {1.0801989082144297, 0.15087012116893278}, {1.074084603142081, 0.19339400131474477}}},
+         3u,
+         0.06588809151467676,
+         419.7735041770192},
+    }};
+
+    TEST_CASE("directed edge - boundary and length")
+    {
+        constexpr double tolerance = 1e-9;
+        for (const auto& sample: edge_samples)
+        {
+            const index edge {sample.edge};
+            std::array<gis::wgs84::coordinate, directed_edge::max_boundary_count> buffer;
+            std::span<gis::wgs84::coordinate> vertices {buffer};
+            REQUIRE(directed_edge::boundary(edge, vertices) == error_t::none);
+            REQUIRE(vertices.size() == sample.vertex_count);
+            for (std::size_t i {}; i != vertices.size(); ++i)
+            {
+                REQUIRE(std::abs(vertices[i].latitude - sample.vertices[i].latitude) < tolerance);
+                REQUIRE(std::abs(vertices[i].longitude - sample.vertices[i].longitude) < tolerance);
+            }
+
+            double length {};
+            REQUIRE(directed_edge::length_rads(edge, length) == error_t::none);
+            REQUIRE(std::abs(length - sample.length_rads) < tolerance);
+            REQUIRE(directed_edge::length_km(edge, length) == error_t::none);
+            REQUIRE(std::abs(length / sample.length_km - 1.0) < 1e-6);
+            REQUIRE(directed_edge::length_m(edge, length) == error_t::none);
+            REQUIRE(std::abs(length / (1000.0 * sample.length_km) - 1.0) < 1e-6);
+        }
+
+        // the batch boundaries, from the first vertex to the last
+        std::array<index, edge_samples.size()> edges;
+        for (std::size_t i {}; i != edges.size(); ++i)
+            edges[i] = edge_samples[i].edge;
+
+        std::array<double, edges.size()> start_latitudes, start_longitudes, end_latitudes, end_longitudes;
+        directed_edge::boundary_columns columns {start_latitudes, start_longitudes, end_latitudes, end_longitudes};
+        REQUIRE(directed_edge::boundaries(edges, columns) == error_t::none);
+        REQUIRE(columns.start_latitudes.size() == edges.size());
+        for (std::size_t i {}; i != edges.size(); ++i)
+        {
+            const auto& sample = edge_samples[i];
+            const auto& last = sample.vertices[sample.vertex_count - 1u];
+            REQUIRE(std::abs(columns.start_latitudes[i] - sample.vertices[0].latitude) < tolerance);
+            REQUIRE(std::abs(columns.start_longitudes[i] - sample.vertices[0].longitude) < tolerance);
+            REQUIRE(std::abs(columns.end_latitudes[i] - last.latitude) < tolerance);
+            REQUIRE(std::abs(columns.end_longitudes[i] - last.longitude) < tolerance);
+        }
+
+        double length {};
+        REQUIRE(directed_edge::length_rads(index {0x85283473fffffffu}, length) == error_t::dir_edge_invalid);
+    }
+}
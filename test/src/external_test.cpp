@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <filesystem>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/external.hpp>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace kmx::geohex
+{
+    /// @brief Records on cells of resolution 8 in one cell of resolution 3, with repeats, in random order.
+    static std::vector<std::pair<index, std::uint64_t>> random_records(const std::size_t count)
+    {
+        std::mt19937_64 random {3u};
+        std::vector<index> cells;
+        cell::for_each_descendant(index {0x832830fffffffffu}, resolution_t::r8, [&cells](const index cell) { cells.push_back(cell); });
+        std::vector<std::pair<index, std::uint64_t>> records;
+        for (std::size_t i {}; i != count; ++i)
+            records.emplace_back(cells[random() % cells.size()], random() % 1000u);
+        return records;
+    }
+
+    /// @brief Counts the run files left in a directory.
+    static std::size_t run_files(const std::filesystem::path& directory)
+    {
+        return static_cast<std::size_t>(std::count_if(std::filesystem::directory_iterator {directory}, {},
+                                                      [](const auto& entry) { return entry.path().extension() == ".run"; }));
+    }
+
+    TEST_CASE("external - sort")
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "geohex-external-test";
+        std::filesystem::create_directories(directory);
+        const auto records = random_records(300000u);
+        {
+            // 64 KiB per run: more runs than one merge takes
+            external::sorter sorter {directory, 0u};
+            for (const auto& [cell, payload]: records)
+                REQUIRE(sorter.add(cell, payload) == error_t::none);
+            REQUIRE(sorter.finish() == error_t::none);
+            REQUIRE(sorter.run_count() > 128u);
+
+            // a stable sort: equal cells in the order they were added
+            auto expected = records;
+            std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            index cell;
+            std::uint64_t payload;
+            for (const auto& item: expected)
+            {
+                REQUIRE(sorter.next(cell, payload));
+                REQUIRE(cell == item.first);
+                REQUIRE(payload == item.second);
+            }
+            REQUIRE(!sorter.next(cell, payload));
+            REQUIRE(sorter.error() == error_t::none);
+        }
+        REQUIRE(run_files(directory) == 0u);
+
+        for (const auto mode: {external::duplicates::first, external::duplicates::sum, external::duplicates::max})
+        {
+            std::map<index, std::uint64_t> expected;
+            for (const auto& [cell, payload]: records)
+            {
+                const auto [found, added] = expected.emplace(cell, payload);
+                if (!added)
+                    found->second = mode == external::duplicates::sum   ? found->second + payload
+                                    : mode == external::duplicates::max ? std::max(found->second, payload)
+                                                                        : found->second;
+            }
+
+            external::sorter sorter {directory, 1u << 20u, mode};
+            for (const auto& [cell, payload]: records)
+                REQUIRE(sorter.add(cell, payload) == error_t::none);
+            REQUIRE(sorter.finish() == error_t::none);
+
+            index cell;
+            std::uint64_t payload;
+            for (const auto& item: expected)
+            {
+                REQUIRE(sorter.next(cell, payload));
+                REQUIRE(cell == item.first);
+                REQUIRE(payload == item.second);
+            }
+            REQUIRE(!sorter.next(cell, payload));
+        }
+
+        // records that fit in memory are not spilled
+        external::sorter sorter {directory, 1u << 20u};
+        REQUIRE(sorter.add(index {0x832830fffffffffu}, 1u) == error_t::none);
+        REQUIRE(sorter.finish() == error_t::none);
+        REQUIRE(sorter.run_count() == 0u);
+        REQUIRE(sorter.finish() == error_t::failed);
+        REQUIRE(sorter.add(index {0x832830fffffffffu}, 1u) == error_t::failed);
+        std::filesystem::remove_all(directory);
+    }
+}
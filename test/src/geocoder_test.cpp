@@ -0,0 +1,116 @@
+#include <catch2/catch_all.hpp>
+#include <kmx/geohex/geocoder.hpp>
+#include <kmx/geohex/polygon/prepared.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace kmx::geohex
+{
+    /// @brief A layer of 4 by 4 squares of a tenth of a degree around San Francisco, the first with a hole.
+    struct square_layer
+    {
+        square_layer()
+        {
+            for (std::size_t i {}; i != 16u; ++i)
+            {
+                const double south = 37.6 + 0.1 * static_cast<double>(i / 4u);
+                const double west = -122.6 + 0.1 * static_cast<double>(i % 4u);
+                add_ring(south, west, 0.1);
+                if (i == 0u)
+                    add_ring(south + 0.03, west + 0.03, 0.04);
+                polygon_offsets.push_back(ring_offsets.size() - 1u);
+            }
+        }
+
+        void add_ring(const double south, const double west, const double size)
+        {
+            coordinates.push_back(gis::wgs84::coordinate::from_degrees(south, west));
+            coordinates.push_back(gis::wgs84::coordinate::from_degrees(south, west + size));
+            coordinates.push_back(gis::wgs84::coordinate::from_degrees(south + size, west + size));
+            coordinates.push_back(gis::wgs84::coordinate::from_degrees(south + size, west));
+            ring_offsets.push_back(coordinates.size());
+        }
+
+        polygon::batch::polygons polygons() const noexcept { return {coordinates, ring_offsets, polygon_offsets}; }
+
+        std::vector<gis::wgs84::coordinate> coordinates;
+        std::vector<std::size_t> ring_offsets {0u};
+        std::vector<std::size_t> polygon_offsets {0u};
+    };
+
+    TEST_CASE("geocoder - find")
+    {
+        const square_layer layer;
+        geocoder::store store;
+        REQUIRE(store.build(layer.polygons(), resolution_t::r7) == error_t::none);
+        REQUIRE(store.polygon_count() == 16u);
+        REQUIRE(store.cell_count() > 0u);
+
+        std::vector<polygon::prepared> polygons;
+        for (std::size_t i {}; i != 16u; ++i)
+        {
+            const auto ring = [&layer](const std::size_t r)
+            { return std::span {layer.coordinates}.subspan(layer.ring_offsets[r], layer.ring_offsets[r + 1u] - layer.ring_offsets[r]); };
+            std::vector<polygon::span_based::item> holes;
+            for (auto r = layer.polygon_offsets[i] + 1u; r < layer.polygon_offsets[i + 1u]; ++r)
+                holes.push_back(ring(r));
+            polygons.emplace_back(ring(layer.polygon_offsets[i]), holes);
+        }
+
+        std::vector<std::byte> data;
+        store.save(data);
+        geocoder::store loaded;
+        std::span<const std::byte> saved {data};
+        REQUIRE(loaded.load(saved) == error_t::none);
+        REQUIRE(saved.empty());
+        REQUIRE(loaded.cell_count() == store.cell_count());
+
+        // random points in and around the squares, against a test of every polygon
+        std::mt19937_64 random {7u};
+        std::uniform_real_distribution<double> latitude {37.55, 38.05}, longitude {-122.65, -122.15};
+        for (std::size_t i {}; i != 5000u; ++i)
+        {
+            const auto point = gis::wgs84::coordinate::from_degrees(latitude(random), longitude(random));
+            auto expected = geocoder::store::none;
+            for (std::size_t j {}; (j != polygons.size()) && (expected == geocoder::store::none); ++j)
+                if (polygons[j].contains(point))
+                    expected = static_cast<geocoder::store::id_t>(j);
+
+            REQUIRE(store.find(point) == expected);
+            REQUIRE(loaded.find(point) == expected);
+        }
+
+        REQUIRE(store.find({std::numeric_limits<double>::quiet_NaN(), 0.0}) == geocoder::store::none);
+    }
+
+    TEST_CASE("geocoder - errors")
+    {
+        square_layer layer;
+        geocoder::store store;
+        REQUIRE(store.build(layer.polygons(), static_cast<resolution_t>(16)) == error_t::res_domain);
+
+        auto polygons = layer.polygons();
+        const std::vector<std::size_t> offsets {0u, 3u};
+        polygons.polygon_offsets = offsets;
+        REQUIRE(store.build(polygons, resolution_t::r5) == error_t::domain);
+
+        layer.coordinates[5].latitude = std::numeric_limits<double>::quiet_NaN();
+        REQUIRE(store.build(layer.polygons(), resolution_t::r5) == error_t::latlng_domain);
+
+        // truncated data, another magic
+        layer.coordinates[5].latitude = layer.coordinates[4].latitude;
+        REQUIRE(store.build(layer.polygons(), resolution_t::r5) == error_t::none);
+        std::vector<std::byte> data;
+        store.save(data);
+        std::span<const std::byte> truncated {data.data(), data.size() - 1u};
+        REQUIRE(store.load(truncated) == error_t::domain);
+        REQUIRE(truncated.size() == data.size() - 1u);
+
+        data[0] ^= std::byte {1u};
+        std::span<const std::byte> other {data};
+        REQUIRE(store.load(other) == error_t::domain);
+        REQUIRE(store.polygon_count() == 16u);
+    }
+}
@@ -0,0 +1,167 @@
+#include <catch2/catch_all.hpp>
+#include <bit>
+#include <cstring>
+#include <kmx/geohex/geometry/reader.hpp>
+#include <kmx/geohex/util.hpp>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace kmx::geohex
+{
+    // The San Francisco polygon of the H3 polygonToCells tests, with its hole, as X (longitude) and Y (latitude) in
+    // radians; the rings repeat their first vertex.
+    static constexpr std::string_view san_francisco_wkt =
+        "POLYGON ((-2.1364398519396 0.659966917655, -2.1359434279405 0.6595011102219, -2.1354884206045 0.6583348114025, "
+        "-2.1382437718946 0.6581220034068, -2.1384597563896 0.6594479998527, -2.1376771158464 0.6599990002976, "
+        "-2.1364398519396 0.659966917655), "
+        "(-2.1371053983433 0.6595072188743, -2.1373141048153 0.6591482046471, -2.1365222838402 0.6592295020837, "
+        "-2.1371053983433 0.6595072188743))";
+
+    /// @brief Writes WKB values in a byte order.
+    class wkb_writer
+    {
+    public:
+        explicit wkb_writer(const bool little) noexcept: little_ {little} {}
+
+        void header(const std::uint32_t type)
+        {
+            bytes.push_back(std::byte {little_});
+            put(type);
+        }
+
+        void put(const std::uint32_t value) { put_bits(value); }
+
+        void put(const double value) { put_bits(std::bit_cast<std::uint64_t>(value)); }
+
+        std::vector<std::byte> bytes;
+
+    private:
+        template <typename T>
+        void put_bits(T bits)
+        {
+            if (little_ != (std::endian::native == std::endian::little))
+                bits = std::byteswap(bits);
+            const auto size = bytes.size();
+            bytes.resize(size + sizeof(T));
+            std::memcpy(bytes.data() + size, &bits, sizeof(T));
+        }
+
+        const bool little_;
+    };
+
+    TEST_CASE("geometry - read wkt")
+    {
+        geometry::item item;
+        auto text = san_francisco_wkt;
+        REQUIRE(geometry::read_wkt(text, geometry::unit_t::radians, item) == error_t::none);
+        REQUIRE(text.empty());
+        REQUIRE(item.type == geometry::type_t::polygon);
+        REQUIRE(item.size() == 1u);
+        REQUIRE(item.ring(0u).size() == 6u);
+        REQUIRE(item.ring(1u).size() == 3u);
+
+        polygon::batch::cells cells;
+        REQUIRE(polygon::batch::to_cells(item.polygons(), resolution_t::r9, cells) == error_t::none);
+        REQUIRE(cells.items.size() == 1214u);
+
+        // a stream of geometries in degrees, with Z values, empty parts and bare multi points
+        std::string_view stream = "point z (10 20 30) MultiPoint (1 2, EMPTY, (3 4)) SRID=4326;LINESTRING EMPTY "
+                                  "MULTIPOLYGON (((0 0, 1 0, 1 1, 0 0)), EMPTY, ((5 5, 6 5, 6 6, 5 5), (5.1 5.1, 5.2 5.1, 5.2 5.2)))";
+        REQUIRE(geometry::read_wkt(stream, geometry::unit_t::degrees, item) == error_t::none);
+        REQUIRE(item.type == geometry::type_t::point);
+        REQUIRE(item.coordinates.size() == 1u);
+        REQUIRE(item.coordinates[0].latitude == degree::to_radian(20.0));
+        REQUIRE(item.coordinates[0].longitude == degree::to_radian(10.0));
+
+        REQUIRE(geometry::read_wkt(stream, geometry::unit_t::degrees, item) == error_t::none);
+        REQUIRE(item.type == geometry::type_t::multi_point);
+        REQUIRE(item.size() == 2u);
+
+        REQUIRE(geometry::read_wkt(stream, geometry::unit_t::degrees, item) == error_t::none);
+        REQUIRE(item.type == geometry::type_t::line_string);
+        REQUIRE(item.size() == 0u);
+
+        REQUIRE(geometry::read_wkt(stream, geometry::unit_t::degrees, item) == error_t::none);
+        REQUIRE(item.type == geometry::type_t::multi_polygon);
+        REQUIRE(item.size() == 2u);
+        REQUIRE(item.part_offsets == std::vector<std::size_t> {0u, 1u, 3u});
+        REQUIRE(item.ring(2u).size() == 3u);
+        REQUIRE(stream.empty());
+
+        for (const auto invalid: {"POLYGON ((0 0, 1 0, 1 1)", "CIRCLE (0 0)", "POINT (1)", "LINESTRING (0 0, 1 x)"})
+        {
+            std::string_view bad = invalid;
+            REQUIRE(geometry::read_wkt(bad, geometry::unit_t::degrees, item) == error_t::domain);
+            REQUIRE(bad == invalid);
+        }
+    }
+
+    TEST_CASE("geometry - read wkb")
+    {
+        // a multi polygon of two squares, the second with Z values and a hole, then a point, in both byte orders
+        for (const bool little: {true, false})
+        {
+            wkb_writer writer {little};
+            writer.header(6u);
+            writer.put(2u);
+
+            using points = std::vector<std::pair<double, double>>;
+            const auto put_ring = [&writer](const points& ring, const bool z)
+            {
+                writer.put(static_cast<std::uint32_t>(ring.size()));
+                for (const auto& [x, y]: ring)
+                {
+                    writer.put(x);
+                    writer.put(y);
+                    if (z)
+                        writer.put(100.0);
+                }
+            };
+
+            writer.header(3u);
+            writer.put(1u);
+            put_ring({{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}, {0.0, 0.0}}, false);
+
+            writer.header(1003u);
+            writer.put(2u);
+            put_ring({{5.0, 5.0}, {7.0, 5.0}, {5.0, 7.0}, {5.0, 5.0}}, true);
+            put_ring({{5.2, 5.2}, {5.5, 5.2}, {5.2, 5.5}, {5.2, 5.2}}, true);
+
+            writer.header(0x20000001u);
+            writer.put(4326u);
+            writer.put(-122.0);
+            writer.put(37.0);
+
+            std::span<const std::byte> data {writer.bytes};
+            geometry::item item;
+            REQUIRE(geometry::read_wkb(data, geometry::unit_t::degrees, item) == error_t::none);
+            REQUIRE(item.type == geometry::type_t::multi_polygon);
+            REQUIRE(item.size() == 2u);
+            REQUIRE(item.ring_offsets == std::vector<std::size_t> {0u, 4u, 7u, 10u});
+            REQUIRE(item.ring(1u)[1u].longitude == degree::to_radian(7.0));
+            REQUIRE(item.ring(1u)[1u].latitude == degree::to_radian(5.0));
+
+            polygon::batch::cells cells;
+            REQUIRE(polygon::batch::to_cells(item.polygons(), resolution_t::r5, cells) == error_t::none);
+            REQUIRE(cells.offsets.size() == 3u);
+
+            REQUIRE(geometry::read_wkb(data, geometry::unit_t::degrees, item) == error_t::none);
+            REQUIRE(item.type == geometry::type_t::point);
+            REQUIRE(item.coordinates.size() == 1u);
+            REQUIRE(item.coordinates[0].latitude == degree::to_radian(37.0));
+            REQUIRE(data.empty());
+
+            // truncated data, an unsupported type
+            std::span<const std::byte> truncated {writer.bytes.data(), 40u};
+            REQUIRE(geometry::read_wkb(truncated, geometry::unit_t::degrees, item) == error_t::domain);
+            REQUIRE(truncated.size() == 40u);
+
+            wkb_writer collection {little};
+            collection.header(7u);
+            collection.put(0u);
+            std::span<const std::byte> unsupported {collection.bytes};
+            REQUIRE(geometry::read_wkb(unsupported, geometry::unit_t::degrees, item) == error_t::domain);
+        }
+    }
+}
@@ -2,6 +2,8 @@
 #include <catch2/catch_all.hpp>
 #include <kmx/geohex/cell/base.hpp>
 #include <kmx/geohex/index.hpp>
+#include <kmx/gis/wgs84/view.hpp>
+#include <vector>
 
 namespace kmx::geohex
 {
@@ -115,4 +117,27 @@ namespace kmx::geohex
             REQUIRE(a.base_cell() == i);
         }
     }
+
+    TEST_CASE("index - from wgs through an accessor")
+    {
+        // records of an identifier, a longitude and a latitude in degrees, as float
+        const std::vector<float> records {1.0f, -122.42f, 37.77f, 2.0f, 2.35f, 48.86f, 3.0f, 151.21f, -33.87f};
+        const gis::wgs84::strided_view<float, gis::wgs84::degrees> points {&records[2], &records[1], 3u, 3u};
+
+        std::vector<index> buffer(4u);
+        std::span<index> cells {buffer};
+        REQUIRE(from_wgs(points, resolution_t::r9, cells) == error_t::none);
+        REQUIRE(cells.size() == 3u);
+        for (std::size_t i {}; i != points.size(); ++i)
+        {
+            const auto coord = gis::wgs84::coordinate::from_degrees(records[3u * i + 2u], records[3u * i + 1u]);
+            index expected;
+            REQUIRE(from_wgs(coord, resolution_t::r9, expected) == error_t::none);
+            REQUIRE(cells[i] == expected);
+        }
+
+        std::span<index> small {buffer.data(), 2u};
+        REQUIRE(from_wgs(points, resolution_t::r9, small) == error_t::memory_bounds);
+        REQUIRE(small.empty());
+    }
 }
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/join.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace kmx::geohex
+{
+    TEST_CASE("join - points")
+    {
+        // points around San Francisco against overlapping cells of resolutions 3 to 9 around some of them
+        std::mt19937_64 random {9u};
+        std::normal_distribution<double> offset {0.0, 0.01};
+        const auto center = gis::wgs84::coordinate::from_degrees(37.77, -122.42);
+        std::vector<gis::wgs84::coordinate> points;
+        for (std::size_t i {}; i != 50000u; ++i)
+            points.push_back({center.latitude + offset(random), center.longitude + offset(random)});
+
+        std::vector<index> layer;
+        std::vector<join::id_t> ids;
+        for (std::size_t i {}; i != 200u; ++i)
+        {
+            index cell;
+            REQUIRE(from_wgs(points[random() % points.size()], resolution_t::r9, cell) == error_t::none);
+            layer.push_back(cell::parent(cell, static_cast<resolution_t>(3u + random() % 7u)));
+            ids.push_back(static_cast<join::id_t>(i % 50u));
+        }
+
+        std::vector<join::match> matches;
+        REQUIRE(join::points(points, layer, ids, matches) == error_t::none);
+
+        // every point against every layer cell
+        std::vector<std::pair<std::uint64_t, join::id_t>> expected;
+        for (std::size_t i {}; i != points.size(); ++i)
+        {
+            index cell;
+            REQUIRE(from_wgs(points[i], resolution_t::r9, cell) == error_t::none);
+            for (std::size_t j {}; j != layer.size(); ++j)
+                if (cell::parent(cell, layer[j].resolution()) == layer[j])
+                    expected.emplace_back(i, ids[j]);
+        }
+
+        std::vector<std::pair<std::uint64_t, join::id_t>> found;
+        for (const auto& item: matches)
+            found.emplace_back(item.point, item.id);
+        std::sort(expected.begin(), expected.end());
+        std::sort(found.begin(), found.end());
+        REQUIRE(!expected.empty());
+        REQUIRE(found == expected);
+
+        // layer cells finer than the points match none
+        std::vector<index> cells;
+        for (std::size_t i {}; i != 100u; ++i)
+        {
+            index cell;
+            REQUIRE(from_wgs(points[i], resolution_t::r4, cell) == error_t::none);
+            cells.push_back(cell);
+        }
+        REQUIRE(join::cells(cells, layer, ids, matches) == error_t::none);
+        expected.clear();
+        for (std::size_t i {}; i != cells.size(); ++i)
+            for (std::size_t j {}; j != layer.size(); ++j)
+                if ((+layer[j].resolution() <= 4u) && (cell::parent(cells[i], layer[j].resolution()) == layer[j]))
+                    expected.emplace_back(i, ids[j]);
+
+        found.clear();
+        for (const auto& item: matches)
+            found.emplace_back(item.point, item.id);
+        std::sort(expected.begin(), expected.end());
+        std::sort(found.begin(), found.end());
+        REQUIRE(found == expected);
+
+        cells.push_back(cell::parent(cells[0], resolution_t::r3));
+        REQUIRE(join::cells(cells, layer, ids, matches) == error_t::res_mismatch);
+        REQUIRE(join::points(points, layer, std::span<const join::id_t> {ids}.first(1u), matches) == error_t::domain);
+    }
+}
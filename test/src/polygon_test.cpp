@@ -0,0 +1,404 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <array>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/directed_edge.hpp>
+#include <kmx/geohex/polygon/batch.hpp>
+#include <kmx/geohex/polygon/prepared.hpp>
+#include <kmx/geohex/polygon/span_based.hpp>
+#include <kmx/geohex/polygon/vector_based.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <kmx/gis/wgs84/view.hpp>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+namespace kmx::geohex
+{
+    // The polygons of the H3 polygonToCells tests, in radians.
+    static const gis::wgs84::coordinate::vector san_francisco {
+        {0.659966917655, -2.1364398519396},  {0.6595011102219, -2.1359434279405}, {0.6583348114025, -2.1354884206045},
+        {0.6581220034068, -2.1382437718946}, {0.6594479998527, -2.1384597563896}, {0.6599990002976, -2.1376771158464},
+    };
+
+    static const gis::wgs84::coordinate::vector san_francisco_hole {
+        {0.6595072188743, -2.1371053983433},
+        {0.6591482046471, -2.1373141048153},
+        {0.6592295020837, -2.1365222838402},
+    };
+
+    static void require_unique_cells(std::vector<index> cells, const resolution_t res)
+    {
+        for (const auto cell: cells)
+        {
+            REQUIRE(cell.is_valid());
+            REQUIRE(cell.resolution() == res);
+        }
+
+        std::sort(cells.begin(), cells.end());
+        REQUIRE(std::adjacent_find(cells.begin(), cells.end()) == cells.end());
+    }
+
+    TEST_CASE("polygon - to cells")
+    {
+        std::vector<index> cells;
+        REQUIRE(polygon::vector_based::to_cells(san_francisco, resolution_t::r9, cells) == error_t::none);
+        REQUIRE(cells.size() == 1253u);
+        REQUIRE(cells.size() <= polygon::span_based::max_size(san_francisco, resolution_t::r9));
+        require_unique_cells(cells, resolution_t::r9);
+
+        // the cell of a point well inside the polygon is covered
+        index center_cell;
+        const auto center = gis::wgs84::coordinate {0.6591, -2.1370};
+        REQUIRE(from_wgs(center, resolution_t::r9, center_cell) == error_t::none);
+        REQUIRE(std::find(cells.begin(), cells.end(), center_cell) != cells.end());
+    }
+
+    TEST_CASE("polygon - to cells with hole")
+    {
+        std::vector<index> cells;
+        REQUIRE(polygon::vector_based::to_cells(san_francisco, {san_francisco_hole}, resolution_t::r9, cells) == error_t::none);
+        REQUIRE(cells.size() == 1214u);
+        require_unique_cells(cells, resolution_t::r9);
+    }
+
+    TEST_CASE("polygon - to cells across the antimeridian")
+    {
+        const auto pi = std::numbers::pi_v<double>;
+        const gis::wgs84::coordinate::vector box {{0.01, -pi + 0.01}, {0.01, pi - 0.01}, {-0.01, pi - 0.01}, {-0.01, -pi + 0.01}};
+
+        std::vector<index> cells;
+        REQUIRE(polygon::vector_based::to_cells(box, resolution_t::r7, cells) == error_t::none);
+        REQUIRE(cells.size() == 4238u);
+        require_unique_cells(cells, resolution_t::r7);
+    }
+
+    TEST_CASE("polygon - to cells around a pentagon")
+    {
+        const gis::wgs84::coordinate::vector box {
+            gis::wgs84::coordinate::from_degrees(63.7, 8.536),
+            gis::wgs84::coordinate::from_degrees(63.7, 12.536),
+            gis::wgs84::coordinate::from_degrees(65.7, 12.536),
+            gis::wgs84::coordinate::from_degrees(65.7, 8.536),
+        };
+
+        std::vector<index> cells;
+        REQUIRE(polygon::vector_based::to_cells(box, resolution_t::r5, cells) == error_t::none);
+        REQUIRE(cells.size() == 267u);
+        REQUIRE(std::find(cells.begin(), cells.end(), index {0x85080003fffffffu}) != cells.end());
+        require_unique_cells(cells, resolution_t::r5);
+    }
+
+    static cell::children_count_t expanded_count(const std::vector<index>& cells, const resolution_t res)
+    {
+        cell::children_count_t result {};
+        for (const auto item: cells)
+            result += cell::children_count(item, res);
+        return result;
+    }
+
+    TEST_CASE("polygon - to compact cells")
+    {
+        std::vector<index> cells;
+        REQUIRE(polygon::vector_based::to_compact_cells(san_francisco, resolution_t::r9, cells) == error_t::none);
+        REQUIRE(cells.size() == 209u);
+        REQUIRE(expanded_count(cells, resolution_t::r9) == 1253u);
+
+        REQUIRE(polygon::vector_based::to_compact_cells(san_francisco, resolution_t::r11, cells) == error_t::none);
+        REQUIRE(cells.size() == 1593u);
+        REQUIRE(expanded_count(cells, resolution_t::r11) == 61569u);
+
+        std::vector<index> with_hole;
+        REQUIRE(polygon::vector_based::to_compact_cells(san_francisco, {san_francisco_hole}, resolution_t::r9, with_hole) == error_t::none);
+        REQUIRE(expanded_count(with_hole, resolution_t::r9) == 1214u);
+    }
+
+    TEST_CASE("polygon - to compact cells errors")
+    {
+        std::array<index, 4u> buffer {};
+        std::span<index> cells {buffer};
+        REQUIRE(polygon::span_based::to_compact_cells(san_francisco, resolution_t::r9, cells) == error_t::memory_bounds);
+        REQUIRE(cells.empty());
+        REQUIRE(polygon::span_based::to_compact_cells(san_francisco, static_cast<resolution_t>(16), cells) == error_t::res_domain);
+    }
+
+    TEST_CASE("polygon - to cells errors")
+    {
+        std::array<index, 4u> buffer {};
+        std::span<index> cells {buffer};
+        REQUIRE(polygon::span_based::to_cells(san_francisco, resolution_t::r9, cells) == error_t::memory_bounds);
+        REQUIRE(cells.empty());
+
+        cells = buffer;
+        REQUIRE(polygon::span_based::to_cells(std::span {san_francisco}.first(2u), resolution_t::r9, cells) == error_t::none);
+        REQUIRE(cells.empty());
+
+        const gis::wgs84::coordinate::vector invalid {{0.0, 0.0}, {0.1, std::numeric_limits<double>::quiet_NaN()}, {0.1, 0.1}};
+        cells = buffer;
+        REQUIRE(polygon::span_based::to_cells(invalid, resolution_t::r9, cells) == error_t::latlng_domain);
+        REQUIRE(polygon::span_based::to_cells(san_francisco, static_cast<resolution_t>(16), cells) == error_t::res_domain);
+        REQUIRE(polygon::span_based::max_size(san_francisco, static_cast<resolution_t>(16)) == 0u);
+    }
+
+    TEST_CASE("polygon - prepared")
+    {
+        const std::array<polygon::span_based::item, 1u> holes {san_francisco_hole};
+        const polygon::prepared prepared {san_francisco, holes};
+        REQUIRE(prepared.is_finite());
+        REQUIRE(prepared.ring_count() == 2u);
+        REQUIRE(prepared.vertex_count() == 9u);
+
+        REQUIRE(prepared.contains({0.6591, -2.1370}));
+        REQUIRE(!prepared.contains({0.6593, -2.1370}));
+        REQUIRE(!prepared.contains({0.0, 0.0}));
+        REQUIRE(prepared.crosses(san_francisco[0], 1e-6));
+        REQUIRE(!prepared.crosses({0.6589, -2.1378}, 1e-6));
+
+        std::vector<index> cells;
+        REQUIRE(polygon::vector_based::to_cells(prepared, resolution_t::r9, cells) == error_t::none);
+        REQUIRE(cells.size() == 1214u);
+        require_unique_cells(cells, resolution_t::r9);
+
+        std::vector<index> compact;
+        REQUIRE(polygon::vector_based::to_compact_cells(prepared, resolution_t::r9, compact) == error_t::none);
+        REQUIRE(expanded_count(compact, resolution_t::r9) == 1214u);
+
+        const gis::wgs84::coordinate::vector invalid {{0.0, 0.0}, {0.1, std::numeric_limits<double>::quiet_NaN()}, {0.1, 0.1}};
+        const polygon::prepared invalid_prepared {invalid};
+        REQUIRE(!invalid_prepared.is_finite());
+        REQUIRE(polygon::vector_based::to_cells(invalid_prepared, resolution_t::r9, cells) == error_t::latlng_domain);
+    }
+
+    TEST_CASE("polygon - prepared through accessors")
+    {
+        std::vector<index> expected;
+        REQUIRE(polygon::vector_based::to_cells(san_francisco, {san_francisco_hole}, resolution_t::r9, expected) == error_t::none);
+
+        // separate latitude and longitude columns, in radians
+        std::vector<double> columns;
+        for (const auto& ring: {san_francisco, san_francisco_hole})
+            for (const auto& coord: ring)
+                columns.push_back(coord.latitude);
+        for (const auto& ring: {san_francisco, san_francisco_hole})
+            for (const auto& coord: ring)
+                columns.push_back(coord.longitude);
+
+        const auto count = san_francisco.size() + san_francisco_hole.size();
+        using radian_view = gis::wgs84::strided_view<double>;
+        const radian_view all {columns.data(), columns.data() + count, count};
+        const auto outer = all.subview(0u, san_francisco.size());
+        const std::array<radian_view, 1u> holes {all.subview(san_francisco.size(), san_francisco_hole.size())};
+
+        polygon::prepared prepared {outer, std::span<const radian_view> {holes}};
+        REQUIRE(prepared.vertex_count() == count);
+        std::vector<index> cells;
+        REQUIRE(polygon::vector_based::to_cells(prepared, resolution_t::r9, cells) == error_t::none);
+        REQUIRE(cells == expected);
+
+        // interleaved longitudes and latitudes, in degrees
+        std::vector<double> interleaved;
+        for (const auto& coord: san_francisco)
+            interleaved.insert(interleaved.end(), {radians_to_degrees(coord.longitude), radians_to_degrees(coord.latitude)});
+
+        using degree_view = gis::wgs84::strided_view<double, gis::wgs84::degrees>;
+        prepared.assign(degree_view::longitude_latitude(interleaved.data(), san_francisco.size()));
+        REQUIRE(polygon::vector_based::to_cells(prepared, resolution_t::r9, cells) == error_t::none);
+        REQUIRE(cells.size() == 1253u);
+    }
+
+    TEST_CASE("polygon - batch")
+    {
+        // small squares around San Francisco, every third with a hole, then San Francisco with its hole
+        gis::wgs84::coordinate::vector coordinates;
+        std::vector<std::size_t> ring_offsets {0u};
+        std::vector<std::size_t> polygon_offsets {0u};
+        const auto add_square = [&](const double latitude, const double longitude, const double half)
+        {
+            coordinates.insert(coordinates.end(), {{latitude - half, longitude - half},
+                                                   {latitude - half, longitude + half},
+                                                   {latitude + half, longitude + half},
+                                                   {latitude + half, longitude - half}});
+            ring_offsets.push_back(coordinates.size());
+        };
+
+        for (std::size_t i {}; i != 300u; ++i)
+        {
+            add_square(0.6580 + 1e-5 * static_cast<double>(i), -2.1380 + 1e-5 * static_cast<double>(i % 17u), 2e-5);
+            if ((i % 3u) == 0u)
+                add_square(0.6580 + 1e-5 * static_cast<double>(i), -2.1380 + 1e-5 * static_cast<double>(i % 17u), 1e-5);
+            polygon_offsets.push_back(ring_offsets.size() - 1u);
+        }
+
+        coordinates.insert(coordinates.end(), san_francisco.begin(), san_francisco.end());
+        ring_offsets.push_back(coordinates.size());
+        coordinates.insert(coordinates.end(), san_francisco_hole.begin(), san_francisco_hole.end());
+        ring_offsets.push_back(coordinates.size());
+        polygon_offsets.push_back(ring_offsets.size() - 1u);
+
+        const polygon::batch::polygons polygons {coordinates, ring_offsets, polygon_offsets};
+        polygon::batch::cells cells;
+        REQUIRE(polygon::batch::to_cells(polygons, resolution_t::r12, cells) == error_t::none);
+        REQUIRE(cells.offsets.size() == polygons.size() + 1u);
+        REQUIRE(cells.offsets.back() == cells.items.size());
+
+        std::vector<index> expected;
+        for (std::size_t i {}; i != polygons.size(); ++i)
+        {
+            const auto first = ring_offsets[polygon_offsets[i]];
+            const auto ring = std::span {coordinates}.subspan(first, ring_offsets[polygon_offsets[i] + 1u] - first);
+            std::vector<polygon::span_based::item> holes;
+            for (auto hole = polygon_offsets[i] + 1u; hole != polygon_offsets[i + 1u]; ++hole)
+                holes.push_back(std::span {coordinates}.subspan(ring_offsets[hole], ring_offsets[hole + 1u] - ring_offsets[hole]));
+
+            const polygon::prepared prepared {ring, holes};
+            REQUIRE(polygon::vector_based::to_cells(prepared, resolution_t::r12, expected) == error_t::none);
+            const auto actual = cells.of(i);
+            REQUIRE(std::equal(actual.begin(), actual.end(), expected.begin(), expected.end()));
+        }
+
+        // offsets that do not cover the rings, a polygon without rings
+        const std::array<std::size_t, 2u> short_offsets {0u, 1u};
+        REQUIRE(polygon::batch::to_cells({coordinates, ring_offsets, short_offsets}, resolution_t::r12, cells) == error_t::domain);
+        const std::array<std::size_t, 3u> empty_polygon {0u, 0u, ring_offsets.size() - 1u};
+        REQUIRE(polygon::batch::to_cells({coordinates, ring_offsets, empty_polygon}, resolution_t::r12, cells) == error_t::domain);
+        REQUIRE(polygon::batch::to_cells(polygons, static_cast<resolution_t>(16), cells) == error_t::res_domain);
+    }
+
+    TEST_CASE("polygon - cells to multi polygon")
+    {
+        index center;
+        REQUIRE(from_wgs({0.6591, -2.1370}, resolution_t::r9, center) == error_t::none);
+
+        polygon::vector_based::multi polygons;
+        REQUIRE(polygon::vector_based::cells_to_multi_polygon(std::span {&center, 1u}, polygons) == error_t::none);
+        REQUIRE(polygons.size() == 1u);
+        REQUIRE(polygons[0].outer.size() == 6u);
+        REQUIRE(polygons[0].holes.empty());
+
+        // the neighbors of a cell dissolve into a ring around it
+        std::array<index, directed_edge::max_count> edges {};
+        std::span<index> edges_span {edges};
+        REQUIRE(directed_edge::of(center, edges_span) == error_t::none);
+        std::vector<index> neighbors;
+        for (const auto edge: edges_span)
+            REQUIRE(directed_edge::destination(edge, neighbors.emplace_back()) == error_t::none);
+
+        REQUIRE(polygon::vector_based::cells_to_multi_polygon(neighbors, polygons) == error_t::none);
+        REQUIRE(polygons.size() == 1u);
+        REQUIRE(polygons[0].outer.size() == 18u);
+        REQUIRE(polygons[0].holes.size() == 1u);
+        REQUIRE(polygons[0].holes[0].size() == 6u);
+
+        // the polygon of a fill covers the same cells
+        std::vector<index> cells;
+        REQUIRE(polygon::vector_based::to_cells(san_francisco, {san_francisco_hole}, resolution_t::r9, cells) == error_t::none);
+        REQUIRE(polygon::vector_based::cells_to_multi_polygon(cells, polygons) == error_t::none);
+        REQUIRE(polygons.size() == 1u);
+        REQUIRE(polygons[0].holes.size() == 1u);
+
+        std::vector<index> refilled;
+        REQUIRE(polygon::vector_based::to_cells(polygons[0].outer, polygons[0].holes, resolution_t::r9, refilled) == error_t::none);
+        std::sort(cells.begin(), cells.end());
+        std::sort(refilled.begin(), refilled.end());
+        REQUIRE(refilled == cells);
+
+        // a band around the north pole: the ring farther from the pole is the outer one, as in H3
+        index pole;
+        REQUIRE(from_wgs({std::numbers::pi_v<double> / 2.0, 0.0}, resolution_t::r2, pole) == error_t::none);
+        // the cells 2 and 3 steps away from the pole cell, grown ring by ring through the edges
+        std::vector<index> disk {pole};
+        std::size_t inner_size {};
+        for (std::size_t k {}, first {}; k != 3u; ++k)
+        {
+            const auto last = disk.size();
+            for (auto i = first; i != last; ++i)
+            {
+                edges_span = edges;
+                REQUIRE(directed_edge::of(disk[i], edges_span) == error_t::none);
+                for (const auto edge: edges_span)
+                {
+                    index neighbor;
+                    REQUIRE(directed_edge::destination(edge, neighbor) == error_t::none);
+                    if (std::find(disk.begin(), disk.end(), neighbor) == disk.end())
+                        disk.push_back(neighbor);
+                }
+            }
+
+            first = last;
+            if (k == 0u)
+                inner_size = disk.size();
+        }
+
+        const std::vector<index> band(disk.begin() + static_cast<std::ptrdiff_t>(inner_size), disk.end());
+        REQUIRE(polygon::vector_based::cells_to_multi_polygon(band, polygons) == error_t::none);
+        REQUIRE(polygons.size() == 1u);
+        REQUIRE(polygons[0].outer.size() == 42u);
+        REQUIRE(polygons[0].holes.size() == 1u);
+        REQUIRE(polygons[0].holes[0].size() == 18u);
+        const auto by_latitude = [](const gis::wgs84::coordinate& a, const gis::wgs84::coordinate& b) { return a.latitude < b.latitude; };
+        REQUIRE(std::max_element(polygons[0].outer.begin(), polygons[0].outer.end(), by_latitude)->latitude <
+                std::min_element(polygons[0].holes[0].begin(), polygons[0].holes[0].end(), by_latitude)->latitude);
+    }
+
+    TEST_CASE("polygon - cells to multi polygons")
+    {
+        index center;
+        REQUIRE(from_wgs({0.6591, -2.1370}, resolution_t::r9, center) == error_t::none);
+
+        std::array<index, directed_edge::max_count> edges {};
+        std::span<index> edges_span {edges};
+        REQUIRE(directed_edge::of(center, edges_span) == error_t::none);
+        std::vector<polygon::vector_based::class_cell> field {{center, 7u}};
+        for (const auto edge: edges_span)
+        {
+            index neighbor;
+            REQUIRE(directed_edge::destination(edge, neighbor) == error_t::none);
+            field.push_back({neighbor, 3u});
+        }
+
+        std::vector<polygon::vector_based::class_polygons> polygons;
+        REQUIRE(polygon::vector_based::cells_to_multi_polygons(field, polygons) == error_t::none);
+        REQUIRE(polygons.size() == 2u);
+        REQUIRE(polygons[0].class_id == 3u);
+        REQUIRE(polygons[0].polygons.size() == 1u);
+        REQUIRE(polygons[0].polygons[0].holes.size() == 1u);
+        REQUIRE(polygons[1].class_id == 7u);
+        REQUIRE(polygons[1].polygons.size() == 1u);
+
+        // the edges between the classes are shared: the hole runs through the vertices of the center cell backwards
+        auto hole = polygons[0].polygons[0].holes[0];
+        const auto& outer = polygons[1].polygons[0].outer;
+        REQUIRE(hole.size() == outer.size());
+        std::reverse(hole.begin(), hole.end());
+        const auto start = std::find_if(hole.begin(), hole.end(), [&outer](const gis::wgs84::coordinate& item)
+                                        { return (item.latitude == outer[0].latitude) && (item.longitude == outer[0].longitude); });
+        REQUIRE(start != hole.end());
+        std::rotate(hole.begin(), start, hole.end());
+        for (std::size_t i {}; i != outer.size(); ++i)
+        {
+            REQUIRE(hole[i].latitude == outer[i].latitude);
+            REQUIRE(hole[i].longitude == outer[i].longitude);
+        }
+    }
+
+    TEST_CASE("polygon - cells to multi polygon errors")
+    {
+        index center;
+        REQUIRE(from_wgs({0.6591, -2.1370}, resolution_t::r9, center) == error_t::none);
+        index coarse;
+        REQUIRE(from_wgs({0.6591, -2.1370}, resolution_t::r8, coarse) == error_t::none);
+
+        polygon::vector_based::multi polygons;
+        REQUIRE(polygon::vector_based::cells_to_multi_polygon({}, polygons) == error_t::none);
+        REQUIRE(polygons.empty());
+
+        const std::array duplicates {center, center};
+        REQUIRE(polygon::vector_based::cells_to_multi_polygon(duplicates, polygons) == error_t::duplicate_input);
+
+        const std::array mixed {center, coarse};
+        REQUIRE(polygon::vector_based::cells_to_multi_polygon(mixed, polygons) == error_t::res_mismatch);
+
+        const std::array invalid {center, index {}};
+        REQUIRE(polygon::vector_based::cells_to_multi_polygon(invalid, polygons) == error_t::cell_invalid);
+    }
+}
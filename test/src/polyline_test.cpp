@@ -0,0 +1,98 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <kmx/geohex/grid/neighbor.hpp>
+#include <kmx/geohex/polyline.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+namespace kmx::geohex
+{
+    // A trajectory through San Francisco, then a flight from San Francisco to Paris, in radians.
+    static const gis::wgs84::coordinate::vector trajectory {
+        gis::wgs84::coordinate::from_degrees(37.7749, -122.4194),
+        gis::wgs84::coordinate::from_degrees(37.7790, -122.4100),
+        gis::wgs84::coordinate::from_degrees(37.7790, -122.4100),
+        gis::wgs84::coordinate::from_degrees(37.7850, -122.4060),
+        gis::wgs84::coordinate::from_degrees(37.7700, -122.3950),
+    };
+
+    static const gis::wgs84::coordinate::vector flight {
+        gis::wgs84::coordinate::from_degrees(37.6213, -122.3790),
+        gis::wgs84::coordinate::from_degrees(49.0097, 2.5479),
+    };
+
+    static void require_path(const std::vector<index>& cells, const gis::wgs84::coordinate::vector& line, const resolution_t res)
+    {
+        REQUIRE(!cells.empty());
+        index first, last;
+        REQUIRE(from_wgs(line.front(), res, first) == error_t::none);
+        REQUIRE(from_wgs(line.back(), res, last) == error_t::none);
+        REQUIRE(cells.front() == first);
+        REQUIRE(cells.back() == last);
+
+        // consecutive cells are distinct neighbors
+        for (std::size_t i = 1u; i < cells.size(); ++i)
+            REQUIRE(grid::neighbor::check(cells[i - 1u], cells[i]));
+    }
+
+    TEST_CASE("polyline - to cells")
+    {
+        std::vector<index> cells;
+        REQUIRE(polyline::to_cells(trajectory, resolution_t::r10, cells) == error_t::none);
+        require_path(cells, trajectory, resolution_t::r10);
+
+        // the cell of a vertex in the middle is on the path
+        index middle;
+        REQUIRE(from_wgs(trajectory[3], resolution_t::r10, middle) == error_t::none);
+        REQUIRE(std::find(cells.begin(), cells.end(), middle) != cells.end());
+
+        REQUIRE(polyline::to_cells(flight, resolution_t::r5, cells) == error_t::none);
+        require_path(cells, flight, resolution_t::r5);
+        REQUIRE(cells.size() > 500u);
+
+        REQUIRE(polyline::to_cells(std::span {trajectory}.first(1u), resolution_t::r8, cells) == error_t::none);
+        REQUIRE(cells.size() == 1u);
+    }
+
+    TEST_CASE("polyline - batch")
+    {
+        std::vector<gis::wgs84::coordinate> coordinates;
+        std::vector<std::size_t> offsets {0u};
+        for (std::size_t i {}; i != 300u; ++i)
+        {
+            const auto& line = (i % 2u) == 0u ? trajectory : flight;
+            coordinates.insert(coordinates.end(), line.begin(), line.begin() + static_cast<std::ptrdiff_t>(1u + i % line.size()));
+            offsets.push_back(coordinates.size());
+        }
+
+        polyline::cells cells;
+        REQUIRE(polyline::to_cells({coordinates, offsets}, resolution_t::r7, cells) == error_t::none);
+        REQUIRE(cells.offsets.size() == offsets.size());
+
+        std::vector<index> expected;
+        for (std::size_t i {}; i + 1u < offsets.size(); ++i)
+        {
+            const auto line = std::span {coordinates}.subspan(offsets[i], offsets[i + 1u] - offsets[i]);
+            REQUIRE(polyline::to_cells(line, resolution_t::r7, expected) == error_t::none);
+            const auto actual = cells.of(i);
+            REQUIRE(std::equal(actual.begin(), actual.end(), expected.begin(), expected.end()));
+        }
+    }
+
+    TEST_CASE("polyline - errors")
+    {
+        std::vector<index> cells;
+        const gis::wgs84::coordinate::vector antipodes {{0.0, 0.0}, {0.0, std::numbers::pi_v<double>}};
+        REQUIRE(polyline::to_cells(antipodes, resolution_t::r3, cells) == error_t::domain);
+
+        const gis::wgs84::coordinate::vector invalid {{0.0, 0.0}, {std::numeric_limits<double>::quiet_NaN(), 0.0}};
+        REQUIRE(polyline::to_cells(invalid, resolution_t::r3, cells) == error_t::latlng_domain);
+        REQUIRE(polyline::to_cells(flight, static_cast<resolution_t>(16), cells) == error_t::res_domain);
+
+        const std::vector<std::size_t> offsets {0u, 3u};
+        polyline::cells batch;
+        REQUIRE(polyline::to_cells({flight, offsets}, resolution_t::r3, batch) == error_t::domain);
+    }
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch_all.hpp>
+#include <cmath>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/pyramid.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace kmx::geohex
+{
+    TEST_CASE("pyramid - build")
+    {
+        // events on cells of resolution 12 around San Francisco, in random order
+        std::mt19937_64 random {11u};
+        std::normal_distribution<double> offset {0.0, 0.0005};
+        const auto center = gis::wgs84::coordinate::from_degrees(37.77, -122.42);
+        std::vector<index> cells;
+        std::vector<double> values;
+        for (std::size_t i {}; i != 20000u; ++i)
+        {
+            index cell;
+            REQUIRE(from_wgs({center.latitude + offset(random), center.longitude + offset(random)}, resolution_t::r12, cell) ==
+                    error_t::none);
+            cells.push_back(cell);
+            values.push_back(static_cast<double>(i % 10u));
+        }
+
+        std::vector<pyramid::level> levels;
+        REQUIRE(pyramid::build(cells, values, resolution_t::r3, levels) == error_t::none);
+        REQUIRE(levels.size() == 10u);
+
+        // every level against a map of the ancestors
+        for (const auto& level: levels)
+        {
+            std::map<index, std::pair<std::uint64_t, double>> expected;
+            for (std::size_t i {}; i != cells.size(); ++i)
+            {
+                auto& [count, sum] = expected[cell::parent(cells[i], level.resolution)];
+                ++count;
+                sum += values[i];
+            }
+
+            REQUIRE(level.cells.size() == expected.size());
+            REQUIRE(level.counts.size() == expected.size());
+            REQUIRE(level.sums.size() == expected.size());
+            std::size_t i {};
+            for (const auto& [cell, total]: expected)
+            {
+                REQUIRE(level.cells[i] == cell);
+                REQUIRE(level.counts[i] == total.first);
+                REQUIRE(std::abs(level.sums[i] - total.second) < 1e-6);
+                ++i;
+            }
+        }
+
+        REQUIRE(levels.front().resolution == resolution_t::r12);
+        REQUIRE(levels.back().resolution == resolution_t::r3);
+        REQUIRE(levels.back().counts.front() <= cells.size());
+
+        // errors
+        REQUIRE(pyramid::build(cells, std::span {values}.first(3u), resolution_t::r3, levels) == error_t::domain);
+        REQUIRE(pyramid::build(cells, values, resolution_t::r13, levels) == error_t::res_domain);
+        cells[5] = cell::parent(cells[5], resolution_t::r11);
+        REQUIRE(pyramid::build(cells, values, resolution_t::r3, levels) == error_t::res_mismatch);
+        REQUIRE(pyramid::build({}, {}, resolution_t::r3, levels) == error_t::none);
+        REQUIRE(levels.empty());
+    }
+}
@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/radix.hpp>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace kmx::geohex
+{
+    TEST_CASE("radix - sort")
+    {
+        // cells of resolution 9 in one cell of resolution 3, with repeats, and cells of any resolution
+        std::mt19937_64 random {5u};
+        const auto parent = cell::parent(index {0x8928308280fffffu}, resolution_t::r3);
+        std::vector<index> local;
+        cell::for_each_descendant(parent, resolution_t::r9, [&local](const index cell) { local.push_back(cell); });
+        for (std::size_t i {}; i != 100000u; ++i)
+            local.push_back(local[random() % local.size()]);
+        std::shuffle(local.begin(), local.end(), random);
+
+        std::vector<index> mixed;
+        for (std::size_t i {}; i != 1000u; ++i)
+            mixed.push_back(cell::parent(local[i], static_cast<resolution_t>(random() % 10u)));
+
+        for (const auto* cells: {&local, &mixed})
+        {
+            auto expected = *cells;
+            std::sort(expected.begin(), expected.end());
+            auto sorted = *cells;
+            radix::sort(sorted);
+            REQUIRE(sorted == expected);
+        }
+    }
+
+    TEST_CASE("radix - sort with values")
+    {
+        std::mt19937_64 random {6u};
+        std::vector<index> cells;
+        cell::for_each_descendant(index {0x8001fffffffffffu}, resolution_t::r6, [&cells](const index cell) { cells.push_back(cell); });
+        for (std::size_t i {}; i != 200000u; ++i)
+            cells.push_back(cells[random() % cells.size()]);
+        std::shuffle(cells.begin(), cells.end(), random);
+
+        // the values are the rows: equal cells keep the order of their rows
+        std::vector<std::uint64_t> rows(cells.size());
+        std::iota(rows.begin(), rows.end(), std::uint64_t {});
+        std::vector<std::uint64_t> expected = rows;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [&cells](const std::uint64_t a, const std::uint64_t b) { return cells[a] < cells[b]; });
+
+        auto sorted = cells;
+        REQUIRE(radix::sort(sorted, rows) == error_t::none);
+        REQUIRE(rows == expected);
+        for (std::size_t i {}; i != cells.size(); ++i)
+            REQUIRE(sorted[i] == cells[rows[i]]);
+
+        std::vector<std::uint64_t> short_values(1u);
+        REQUIRE(radix::sort(sorted, short_values) == error_t::domain);
+    }
+}
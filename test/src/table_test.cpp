@@ -0,0 +1,105 @@
+#include <catch2/catch_all.hpp>
+#include <cstring>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/table.hpp>
+#include <vector>
+
+namespace kmx::geohex
+{
+    /// @brief The payload of a cell in the tests: its value, repeated by its last digit.
+    static std::vector<std::byte> payload_of(const index cell)
+    {
+        const index::value_t value = cell;
+        std::vector<std::byte> result(sizeof(value) * (value % 4u));
+        for (std::size_t i {}; i < result.size(); i += sizeof(value))
+            std::memcpy(result.data() + i, &value, sizeof(value));
+        return result;
+    }
+
+    TEST_CASE("table - find")
+    {
+        // the resolution 4 descendants of base cell 0 (a hexagon), the resolution 2 ones of base cell 4 (a pentagon)
+        std::vector<index> cells;
+        index base_0 {0x8001fffffffffffu}, base_4 {0x8009fffffffffffu};
+        cell::for_each_descendant(base_0, resolution_t::r4, [&cells](const index cell) { cells.push_back(cell); });
+        cell::for_each_descendant(base_4, resolution_t::r2, [&cells](const index cell) { cells.push_back(cell); });
+
+        table::writer writer;
+        for (auto i = cells.size(); i-- != 0u;)
+            writer.add(cells[i], payload_of(cells[i]));
+
+        std::vector<std::byte> data;
+        REQUIRE(writer.write(data) == error_t::none);
+
+        table::view view;
+        REQUIRE(view.open(data) == error_t::none);
+        REQUIRE(view.size() == cells.size());
+        for (const auto cell: cells)
+        {
+            const auto rank = view.find(cell);
+            REQUIRE(rank < view.size());
+            REQUIRE(view.key(rank) == cell);
+            const auto payload = view.payload(rank);
+            const auto expected = payload_of(cell);
+            REQUIRE(std::equal(payload.begin(), payload.end(), expected.begin(), expected.end()));
+        }
+
+        // parents are not in the table, descendants find their ancestor
+        REQUIRE(view.find(base_0) == view.size());
+        REQUIRE(view.find_ancestor(base_0) == view.size());
+        cell::for_each_descendant(cells[100], resolution_t::r6,
+                                  [&view, &cells](const index cell) { REQUIRE(view.find_ancestor(cell) == view.find(cells[100])); });
+        cell::for_each_descendant(cells.back(), resolution_t::r5,
+                                  [&view, &cells](const index cell) { REQUIRE(view.key(view.find_ancestor(cell)) == cells.back()); });
+
+        table::writer empty;
+        data.clear();
+        REQUIRE(empty.write(data) == error_t::none);
+        REQUIRE(view.open(data) == error_t::none);
+        REQUIRE(view.size() == 0u);
+        REQUIRE(view.find(base_0) == 0u);
+    }
+
+    TEST_CASE("table - errors")
+    {
+        table::writer writer;
+        const index cell {0x8001fffffffffffu};
+        writer.add(cell, {});
+        writer.add(cell, {});
+        std::vector<std::byte> data;
+        REQUIRE(writer.write(data) == error_t::duplicate_input);
+
+        table::writer invalid;
+        invalid.add(index {0u}, {});
+        REQUIRE(invalid.write(data) == error_t::cell_invalid);
+
+        table::writer single;
+        single.add(cell, payload_of(cell));
+        REQUIRE(single.write(data) == error_t::none);
+
+        table::view view;
+        REQUIRE(view.open(std::span {data}.first(data.size() - 1u)) == error_t::domain);
+
+        data[0] ^= std::byte {1u};
+        REQUIRE(view.open(data) == error_t::domain);
+
+        // a damaged summary: the block numbers point past the keys
+        std::vector<index> cells;
+        cell::for_each_descendant(cell, resolution_t::r3, [&cells](const index child) { cells.push_back(child); });
+        table::writer several;
+        for (const auto child: cells)
+            several.add(child, {});
+
+        data.clear();
+        REQUIRE(several.write(data) == error_t::none);
+        for (std::size_t slot {}; slot <= (cells.size() + table::block_size - 1u) / table::block_size; ++slot)
+        {
+            const std::uint64_t block = std::uint64_t {1u} << 40u;
+            std::memcpy(data.data() + 64u + slot * 16u + 8u, &block, sizeof(block));
+        }
+
+        REQUIRE(view.open(data) == error_t::none);
+        for (const auto child: cells)
+            REQUIRE(view.find(child) <= view.size());
+    }
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <kmx/geohex/tile.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <numbers>
+#include <vector>
+
+namespace kmx::geohex
+{
+    /// @brief Checks that the cells of the points of a grid over a box are in sorted cells.
+    static void require_covered(const std::vector<index>& cells, const tile::box& box, const resolution_t res)
+    {
+        const double width = box.is_transmeridian() ? box.east - box.west + 2.0 * std::numbers::pi_v<double> : box.east - box.west;
+        for (auto i = 0; i <= 40; ++i)
+            for (auto j = 0; j <= 40; ++j)
+            {
+                const gis::wgs84::coordinate point {box.south + (box.north - box.south) * i / 40.0,
+                                                    std::remainder(box.west + width * j / 40.0, 2.0 * std::numbers::pi_v<double>)};
+                index cell;
+                REQUIRE(from_wgs(point, res, cell) == error_t::none);
+                REQUIRE(std::binary_search(cells.begin(), cells.end(), cell));
+            }
+    }
+
+    TEST_CASE("tile - to cells")
+    {
+        // the tile of San Francisco at zoom 12
+        const tile::id tile {12u, 655u, 1583u};
+        const auto box = tile::to_box(tile);
+        REQUIRE(box.contains(gis::wgs84::coordinate::from_degrees(37.7749, -122.4194)));
+
+        std::vector<index> cells;
+        REQUIRE(tile::to_cells(tile, resolution_t::r9, cells) == error_t::none);
+        REQUIRE(std::is_sorted(cells.begin(), cells.end()));
+        require_covered(cells, box, resolution_t::r9);
+
+        // each cell comes within its radius of the tile
+        const double radius = cell::bounds::max_radius(resolution_t::r9);
+        for (const auto cell: cells)
+        {
+            tile::box cell_box;
+            REQUIRE(cell::bounds::get(cell, cell_box) == error_t::none);
+            REQUIRE(cell_box.south <= box.north + radius);
+            REQUIRE(cell_box.north >= box.south - radius);
+            REQUIRE(cell_box.west <= box.east + 2.0 * radius);
+            REQUIRE(cell_box.east >= box.west - 2.0 * radius);
+        }
+
+        // a box across the antimeridian, and one around a pole
+        const tile::box pacific {-0.1, 0.1, 3.1, -3.1};
+        REQUIRE(tile::to_cells(pacific, resolution_t::r4, cells) == error_t::none);
+        require_covered(cells, pacific, resolution_t::r4);
+
+        const tile::box arctic {1.5, std::numbers::pi_v<double> / 2.0, -std::numbers::pi_v<double>, std::numbers::pi_v<double>};
+        REQUIRE(tile::to_cells(arctic, resolution_t::r3, cells) == error_t::none);
+        require_covered(cells, arctic, resolution_t::r3);
+
+        REQUIRE(tile::to_cells(tile::box {0.2, 0.1, 0.0, 0.1}, resolution_t::r4, cells) == error_t::latlng_domain);
+        REQUIRE(tile::to_cells(tile::id {2u, 4u, 0u}, resolution_t::r4, cells) == error_t::domain);
+    }
+
+    TEST_CASE("tile - to tiles")
+    {
+        const tile::id tile {12u, 655u, 1583u};
+        std::vector<index> cells;
+        REQUIRE(tile::to_cells(tile, resolution_t::r8, cells) == error_t::none);
+
+        // the tiles of the cover surround the tile
+        std::vector<tile::id> tiles;
+        REQUIRE(tile::to_tiles(cells, 12u, tiles) == error_t::none);
+        REQUIRE(std::binary_search(tiles.begin(), tiles.end(), tile));
+        REQUIRE(tiles.size() <= 9u);
+
+        REQUIRE(tile::to_tiles(cells, 0u, tiles) == error_t::none);
+        REQUIRE(tiles == std::vector<tile::id> {{0u, 0u, 0u}});
+        REQUIRE(tile::to_tiles(cells, 31u, tiles) == error_t::domain);
+    }
+
+    TEST_CASE("tile - cache")
+    {
+        tile::cache cache {2u};
+        tile::cache::cells first, second;
+        REQUIRE(cache.get({10u, 163u, 395u}, resolution_t::r7, first) == error_t::none);
+        REQUIRE(cache.get({10u, 163u, 395u}, resolution_t::r7, second) == error_t::none);
+        REQUIRE(first == second);
+
+        std::vector<index> cells;
+        REQUIRE(tile::to_cells(tile::id {10u, 163u, 395u}, resolution_t::r7, cells) == error_t::none);
+        REQUIRE(*first == cells);
+
+        // the oldest cover is replaced
+        REQUIRE(cache.get({10u, 164u, 395u}, resolution_t::r7, second) == error_t::none);
+        REQUIRE(cache.get({10u, 165u, 395u}, resolution_t::r7, second) == error_t::none);
+        REQUIRE(cache.get({10u, 163u, 395u}, resolution_t::r7, second) == error_t::none);
+        REQUIRE(first != second);
+        REQUIRE(*first == *second);
+    }
+}
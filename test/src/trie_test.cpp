@@ -0,0 +1,70 @@
+#include <catch2/catch_all.hpp>
+#include <cmath>
+#include <kmx/geohex/cell.hpp>
+#include <kmx/geohex/trie.hpp>
+#include <kmx/gis/wgs84/coordinate.hpp>
+#include <random>
+#include <vector>
+
+namespace kmx::geohex
+{
+    TEST_CASE("trie - aggregates")
+    {
+        // values on random cells of resolution 9 around San Francisco, and on a few of their resolution 5 ancestors
+        std::mt19937_64 random {3u};
+        std::normal_distribution<double> offset {0.0, 0.005};
+        std::uniform_real_distribution<double> value {-10.0, 10.0};
+        const auto center = gis::wgs84::coordinate::from_degrees(37.77, -122.42);
+        std::vector<index> cells;
+        std::vector<double> values;
+        for (std::size_t i {}; i != 3000u; ++i)
+        {
+            index cell;
+            REQUIRE(from_wgs({center.latitude + offset(random), center.longitude + offset(random)}, resolution_t::r9, cell) ==
+                    error_t::none);
+            cells.push_back(i % 100u == 0u ? cell::parent(cell, resolution_t::r5) : cell);
+            values.push_back(value(random));
+        }
+
+        trie::tree tree;
+        REQUIRE(tree.assign(cells, values) == error_t::none);
+        REQUIRE(tree.size() == cells.size());
+
+        // the aggregate of every ancestor of a few cells, against a scan of the values
+        for (std::size_t i = 1u; i < cells.size(); i += 211u)
+            for (auto res = +resolution_t::r3; res <= +resolution_t::r9; ++res)
+            {
+                const auto ancestor = cell::parent(cells[i], static_cast<resolution_t>(res));
+                trie::aggregate expected;
+                for (std::size_t j {}; j != cells.size(); ++j)
+                    if ((cells[j].resolution() >= ancestor.resolution()) && (cell::parent(cells[j], ancestor.resolution()) == ancestor))
+                        expected.add(values[j]);
+
+                const auto actual = tree.total(ancestor);
+                REQUIRE(actual.count == expected.count);
+                REQUIRE(std::abs(actual.sum - expected.sum) < 1e-9);
+                REQUIRE(actual.min == expected.min);
+                REQUIRE(actual.max == expected.max);
+            }
+
+        // the values of a cell itself, and the finest ancestor with values
+        REQUIRE(tree.values(cells[1]).count >= 1u);
+        REQUIRE(tree.values(cell::parent(cells[1], resolution_t::r7)).count == 0u);
+        index found;
+        std::vector<index> children;
+        cell::for_each_child(cells[1], [&children](const index child) { children.push_back(child); });
+        REQUIRE(tree.find_ancestor(children.front(), found));
+        REQUIRE(found == cells[1]);
+        index descendant;
+        cell::for_each_descendant(cells[0], resolution_t::r7, [&descendant](const index cell) { descendant = cell; });
+        REQUIRE(tree.find_ancestor(descendant, found));
+        REQUIRE(found == cells[0]);
+
+        REQUIRE(tree.insert(cells[1], 100.0) == error_t::none);
+        REQUIRE(tree.values(cells[1]).max == 100.0);
+        REQUIRE(tree.total(cell::parent(cells[1], resolution_t::r0)).count == cells.size() + 1u);
+
+        REQUIRE(tree.assign(cells, std::span {values}.first(10u)) == error_t::domain);
+        REQUIRE(tree.insert(index {0u}, 1.0) == error_t::cell_invalid);
+    }
+}
@@ -0,0 +1,101 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <kmx/geohex/grid/neighbor.hpp>
+#include <kmx/geohex/mesh.hpp>
+#include <kmx/geohex/vertex.hpp>
+#include <vector>
+
+namespace kmx::geohex
+{
+    static std::vector<index> cell_with_neighbors(const index origin)
+    {
+        std::vector<index> result {origin};
+        for (auto d = +direction_t::k_axes; d != direction_count; ++d)
+        {
+            int rotations {};
+            index neighbor;
+            if (grid::neighbor::get(origin, static_cast<direction_t>(d), rotations, neighbor) == error_t::none)
+                result.push_back(neighbor);
+        }
+
+        return result;
+    }
+
+    TEST_CASE("vertex - of hexagon")
+    {
+        const index origin {0x85283473fffffffu};
+        std::array<index, vertex::max_count> buffer {};
+        std::span<index> vertices {buffer};
+        REQUIRE(vertex::of(origin, vertices) == error_t::none);
+        REQUIRE(vertices.size() == 6u);
+
+        for (vertex::number_t i {}; i != 6; ++i)
+        {
+            REQUIRE(vertex::is_valid(vertices[i]));
+            REQUIRE(vertex::owner(vertices[i]) <= origin);
+
+            index single;
+            REQUIRE(vertex::of(origin, i, single) == error_t::none);
+            REQUIRE(single == vertices[i]);
+        }
+
+        index out_of_range;
+        REQUIRE(vertex::of(origin, 6, out_of_range) == error_t::domain);
+        REQUIRE(!vertex::is_valid(origin));
+    }
+
+    TEST_CASE("vertex - of pentagon")
+    {
+        const index origin {0x8009fffffffffffu};
+        std::array<index, vertex::max_count> buffer {};
+        std::span<index> vertices {buffer};
+        REQUIRE(vertex::of(origin, vertices) == error_t::none);
+        REQUIRE(vertices.size() == 5u);
+
+        for (const auto item: vertices)
+            REQUIRE(vertex::is_valid(item));
+    }
+
+    TEST_CASE("vertex - shared by neighbors")
+    {
+        const auto cells = cell_with_neighbors(index {0x85283473fffffffu});
+        std::array<index, vertex::max_count> origin_buffer {};
+        std::span<index> origin_vertices {origin_buffer};
+        REQUIRE(vertex::of(cells.front(), origin_vertices) == error_t::none);
+
+        for (std::size_t i = 1u; i != cells.size(); ++i)
+        {
+            std::array<index, vertex::max_count> buffer {};
+            std::span<index> vertices {buffer};
+            REQUIRE(vertex::of(cells[i], vertices) == error_t::none);
+
+            const auto shared = std::count_if(vertices.begin(), vertices.end(), [&](const index item)
+                                              { return std::find(origin_vertices.begin(), origin_vertices.end(), item) != origin_vertices.end(); });
+            REQUIRE(shared == 2);
+        }
+    }
+
+    TEST_CASE("mesh - shared vertices")
+    {
+        const auto cells = cell_with_neighbors(index {0x85283473fffffffu});
+        REQUIRE(cells.size() == 7u);
+
+        mesh::indexed result;
+        REQUIRE(mesh::build(cells, result) == error_t::none);
+        REQUIRE(result.vertices.size() == 24u);
+        REQUIRE(result.positions.size() == result.vertices.size());
+        REQUIRE(result.triangles.size() == mesh::max_triangle_count(cells.size()) * 3u);
+        REQUIRE(std::is_sorted(result.vertices.begin(), result.vertices.end()));
+
+        for (const auto item: result.triangles)
+            REQUIRE(item < result.vertices.size());
+
+        for (const auto& position: result.positions)
+        {
+            const auto length_squared = position.x * position.x + position.y * position.y + position.z * position.z;
+            REQUIRE(std::abs(length_squared - 1.0f) < 1e-5f);
+        }
+    }
+}